@@ -0,0 +1,408 @@
+#include "BufferPool.h"
+#include "NumaUtils.h"
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <malloc.h>
+#elif defined(__linux__)
+    #include <sys/mman.h>
+    #include <unistd.h>
+    #include <cstdint>
+#endif
+
+namespace GenICamWrapper {
+
+    namespace {
+        constexpr size_t HUGE_PAGE_2M = size_t(2) * 1024 * 1024;
+        constexpr size_t HUGE_PAGE_1G = size_t(1024) * 1024 * 1024;
+
+        size_t roundUp(size_t value, size_t multiple) {
+            return ((value + multiple - 1) / multiple) * multiple;
+        }
+    }
+
+    BufferPool::~BufferPool() {
+        for (auto& block : m_blocks) {
+            freeBlock(block);
+        }
+    }
+
+    const char* BufferPool::policyToString(BufferMemoryPolicy policy) {
+        switch (policy) {
+        case BufferMemoryPolicy::TransparentHugePages: return "TransparentHugePages";
+        case BufferMemoryPolicy::HugePages2M: return "HugePages2M";
+        case BufferMemoryPolicy::HugePages1G: return "HugePages1G";
+        case BufferMemoryPolicy::Default:
+        default: return "Default";
+        }
+    }
+
+#ifdef _WIN32
+
+    bool BufferPool::allocateMapped(Block& block, BufferMemoryPolicy policy, std::string& error) {
+        // Windows offre solo le large page (tipicamente 2 MiB), con SeLockMemoryPrivilege
+        if (policy == BufferMemoryPolicy::TransparentHugePages || policy == BufferMemoryPolicy::HugePages1G) {
+            error = std::string(policyToString(policy)) + " non supportato su Windows";
+            return false;
+        }
+
+        const bool largePages = (policy == BufferMemoryPolicy::HugePages2M);
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        const size_t pageSize = largePages ? GetLargePageMinimum() : systemInfo.dwAllocationGranularity;
+        if (pageSize == 0 || block.alignment > pageSize) {
+            error = largePages ? "Large page non disponibili" : "Allineamento superiore alla granularità di VirtualAlloc";
+            return false;
+        }
+
+        const size_t mappedSize = roundUp(block.size, pageSize);
+        const DWORD flags = MEM_RESERVE | MEM_COMMIT | (largePages ? MEM_LARGE_PAGES : 0);
+        void* ptr = nullptr;
+        if (block.numaNode >= 0) {
+            ptr = VirtualAllocExNuma(GetCurrentProcess(), nullptr, mappedSize, flags, PAGE_READWRITE, static_cast<DWORD>(block.numaNode));
+        }
+        else {
+            ptr = VirtualAlloc(nullptr, mappedSize, flags, PAGE_READWRITE);
+        }
+        if (!ptr) {
+            error = std::string(largePages ? "VirtualAlloc(MEM_LARGE_PAGES)" : "VirtualAllocExNuma")
+                + " fallita (errore " + std::to_string(GetLastError()) + ")";
+            return false;
+        }
+
+        block.ptr = ptr;
+        block.mapped = true;
+        block.mappedSize = mappedSize;
+        block.policy = policy;
+        block.numaBound = block.numaNode >= 0;
+        return true;
+    }
+
+#elif defined(__linux__)
+
+    bool BufferPool::allocateMapped(Block& block, BufferMemoryPolicy policy, std::string& error) {
+        if (policy == BufferMemoryPolicy::TransparentHugePages) {
+            if (block.alignment > HUGE_PAGE_2M) {
+                error = "Allineamento superiore a 2 MiB";
+                return false;
+            }
+
+            // Regione allineata a 2 MiB: il kernel può usare huge page solo su range allineati
+            const size_t mappedSize = roundUp(block.size, HUGE_PAGE_2M);
+            const size_t reserveSize = mappedSize + HUGE_PAGE_2M;
+            void* raw = mmap(nullptr, reserveSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) {
+                error = std::string("mmap: ") + std::strerror(errno);
+                return false;
+            }
+
+            const uintptr_t rawAddress = reinterpret_cast<uintptr_t>(raw);
+            const uintptr_t alignedAddress = roundUp(rawAddress, HUGE_PAGE_2M);
+            const size_t head = alignedAddress - rawAddress;
+            const size_t tail = reserveSize - head - mappedSize;
+            if (head > 0) {
+                munmap(raw, head);
+            }
+            if (tail > 0) {
+                munmap(reinterpret_cast<void*>(alignedAddress + mappedSize), tail);
+            }
+
+            void* ptr = reinterpret_cast<void*>(alignedAddress);
+            block.ptr = ptr;
+            block.mapped = true;
+            block.mappedSize = mappedSize;
+            bindToNode(block, error);
+
+            if (madvise(ptr, mappedSize, MADV_HUGEPAGE) != 0) {
+                // THP disabilitate (never): la memoria resta valida con pagine normali
+                error = std::string("madvise(MADV_HUGEPAGE): ") + std::strerror(errno);
+                block.policy = BufferMemoryPolicy::Default;
+                return true;
+            }
+
+            block.policy = BufferMemoryPolicy::TransparentHugePages;
+            return true;
+        }
+
+        if (policy == BufferMemoryPolicy::Default) {
+            // Pagine normali via mmap: solo per poter vincolare il range a un nodo NUMA
+            const size_t systemPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            if (block.alignment > systemPageSize) {
+                error = "Allineamento superiore alla pagina di sistema";
+                return false;
+            }
+
+            const size_t mappedSize = roundUp(block.size, systemPageSize);
+            void* ptr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED) {
+                error = std::string("mmap: ") + std::strerror(errno);
+                return false;
+            }
+
+            block.ptr = ptr;
+            block.mapped = true;
+            block.mappedSize = mappedSize;
+            block.policy = BufferMemoryPolicy::Default;
+            bindToNode(block, error);
+            return true;
+        }
+
+        const size_t pageSize = (policy == BufferMemoryPolicy::HugePages1G) ? HUGE_PAGE_1G : HUGE_PAGE_2M;
+        if (block.alignment > pageSize) {
+            error = "Allineamento superiore alla dimensione della huge page";
+            return false;
+        }
+
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+        flags |= (policy == BufferMemoryPolicy::HugePages1G ? 30 : 21) << MAP_HUGE_SHIFT;
+#else
+        if (policy == BufferMemoryPolicy::HugePages1G) {
+            error = "MAP_HUGE_1GB non supportato";
+            return false;
+        }
+#endif
+
+        const size_t mappedSize = roundUp(block.size, pageSize);
+        void* ptr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (ptr == MAP_FAILED) {
+            // ENOMEM: pool di huge page (vm.nr_hugepages) vuoto o insufficiente
+            error = std::string("mmap(MAP_HUGETLB ") + policyToString(policy) + "): " + std::strerror(errno);
+            return false;
+        }
+
+        block.ptr = ptr;
+        block.mapped = true;
+        block.mappedSize = mappedSize;
+        block.policy = policy;
+        bindToNode(block, error);
+        return true;
+    }
+
+#else
+
+    bool BufferPool::allocateMapped(Block& block, BufferMemoryPolicy policy, std::string& error) {
+        error = std::string(policyToString(policy)) + " non supportato su questa piattaforma";
+        return false;
+    }
+
+#endif
+
+    void BufferPool::bindToNode(Block& block, std::string& error) {
+        if (block.numaNode < 0) {
+            return;
+        }
+
+        // Prima del primo accesso: le pagine vengono allocate sul nodo al page fault
+        std::string bindError;
+        block.numaBound = NumaUtils::bindMemory(block.ptr, block.mappedSize, block.numaNode, bindError);
+        if (!block.numaBound) {
+            error = bindError;
+        }
+    }
+
+    bool BufferPool::allocateBlock(Block& block, std::string& fallbackReason) {
+        // Dalla politica richiesta verso quelle meno restrittive
+        // Con un nodo NUMA anche le pagine normali passano da mmap/VirtualAlloc (livello 0)
+        std::string reasons;
+        const int lowestMappedLevel = block.numaNode >= 0 ? 0 : 1;
+        for (int level = static_cast<int>(block.requestedPolicy); level >= lowestMappedLevel; --level) {
+            std::string error;
+            const bool allocated = allocateMapped(block, static_cast<BufferMemoryPolicy>(level), error);
+            if (!error.empty()) {
+                reasons += (reasons.empty() ? "" : "; ") + error;
+            }
+            if (allocated) {
+                break;
+            }
+        }
+
+        if (!reasons.empty()) {
+            fallbackReason = reasons;
+        }
+        if (block.ptr) {
+            return true;
+        }
+
+#ifdef _WIN32
+        block.ptr = _aligned_malloc(block.size, block.alignment);
+#else
+        // aligned_alloc richiede una dimensione multipla dell'allineamento
+        block.ptr = aligned_alloc(block.alignment, roundUp(block.size, block.alignment));
+#endif
+        block.mapped = false;
+        block.policy = BufferMemoryPolicy::Default;
+        return block.ptr != nullptr;
+    }
+
+    void BufferPool::freeBlock(const Block& block) {
+        if (!block.ptr) {
+            return;
+        }
+
+        if (block.mapped) {
+#ifdef _WIN32
+            VirtualFree(block.ptr, 0, MEM_RELEASE);
+#elif defined(__linux__)
+            munmap(block.ptr, block.mappedSize);
+#endif
+            return;
+        }
+
+#ifdef _WIN32
+        _aligned_free(block.ptr);
+#else
+        free(block.ptr);
+#endif
+    }
+
+    std::vector<void*> BufferPool::acquire(size_t count, size_t size, size_t alignment, BufferMemoryPolicy policy, int numaNode, bool zeroFill) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Nuova chiave: i blocchi liberi della precedente non sono più utilizzabili
+        if (size != m_bufferSize || alignment != m_alignment || policy != m_policy || numaNode != m_numaNode) {
+            m_bufferSize = size;
+            m_alignment = alignment;
+            m_policy = policy;
+            m_numaNode = numaNode;
+            m_lastFallbackReason.clear();
+            trimLocked();
+        }
+
+        std::vector<void*> result;
+        result.reserve(count);
+
+        for (auto& block : m_blocks) {
+            if (result.size() == count) {
+                break;
+            }
+            if (!block.inUse && block.size == size && block.alignment == alignment &&
+                block.requestedPolicy == policy && block.numaNode == numaNode) {
+                block.inUse = true;
+                result.push_back(block.ptr);
+                ++m_reuses;
+            }
+        }
+
+        while (result.size() < count) {
+            Block block;
+            block.size = size;
+            block.alignment = alignment;
+            block.requestedPolicy = policy;
+            block.numaNode = numaNode;
+
+            if (!allocateBlock(block, m_lastFallbackReason)) {
+                // Nessun blocco trattenuto: quelli prelevati tornano liberi nel pool
+                for (void* taken : result) {
+                    for (auto& pooled : m_blocks) {
+                        if (pooled.ptr == taken) {
+                            pooled.inUse = false;
+                        }
+                    }
+                }
+                return {};
+            }
+
+            // Azzera la memoria (alcune telecamere lo richiedono); solo alla prima allocazione
+            if (zeroFill) {
+                std::memset(block.ptr, 0, size);
+            }
+
+            block.inUse = true;
+            m_blocks.push_back(block);
+            result.push_back(block.ptr);
+            ++m_allocations;
+        }
+
+        return result;
+    }
+
+    void BufferPool::release(void* ptr) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it) {
+            if (it->ptr != ptr) {
+                continue;
+            }
+
+            if (it->size != m_bufferSize || it->alignment != m_alignment ||
+                it->requestedPolicy != m_policy || it->numaNode != m_numaNode) {
+                // Blocco di una chiave precedente: non verrà più riutilizzato
+                freeBlock(*it);
+                m_blocks.erase(it);
+                ++m_trimmedBuffers;
+            }
+            else {
+                it->inUse = false;
+            }
+            return;
+        }
+    }
+
+    std::shared_ptr<void> BufferPool::detach(void* ptr) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it) {
+            if (it->ptr == ptr) {
+                const Block block = *it;
+                m_blocks.erase(it);
+                return std::shared_ptr<void>(block.ptr, [block](void*) { freeBlock(block); });
+            }
+        }
+        return nullptr;
+    }
+
+    void BufferPool::trim() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        trimLocked();
+    }
+
+    void BufferPool::trimLocked() {
+        auto firstFree = std::stable_partition(m_blocks.begin(), m_blocks.end(),
+            [](const Block& block) { return block.inUse; });
+
+        for (auto it = firstFree; it != m_blocks.end(); ++it) {
+            freeBlock(*it);
+            ++m_trimmedBuffers;
+        }
+        m_blocks.erase(firstFree, m_blocks.end());
+    }
+
+    BufferPoolStatistics BufferPool::statistics() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        BufferPoolStatistics stats;
+        stats.bufferSize = m_bufferSize;
+        stats.alignment = m_alignment;
+        stats.requestedPolicy = m_policy;
+        stats.numaNode = m_numaNode;
+        stats.lastFallbackReason = m_lastFallbackReason;
+        stats.totalBuffers = m_blocks.size();
+        for (const auto& block : m_blocks) {
+            if (!block.inUse) {
+                ++stats.freeBuffers;
+            }
+            stats.totalBytes += block.mapped ? block.mappedSize : block.size;
+            if (block.numaBound) {
+                ++stats.numaBoundBuffers;
+            }
+
+            switch (block.policy) {
+            case BufferMemoryPolicy::TransparentHugePages: ++stats.transparentHugePageBuffers; break;
+            case BufferMemoryPolicy::HugePages2M: ++stats.hugePage2MBuffers; break;
+            case BufferMemoryPolicy::HugePages1G: ++stats.hugePage1GBuffers; break;
+            case BufferMemoryPolicy::Default:
+            default: ++stats.standardPageBuffers; break;
+            }
+        }
+        stats.allocations = m_allocations;
+        stats.reuses = m_reuses;
+        stats.trimmedBuffers = m_trimmedBuffers;
+        return stats;
+    }
+
+} // namespace GenICamWrapper
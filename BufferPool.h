@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief Tipo di pagine usato per la memoria dei buffer
+     *
+     * Default:              heap allineato (pagine da 4 KiB).
+     * TransparentHugePages: mmap allineato a 2 MiB + madvise(MADV_HUGEPAGE) (Linux).
+     * HugePages2M:          mmap con MAP_HUGETLB da 2 MiB (Linux, richiede vm.nr_hugepages);
+     *                       su Windows VirtualAlloc con MEM_LARGE_PAGES (SeLockMemoryPrivilege).
+     * HugePages1G:          mmap con MAP_HUGETLB da 1 GiB (Linux).
+     *
+     * Se la politica richiesta non è disponibile si ripiega sulla successiva meno
+     * restrittiva (1G -> 2M -> trasparenti -> Default); la politica ottenuta è
+     * riportata in BufferPoolStatistics.
+     */
+    enum class BufferMemoryPolicy {
+        Default,
+        TransparentHugePages,
+        HugePages2M,
+        HugePages1G
+    };
+
+    /**
+     * @brief Contatori del pool di buffer di acquisizione
+     */
+    struct BufferPoolStatistics {
+        size_t bufferSize = 0;          // Dimensione corrente dei blocchi (0 = pool vuoto)
+        size_t alignment = 0;
+        size_t totalBuffers = 0;        // Blocchi allocati (liberi + in uso)
+        size_t freeBuffers = 0;
+        size_t totalBytes = 0;
+        uint64_t allocations = 0;       // Blocchi allocati dal sistema
+        uint64_t reuses = 0;            // Blocchi riutilizzati senza allocazione
+        uint64_t trimmedBuffers = 0;    // Blocchi liberati per cambio dimensione o trim
+
+        // Politica richiesta e blocchi per politica effettivamente ottenuta
+        BufferMemoryPolicy requestedPolicy = BufferMemoryPolicy::Default;
+        size_t standardPageBuffers = 0;
+        size_t transparentHugePageBuffers = 0;
+        size_t hugePage2MBuffers = 0;
+        size_t hugePage1GBuffers = 0;
+        std::string lastFallbackReason;     // Motivo dell'ultimo ripiego (vuoto se nessuno)
+
+        int numaNode = -1;                  // Nodo richiesto (-1 = nessun vincolo)
+        size_t numaBoundBuffers = 0;        // Blocchi effettivamente vincolati al nodo
+    };
+
+    /**
+     * @brief Pool persistente di memoria allineata per i buffer GenTL
+     *
+     * I blocchi sopravvivono alla chiusura del data stream: a ogni sessione di
+     * acquisizione vengono solo riannunciati al producer, senza allocazione né
+     * azzeramento. Il pool contiene blocchi di una sola coppia dimensione/allineamento:
+     * una richiesta con chiave diversa (es. cambio di PayloadSize) libera i blocchi
+     * liberi della chiave precedente; quelli ancora in uso vengono liberati al rilascio.
+     * Anche la politica di memoria e il nodo NUMA fanno parte della chiave.
+     *
+     * Thread Safety: tutti i metodi sono serializzati internamente.
+     */
+    class BufferPool {
+    public:
+        BufferPool() = default;
+        ~BufferPool();
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        /**
+         * @brief Preleva count blocchi di size byte allineati ad alignment
+         * @param alignment Potenza di 2
+         * @return Blocchi prelevati; vuoto se l'allocazione fallisce (nessun blocco trattenuto)
+         * @param zeroFill Azzera i blocchi nuovi; quelli riutilizzati contengono i dati precedenti
+         */
+        std::vector<void*> acquire(size_t count, size_t size, size_t alignment,
+            BufferMemoryPolicy policy = BufferMemoryPolicy::Default, int numaNode = -1, bool zeroFill = true);
+
+        /**
+         * @brief Restituisce un blocco al pool (la memoria non viene liberata)
+         */
+        void release(void* block);
+
+        /**
+         * @brief Libera i blocchi non in uso
+         */
+        void trim();
+
+        /**
+         * @brief Toglie un blocco in uso dal pool e ne cede la proprietà
+         * @return Memoria liberata all'ultimo riferimento; nullptr se il blocco non è del pool
+         * @note Per la memoria che deve sopravvivere al pool (es. frame ancora in prestito)
+         */
+        std::shared_ptr<void> detach(void* block);
+
+        BufferPoolStatistics statistics() const;
+
+        static const char* policyToString(BufferMemoryPolicy policy);
+
+    private:
+        struct Block {
+            void* ptr = nullptr;
+            size_t size = 0;
+            size_t alignment = 0;
+            BufferMemoryPolicy requestedPolicy = BufferMemoryPolicy::Default;
+            BufferMemoryPolicy policy = BufferMemoryPolicy::Default;    // Ottenuta
+            bool mapped = false;        // mmap/VirtualAlloc invece dell'heap
+            size_t mappedSize = 0;
+            int numaNode = -1;
+            bool numaBound = false;
+            bool inUse = false;
+        };
+
+        static bool allocateBlock(Block& block, std::string& fallbackReason);
+        static bool allocateMapped(Block& block, BufferMemoryPolicy policy, std::string& error);
+        static void bindToNode(Block& block, std::string& error);
+        static void freeBlock(const Block& block);
+        void trimLocked();
+
+        mutable std::mutex m_mutex;
+        std::vector<Block> m_blocks;
+        size_t m_bufferSize = 0;
+        size_t m_alignment = 0;
+        BufferMemoryPolicy m_policy = BufferMemoryPolicy::Default;
+        int m_numaNode = -1;
+        std::string m_lastFallbackReason;
+        uint64_t m_allocations = 0;
+        uint64_t m_reuses = 0;
+        uint64_t m_trimmedBuffers = 0;
+    };
+
+} // namespace GenICamWrapper
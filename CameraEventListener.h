@@ -21,12 +21,25 @@ namespace GenICamWrapper {
         virtual ~CameraEventListener() = default;
 
         /**
-         * @brief Callback chiamato quando un nuovo frame  disponibile
+         * @brief Callback chiamato quando un nuovo frame è disponibile
          * @param imageData Puntatore ai dati dell'immagine acquisita
          * @note Questo metodo viene chiamato dal thread di acquisizione
          */
         virtual void OnFrameReady(const ImageData* imageData, cv::Mat) = 0;
 
+        /**
+         * @brief Callback chiamato in modalità FrameDeliveryMode::Loan
+         * @param frame Frame in prestito: ImageData::buffer punta direttamente al buffer GenTL
+         * @param image Vista del frame: senza copia per i formati già in layout OpenCV (Mono, BGR, BGRa),
+         *              convertita per gli altri (Bayer, RGB, YUV, packed)
+         * @note Il buffer torna al producer quando viene rilasciato l'ultimo riferimento a frame.
+         *       image può puntare alla stessa memoria: non usarla dopo aver rilasciato frame.
+         *       L'implementazione di default inoltra a OnFrameReady (rilascio al ritorno).
+         */
+        virtual void OnFrameLoaned(std::shared_ptr<const ImageData> frame, cv::Mat image) {
+            OnFrameReady(frame.get(), image);
+        }
+
         /**
          * @brief Callback chiamato quando la connessione con la camera viene persa
          * @param errorMessage Messaggio descrittivo dell'errore
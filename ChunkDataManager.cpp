@@ -68,11 +68,11 @@ namespace GenICamWrapper {
       try {
          if (enable) {
             m_pChunkModeActive->SetIntValue(1); // Attiva chunk mode
-            std::cout << "Modalit Chunk Data attivata" << std::endl;
+            std::cout << "Modalità Chunk Data attivata" << std::endl;
          }
          else {
             m_pChunkModeActive->SetIntValue(0); // Disattiva chunk mode
-            std::cout << "Modalit Chunk Data disattivata" << std::endl;
+            std::cout << "Modalità Chunk Data disattivata" << std::endl;
          }
          m_chunkModeEnabled = enable;
       }
@@ -143,7 +143,7 @@ namespace GenICamWrapper {
    }
 
    void ChunkDataManager::EnableStandardChunks() {
-      // Abilita i chunk standard pi comuni secondo SFNC
+      // Abilita i chunk standard più comuni secondo SFNC
       EnableTimestampChunk(true);
       EnableFrameIDChunk(true);
       EnableExposureTimeChunk(true);
@@ -287,6 +287,192 @@ namespace GenICamWrapper {
       return data;
    }
 
+   bool ChunkDataManager::PrepareFrameReader(INodeMap* deviceNodeMap, bool readCounterValue) {
+      ReleaseFrameReader();
+
+      if (!deviceNodeMap) {
+         return false;
+      }
+
+      try {
+         CBooleanPtr pChunkModeActive = deviceNodeMap->GetNode("ChunkModeActive");
+         if (!pChunkModeActive.IsValid() || !IsReadable(pChunkModeActive) || !pChunkModeActive->GetValue()) {
+            return false;
+         }
+
+         m_pExposureTimeChunk = deviceNodeMap->GetNode("ChunkExposureTime");
+         m_pGainChunk = deviceNodeMap->GetNode("ChunkGain");
+         m_rawFrameID = ResolveRawChunkValue(deviceNodeMap, "ChunkFrameID");
+         if (readCounterValue) {
+            m_rawCounterValue = ResolveRawChunkValue(deviceNodeMap, "ChunkCounterValue");
+         }
+
+         if (!m_pExposureTimeChunk.IsValid() && !m_pGainChunk.IsValid() &&
+            !m_rawFrameID.valid && !m_rawCounterValue.valid) {
+            return false;
+         }
+
+         if (m_pExposureTimeChunk.IsValid() || m_pGainChunk.IsValid()) {
+            m_frameChunkAdapter = std::make_unique<CChunkAdapterGeneric>(deviceNodeMap);
+         }
+         return true;
+      }
+      catch (const GenericException& e) {
+         std::cerr << "Chunk metadata non disponibili: " << e.GetDescription() << std::endl;
+         ReleaseFrameReader();
+         return false;
+      }
+   }
+
+   void ChunkDataManager::ReleaseFrameReader() {
+      std::lock_guard<std::mutex> lock(m_frameReaderMutex);
+      m_frameChunkAdapter.reset();
+      m_pExposureTimeChunk = nullptr;
+      m_pGainChunk = nullptr;
+      m_rawFrameID = RawChunkValue();
+      m_rawCounterValue = RawChunkValue();
+   }
+
+   RawChunkValue ChunkDataManager::ResolveRawChunkValue(INodeMap* deviceNodeMap, const char* nodeName) {
+      RawChunkValue location;
+
+      INode* pNode = deviceNodeMap->GetNode(nodeName);
+      if (!pNode) {
+         return location;
+      }
+
+      // Solo registri a indirizzo fisso: indirizzi calcolati (pAddress, pIndex) o
+      // valori derivati (converter, swiss knife) richiedono il nodemap
+      gcstring value, attribute;
+      if (pNode->GetProperty("pAddress", value, attribute) || pNode->GetProperty("pIndex", value, attribute)) {
+         return location;
+      }
+
+      gcstring address, length, port, chunkID;
+      if (!pNode->GetProperty("Address", address, attribute) ||
+         !pNode->GetProperty("Length", length, attribute) ||
+         !pNode->GetProperty("pPort", port, attribute)) {
+         return location;
+      }
+
+      INode* pPort = deviceNodeMap->GetNode(port);
+      if (!pPort || !pPort->GetProperty("ChunkID", chunkID, attribute)) {
+         return location;
+      }
+
+      unsigned lsb = 0;
+      unsigned msb = 0;
+      bool masked = false;
+      try {
+         location.offset = static_cast<size_t>(std::stoull(address.c_str(), nullptr, 0));
+         location.length = static_cast<size_t>(std::stoull(length.c_str(), nullptr, 0));
+         // Nel file XML il ChunkID è esadecimale
+         location.chunkID = std::stoull(chunkID.c_str(), nullptr, 16);
+
+         gcstring lsbValue, msbValue;
+         if (pNode->GetProperty("Bit", lsbValue, attribute)) {
+            lsb = msb = static_cast<unsigned>(std::stoul(lsbValue.c_str(), nullptr, 0));
+            masked = true;
+         }
+         else if (pNode->GetProperty("LSB", lsbValue, attribute) && pNode->GetProperty("MSB", msbValue, attribute)) {
+            lsb = static_cast<unsigned>(std::stoul(lsbValue.c_str(), nullptr, 0));
+            msb = static_cast<unsigned>(std::stoul(msbValue.c_str(), nullptr, 0));
+            masked = true;
+         }
+      }
+      catch (const std::exception&) {
+         return location;
+      }
+
+      if (location.length == 0 || location.length > sizeof(uint64_t)) {
+         return location;
+      }
+
+      gcstring endianess;
+      location.bigEndian = pNode->GetProperty("Endianess", endianess, attribute) && endianess == "BigEndian";
+
+      const unsigned registerBits = static_cast<unsigned>(location.length * 8);
+      if (masked) {
+         // Nei registri big endian il bit 0 è il più significativo
+         const unsigned low = location.bigEndian ? registerBits - 1 - lsb : lsb;
+         const unsigned high = location.bigEndian ? registerBits - 1 - msb : msb;
+         if (lsb >= registerBits || msb >= registerBits || high < low) {
+            return location;
+         }
+         location.shift = low;
+         location.bits = high - low + 1;
+      }
+      else {
+         location.bits = registerBits;
+      }
+
+      location.valid = true;
+      return location;
+   }
+
+   bool ChunkDataManager::ReadRawChunkValue(const uint8_t* buffer, const GenTL::SINGLE_CHUNK_DATA* chunks,
+      size_t numChunks, const RawChunkValue& location, uint64_t& value) {
+      if (!location.valid || !buffer) {
+         return false;
+      }
+
+      for (size_t i = 0; i < numChunks; ++i) {
+         const GenTL::SINGLE_CHUNK_DATA& chunk = chunks[i];
+         if (chunk.ChunkID != location.chunkID) {
+            continue;
+         }
+         if (chunk.ChunkOffset < 0 || location.offset + location.length > chunk.ChunkLength) {
+            return false;
+         }
+
+         const uint8_t* pRegister = buffer + chunk.ChunkOffset + location.offset;
+         uint64_t raw = 0;
+         for (size_t b = 0; b < location.length; ++b) {
+            raw = (raw << 8) | pRegister[location.bigEndian ? b : location.length - 1 - b];
+         }
+
+         raw >>= location.shift;
+         if (location.bits < 64) {
+            raw &= (uint64_t{ 1 } << location.bits) - 1;
+         }
+         value = raw;
+         return true;
+      }
+
+      return false;
+   }
+
+   bool ChunkDataManager::ReadFrameChunks(uint8_t* buffer, GenTL::SINGLE_CHUNK_DATA* chunks, size_t numChunks,
+      ChunkFrameValues& values) {
+      std::lock_guard<std::mutex> lock(m_frameReaderMutex);
+      if (!m_frameChunkAdapter || !buffer || numChunks == 0) {
+         return false;
+      }
+
+      try {
+         // SINGLE_CHUNK_DATA (GenTL) e SingleChunkData_t (GenApi) hanno lo stesso layout
+         m_frameChunkAdapter->AttachBuffer(buffer,
+            reinterpret_cast<SingleChunkData_t*>(chunks), static_cast<int64_t>(numChunks));
+
+         if (m_pExposureTimeChunk.IsValid() && IsReadable(m_pExposureTimeChunk)) {
+            values.exposureTime = m_pExposureTimeChunk->GetValue();
+            values.hasExposureTime = true;
+         }
+         if (m_pGainChunk.IsValid() && IsReadable(m_pGainChunk)) {
+            values.gain = m_pGainChunk->GetValue();
+            values.hasGain = true;
+         }
+
+         m_frameChunkAdapter->DetachBuffer();
+         return true;
+      }
+      catch (const GenericException&) {
+         // Chunk non interpretabili
+         m_frameChunkAdapter->DetachBuffer();
+         return false;
+      }
+   }
+
    bool ChunkDataManager::GetChunkTimestamp(const ChunkData& data, uint64_t& timestamp) const {
       if (data.timestamp != 0) {
          timestamp = data.timestamp;
@@ -368,7 +554,7 @@ namespace GenICamWrapper {
 
    void ChunkDataManager::PrintChunkInfo() const {
       std::cout << "\n=== Informazioni Chunk Data ===" << std::endl;
-      std::cout << "Modalit Chunk: " << (m_chunkModeEnabled ? "Attiva" : "Inattiva") << std::endl;
+      std::cout << "Modalità Chunk: " << (m_chunkModeEnabled ? "Attiva" : "Inattiva") << std::endl;
       std::cout << "Chunk disponibili: " << m_chunkInfoMap.size() << std::endl;
 
       for (const auto& pair : m_chunkInfoMap) {
@@ -383,7 +569,7 @@ namespace GenICamWrapper {
          default: std::cout << "Altro"; break;
          }
          std::cout << std::endl;
-         std::cout << "  Abilitato: " << (info.isEnabled ? "S" : "No") << std::endl;
+         std::cout << "  Abilitato: " << (info.isEnabled ? "Sì" : "No") << std::endl;
       }
    }
 
@@ -4,6 +4,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <mutex>
 #include "GenICamCamera.h"
 #include "GenICamException.h"
 
@@ -29,6 +30,26 @@ namespace GenICamWrapper {
       uint64_t frameID;
    };
 
+   // Valori dei chunk standard di un singolo frame (lettura sui worker di conversione)
+   struct ChunkFrameValues {
+      bool hasExposureTime = false;
+      double exposureTime = 0.0;
+      bool hasGain = false;
+      double gain = 0.0;
+   };
+
+   // Posizione di un registro intero nei chunk, risolta una volta dal nodemap:
+   // permette di leggere il valore direttamente dal buffer, senza GenApi
+   struct RawChunkValue {
+      bool valid = false;
+      uint64_t chunkID = 0;
+      size_t offset = 0;          // Offset del registro nel chunk
+      size_t length = 0;          // Byte del registro (1..8)
+      bool bigEndian = false;
+      unsigned shift = 0;         // Bit meno significativo (MaskedIntReg)
+      unsigned bits = 64;
+   };
+
    class ChunkDataManager {
    public:
       ChunkDataManager();
@@ -37,7 +58,7 @@ namespace GenICamWrapper {
       // Inizializza il manager con il nodemap del dispositivo
       void Initialize(GenApi::INodeMap* deviceNodeMap, GenApi::INodeMap* streamNodeMap);
 
-      // Abilita/disabilita la modalit chunk
+      // Abilita/disabilita la modalità chunk
       void EnableChunkMode(bool enable);
       bool IsChunkModeEnabled() const;
 
@@ -59,6 +80,26 @@ namespace GenICamWrapper {
       // Parsing dei chunk data dal buffer
       ChunkData ParseChunkData(const void* buffer, size_t bufferSize, size_t payloadSize);
 
+      // Lettura per frame dei chunk standard, senza allocazioni: il layout dei chunk
+      // è quello restituito dal GenTL producer (DSGetBufferChunkData).
+      // PrepareFrameReader restituisce false se chunk mode non è attivo o nessun chunk è leggibile
+      bool PrepareFrameReader(GenApi::INodeMap* deviceNodeMap, bool readCounterValue);
+      void ReleaseFrameReader();
+      bool HasFrameIDChunk() const { return m_rawFrameID.valid; }
+      bool HasCounterValueChunk() const { return m_rawCounterValue.valid; }
+      const RawChunkValue& GetRawFrameIDChunk() const { return m_rawFrameID; }
+      const RawChunkValue& GetRawCounterValueChunk() const { return m_rawCounterValue; }
+      bool HasFrameValueChunks() const { return m_frameChunkAdapter != nullptr; }
+
+      // Esposizione e guadagno tramite GenApi: le letture sono serializzate perché
+      // l'adapter è unico e condiviso tra i thread chiamanti
+      bool ReadFrameChunks(uint8_t* buffer, GenTL::SINGLE_CHUNK_DATA* chunks, size_t numChunks,
+         ChunkFrameValues& values);
+
+      // Lettura diretta di un registro dai chunk del buffer: nessun lock né accesso al nodemap
+      static bool ReadRawChunkValue(const uint8_t* buffer, const GenTL::SINGLE_CHUNK_DATA* chunks,
+         size_t numChunks, const RawChunkValue& location, uint64_t& value);
+
       // Estrae informazioni specifiche
       bool GetChunkTimestamp(const ChunkData& data, uint64_t& timestamp) const;
       bool GetChunkFrameID(const ChunkData& data, uint64_t& frameID) const;
@@ -80,10 +121,19 @@ namespace GenICamWrapper {
       GenApi::CEnumerationPtr m_pChunkSelector;
       GenApi::CBooleanPtr m_pChunkEnable;
 
+      // Parser dei chunk per frame (PrepareFrameReader)
+      std::mutex m_frameReaderMutex;
+      std::unique_ptr<GenApi::CChunkAdapterGeneric> m_frameChunkAdapter;
+      GenApi::CFloatPtr m_pExposureTimeChunk;
+      GenApi::CFloatPtr m_pGainChunk;
+      RawChunkValue m_rawFrameID;
+      RawChunkValue m_rawCounterValue;
+
       // Metodi interni
       void ValidateInitialization() const;
       void CollectAvailableChunks();
       GenApi::INode* GetChunkNode(const std::string& chunkName) const;
+      static RawChunkValue ResolveRawChunkValue(GenApi::INodeMap* deviceNodeMap, const char* nodeName);
       void ExtractChunkValue(GenApi::INode* pNode, ChunkData& data) const;
    };
 
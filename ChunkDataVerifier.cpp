@@ -113,7 +113,7 @@ namespace GenICamWrapper {
                      chunkResult.actualValue = FormatChunkValue(chunkData, chunkName);
                      chunkResult.hasData = !chunkResult.actualValue.empty();
 
-                     // Verifica validit confrontando con parametri camera
+                     // Verifica validità confrontando con parametri camera
                      if (chunkResult.hasData) {
                         CompareChunkWithCameraParameter(chunkName, chunkData, chunkResult);
                      }
@@ -199,7 +199,7 @@ namespace GenICamWrapper {
       auto startTime = std::chrono::high_resolution_clock::now();
 
       try {
-         // Verifica se il chunk  abilitato
+         // Verifica se il chunk è abilitato
          result.isEnabled = m_pChunkManager->IsChunkEnabled(chunkName);
          if (!result.isEnabled) {
             result.errorMessage = "Chunk non abilitato";
@@ -256,7 +256,7 @@ namespace GenICamWrapper {
 
          std::vector<ChunkData> chunkDataList;
 
-         // Raccogli dati da pi frame
+         // Raccogli dati da più frame
          for (int i = 0; i < frameCount; i++) {
             cv::Mat image;
             uint8_t* pBuffer = nullptr;
@@ -466,10 +466,10 @@ namespace GenICamWrapper {
                // Verifica che il timestamp del chunk sia ragionevole
                if (chunkData.timestamp > 0) {
                   // Il timestamp dovrebbe essere vicino al momento dell'acquisizione
-                  // (questa  una verifica semplificata)
+                  // (questa è una verifica semplificata)
                   uint64_t currentTimestamp;
                   if (m_pChunkManager->GetChunkTimestamp(chunkData, currentTimestamp)) {
-                     // Verifica base: il timestamp esiste ed  non-zero
+                     // Verifica base: il timestamp esiste ed è non-zero
                      if (currentTimestamp == 0) {
                         syncOk = false;
                      }
@@ -540,7 +540,7 @@ namespace GenICamWrapper {
 
    bool ChunkDataVerifier::VerifyChunkDataWithHardwareTrigger() {
       try {
-         // Salva modalit trigger corrente
+         // Salva modalità trigger corrente
          TriggerMode originalMode = m_pCamera->getTriggerMode();
 
          // Imposta trigger hardware
@@ -581,7 +581,7 @@ namespace GenICamWrapper {
 
          m_pCamera->stopAcquisition();
 
-         // Ripristina modalit originale
+         // Ripristina modalità originale
          m_pCamera->setTriggerMode(originalMode);
 
          return verifyOk;
@@ -659,7 +659,7 @@ namespace GenICamWrapper {
       uint64_t frameID;
       if (m_pChunkManager->GetChunkFrameID(data, frameID)) {
          result.actualValue = std::to_string(frameID);
-         result.isValid = true; // Frame ID pu essere 0 per il primo frame
+         result.isValid = true; // Frame ID può essere 0 per il primo frame
       }
       else {
          result.errorMessage = "Impossibile estrarre frame ID";
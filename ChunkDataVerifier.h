@@ -66,7 +66,7 @@ namespace GenICamWrapper {
       ChunkVerificationResult VerifySingleChunk(const std::string& chunkName);
 
       /**
-       * @brief Verifica la consistenza dei chunk data su pi frame
+       * @brief Verifica la consistenza dei chunk data su più frame
        * @param frameCount Numero di frame da verificare
        * @return true se i dati sono consistenti
        */
@@ -107,7 +107,7 @@ namespace GenICamWrapper {
       int StressTestChunkData(int durationSeconds = 30);
 
       /**
-       * @brief Verifica compatibilit chunk data con trigger hardware
+       * @brief Verifica compatibilità chunk data con trigger hardware
        * @return true se compatibile
        */
       bool VerifyChunkDataWithHardwareTrigger();
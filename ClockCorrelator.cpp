@@ -0,0 +1,98 @@
+#include "ClockCorrelator.h"
+#include <cmath>
+
+namespace GenICamWrapper {
+
+    ClockCorrelator::ClockCorrelator(size_t windowSize)
+        : m_windowSize(windowSize < 2 ? 2 : windowSize)
+        , m_mapping(std::make_shared<const ClockMapping>()) {
+    }
+
+    void ClockCorrelator::addSample(uint64_t deviceTicks, std::chrono::steady_clock::time_point hostTime,
+        std::chrono::nanoseconds latchUncertainty) {
+        std::lock_guard<std::mutex> lock(m_samplesMutex);
+
+        // Contatore del device ripartito (reset o riavvio): i campioni precedenti non valgono più
+        if (!m_samples.empty() && deviceTicks <= m_samples.back().deviceTicks) {
+            m_samples.clear();
+        }
+
+        Sample sample;
+        sample.deviceTicks = deviceTicks;
+        sample.hostNs = std::chrono::duration_cast<std::chrono::nanoseconds>(hostTime.time_since_epoch()).count();
+        sample.uncertaintyNs = latchUncertainty.count();
+        m_samples.push_back(sample);
+
+        while (m_samples.size() > m_windowSize) {
+            m_samples.pop_front();
+        }
+
+        fit();
+    }
+
+    void ClockCorrelator::reset() {
+        std::lock_guard<std::mutex> lock(m_samplesMutex);
+        m_samples.clear();
+        m_mapping.store(std::make_shared<const ClockMapping>(), std::memory_order_release);
+    }
+
+    void ClockCorrelator::setWindowSize(size_t windowSize) {
+        std::lock_guard<std::mutex> lock(m_samplesMutex);
+        m_windowSize = windowSize < 2 ? 2 : windowSize;
+        while (m_samples.size() > m_windowSize) {
+            m_samples.pop_front();
+        }
+    }
+
+    void ClockCorrelator::fit() {
+        auto result = std::make_shared<ClockMapping>();
+        result->samples = m_samples.size();
+
+        if (m_samples.size() < 2) {
+            m_mapping.store(result, std::memory_order_release);
+            return;
+        }
+
+        // Minimi quadrati su valori relativi all'ultimo campione: i delta restano
+        // piccoli e rappresentabili esattamente in double
+        const Sample& ref = m_samples.back();
+        const double n = static_cast<double>(m_samples.size());
+        double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0, sumUncertainty = 0.0;
+
+        for (const auto& s : m_samples) {
+            const double x = static_cast<double>(static_cast<int64_t>(s.deviceTicks - ref.deviceTicks));
+            const double y = static_cast<double>(s.hostNs - ref.hostNs);
+            sumX += x;
+            sumY += y;
+            sumXX += x * x;
+            sumXY += x * y;
+            sumUncertainty += static_cast<double>(s.uncertaintyNs);
+        }
+
+        const double denominator = n * sumXX - sumX * sumX;
+        if (denominator <= 0.0) {
+            m_mapping.store(result, std::memory_order_release);
+            return;
+        }
+
+        const double slope = (n * sumXY - sumX * sumY) / denominator;
+        const double intercept = (sumY - slope * sumX) / n;
+
+        double sumResidual2 = 0.0;
+        for (const auto& s : m_samples) {
+            const double x = static_cast<double>(static_cast<int64_t>(s.deviceTicks - ref.deviceTicks));
+            const double y = static_cast<double>(s.hostNs - ref.hostNs);
+            const double residual = y - (intercept + slope * x);
+            sumResidual2 += residual * residual;
+        }
+
+        result->valid = slope > 0.0;
+        result->refTicks = ref.deviceTicks;
+        result->refHostNs = ref.hostNs + static_cast<int64_t>(intercept);
+        result->nsPerTick = slope;
+        result->errorNs = std::sqrt(sumResidual2 / n) + sumUncertainty / n;
+
+        m_mapping.store(result, std::memory_order_release);
+    }
+
+} // namespace GenICamWrapper
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief Mappatura lineare tick del device -> steady_clock dell'host
+     *
+     * hostNs = refHostNs + nsPerTick * (ticks - refTicks), con i nanosecondi riferiti
+     * all'epoca di std::chrono::steady_clock. Il riferimento vicino ai campioni recenti
+     * evita la perdita di precisione dei double con contatori a 64 bit.
+     */
+    struct ClockMapping {
+        bool valid = false;
+        uint64_t refTicks = 0;
+        int64_t refHostNs = 0;
+        double nsPerTick = 1.0;
+        double errorNs = 0.0;       // Stima dell'errore: RMS dei residui + incertezza del latch
+        size_t samples = 0;
+
+        std::chrono::steady_clock::time_point toHostTime(uint64_t ticks) const {
+            const double deltaTicks = static_cast<double>(static_cast<int64_t>(ticks - refTicks));
+            const int64_t hostNs = refHostNs + static_cast<int64_t>(nsPerTick * deltaTicks);
+            return std::chrono::steady_clock::time_point(
+                std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(hostNs)));
+        }
+    };
+
+    /**
+     * @brief Correlazione tra clock del device e clock dell'host
+     *
+     * Riceve coppie (tick del device, istante host) ottenute con TimestampLatch e
+     * stima con i minimi quadrati su una finestra mobile la relazione lineare tra i
+     * due clock (offset e deriva). La mappatura corrente è pubblicata come snapshot
+     * immutabile: mapping() non usa lock ed è adatto al percorso dei frame.
+     *
+     * Thread Safety: addSample e reset sono serializzati internamente; mapping()
+     * può essere chiamato da qualsiasi thread.
+     */
+    class ClockCorrelator {
+    public:
+        explicit ClockCorrelator(size_t windowSize = 16);
+
+        /**
+         * @brief Aggiunge un campione e ricalcola la mappatura
+         * @param deviceTicks Valore di TimestampLatchValue
+         * @param hostTime Istante host stimato del latch (punto medio della richiesta)
+         * @param latchUncertainty Metà della durata della richiesta di latch
+         */
+        void addSample(uint64_t deviceTicks, std::chrono::steady_clock::time_point hostTime,
+            std::chrono::nanoseconds latchUncertainty);
+
+        void reset();
+        void setWindowSize(size_t windowSize);
+
+        /**
+         * @brief Mappatura corrente (valid = false finché non ci sono almeno 2 campioni)
+         */
+        std::shared_ptr<const ClockMapping> mapping() const {
+            return m_mapping.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct Sample {
+            uint64_t deviceTicks;
+            int64_t hostNs;
+            int64_t uncertaintyNs;
+        };
+
+        void fit();
+
+        std::mutex m_samplesMutex;
+        std::deque<Sample> m_samples;
+        size_t m_windowSize;
+        std::atomic<std::shared_ptr<const ClockMapping>> m_mapping;
+    };
+
+} // namespace GenICamWrapper
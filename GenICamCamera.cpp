@@ -1,6 +1,8 @@
 ﻿#include "GenICamCamera.h"
 #include "GenICamException.h"
 #include "GenTLLoader.h"
+#include "ThreadUtils.h"
+#include "ChunkDataManager.h"
 #include <iostream>
 #include <sstream>
 #include <cstring>
@@ -23,8 +25,7 @@ namespace GenICamWrapper {
         , m_bufferSize(0)
         , m_state(CameraState::Disconnected)
         , m_isAcquiring(false)
-        , m_stopAcquisition(false)
-        , m_eventListener(nullptr),
+        , m_stopAcquisition(false),
         m_featureEventHandle(nullptr) {
 
         try {
@@ -51,6 +52,119 @@ namespace GenICamWrapper {
         }
     }
 
+    // === Dispatch ai listener ===
+
+    // Snapshot della lista listener in uso dal thread corrente (dispatch annidati inclusi):
+    // consente a unsubscribe() chiamato da una callback di non attendere se stesso
+    static thread_local std::vector<const void*> t_dispatchingSnapshots;
+
+    template<typename Callback>
+    void GenICamCamera::dispatchToListeners(Callback&& callback) {
+        std::shared_ptr<const ListenerList> listeners = m_listeners.load();
+        if (!listeners || listeners->empty()) {
+            return;
+        }
+
+        t_dispatchingSnapshots.push_back(listeners.get());
+        for (CameraEventListener* listener : *listeners) {
+            try {
+                callback(listener);
+            }
+            catch (...) {
+                // Ignora eccezioni nel callback: non devono bloccare gli altri listener
+            }
+        }
+        t_dispatchingSnapshots.pop_back();
+    }
+
+    void GenICamCamera::retireListenerSnapshot(std::shared_ptr<const ListenerList> previous) {
+        // Chiamato con m_callbackMutex: gli snapshot già rilasciati da tutti i dispatch spariscono
+        m_retiredListeners.erase(std::remove_if(m_retiredListeners.begin(), m_retiredListeners.end(),
+            [](const std::weak_ptr<const ListenerList>& retired) { return retired.expired(); }),
+            m_retiredListeners.end());
+        if (previous) {
+            m_retiredListeners.push_back(previous);
+        }
+    }
+
+    void GenICamCamera::waitForListenerReaders(CameraEventListener* removed) {
+        std::vector<std::weak_ptr<const ListenerList>> retired;
+        {
+            std::lock_guard<std::mutex> lock(m_callbackMutex);
+            retired = m_retiredListeners;
+        }
+
+        // Grace period RCU: gli snapshot sostituiti non sono più pubblicati, quindi i
+        // riferimenti residui appartengono a dispatch in corso (esclusi quelli del thread
+        // corrente). removed == nullptr attende tutti gli snapshot, altrimenti solo
+        // quelli che contengono il listener rimosso
+        for (const auto& weak : retired) {
+            std::shared_ptr<const ListenerList> snapshot = weak.lock();
+            if (!snapshot) {
+                continue;
+            }
+            if (removed && std::find(snapshot->begin(), snapshot->end(), removed) == snapshot->end()) {
+                continue;
+            }
+
+            const long ownReferences = static_cast<long>(std::count(
+                t_dispatchingSnapshots.begin(), t_dispatchingSnapshots.end(), snapshot.get()));
+
+            while (snapshot.use_count() > 1 + ownReferences) {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+
+    void GenICamCamera::setEventListener(CameraEventListener* listener) {
+        {
+            std::lock_guard<std::mutex> lock(m_callbackMutex);
+            auto updated = std::make_shared<ListenerList>();
+            if (listener) {
+                updated->push_back(listener);
+            }
+            retireListenerSnapshot(m_listeners.exchange(std::move(updated)));
+        }
+        waitForListenerReaders(nullptr);
+    }
+
+    void GenICamCamera::subscribe(CameraEventListener* listener) {
+        if (!listener) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError, "Listener nullo");
+        }
+
+        std::lock_guard<std::mutex> lock(m_callbackMutex);
+        std::shared_ptr<const ListenerList> current = m_listeners.load();
+
+        auto updated = current ? std::make_shared<ListenerList>(*current) : std::make_shared<ListenerList>();
+        if (std::find(updated->begin(), updated->end(), listener) != updated->end()) {
+            return;     // Già registrato
+        }
+        updated->push_back(listener);
+
+        // Aggiungere un listener non richiede grace period, ma lo snapshot sostituito
+        // può ancora essere in uso: un unsubscribe successivo deve attenderlo
+        retireListenerSnapshot(m_listeners.exchange(std::move(updated)));
+    }
+
+    void GenICamCamera::unsubscribe(CameraEventListener* listener) {
+        {
+            std::lock_guard<std::mutex> lock(m_callbackMutex);
+            std::shared_ptr<const ListenerList> current = m_listeners.load();
+
+            // Già rimosso (anche da un unsubscribe concorrente): resta da attendere il grace period
+            if (current && std::find(current->begin(), current->end(), listener) != current->end()) {
+                auto updated = std::make_shared<ListenerList>(*current);
+                updated->erase(std::remove(updated->begin(), updated->end(), listener), updated->end());
+                retireListenerSnapshot(m_listeners.exchange(std::move(updated)));
+            }
+        }
+
+        // Al ritorno nessun altro thread sta eseguendo callback sul listener rimosso,
+        // su nessuno degli snapshot precedenti
+        waitForListenerReaders(listener);
+    }
+
     // === Inizializzazione GenTL ===
 
     void GenICamCamera::initializeGenTL(std::string fileProducer) {
@@ -445,30 +559,137 @@ namespace GenICamWrapper {
         }
     }
 
-    void GenICamCamera::handleFeatureInvalidation(const std::string& featureName) {
-        std::cout << "Feature invalidated: " << featureName << std::endl;
+    static bool isExposureFeature(const std::string& featureName) {
+        return featureName == "ExposureTime" || featureName == "ExposureTimeAbs"
+            || featureName == "ExposureTimeRaw" || featureName == "ExposureAuto";
+    }
 
-        // Rimuovi dalla cache
-        {
-            std::unique_lock<std::shared_mutex> lock(m_parameterMutex);
-            m_parameterCache.erase(featureName);
+    static bool isGainFeature(const std::string& featureName) {
+        return featureName == "Gain" || featureName == "GainRaw" || featureName == "GainAbs"
+            || featureName == "AnalogGain" || featureName == "DigitalGain"
+            || featureName == "GainAuto" || featureName == "GainSelector";
+    }
+
+    void GenICamCamera::handleFeatureInvalidations(const std::set<std::string>& featureNames, bool refreshAll) {
+        if (refreshAll) {
+            // Evento senza nome della feature: unico caso in cui si invalida tutto
+            refreshNodeMap();
+            refreshParameterShadows();
         }
+        else {
+            // Rimuovi dalla cache
+            bool exposureChanged = false;
+            bool gainChanged = false;
+            {
+                std::unique_lock<std::shared_mutex> lock(m_parameterMutex);
+                for (const auto& featureName : featureNames) {
+                    m_parameterCache.erase(featureName);
+                    exposureChanged = exposureChanged || isExposureFeature(featureName);
+                    gainChanged = gainChanged || isGainFeature(featureName);
+                }
+            }
 
-        // Notifica il listener se presente
-        {
-            std::lock_guard<std::mutex> lock(m_callbackMutex);
-            if (m_eventListener) {
-                m_eventListener->OnParameterChanged(featureName, "INVALIDATED");
+            // Aggiorna i valori ombra se il device ha cambiato esposizione o guadagno
+            // (es. ExposureAuto/GainAuto): una lettura per raffica di eventi
+            if (exposureChanged || gainChanged) {
+                refreshParameterShadows(exposureChanged, gainChanged);
             }
         }
 
-        // Se troppe invalidazioni, considera un refresh completo
-        static std::atomic<int> invalidationCount{ 0 };
-        invalidationCount++;
+        // Notifica i listener, una volta per feature
+        for (const auto& featureName : featureNames) {
+            dispatchToListeners([&](CameraEventListener* listener) {
+                listener->OnParameterChanged(featureName, "INVALIDATED");
+            });
+        }
+    }
 
-        if (invalidationCount > 10) {
-            invalidationCount = 0;
-            refreshNodeMap();
+    GenTL::GC_ERROR GenICamCamera::readFeatureEvent(uint64_t timeoutMs, std::string& featureName) {
+        char eventData[256] = { 0 };
+        size_t dataSize = sizeof(eventData);
+
+        GenTL::GC_ERROR err = GENTL_CALL(EventGetData)(m_featureEventHandle, eventData, &dataSize, timeoutMs);
+        if (err != GenTL::GC_ERR_SUCCESS) {
+            return err;
+        }
+
+        // EventGetDataInfo per ottenere il nome del parametro
+        GenTL::INFO_DATATYPE dataType;
+        char name[256] = { 0 };
+        size_t nameSize = sizeof(name);
+
+        featureName.clear();
+        if (GENTL_CALL(EventGetDataInfo)(m_featureEventHandle, eventData, dataSize,
+                GenTL::EVENT_DATA_ID, &dataType, name, &nameSize) == GenTL::GC_ERR_SUCCESS) {
+            featureName = name;
+        }
+        return GenTL::GC_ERR_SUCCESS;
+    }
+
+    void GenICamCamera::featureEventThreadFunction() {
+        applyThreadConfig(AcquisitionThreadRole::FeatureEvents, 0);
+
+        std::set<std::string> invalidated;
+        bool running = true;
+
+        while (running && !m_stopFeatureEvents) {
+            std::string featureName;
+            GenTL::GC_ERROR err = readFeatureEvent(GENTL_INFINITE, featureName);
+
+            if (err == GenTL::GC_ERR_ABORT) {
+                break;      // EventKill da stopFeatureEventThread
+            }
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                if (err != GenTL::GC_ERR_TIMEOUT) {
+                    std::this_thread::sleep_for(FEATURE_EVENT_RETRY_DELAY);
+                }
+                continue;
+            }
+
+            // Le invalidazioni arrivano a raffica (es. cambio di ROI o PixelFormat):
+            // raccoglie quelle della finestra di coalescenza e le gestisce insieme
+            bool refreshAll = featureName.empty();
+            if (!refreshAll) {
+                invalidated.insert(featureName);
+            }
+
+            const auto deadline = std::chrono::steady_clock::now() + FEATURE_EVENT_COALESCE_WINDOW;
+            for (;;) {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                if (remaining <= 0) {
+                    break;
+                }
+
+                err = readFeatureEvent(static_cast<uint64_t>(remaining), featureName);
+                if (err == GenTL::GC_ERR_ABORT) {
+                    running = false;
+                    break;
+                }
+                if (err != GenTL::GC_ERR_SUCCESS) {
+                    break;
+                }
+
+                if (featureName.empty()) {
+                    refreshAll = true;
+                }
+                else {
+                    invalidated.insert(featureName);
+                }
+            }
+
+            handleFeatureInvalidations(invalidated, refreshAll);
+            invalidated.clear();
+        }
+    }
+
+    void GenICamCamera::stopFeatureEventThread() {
+        m_stopFeatureEvents = true;
+        if (m_featureEventHandle) {
+            GENTL_CALL(EventKill)(m_featureEventHandle);
+        }
+        if (m_featureEventThread.joinable()) {
+            m_featureEventThread.join();
         }
     }
 
@@ -480,26 +701,21 @@ namespace GenICamWrapper {
             GenTL::GC_ERROR err = GENTL_CALL(GCRegisterEvent)(
                 m_devHandle,
                 GenTL::EVENT_FEATURE_INVALIDATE,
-                &m_eventHandle);
+                &m_featureEventHandle);
 
-            if (err == GenTL::GC_ERR_SUCCESS) {
+            if (err == GenTL::GC_ERR_SUCCESS && m_featureEventHandle) {
+                // Gli eventi sono gestiti da un thread dedicato, fuori dal percorso dei frame
+                m_stopFeatureEvents = false;
+                m_featureEventThread = std::thread(&GenICamCamera::featureEventThreadFunction, this);
                 std::cout << "Feature invalidation events registered" << std::endl;
             }
-
-            // Registra anche EVENT_FEATURE_CHANGE se supportato
-            GenTL::EVENT_HANDLE changeEventHandle = nullptr;
-            err = GENTL_CALL(GCRegisterEvent)(
-                m_devHandle,
-                GenTL::EVENT_FEATURE_CHANGE,
-                &changeEventHandle);
-
-            if (err == GenTL::GC_ERR_SUCCESS) {
-                std::cout << "Feature change events registered" << std::endl;
+            else {
+                m_featureEventHandle = nullptr;
             }
-
         }
         catch (...) {
             // Eventi non supportati, continua senza
+            m_featureEventHandle = nullptr;
             std::cout << "Feature invalidation events not supported" << std::endl;
         }
     }
@@ -508,8 +724,11 @@ namespace GenICamWrapper {
         if (!m_devHandle) return;
 
         try {
-            GENTL_CALL(GCUnregisterEvent)(m_devHandle, GenTL::EVENT_FEATURE_INVALIDATE);
-            GENTL_CALL(GCUnregisterEvent)(m_devHandle, GenTL::EVENT_FEATURE_CHANGE);
+            stopFeatureEventThread();
+            if (m_featureEventHandle) {
+                GENTL_CALL(GCUnregisterEvent)(m_devHandle, GenTL::EVENT_FEATURE_INVALIDATE);
+                m_featureEventHandle = nullptr;
+            }
         }
         catch (...) {
             // Ignora errori durante cleanup
@@ -525,6 +744,10 @@ namespace GenICamWrapper {
 
     void GenICamCamera::disconnect() {
        notifyParameterChanged("Disconnected", "");
+
+       // Ferma il thread degli eventi prima del lock: i suoi listener possono
+       // interrogare lo stato della connessione
+       stopFeatureEventThread();
        
        std::unique_lock<std::shared_mutex> lock(m_connectionMutex);
 
@@ -553,12 +776,16 @@ namespace GenICamWrapper {
              m_devHandle = nullptr;
           }
 
+          // Un'altra camera può richiedere buffer diversi: la memoria del pool non serve più
+          m_bufferPool.trim();
+
           if (m_ifHandle) {
              GENTL_CALL(IFClose)(m_ifHandle);
              m_ifHandle = nullptr;
           }
 
           m_portHandle = nullptr;
+          m_clockCorrelator.reset();
           m_state = CameraState::Disconnected;
           m_cameraID.clear();
           m_parameterCache.clear();
@@ -761,74 +988,19 @@ namespace GenICamWrapper {
             setTransportLayerLock(true);
 
             // 3. Apri data stream
-            uint32_t numStreams = 0;
-            err = GENTL_CALL(DevGetNumDataStreams)(m_devHandle, &numStreams);
-            if (err != GenTL::GC_ERR_SUCCESS || numStreams == 0) {
-                THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Nessun data stream disponibile", err);
-            }
+            openDataStream();
 
-            char streamID[256] = { 0 };
-            size_t streamIDSize = sizeof(streamID);
-            err = GENTL_CALL(DevGetDataStreamID)(m_devHandle, 0, streamID, &streamIDSize);
-            if (err != GenTL::GC_ERR_SUCCESS) {
-                THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Impossibile ottenere l'ID dello stream", err);
-            }
-
-            err = GENTL_CALL(DevOpenDataStream)(m_devHandle, streamID, &m_dsHandle);
-            if (err != GenTL::GC_ERR_SUCCESS) {
-                THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Impossibile aprire il data stream", err);
-            }
+            openLoanSession();
 
             // 4. Ottieni dimensione buffer
-            GenTL::INFO_DATATYPE dataType;
-            bool8_t definesPayloadSize = 0;
-            size_t infoSize = sizeof(definesPayloadSize);
+            updateBufferSize();
 
-            err = GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_DEFINES_PAYLOADSIZE, &dataType, &definesPayloadSize, &infoSize);
-
-            if (definesPayloadSize) {
-               infoSize = sizeof(m_bufferSize);
-               err = GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_PAYLOAD_SIZE, &dataType, &m_bufferSize, &infoSize);
-               if (err != GenTL::GC_ERR_SUCCESS) {
-                  THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, "Impossibile determinare la dimensione del buffer", err);
-               }
-            }
-            else {
-               GenApi::IInteger* pp = dynamic_cast<GenApi::IInteger*>(m_pNodeMap->_GetNode("PayloadSize"));
-               if (GenApi::IsReadable(pp))
-                  m_bufferSize = static_cast<size_t>(pp->GetValue());
-               else {
-                  // Calcola manualmente per telecamere che non definiscono PayloadSize
-                  ROI roi = getROI();
-                  PixelFormat pf = getPixelFormat();
-
-                  int bytesPerPixel = 1;
-                  switch (pf) {
-                  case PixelFormat::Mono8:
-                  case PixelFormat::BayerRG8:
-                  case PixelFormat::BayerGB8:
-                  case PixelFormat::BayerGR8:
-                  case PixelFormat::BayerBG8:
-                     bytesPerPixel = 1;
-                     break;
-                  case PixelFormat::Mono10:
-                  case PixelFormat::Mono12:
-                  case PixelFormat::Mono16:
-                     bytesPerPixel = 2;
-                     break;
-                  case PixelFormat::RGB8:
-                  case PixelFormat::BGR8:
-                     bytesPerPixel = 3;
-                     break;
-                  default:
-                     bytesPerPixel = 1;
-                  }
-
-                  m_bufferSize = roi.width * roi.height * bytesPerPixel;
-               }
+            if (m_adaptiveBufferConfig.enabled) {
+                bufferCount = std::clamp(bufferCount, m_adaptiveBufferConfig.minBuffers, m_adaptiveBufferConfig.maxBuffers);
             }
-
             allocateBuffers(bufferCount);
+            m_announcedBufferCount = m_bufferHandles.size();
+            m_pendingBufferRevokes = 0;
 
             for (auto& hBuffer : m_bufferHandles) {
                 err = GENTL_CALL(DSQueueBuffer)(m_dsHandle, hBuffer);
@@ -848,40 +1020,42 @@ namespace GenICamWrapper {
             }
 
             // Usa GenApi per avviare l'acquisizione...
-            try {
-                GenApi::CCommandPtr pAcqStart = getCommandNode("AcquisitionStart");
-                if (pAcqStart.IsValid() && GenApi::IsWritable(pAcqStart)) {
-                    pAcqStart->Execute();
-                }
-            }
-            catch (const GENICAM_NAMESPACE::GenericException& e) {
-                THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                    std::string("Errore comando AcquisitionStart: ") + e.GetDescription());
-            }
+            executeAcquisitionStart();
 
             m_isAcquiring = true;
             m_stopAcquisition = false;
             m_state = CameraState::Acquiring;
 
             // Notifica listener
-            {
-                std::lock_guard<std::mutex> cbLock(m_callbackMutex);
-                if (m_eventListener) {
-                    m_eventListener->OnAcquisitionStarted();
-                }
-            }
+            dispatchToListeners([](CameraEventListener* listener) {
+                listener->OnAcquisitionStarted();
+            });
+
+            // Valori iniziali dei metadati per frame, letti una volta sola prima del grab
+            refreshParameterShadows();
+            setupChunkMetadata();
 
+            resetAcquisitionStatistics();
+            openFrameQueue();
+            startPipeline();
             m_acquisitionThread = std::thread(&GenICamCamera::acquisitionThreadFunction, this);
+            startClockCorrelation();
+            startBufferMonitor();
 
         }
         catch (...) {
             // Cleanup in caso di errore
+            stopBufferMonitor();
+            stopClockCorrelation();
+            stopPipeline();
+            closeFrameQueue();
             setTransportLayerLock(false);
 
             if (m_eventHandle) {
                 GENTL_CALL(GCUnregisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER);
                 m_eventHandle = nullptr;
             }
+            closeLoanSession();
             if (m_dsHandle) {
                 GENTL_CALL(DSClose)(m_dsHandle);
                 m_dsHandle = nullptr;
@@ -892,6 +1066,7 @@ namespace GenICamWrapper {
     }
 
     void GenICamCamera::stopAcquisition() {
+        const auto stopStart = std::chrono::steady_clock::now();
 
         // Prima imposta il flag di stop FUORI dal mutex per evitare deadlock
         m_stopAcquisition = true;
@@ -901,60 +1076,39 @@ namespace GenICamWrapper {
         }
 
         try {
-            // 1. Stop acquisizione su camera (SFNC)
-            // Usa GenApi per fermare l'acquisizione
-            try {
-                GenApi::CCommandPtr pAcqStop = getCommandNode("AcquisitionStop");
-                if (pAcqStop.IsValid() && GenApi::IsWritable(pAcqStop)) {
-                    pAcqStop->Execute();
-
-                    // Attendi completamento con timeout
-                    auto startTime = std::chrono::steady_clock::now();
-                    while (!pAcqStop->IsDone()) {
-                        auto elapsed = std::chrono::steady_clock::now() - startTime;
-                        if (elapsed > std::chrono::milliseconds(1000)) {
-                            break; // Timeout, procedi comunque
-                        }
-                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                    }
-                }
-            }
-            catch (...) {
-                // Non critico, continua con cleanup
+            // 0. Risveglia subito il thread di grab: EventGetData attende senza timeout
+            //    e ritorna GC_ERR_ABORT (se nessuno è in attesa, la prossima chiamata)
+            if (m_eventHandle) {
+                GENTL_CALL(EventKill)(m_eventHandle);
             }
 
+            // 0b. Nessun annuncio o revoca di buffer da qui in poi
+            stopBufferMonitor();
+
+            // 1. Stop acquisizione su camera (SFNC)
+            executeAcquisitionStop();
+
             // 2. Stop data stream
             if (m_dsHandle) {
                 GENTL_CALL(DSStopAcquisition)(m_dsHandle, GenTL::ACQ_STOP_FLAGS_KILL); // vedere questo. ******************   ACQ_STOP_FLAGS_KILL
                 GENTL_CALL(DSFlushQueue)(m_dsHandle, GenTL::ACQ_QUEUE_ALL_DISCARD);
             }
             
-            // 3. Attendi thread di acquisizione
+            // 3. Attendi thread di acquisizione: già risvegliato da EventKill, termina
+            //    appena completato il frame eventualmente in lavorazione
             if (m_acquisitionThread.joinable()) {
-                // Implementa timeout per evitare blocco infinito
-                auto startTime = std::chrono::steady_clock::now();
-                const auto maxWaitTime = std::chrono::seconds(5);
-
-                while (m_acquisitionThread.joinable()) {
-                    // Controlla se il thread è terminato
-                    if (m_acquisitionThread.joinable()) {
-                        // Usa native_handle per verificare se il thread è ancora attivo
-                        auto elapsed = std::chrono::steady_clock::now() - startTime;
-                        if (elapsed > maxWaitTime) {
-                            std::cerr << "WARNING: Thread acquisizione non terminato dopo "
-                                << "5 secondi, forzando detach" << std::endl;
-                            m_acquisitionThread.detach();
-                            break;
-                        }
+                m_acquisitionThread.join();
+            }
 
-                        // Prova join con attesa breve
-                        if (m_acquisitionThread.joinable()) {
-                            m_acquisitionThread.join();
-                            break;
-                        }
-                    }
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                }
+            // 3b. Svuota e ferma gli stadi di conversione e consegna
+            stopPipeline();
+            stopClockCorrelation();
+
+            // 3c. Risveglia i consumatori pull e rilascia i frame ancora nel ring
+            closeFrameQueue();
+            m_chunkMetadataActive = false;
+            if (m_chunkReader) {
+                m_chunkReader->ReleaseFrameReader();
             }
 
             // 4. Cleanup eventi
@@ -963,6 +1117,9 @@ namespace GenICamWrapper {
                 m_eventHandle = nullptr;
             }
 
+            // 4b. Attendi la restituzione dei frame in prestito prima di chiudere lo stream
+            closeLoanSession();
+
             // 5. Chiudi data stream
             if (m_dsHandle) {
                 GENTL_CALL(DSClose)(m_dsHandle);
@@ -978,13 +1135,13 @@ namespace GenICamWrapper {
             m_isAcquiring = false;
             m_state = CameraState::Connected;
 
+            m_lastStopDurationUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - stopStart).count();
+
             // 8. Notifica listener
-            {
-                std::lock_guard<std::mutex> cbLock(m_callbackMutex);
-                if (m_eventListener) {
-                    m_eventListener->OnAcquisitionStopped();
-                }
-            }
+            dispatchToListeners([](CameraEventListener* listener) {
+                listener->OnAcquisitionStopped();
+            });
         }
         catch (const std::exception& e) {
             // Tenta cleanup anche in caso di errore
@@ -995,3973 +1152,6500 @@ namespace GenICamWrapper {
         }
     }
 
-    void GenICamCamera::acquisitionThreadFunction() {
-
-        // Timeout breve per permettere controllo periodico di m_stopAcquisition
-        const size_t BUFFER_WAIT_TIMEOUT_MS = 100;  // 100ms invece di GENTL_INFINITE
-
-        // Variabili per gestione eventi feature
-        bool hasFeatureEvents = false;
+    void GenICamCamera::executeAcquisitionStart() {
         try {
-            // Verifica che l'handle sia valido tentando di ottenere informazioni
-            if (m_featureEventHandle != nullptr) {
-                GenTL::INFO_DATATYPE dataType;
-                size_t infoSize = sizeof(int32_t);
-                int32_t eventType;
-
-                GenTL::GC_ERROR err = GENTL_CALL(EventGetInfo)(
-                    m_featureEventHandle,
-                    GenTL::EVENT_EVENT_TYPE,
-                    &dataType,
-                    &eventType,
-                    &infoSize);
-
-                if (err == GenTL::GC_ERR_SUCCESS &&
-                    eventType == GenTL::EVENT_FEATURE_INVALIDATE) {
-                    hasFeatureEvents = true;
-                    std::cout << "Feature invalidation monitoring active in acquisition thread" << std::endl;
-                }
+            GenApi::CCommandPtr pAcqStart = getCommandNode("AcquisitionStart");
+            if (pAcqStart.IsValid() && GenApi::IsWritable(pAcqStart)) {
+                pAcqStart->Execute();
             }
         }
-        catch (...) {
-            // Eventi non disponibili
-            hasFeatureEvents = false;
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore comando AcquisitionStart: ") + e.GetDescription());
         }
+    }
 
-        while (!m_stopAcquisition) {
-            // Check per eventi di invalidazione feature (non bloccante)
-            if (hasFeatureEvents && m_featureEventHandle) {
-                size_t dataSize = 256;
-                char eventData[256] = { 0 };
-
-                // Usa timeout 0 per non bloccare
-                GenTL::GC_ERROR err = GENTL_CALL(EventGetData)(m_featureEventHandle, eventData, &dataSize, 0);
+    void GenICamCamera::executeAcquisitionStop() {
+        // Usa GenApi per fermare l'acquisizione
+        try {
+            GenApi::CCommandPtr pAcqStop = getCommandNode("AcquisitionStop");
+            if (pAcqStop.IsValid() && GenApi::IsWritable(pAcqStop)) {
+                pAcqStop->Execute();
 
-                if (err == GenTL::GC_ERR_SUCCESS) {
-                    // EventGetDataInfo per ottenere il nome del parametro
-                    GenTL::INFO_DATATYPE dataType;
-                    char featureName[256] = { 0 };
-                    size_t nameSize = sizeof(featureName);
-
-                    err = GENTL_CALL(EventGetDataInfo)(
-                        m_featureEventHandle,
-                        eventData,
-                        dataSize,
-                        GenTL::EVENT_DATA_ID,  // ID del parametro invalidato
-                        &dataType,
-                        featureName,
-                        &nameSize);
-
-                    if (err == GenTL::GC_ERR_SUCCESS && strlen(featureName) > 0) {
-                        // Processa evento di invalidazione
-                        handleFeatureInvalidation(std::string(featureName));
-                    }
-                    else {
-                        // Se non riusciamo a ottenere il nome, invalida tutto
-                        std::cout << "Feature invalidation event received (unknown feature)" << std::endl;
-                        refreshNodeMap();
+                // Attendi completamento con timeout: quasi sempre già completato al
+                // primo controllo, altrimenti ricontrolla ogni millisecondo
+                auto startTime = std::chrono::steady_clock::now();
+                while (!pAcqStop->IsDone()) {
+                    auto elapsed = std::chrono::steady_clock::now() - startTime;
+                    if (elapsed > std::chrono::milliseconds(1000)) {
+                        break; // Timeout, procedi comunque
                     }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
                 }
             }
+        }
+        catch (...) {
+            // Non critico, continua con cleanup
+        }
+    }
 
-            GenTL::EVENT_NEW_BUFFER_DATA bufferData;
-            size_t bufferDataSize = sizeof(bufferData);
+    ReconfigurationResult GenICamCamera::reconfigureAcquisition(const StreamReconfiguration& change) {
+        const auto start = std::chrono::steady_clock::now();
+        ReconfigurationResult result;
+        ParameterNotifications notifications;
+        std::exception_ptr error;
+        bool streaming = false;
 
-            GenTL::GC_ERROR err = GENTL_CALL(EventGetData)(m_eventHandle, &bufferData, &bufferDataSize, 100);
+        {
+            std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-            if (err == GenTL::GC_ERR_TIMEOUT) {
-                // Timeout normale, controlla se dobbiamo fermarci
-                continue;
+            if (!isConnected()) {
+                THROW_GENICAM_ERROR(ErrorType::ConnectionError,
+                    "Camera non connessa");
             }
 
-            if (err == GenTL::GC_ERR_SUCCESS) {
-                GenTL::BUFFER_HANDLE hBuffer = bufferData.BufferHandle;
-
-                if (hBuffer) {
-                    try {
-                        GenTL::INFO_DATATYPE dataType;
-                        void* pBuffer = nullptr;
-                        size_t infoSize = sizeof(pBuffer);
-
-                        err = GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_BASE, &dataType, &pBuffer, &infoSize);
-
-                        if (err == GenTL::GC_ERR_SUCCESS && pBuffer) {
-                            uint32_t width = 0, height = 0;
-                            uint64_t pixelFormat = 0;
-                            size_t tempSize = sizeof(uint32_t);
+            result.previousPayloadSize = m_bufferSize;
+            streaming = m_isAcquiring;
 
-                            GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_WIDTH, &dataType, &width, &tempSize);
-                            GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_HEIGHT, &dataType, &height, &tempSize);
-                            tempSize = sizeof(uint64_t);
-                            GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_PIXELFORMAT, &dataType, &pixelFormat, &tempSize);
+            if (streaming) {
+                error = reconfigureStreaming(change, notifications, result);
+            }
+            else {
+                try {
+                    applyStreamReconfiguration(change, notifications);
+                }
+                catch (...) {
+                    error = std::current_exception();
+                }
+                result.payloadSize = m_bufferSize;
+            }
+        }
 
-                            cv::Mat image = convertBufferToMat(pBuffer, m_bufferSize, width, height, convertFromGenICamPixelFormat(pixelFormat));
+        // Fuori da m_acquisitionMutex: un listener può richiamare stopAcquisition
+        // o altri metodi dell'acquisizione da OnParameterChanged
+        for (const auto& [parameterName, value] : notifications) {
+            notifyParameterChanged(parameterName, value);
+        }
 
-                            if (!image.empty()) {
-                                auto imageData = std::make_unique<ImageData>();
-                                imageData->buffer = std::shared_ptr<uint8_t>(new uint8_t[image.total() * image.elemSize()], std::default_delete<uint8_t[]>());
+        result.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        if (streaming) {
+            std::cout << "Acquisition reconfigured in " << result.duration.count() << " us (payload "
+                << result.previousPayloadSize << " -> " << result.payloadSize << " bytes"
+                << (result.buffersReallocated ? ", buffers reallocated" : "") << ")" << std::endl;
+        }
 
-                                std::memcpy(imageData->buffer.get(), image.data, image.total() * image.elemSize());
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return result;
+    }
 
-                                imageData->bufferSize = image.total() * image.elemSize();
-                                imageData->width = width;
-                                imageData->height = height;
-                                imageData->pixelFormat = convertFromGenICamPixelFormat(pixelFormat);
-                                imageData->stride = image.step;
+    std::exception_ptr GenICamCamera::reconfigureStreaming(const StreamReconfiguration& change,
+        ParameterNotifications& notifications, ReconfigurationResult& result) {
+        // 1. Pausa: la camera smette di inviare, lo stream di riempire buffer
+        executeAcquisitionStop();
+        GENTL_CALL(DSStopAcquisition)(m_dsHandle, GenTL::ACQ_STOP_FLAGS_DEFAULT);
 
-                                tempSize = sizeof(uint64_t);
-                                GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_FRAMEID, &dataType, &imageData->frameID, &tempSize);
+        // 2. Nessun buffer deve restare in uso mentre torna al producer: grab, conversione,
+        //    consegna e prestiti vengono chiusi come in stopAcquisition
+        const bool loansReturned = stopStreamStages();
 
-                                imageData->timestamp = std::chrono::steady_clock::now();
+        // 3. Parametri bloccati dal TL durante lo streaming: sblocco, scrittura, nuovo payload.
+        //    Un errore non interrompe la ripresa: si riparte con i valori in vigore
+        setTransportLayerLock(false);
+        std::exception_ptr applyError;
+        try {
+            applyStreamReconfiguration(change, notifications);
+        }
+        catch (...) {
+            applyError = std::current_exception();
+        }
 
-                                // Ottieni parametri correnti in modo thread-safe
-                                try {
-                                    imageData->exposureTime = getExposureTime();
-                                    imageData->gain = getGain();
-                                }
-                                catch (...) {
-                                    imageData->exposureTime = 0.0;
-                                    imageData->gain = 0.0;
-                                }
+        try {
+            updateBufferSize();
+            result.payloadSize = m_bufferSize;
 
-                                // Notifica callback
-                                {
-                                    std::lock_guard<std::mutex> lock(m_callbackMutex);
-                                    if (m_eventListener) {
-                                        m_eventListener->OnFrameReady(imageData.get(), image);  // in prima implementazione si e' cercato di inviare imageData al posto di image
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    catch (const std::exception& e) {
-                        std::lock_guard<std::mutex> lock(m_callbackMutex);
-                        if (m_eventListener) {
-                            m_eventListener->OnError(-1, std::string("Errore processamento buffer: ") + e.what());
-                        }
+            if (m_bufferSize <= m_announcedBufferSize && loansReturned) {
+                // 4a. Stessi buffer: i frame nel formato precedente non ancora prelevati
+                //     vengono scartati e tutti i buffer tornano in coda di input
+                GENTL_CALL(DSFlushQueue)(m_dsHandle, GenTL::ACQ_QUEUE_ALL_DISCARD);
+                for (auto& hBuffer : m_bufferHandles) {
+                    GenTL::GC_ERROR err = GENTL_CALL(DSQueueBuffer)(m_dsHandle, hBuffer);
+                    if (err != GenTL::GC_ERR_SUCCESS) {
+                        THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, "Impossibile accodare il buffer", err);
                     }
-
-                    GENTL_CALL(DSQueueBuffer)(m_dsHandle, hBuffer);
                 }
             }
-            else if (err != GenTL::GC_ERR_TIMEOUT) {
-                std::lock_guard<std::mutex> lock(m_callbackMutex);
-                if (m_eventListener) {
-                    m_eventListener->OnError(err, "Errore durante l'acquisizione: " + getGenTLErrorString(err));
+            else {
+                // 4b. Payload più grande dei buffer annunciati, o buffer ancora in mano ai
+                //     listener: memoria nuova, quella in prestito resta alla sessione chiusa
+                if (!loansReturned && !m_externalBuffers.empty()) {
+                    THROW_GENICAM_ERROR(ErrorType::BufferError,
+                        "Frame ancora in prestito su buffer esterni: impossibile riannunciarli");
                 }
+                reallocateStreamBuffers();
+                result.buffersReallocated = true;
+            }
+
+            // 5. Ripresa
+            startStreamStages();
+            setTransportLayerLock(true);
+            GenTL::GC_ERROR err = GENTL_CALL(DSStartAcquisition)(m_dsHandle, GenTL::ACQ_START_FLAGS_DEFAULT, GENTL_INFINITE);
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                THROW_GENICAM_ERROR_CODE(ErrorType::AcquisitionError, "Impossibile riavviare l'acquisizione sul data stream", err);
             }
+            executeAcquisitionStart();
+            refreshParameterShadows();
+        }
+        catch (...) {
+            // Stream fermo: l'applicazione deve chiamare stopAcquisition
+            m_state = CameraState::Error;
+            return std::current_exception();
         }
+
+        return applyError;
     }
 
-    // === Parametri Camera - Implementazione Uniforme GenApi ===
-    GenApi::INodeMap* GenICamCamera::getNodeMap() const {
-       std::shared_lock<std::shared_mutex> lock(m_connectionMutex);
+    bool GenICamCamera::stopStreamStages() {
+        // Come in stopAcquisition, ma senza chiudere lo stream né notificare i listener
+        stopBufferMonitor();
 
-       if (!isConnected()) {
-          THROW_GENICAM_ERROR(ErrorType::ConnectionError,
-             "Camera non connessa - NodeMap non disponibile");
-       }
+        m_stopAcquisition = true;
+        if (m_eventHandle) {
+            GENTL_CALL(EventKill)(m_eventHandle);
+        }
+        if (m_acquisitionThread.joinable()) {
+            m_acquisitionThread.join();
+        }
 
-       if (!m_nodeMapValid || !m_pNodeMap) {
-          THROW_GENICAM_ERROR(ErrorType::GenApiError,
-             "NodeMap non valido o non inizializzato");
-       }
+        // Un EventKill non consumato resterebbe pendente sull'evento: viene registrato di nuovo
+        if (m_eventHandle) {
+            GENTL_CALL(GCUnregisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER);
+            m_eventHandle = nullptr;
+        }
 
-       // Se CNodeMapRef ha un operatore di conversione o un metodo specifico
-      // Controlla la documentazione GenApi per il metodo corretto
+        stopPipeline();
+        closeFrameQueue();
+        return closeLoanSession();
+    }
 
-      // Possibilità 1: Operatore di conversione implicito
-       //GenApi::INodeMap* pNodeMap = m_pNodeMap.get();
+    void GenICamCamera::startStreamStages() {
+        GenTL::GC_ERROR err = GENTL_CALL(GCRegisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER, &m_eventHandle);
+        if (err != GenTL::GC_ERR_SUCCESS) {
+            THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Impossibile registrare l'evento NEW_BUFFER", err);
+        }
 
-       // Possibilità 2: Metodo esplicito (verifica nella documentazione)
-       //GenApi::INodeMap* pNodeMap = m_pNodeMap->GetInterface();
+        openLoanSession();
+        openFrameQueue();
+        startPipeline();
+        m_stopAcquisition = false;
+        m_acquisitionThread = std::thread(&GenICamCamera::acquisitionThreadFunction, this);
+        startBufferMonitor();
+    }
 
-       // Possibilità 3: Cast C-style (meno sicuro, usa solo se necessario)
-       GenApi::INodeMap* pNodeMap = (GenApi::INodeMap*)m_pNodeMap.get();
+    void GenICamCamera::applyStreamReconfiguration(const StreamReconfiguration& change, ParameterNotifications& notifications) {
+        // Binning prima della ROI: ne cambia i limiti (WidthMax/HeightMax)
+        const std::pair<const char*, uint32_t> binning[] = {
+            { "BinningHorizontal", change.binningHorizontal },
+            { "BinningVertical", change.binningVertical }
+        };
+        for (const auto& [nodeName, value] : binning) {
+            if (value == 0) {
+                continue;
+            }
+            try {
+                GenApi::CIntegerPtr pBinning = getIntegerNode(nodeName);
+                if (!GenApi::IsWritable(pBinning)) {
+                    THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                        std::string(nodeName) + " non scrivibile");
+                }
+                pBinning->SetValue(value);
+                notifications.emplace_back(nodeName, std::to_string(value));
+            }
+            catch (const GENICAM_NAMESPACE::GenericException& e) {
+                THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                    std::string("Errore impostazione ") + nodeName + ": " + e.GetDescription());
+            }
+        }
 
-       return pNodeMap;
+        if (change.changePixelFormat) {
+            notifications.emplace_back("PixelFormat", applyPixelFormat(change.pixelFormat));
+        }
+        if (change.changeRoi) {
+            notifications.emplace_back("ROI", applyROI(change.roi));
+        }
     }
 
-    GenApi::INodeMap* GenICamCamera::getStreamNodeMap() const {
-       std::shared_lock<std::shared_mutex> lock(m_connectionMutex);
-
-       if (!isConnected()) {
-          return nullptr;
-       }
+    void GenICamCamera::reallocateStreamBuffers() {
+        // La memoria esterna non può crescere
+        for (const auto& buffer : m_externalBuffers) {
+            if (buffer.size < m_bufferSize) {
+                THROW_GENICAM_ERROR(ErrorType::BufferError,
+                    "Buffer esterni troppo piccoli per il nuovo PayloadSize (" + std::to_string(m_bufferSize) + " bytes)");
+            }
+        }
 
-       // Per ora restituiamo nullptr poiché lo stream NodeMap 
-       // non è ancora implementato in questa versione.
-       // In futuro, se necessario, si può aggiungere:
-       // - Un membro m_pStreamNodeMap
-       // - Inizializzazione durante la connessione al DataStream
-       // - Gestione del ciclo di vita dello stream NodeMap
+        // Gli stadi che usano i buffer sono già fermi (stopStreamStages)
+        GENTL_CALL(DSFlushQueue)(m_dsHandle, GenTL::ACQ_QUEUE_ALL_DISCARD);
 
-       return nullptr;
+        // Stesso numero di buffer, con la nuova dimensione
+        allocateBuffers(std::max<size_t>(m_bufferHandles.size(), 1));
+        m_announcedBufferCount = m_bufferHandles.size();
+        m_pendingBufferRevokes = 0;
 
-       // Implementazione futura potrebbe essere:
-       // return m_pStreamNodeMap ? m_pStreamNodeMap.get() : nullptr;
+        for (auto& hBuffer : m_bufferHandles) {
+            GenTL::GC_ERROR err = GENTL_CALL(DSQueueBuffer)(m_dsHandle, hBuffer);
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, "Impossibile accodare il buffer", err);
+            }
+        }
     }
 
-    // Helper per ottenere nodi GenApi con gestione errori
-    GenApi::CNodePtr GenICamCamera::getNode(const std::string& nodeName) const {
-        std::shared_lock<std::shared_mutex> lock(m_parameterMutex);
+    void GenICamCamera::acquisitionThreadFunction() {
+        applyThreadConfig(AcquisitionThreadRole::Grab, 0);
 
-        // Valida il NodeMap prima dell'uso
-        validateNodeMap();
+        // Senza worker di conversione il grab converte e consegna direttamente
+        const bool inlineConversion = !m_conversionChannel;
+        const bool dropIncomplete = m_pipelineConfig.dropIncompleteFrames;
+        uint64_t nextSequence = 0;
 
-        if (!m_pNodeMap) {
-            THROW_GENICAM_ERROR(ErrorType::ConnectionError,
-                "NodeMap non disponibile");
-        }
+        // Busy-poll: timeout 0 finché non è trascorso spinDuration dall'ultimo frame
+        const bool busyPoll = m_grabWaitConfig.mode == GrabWaitMode::BusyPoll;
+        const auto spinDuration = m_grabWaitConfig.spinDuration;
+        auto lastActivity = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point lastFrameTime;
+        bool hasLastFrame = false;
 
-        GenApi::CNodePtr node = m_pNodeMap->_GetNode(nodeName.c_str());
-        if (!node.IsValid()) {
-            THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "Nodo non trovato: " + nodeName);
-        }
+        // Attesa senza timeout: lo stop arriva tramite EventKill
+        while (!m_stopAcquisition) {
+            GenTL::EVENT_NEW_BUFFER_DATA bufferData;
+            size_t bufferDataSize = sizeof(bufferData);
 
-        return node;
-    }
+            const bool spinning = busyPoll && (std::chrono::steady_clock::now() - lastActivity) < spinDuration;
+            GenTL::GC_ERROR err = GENTL_CALL(EventGetData)(m_eventHandle, &bufferData, &bufferDataSize,
+                spinning ? 0 : GENTL_INFINITE);
 
-    GenApi::CFloatPtr GenICamCamera::getFloatNode(const std::string& nodeName) const {
+            if (err == GenTL::GC_ERR_ABORT) {
+                break;      // EventKill da stopAcquisition
+            }
 
-        // Valida il NodeMap prima dell'uso
-        validateNodeMap();
+            if (err == GenTL::GC_ERR_TIMEOUT) {
+                // Nessun buffer pronto durante lo spin: ricontrolla subito
+                continue;
+            }
 
-        GenApi::CNodePtr node = getNode(nodeName);
-        GenApi::CFloatPtr floatNode(node);
+            if (busyPoll) {
+                lastActivity = std::chrono::steady_clock::now();
+            }
 
-        if (!floatNode.IsValid()) {
-            THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "Il nodo " + nodeName + " non è di tipo Float");
-        }
+            if (err == GenTL::GC_ERR_SUCCESS) {
+                GenTL::BUFFER_HANDLE hBuffer = bufferData.BufferHandle;
 
-        return floatNode;
-    }
+                if (hBuffer) {
+                    // Lo stadio di grab legge solo i metadati e passa il buffer alla pipeline
+                    GrabbedFrame grabbed;
+                    if (!readBufferInfo(hBuffer, grabbed)) {
+                        requeueBuffer(hBuffer);
+                        continue;
+                    }
 
-    GenApi::CIntegerPtr GenICamCamera::getIntegerNode(const std::string& nodeName) const {
+                    m_statFramesReceived.fetch_add(1, std::memory_order_relaxed);
+                    trackFrameId(grabbed.frameID);
 
-        // Valida il NodeMap prima dell'uso
-        validateNodeMap();
+                    if (hasLastFrame) {
+                        m_frameIntervalLatency.record(grabbed.timestamp - lastFrameTime);
+                    }
+                    lastFrameTime = grabbed.timestamp;
+                    hasLastFrame = true;
+
+                    // Frame incompleto (pacchetti persi sul link): viene contato e consegnato
+                    // con isIncomplete, oppure scartato se richiesto dalla configurazione
+                    grabbed.isIncomplete = isFrameIncomplete(grabbed);
+                    if (grabbed.isIncomplete) {
+                        m_statIncompleteFrames.fetch_add(1, std::memory_order_relaxed);
+                        if (dropIncomplete) {
+                            requeueBuffer(hBuffer);
+                            continue;
+                        }
+                    }
 
-        GenApi::CNodePtr node = getNode(nodeName);
-        GenApi::CIntegerPtr intNode(node);
+                    correlateTrigger(grabbed);
 
-        if (!intNode.IsValid()) {
-            THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "Il nodo " + nodeName + " non è di tipo Integer");
+                    grabbed.sequence = nextSequence;
+
+                    if (inlineConversion) {
+                        ++nextSequence;
+                        ConvertedFrame converted = convertGrabbedFrame(grabbed);
+                        deliverFrame(converted);
+                    }
+                    else if (enqueueGrabbedFrame(grabbed)) {
+                        ++nextSequence;
+                    }
+                    else {
+                        // Frame scartato dalla politica di backpressure (o stop durante
+                        // l'attesa): il buffer torna subito al producer
+                        requeueBuffer(hBuffer);
+                        ++m_pipelineDroppedFrames;
+                    }
+                }
+            }
+            else if (err != GenTL::GC_ERR_TIMEOUT) {
+                const std::string message = "Errore durante l'acquisizione: " + getGenTLErrorString(err);
+                dispatchToListeners([&](CameraEventListener* listener) {
+                    listener->OnError(err, message);
+                });
+            }
         }
 
-        return intNode;
+        // Valore finale degli underrun prima della chiusura del data stream
+        refreshProducerUnderruns();
     }
 
-    GenApi::CEnumerationPtr GenICamCamera::getEnumerationNode(const std::string& nodeName) const {
+    // === Statistiche di perdita frame ===
 
-        // Valida il NodeMap prima dell'uso
-        validateNodeMap();
+    void GenICamCamera::resetAcquisitionStatistics() {
+        m_pipelineDroppedFrames = 0;
+        m_statFramesReceived = 0;
+        m_statMissingFrameIds = 0;
+        m_statIncompleteFrames = 0;
+        m_statProducerUnderruns = 0;
+        m_statFrameIdResets = 0;
+        m_statLastFrameId = 0;
+        m_hasLastFrameId = false;
+        m_pipelineHighWaterMark = 0;
+        m_statBuffersAdded = 0;
+        m_statBuffersRevoked = 0;
+        m_matPool.resetCounters();
+        m_grabToDeliveryLatency.reset();
+        m_frameIntervalLatency.reset();
+        resetTriggerTracking();
+    }
 
-        GenApi::CNodePtr node = getNode(nodeName);
-        GenApi::CEnumerationPtr enumNode(node);
+    void GenICamCamera::trackFrameId(uint64_t frameID) {
+        const uint64_t last = m_statLastFrameId.load(std::memory_order_relaxed);
+        m_statLastFrameId.store(frameID, std::memory_order_relaxed);
 
-        if (!enumNode.IsValid()) {
-            THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "Il nodo " + nodeName + " non è di tipo Enumeration");
+        if (!m_hasLastFrameId) {
+            m_hasLastFrameId = true;
+            return;
         }
 
-        return enumNode;
-    }
-
-    GenApi::CCommandPtr GenICamCamera::getCommandNode(const std::string& nodeName) const {
+        uint64_t missing = 0;
+        if (frameID > last) {
+            missing = frameID - last - 1;
+        }
+        else if (last <= GEV1_MAX_BLOCK_ID && last - frameID > GEV1_MAX_BLOCK_ID / 2) {
+            // Rollover del block ID a 16 bit di GigE Vision 1.x: 65535 -> 1 (lo 0 è riservato)
+            missing = (GEV1_MAX_BLOCK_ID - last) + (frameID > 0 ? frameID - 1 : 0);
+        }
+        else if (frameID != last) {
+            // Sequenza ripartita: non è una perdita misurabile
+            m_statFrameIdResets.fetch_add(1, std::memory_order_relaxed);
+        }
 
-        // Valida il NodeMap prima dell'uso
-        validateNodeMap();
+        if (missing > 0) {
+            m_statMissingFrameIds.fetch_add(missing, std::memory_order_relaxed);
+            // Un buco può essere dovuto alla mancanza di buffer nel producer:
+            // aggiorna gli underrun solo in questo caso, non a ogni frame
+            refreshProducerUnderruns();
+        }
+    }
 
-        GenApi::CNodePtr node = getNode(nodeName);
-        GenApi::CCommandPtr cmdNode(node);
+    bool GenICamCamera::isFrameIncomplete(const GrabbedFrame& frame) const {
+        if (frame.isIncomplete) {
+            return true;
+        }
 
-        if (!cmdNode.IsValid()) {
-            THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "Il nodo " + nodeName + " non è di tipo Command");
+        // Alcuni producer non valorizzano IS_INCOMPLETE: confronta i byte ricevuti
+        // con la dimensione minima dell'immagine (i chunk seguono i dati immagine)
+        if (frame.sizeFilled > 0 && frame.width > 0 && frame.height > 0) {
+            const int bpp = getBitsPerPixel(convertFromGenICamPixelFormat(frame.pixelFormat));
+            if (bpp > 0) {
+                const size_t expected = (static_cast<size_t>(frame.width) * bpp + 7) / 8 * frame.height
+                    + frame.xPadding * frame.height;
+                return frame.sizeFilled < expected;
+            }
         }
 
-        return cmdNode;
+        return false;
     }
 
-// === Controllo dell'esposizione (SFNC 2.7 compliant) ===
-
-    void GenICamCamera::setExposureMode(ExposureMode mode) {
-        try {
-            GenApi::CEnumerationPtr pExposureMode = getEnumerationNode("ExposureMode");
+    void GenICamCamera::refreshProducerUnderruns() {
+        if (!m_dsHandle) {
+            return;
+        }
 
-            if (!GenApi::IsWritable(pExposureMode)) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "ExposureMode non scrivibile");
+        uint64_t underruns = 0;
+        size_t infoSize = sizeof(underruns);
+        GenTL::INFO_DATATYPE dataType;
+        if (GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_UNDERRUN, &dataType, &underruns, &infoSize) == GenTL::GC_ERR_SUCCESS) {
+            m_statProducerUnderruns.store(underruns, std::memory_order_relaxed);
+        }
+    }
+
+    AcquisitionStatistics GenICamCamera::getAcquisitionStatistics() const {
+        AcquisitionStatistics stats;
+        stats.framesReceived = m_statFramesReceived.load(std::memory_order_relaxed);
+        stats.missingFrameIds = m_statMissingFrameIds.load(std::memory_order_relaxed);
+        stats.transportIncompleteFrames = m_statIncompleteFrames.load(std::memory_order_relaxed);
+        stats.producerUnderruns = m_statProducerUnderruns.load(std::memory_order_relaxed);
+        stats.pipelineDroppedFrames = m_pipelineDroppedFrames.load(std::memory_order_relaxed);
+        stats.pipelineHighWaterMark = m_pipelineHighWaterMark.load(std::memory_order_relaxed);
+        stats.frameIdResets = m_statFrameIdResets.load(std::memory_order_relaxed);
+        stats.lastFrameId = m_statLastFrameId.load(std::memory_order_relaxed);
+        stats.announcedBuffers = m_announcedBufferCount.load(std::memory_order_relaxed);
+        stats.buffersAdded = m_statBuffersAdded.load(std::memory_order_relaxed);
+        stats.buffersRevoked = m_statBuffersRevoked.load(std::memory_order_relaxed);
+
+        const MatPoolStatistics matStats = m_matPool.statistics();
+        stats.conversionAllocations = matStats.allocations;
+        stats.conversionReuses = matStats.reuses;
+        stats.conversionAllocationsPerFrame = stats.framesReceived > 0
+            ? static_cast<double>(matStats.allocations) / static_cast<double>(stats.framesReceived) : 0.0;
+
+        stats.hostDroppedFrames = stats.producerUnderruns + stats.pipelineDroppedFrames;
+        stats.cameraDroppedFrames = stats.missingFrameIds > stats.producerUnderruns
+            ? stats.missingFrameIds - stats.producerUnderruns : 0;
+        return stats;
+    }
+
+    // === Correlazione trigger software -> frame ===
+
+    void GenICamCamera::resetTriggerTracking() {
+        std::lock_guard<std::mutex> lock(m_triggerMutex);
+        m_pendingTriggers.clear();
+        m_triggerSynced = false;
+        m_triggersIssued = 0;
+        m_triggerFramesMatched = 0;
+        m_triggerFramesLost = 0;
+        m_triggerToGrabLatency.reset();
+        m_triggerToDeliveryLatency.reset();
+    }
+
+    void GenICamCamera::correlateTrigger(GrabbedFrame& frame) {
+        uint64_t key = frame.frameID;
+        bool gevRollover = true;
+        if (frame.hasChunkTriggerCounter) {
+            key = frame.chunkTriggerCounter;
+            gevRollover = false;
+        }
+        else if (frame.hasChunkFrameId) {
+            key = frame.chunkFrameId;
+            gevRollover = false;
+        }
+
+        std::lock_guard<std::mutex> lock(m_triggerMutex);
+
+        uint64_t expectedToken = 0;
+        if (m_triggerSynced) {
+            // Ogni trigger (o frame) fa avanzare il contatore di 1
+            uint64_t delta = 0;
+            if (key > m_triggerLastKey) {
+                delta = key - m_triggerLastKey;
+            }
+            else if (gevRollover && m_triggerLastKey <= GEV1_MAX_BLOCK_ID && m_triggerLastKey - key > GEV1_MAX_BLOCK_ID / 2) {
+                delta = (GEV1_MAX_BLOCK_ID - m_triggerLastKey) + key;
+            }
+
+            expectedToken = m_triggerLastMatchedToken + delta;
+            if (delta == 0 || expectedToken > m_lastTriggerToken) {
+                // Contatore ripartito o frame non prodotto da un trigger software
+                m_triggerSynced = false;
+                return;
             }
 
-            std::string modeString;
-            switch (mode) {
-            case ExposureMode::Off:
-                modeString = "Off";
-                break;
-            case ExposureMode::Timed:
-                modeString = "Timed";
-                break;
-            case ExposureMode::TriggerWidth:
-                modeString = "TriggerWidth";
-                break;
-            case ExposureMode::TriggerControlled:
-                modeString = "TriggerControlled";
-                break;
-            default:
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "ExposureMode non valido");
+            // I trigger precedenti a quello atteso non hanno prodotto un frame
+            while (!m_pendingTriggers.empty() && m_pendingTriggers.front().token < expectedToken) {
+                m_pendingTriggers.pop_front();
+                m_triggerFramesLost.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else {
+            if (m_pendingTriggers.empty()) {
+                return;     // Nessun trigger software in attesa (free run o trigger hardware)
             }
+            // Primo frame dopo l'avvio o una risincronizzazione: è del trigger più vecchio
+            expectedToken = m_pendingTriggers.front().token;
+            m_triggerSynced = true;
+        }
 
-            *pExposureMode = modeString.c_str();
-            notifyParameterChanged("ExposureMode", modeString);
+        m_triggerLastKey = key;
+        m_triggerLastMatchedToken = expectedToken;
+        frame.triggerToken = expectedToken;
 
+        if (!m_pendingTriggers.empty() && m_pendingTriggers.front().token == expectedToken) {
+            frame.triggerTime = m_pendingTriggers.front().time;
+            m_pendingTriggers.pop_front();
+            m_triggerFramesMatched.fetch_add(1, std::memory_order_relaxed);
+            m_triggerToGrabLatency.record(frame.timestamp - frame.triggerTime);
         }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore impostazione ExposureMode: ") + e.GetDescription());
+        else {
+            // Trigger già scartato per eccesso di trigger in attesa: token senza istante
+            frame.triggerTime = frame.timestamp;
         }
     }
 
-    ExposureMode GenICamCamera::getExposureMode() const {
-        try {
-            // Verifica se ExposureMode esiste
-            if (!isParameterAvailable("ExposureMode")) {
-                // Se non esiste, assumiamo Timed mode (default SFNC)
-                return ExposureMode::Timed;
-            }
+    TriggerStatistics GenICamCamera::getTriggerStatistics() const {
+        TriggerStatistics stats;
+        stats.source = m_triggerCorrelationSource.load();
+        stats.triggersIssued = m_triggersIssued.load(std::memory_order_relaxed);
+        stats.framesMatched = m_triggerFramesMatched.load(std::memory_order_relaxed);
+        stats.framesLost = m_triggerFramesLost.load(std::memory_order_relaxed);
+        stats.triggerToGrab = m_triggerToGrabLatency.snapshot();
+        stats.triggerToDelivery = m_triggerToDeliveryLatency.snapshot();
 
-            GenApi::CEnumerationPtr pExposureMode = getEnumerationNode("ExposureMode");
-            std::string mode = pExposureMode->ToString().c_str();
+        std::lock_guard<std::mutex> lock(m_triggerMutex);
+        stats.pendingTriggers = m_pendingTriggers.size();
+        if (!m_pendingTriggers.empty()) {
+            stats.oldestPendingAge = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_pendingTriggers.front().time);
+        }
+        return stats;
+    }
 
-            if (mode == "Off") return ExposureMode::Off;
-            if (mode == "Timed") return ExposureMode::Timed;
-            if (mode == "TriggerWidth") return ExposureMode::TriggerWidth;
-            if (mode == "TriggerControlled") return ExposureMode::TriggerControlled;
+    // === Pipeline di acquisizione (grab -> conversione -> consegna) ===
 
-            return ExposureMode::Timed; // Default
+    bool GenICamCamera::queryBufferInfo(GenTL::BUFFER_HANDLE hBuffer, BufferInfo& info) {
+        struct InfoRequest {
+            GenTL::BUFFER_INFO_CMD cmd;
+            void* target;
+            size_t size;
+        };
 
-        }
-        catch (...) {
-            return ExposureMode::Timed;
-        }
-    }
+        const InfoRequest requests[] = {
+            { GenTL::BUFFER_INFO_BASE,          &info.base,         sizeof(info.base) },
+            { GenTL::BUFFER_INFO_WIDTH,         &info.width,        sizeof(info.width) },
+            { GenTL::BUFFER_INFO_HEIGHT,        &info.height,       sizeof(info.height) },
+            { GenTL::BUFFER_INFO_PIXELFORMAT,   &info.pixelFormat,  sizeof(info.pixelFormat) },
+            { GenTL::BUFFER_INFO_FRAMEID,       &info.frameID,      sizeof(info.frameID) },
+            { GenTL::BUFFER_INFO_TIMESTAMP,     &info.timestamp,    sizeof(info.timestamp) },
+            { GenTL::BUFFER_INFO_IS_INCOMPLETE, &info.isIncomplete, sizeof(info.isIncomplete) },
+            { GenTL::BUFFER_INFO_SIZE_FILLED,   &info.sizeFilled,   sizeof(info.sizeFilled) },
+            { GenTL::BUFFER_INFO_XPADDING,      &info.xPadding,     sizeof(info.xPadding) },
+            { GenTL::BUFFER_INFO_PAYLOADTYPE,   &info.payloadType,  sizeof(info.payloadType) }
+        };
+        constexpr size_t numRequests = sizeof(requests) / sizeof(requests[0]);
 
-    void GenICamCamera::setExposureTime(double microseconds) {
-        try {
-            // Verifica prima ExposureMode se disponibile
-            if (isParameterAvailable("ExposureMode")) {
-                ExposureMode mode = getExposureMode();
-                if (mode != ExposureMode::Timed) {
-                    // Imposta automaticamente Timed mode se necessario
-                    setExposureMode(ExposureMode::Timed);
-                }
+        // GenTL 1.6: tutte le informazioni con una sola chiamata al producer
+        if (m_stackedBufferInfoSupported.load(std::memory_order_relaxed) && GENTL_CALL(DSGetBufferInfoStacked)) {
+            GenTL::DS_BUFFER_INFO_STACKED stacked[numRequests];
+            for (size_t i = 0; i < numRequests; ++i) {
+                stacked[i].iInfoCmd = requests[i].cmd;
+                stacked[i].iType = GenTL::INFO_DATATYPE_UNKNOWN;
+                stacked[i].pBuffer = static_cast<uint8_t*>(requests[i].target);
+                stacked[i].iSize = requests[i].size;
+                stacked[i].iResult = GenTL::GC_ERR_SUCCESS;
             }
 
-            // Verifica se c'è un selector attivo
-            if (isParameterAvailable("ExposureTimeSelector")) {
-                // Il selector è già impostato, usa il valore corrente
+            GenTL::GC_ERROR err = GENTL_CALL(DSGetBufferInfoStacked)(m_dsHandle, hBuffer, stacked, numRequests);
+            if (err != GenTL::GC_ERR_NOT_IMPLEMENTED) {
+                // Il risultato globale può segnalare errori dei singoli comandi:
+                // conta solo BASE, le altre voci mancanti restano ai valori di default
+                return stacked[0].iResult == GenTL::GC_ERR_SUCCESS && info.base != nullptr;
             }
 
-            // Prova i nomi SFNC in ordine di priorità
-            GenApi::CFloatPtr pExposure;
-            const std::vector<std::string> exposureNames = {
-                "ExposureTime",       // SFNC 2.x standard
-                "ExposureTimeAbs",    // Legacy SFNC 1.x
-                "ExposureTimeRaw"     // Alcune implementazioni usano Raw
-            };
+            m_stackedBufferInfoSupported = false;
+        }
 
-            bool found = false;
-            for (const auto& name : exposureNames) {
-                try {
-                    pExposure = getFloatNode(name);
-                    if (pExposure.IsValid() && GenApi::IsWritable(pExposure)) {
-                        found = true;
-                        break;
-                    }
-                }
-                catch (...) {
-                    continue;
-                }
+        // Producer precedenti a GenTL 1.6: una chiamata per informazione
+        for (size_t i = 0; i < numRequests; ++i) {
+            GenTL::INFO_DATATYPE dataType;
+            size_t size = requests[i].size;
+            GenTL::GC_ERROR err = GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, requests[i].cmd, &dataType, requests[i].target, &size);
+            if (i == 0 && (err != GenTL::GC_ERR_SUCCESS || !info.base)) {
+                return false;
             }
+        }
 
-            if (!found) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "Nessun parametro ExposureTime scrivibile trovato");
-            }
+        return true;
+    }
 
-            // Verifica range
-            double min = pExposure->GetMin();
-            double max = pExposure->GetMax();
+    bool GenICamCamera::readBufferInfo(GenTL::BUFFER_HANDLE hBuffer, GrabbedFrame& frame) {
+        frame.hBuffer = hBuffer;
+        frame.timestamp = std::chrono::steady_clock::now();
 
-            if (microseconds < min || microseconds > max) {
-                std::stringstream ss;
-                ss << "Valore esposizione fuori range [" << min << ", " << max << "] µs";
-                THROW_GENICAM_ERROR(ErrorType::ParameterError, ss.str());
-            }
+        BufferInfo info;
+        if (!queryBufferInfo(hBuffer, info)) {
+            return false;
+        }
 
-            // Verifica incremento se disponibile
-            if (pExposure->GetIncMode() != GenApi::noIncrement) {
-                double inc = pExposure->GetInc();
-                // Arrotonda al valore di incremento più vicino
-                microseconds = round(microseconds / inc) * inc;
-            }
+        frame.pBuffer = info.base;
+        frame.width = static_cast<uint32_t>(info.width);
+        frame.height = static_cast<uint32_t>(info.height);
+        frame.pixelFormat = info.pixelFormat;
+        frame.frameID = info.frameID;
+        frame.deviceTimestamp = info.timestamp;
+        frame.sizeFilled = info.sizeFilled;
+        frame.xPadding = info.xPadding;
+        frame.payloadType = info.payloadType;
+        frame.isIncomplete = info.isIncomplete != 0;
 
-            pExposure->SetValue(microseconds);
+        // Sul thread di grab solo la chiave per la correlazione dei trigger
+        if (m_triggerCorrelationSource.load(std::memory_order_relaxed) != TriggerCorrelationSource::BufferFrameId) {
+            readChunkTriggerKey(frame);
+        }
 
-            // Invalida cache
-            m_parameterCache.erase("ExposureTime");
+        return true;
+    }
 
-            notifyParameterChanged("ExposureTime", std::to_string(microseconds));
+    // === Metadati di esposizione per frame (chunk / valori ombra) ===
 
+    void GenICamCamera::refreshParameterShadows(bool exposure, bool gain) {
+        // Forza la rilettura dal device anziché dalla cache dei parametri
+        {
+            std::unique_lock<std::shared_mutex> lock(m_parameterMutex);
+            m_parameterCache.erase("ExposureTime");
+            m_parameterCache.erase("Gain");
         }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore impostazione ExposureTime: ") + e.GetDescription());
+
+        if (exposure) {
+            try {
+                m_exposureTimeShadow = getExposureTime();
+            }
+            catch (...) {
+                // Valore non leggibile: resta l'ultimo noto
+            }
         }
-    }
 
-    double GenICamCamera::getExposureTime() const {
-        try {
-            // Check cache first
-            auto it = m_parameterCache.find("ExposureTime");
-            if (it != m_parameterCache.end()) {
-                auto now = std::chrono::steady_clock::now();
-                if (now - it->second.second < CACHE_TIMEOUT) {
-                    return std::stod(it->second.first);
-                }
+        if (gain) {
+            try {
+                m_gainShadow = getGain();
+            }
+            catch (...) {
+                // Valore non leggibile: resta l'ultimo noto
             }
+        }
+    }
 
-            // Prova i nomi SFNC in ordine
-            const std::vector<std::string> exposureNames = {
-                "ExposureTime",       // SFNC 2.x
-                "ExposureTimeAbs",    // SFNC 1.x
-                "ExposureTimeRaw"     // Raw value
-            };
+    void GenICamCamera::setupChunkMetadata() {
+        m_chunkMetadataActive = false;
+        m_triggerCorrelationSource = TriggerCorrelationSource::BufferFrameId;
 
-            for (const auto& name : exposureNames) {
-                try {
-                    GenApi::CFloatPtr pExposure = getFloatNode(name);
-                    if (pExposure.IsValid() && GenApi::IsReadable(pExposure)) {
-                        double value = pExposure->GetValue();
+        if (!GENTL_CALL(DSGetBufferChunkData) || !m_pNodeMap) {
+            return;
+        }
 
-                        // Se è ExposureTimeRaw, potrebbe servire conversione
-                        if (name == "ExposureTimeRaw") {
-                            // Cerca un fattore di conversione
-                            try {
-                                GenApi::CFloatPtr pConvFactor = getFloatNode("ExposureTimeBaseAbs");
-                                if (pConvFactor.IsValid()) {
-                                    value *= pConvFactor->GetValue();
-                                }
-                            }
-                            catch (...) {}
-                        }
+        // Il contatore nei chunk è utile per i trigger solo se conta i FrameTrigger
+        bool counterCountsTriggers = false;
+        try {
+            GenApi::CEnumerationPtr pCounterEventSource = m_pNodeMap->_GetNode("CounterEventSource");
+            counterCountsTriggers = pCounterEventSource.IsValid() && GenApi::IsReadable(pCounterEventSource) &&
+                pCounterEventSource->ToString() == "FrameTrigger";
+        }
+        catch (const GENICAM_NAMESPACE::GenericException&) {
+            // Contatore non leggibile: correlazione sul frame ID
+        }
 
-                        // Update cache
-                        m_parameterCache["ExposureTime"] = {
-                            std::to_string(value),
-                            std::chrono::steady_clock::now()
-                        };
+        if (!m_chunkReader) {
+            m_chunkReader = std::make_unique<ChunkDataManager>();
+        }
+        if (!m_chunkReader->PrepareFrameReader(m_pNodeMap->_Ptr, counterCountsTriggers)) {
+            return;
+        }
 
-                        return value;
-                    }
-                }
-                catch (...) {
-                    continue;
-                }
-            }
+        if (m_chunkReader->HasCounterValueChunk()) {
+            m_triggerCorrelationSource = TriggerCorrelationSource::TriggerCounter;
+        }
+        else if (m_chunkReader->HasFrameIDChunk()) {
+            m_triggerCorrelationSource = TriggerCorrelationSource::ChunkFrameId;
+        }
 
-            THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "ExposureTime non disponibile");
+        m_chunkMetadataActive = m_chunkReader->HasFrameValueChunks();
+    }
 
+    void GenICamCamera::readChunkTriggerKey(GrabbedFrame& frame) {
+        // Lettura diretta dei byte del chunk: nessun lock del nodemap sul thread di grab
+        GenTL::SINGLE_CHUNK_DATA chunks[MAX_CHUNKS_PER_FRAME];
+        size_t numChunks = MAX_CHUNKS_PER_FRAME;
+        GenTL::GC_ERROR err = GENTL_CALL(DSGetBufferChunkData)(m_dsHandle, frame.hBuffer, chunks, &numChunks);
+        if (err != GenTL::GC_ERR_SUCCESS || numChunks == 0) {
+            return;
         }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore lettura ExposureTime: ") + e.GetDescription());
+
+        const uint8_t* buffer = static_cast<const uint8_t*>(frame.pBuffer);
+        if (m_chunkReader->HasCounterValueChunk()) {
+            frame.hasChunkTriggerCounter = ChunkDataManager::ReadRawChunkValue(buffer, chunks, numChunks,
+                m_chunkReader->GetRawCounterValueChunk(), frame.chunkTriggerCounter);
+        }
+        if (!frame.hasChunkTriggerCounter && m_chunkReader->HasFrameIDChunk()) {
+            frame.hasChunkFrameId = ChunkDataManager::ReadRawChunkValue(buffer, chunks, numChunks,
+                m_chunkReader->GetRawFrameIDChunk(), frame.chunkFrameId);
         }
     }
 
-    void GenICamCamera::setExposureAuto(ExposureAuto mode) {
+    void GenICamCamera::readChunkMetadata(GrabbedFrame& frame) {
+        GenTL::SINGLE_CHUNK_DATA chunks[MAX_CHUNKS_PER_FRAME];
+        size_t numChunks = MAX_CHUNKS_PER_FRAME;
+        GenTL::GC_ERROR err = GENTL_CALL(DSGetBufferChunkData)(m_dsHandle, frame.hBuffer, chunks, &numChunks);
+        if (err != GenTL::GC_ERR_SUCCESS || numChunks == 0) {
+            return;
+        }
+
+        // Chunk non interpretabili: si usano i valori ombra
+        ChunkFrameValues values;
+        if (!m_chunkReader->ReadFrameChunks(static_cast<uint8_t*>(frame.pBuffer), chunks, numChunks, values)) {
+            return;
+        }
+
+        frame.chunkExposureTime = values.exposureTime;
+        frame.hasChunkExposureTime = values.hasExposureTime;
+        frame.chunkGain = values.gain;
+        frame.hasChunkGain = values.hasGain;
+    }
+
+    GenICamCamera::ConvertedFrame GenICamCamera::convertGrabbedFrame(GrabbedFrame& frame) {
+        ConvertedFrame converted;
+        converted.sequence = frame.sequence;
+
+        const bool loan = (m_deliveryMode.load() == FrameDeliveryMode::Loan);
+        // In modalità Loan il riaccodamento passa al deleter del frame consegnato
+        bool bufferReturned = false;
+
+        // Esposizione e guadagno dai chunk: decodifica GenApi fuori dal thread di grab,
+        // prima che il buffer torni al producer
+        if (m_chunkMetadataActive) {
+            readChunkMetadata(frame);
+        }
+
         try {
-            GenApi::CEnumerationPtr pExposureAuto = getEnumerationNode("ExposureAuto");
+            const PixelFormat format = convertFromGenICamPixelFormat(frame.pixelFormat);
+            cv::Mat image = convertBufferToMat(frame.pBuffer, m_announcedBufferSize, frame.width, frame.height, format, loan);
 
-            if (!GenApi::IsWritable(pExposureAuto)) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "ExposureAuto non scrivibile");
+            if (m_sharedRingConfig.content == SharedFrameRingContent::Raw && m_sharedFrameRing.isOpen()) {
+                publishRawFrame(frame);
             }
 
-            std::string modeString;
-            switch (mode) {
-            case ExposureAuto::Off:
-                modeString = "Off";
-                break;
-            case ExposureAuto::Once:
-                modeString = "Once";
-                break;
-            case ExposureAuto::Continuous:
-                modeString = "Continuous";
-                break;
+            if (!loan) {
+                // Il cv::Mat è già una copia: il buffer torna al producer prima della consegna
+                requeueBuffer(frame.hBuffer);
+                bufferReturned = true;
             }
 
-            *pExposureAuto = modeString.c_str();
-            notifyParameterChanged("ExposureAuto", modeString);
+            if (!image.empty()) {
+                auto imageData = std::make_shared<ImageData>();
 
-            // Se impostato su Once, attendi che completi
-            if (mode == ExposureAuto::Once) {
-                // Attendi che torni a Off
-                int maxRetries = 100;
-                while (maxRetries-- > 0) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                    if (getExposureAuto() == ExposureAuto::Off) {
-                        break;
+                if (loan) {
+                    // Il frame descrive il buffer GenTL originale, senza copie
+                    std::shared_ptr<LoanSession> loanSession = m_loanSession.load();
+                    {
+                        std::lock_guard<std::mutex> loanLock(loanSession->mutex);
+                        ++loanSession->outstanding;
                     }
+                    imageData->buffer = std::shared_ptr<uint8_t>(static_cast<uint8_t*>(frame.pBuffer), LoanedBufferRelease{ loanSession, frame.hBuffer });
+                    bufferReturned = true;
+
+                    const int bitsPerPixel = getBitsPerPixel(format);
+                    imageData->stride = (image.data == frame.pBuffer) ? image.step[0] : (static_cast<size_t>(frame.width) * bitsPerPixel + 7) / 8;
+                    imageData->bufferSize = std::min(m_announcedBufferSize, imageData->stride * frame.height);
                 }
-            }
+                else {
+                    // Il buffer condivide i dati del cv::Mat convertito (nessuna memcpy aggiuntiva)
+                    auto holder = std::make_shared<cv::Mat>(image);
+                    imageData->buffer = std::shared_ptr<uint8_t>(holder, holder->data);
+                    imageData->bufferSize = image.total() * image.elemSize();
+                    imageData->stride = image.step;
+                }
+
+                imageData->width = frame.width;
+                imageData->height = frame.height;
+                imageData->pixelFormat = format;
+                imageData->frameID = frame.frameID;
+                imageData->timestamp = frame.timestamp;
+                imageData->deviceTimestamp = frame.deviceTimestamp;
+                imageData->triggerToken = frame.triggerToken;
+                imageData->isIncomplete = frame.isIncomplete;
+                converted.triggerTime = frame.triggerTime;
+
+                if (frame.deviceTimestamp != 0) {
+                    auto clockMapping = m_clockCorrelator.mapping();
+                    if (clockMapping->valid) {
+                        imageData->hostTimestamp = clockMapping->toHostTime(frame.deviceTimestamp);
+                        imageData->hostTimestampError = std::chrono::nanoseconds(static_cast<int64_t>(clockMapping->errorNs));
+                        imageData->hostTimestampValid = true;
+                    }
+                }
+
+                // Metadati di esposizione: dai chunk del frame se presenti, altrimenti
+                // dai valori ombra (nessun accesso al canale di controllo per frame)
+                imageData->exposureTime = frame.hasChunkExposureTime ? frame.chunkExposureTime : m_exposureTimeShadow.load();
+                imageData->gain = frame.hasChunkGain ? frame.chunkGain : m_gainShadow.load();
 
+                converted.imageData = std::move(imageData);
+                converted.image = image;
+            }
         }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore impostazione ExposureAuto: ") + e.GetDescription());
+        catch (const std::exception& e) {
+            const std::string message = std::string("Errore processamento buffer: ") + e.what();
+            dispatchToListeners([&](CameraEventListener* listener) {
+                listener->OnError(-1, message);
+            });
         }
-    }
 
-    ExposureAuto GenICamCamera::getExposureAuto() const {
-        try {
-            GenApi::CEnumerationPtr pExposureAuto = getEnumerationNode("ExposureAuto");
-            std::string mode = pExposureAuto->ToString().c_str();
+        if (!bufferReturned) {
+            requeueBuffer(frame.hBuffer);
+        }
 
-            if (mode == "Off") return ExposureAuto::Off;
-            if (mode == "Once") return ExposureAuto::Once;
-            if (mode == "Continuous") return ExposureAuto::Continuous;
+        return converted;
+    }
 
-            return ExposureAuto::Off;
+    void GenICamCamera::deliverFrame(ConvertedFrame& frame) {
+        if (!frame.imageData) {
+            return;     // Conversione fallita: nulla da consegnare
+        }
 
+        if (m_frameQueueMode.load() != FrameQueueMode::Disabled) {
+            publishPulledFrame(frame);
         }
-        catch (...) {
-            return ExposureAuto::Off;
+
+        if (m_sharedRingConfig.content == SharedFrameRingContent::Converted && m_sharedFrameRing.isOpen()) {
+            publishConvertedFrame(frame);
         }
-    }
 
-    bool GenICamCamera::isExposureAutoAvailable() const {
-        try {
-            GenApi::CNodePtr node = m_pNodeMap->_GetNode("ExposureAuto");
-            return node.IsValid() && GenApi::IsImplemented(node);
+        const auto deliveryTime = std::chrono::steady_clock::now();
+        m_grabToDeliveryLatency.record(deliveryTime - frame.imageData->timestamp);
+        if (frame.imageData->triggerToken != 0) {
+            m_triggerToDeliveryLatency.record(deliveryTime - frame.triggerTime);
         }
-        catch (...) {
-            return false;
+
+        // Notifica callback: nessun mutex sul percorso del frame, si legge lo snapshot corrente
+        if (m_deliveryMode.load() == FrameDeliveryMode::Loan) {
+            dispatchToListeners([&](CameraEventListener* listener) {
+                listener->OnFrameLoaned(frame.imageData, frame.image);
+            });
+        }
+        else {
+            dispatchToListeners([&](CameraEventListener* listener) {
+                listener->OnFrameReady(frame.imageData.get(), frame.image);  // in prima implementazione si e' cercato di inviare imageData al posto di image
+            });
         }
     }
 
-    // Helper per debug della configurazione esposizione
-    std::string GenICamCamera::getExposureConfiguration() const {
-        std::stringstream config;
+    // === Accesso pull ai frame ===
 
-        config << "=== Exposure Configuration (SFNC) ===" << std::endl;
+    void GenICamCamera::openFrameQueue() {
+        const FrameQueueMode mode = m_frameQueueMode.load();
+        const size_t limit = (mode == FrameQueueMode::Disabled) ? 0
+            : (mode == FrameQueueMode::LatestOnly) ? 1 : m_frameQueueCapacity;
 
-        // ExposureMode
-        if (isParameterAvailable("ExposureMode")) {
-            config << "ExposureMode: ";
-            switch (getExposureMode()) {
-            case ExposureMode::Off: config << "Off"; break;
-            case ExposureMode::Timed: config << "Timed"; break;
-            case ExposureMode::TriggerWidth: config << "TriggerWidth"; break;
-            case ExposureMode::TriggerControlled: config << "TriggerControlled"; break;
+        if (limit > 0 && (!m_frameQueue || m_frameQueueLimit != limit)) {
+            // La coda è chiusa: si attende solo l'uscita dei consumatori ancora dentro
+            while (m_frameQueueReaders.load() > 0) {
+                std::this_thread::yield();
             }
-            config << std::endl;
+            m_frameQueue = std::make_unique<BoundedMPMCQueue<AcquiredFrame>>(limit);
         }
+        m_frameQueueLimit = limit;
 
-        // ExposureTime
-        if (isExposureTimeAvailable()) {
-            double min, max;
-            getExposureTimeRange(min, max);
-            config << "ExposureTime: " << getExposureTime() << " µs"
-                << " (Range: " << min << " - " << max << " µs)" << std::endl;
+        std::lock_guard<std::mutex> lock(m_frameQueueMutex);
+        m_frameQueueOpen = (limit > 0);
+    }
+
+    void GenICamCamera::closeFrameQueue() {
+        FrameAwaiter* awaiters = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_frameQueueMutex);
+            m_frameQueueOpen = false;
+            awaiters = m_frameAwaitersHead;
+            m_frameAwaitersHead = m_frameAwaitersTail = nullptr;
+            for (FrameAwaiter* awaiter = awaiters; awaiter; awaiter = awaiter->m_next) {
+                --m_frameWaiters;
+            }
         }
 
-        // ExposureAuto
-        if (isExposureAutoAvailable()) {
-            config << "ExposureAuto: ";
-            switch (getExposureAuto()) {
-            case ExposureAuto::Off: config << "Off"; break;
-            case ExposureAuto::Once: config << "Once"; break;
-            case ExposureAuto::Continuous: config << "Continuous"; break;
+        // La consegna è già ferma: i frame rimasti (eventualmente in prestito) vengono rilasciati
+        if (m_frameQueue) {
+            AcquiredFrame released;
+            while (m_frameQueue->tryPop(released)) {
+                released = AcquiredFrame();
             }
-            config << std::endl;
         }
+        m_frameAvailable.notify_all();
 
-        return config.str();
+        // Le coroutine in attesa riprendono con un frame vuoto
+        while (awaiters) {
+            FrameAwaiter* next = awaiters->m_next;   // L'awaiter può sparire con la ripresa
+            awaiters->m_executor.execute(awaiters->m_handle);
+            awaiters = next;
+        }
     }
 
-    void GenICamCamera::getExposureTimeRange(double& min, double& max) const {
-        try {
-            // Lista dei possibili nomi per ExposureTime secondo SFNC
-            const std::vector<std::string> exposureNames = {
-                "ExposureTime",       // SFNC 2.x standard
-                "ExposureTimeAbs",    // SFNC 1.x legacy
-                "ExposureTimeRaw"     // Raw value (needs conversion)
-            };
+    void GenICamCamera::publishPulledFrame(const ConvertedFrame& frame) {
+        if (!m_frameQueueOpen.load(std::memory_order_acquire)) {
+            return;
+        }
 
-            bool found = false;
+        AcquiredFrame entry{ frame.imageData, frame.image };
+        AcquiredFrame dropped;
 
-            for (const auto& name : exposureNames) {
-                try {
-                    GenApi::CFloatPtr pExposure = getFloatNode(name);
-                    if (pExposure.IsValid() && GenApi::IsReadable(pExposure)) {
-                        min = pExposure->GetMin();
-                        max = pExposure->GetMax();
+        // Coda piena: il frame più vecchio lascia il posto al nuovo
+        while (m_frameQueue->sizeApprox() >= m_frameQueueLimit && m_frameQueue->tryPop(dropped)) {
+            dropped = AcquiredFrame();
+        }
+        while (!m_frameQueue->tryPush(entry)) {
+            if (m_frameQueue->tryPop(dropped)) {
+                dropped = AcquiredFrame();
+            }
+        }
 
-                        // Se è ExposureTimeRaw, applica conversione
-                        if (name == "ExposureTimeRaw") {
-                            try {
-                                // Cerca il fattore di conversione per convertire da raw a microsecondi
-                                GenApi::CFloatPtr pConvFactor = getFloatNode("ExposureTimeBaseAbs");
-                                if (pConvFactor.IsValid() && GenApi::IsReadable(pConvFactor)) {
-                                    double factor = pConvFactor->GetValue();
-                                    min *= factor;
-                                    max *= factor;
-                                }
-                            }
-                            catch (...) {
-                                // Se non c'è fattore di conversione, prova con ExposureTimeBase
-                                try {
-                                    GenApi::CIntegerPtr pTimeBase = getIntegerNode("ExposureTimeBase");
-                                    if (pTimeBase.IsValid() && GenApi::IsReadable(pTimeBase)) {
-                                        double factor = static_cast<double>(pTimeBase->GetValue());
-                                        min *= factor;
-                                        max *= factor;
-                                    }
-                                }
-                                catch (...) {
-                                    // Nessun fattore di conversione trovato, usa valori raw
-                                }
-                            }
-                        }
+        // Pubblicazione del frame prima della lettura di m_frameWaiters (simmetrico a waitForFrame):
+        // se nessuno è parcheggiato non si prende il mutex e non si notifica
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_frameWaiters.load() == 0) {
+            return;
+        }
 
-                        found = true;
-                        break;
-                    }
-                }
-                catch (...) {
-                    // Prova il prossimo nome
-                    continue;
+        FrameAwaiter* resumed = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_frameQueueMutex);
+
+            // Una coroutine in attesa riceve direttamente il frame più vecchio
+            if (m_frameAwaitersHead && popPulledFrame(m_frameAwaitersHead->m_frame)) {
+                resumed = m_frameAwaitersHead;
+                m_frameAwaitersHead = resumed->m_next;
+                if (!m_frameAwaitersHead) {
+                    m_frameAwaitersTail = nullptr;
                 }
+                --m_frameWaiters;
             }
+        }
 
-            // Se non trovato, prova con nodi Integer
-            if (!found) {
-                for (const auto& name : exposureNames) {
-                    try {
-                        GenApi::CIntegerPtr pExposure = getIntegerNode(name);
-                        if (pExposure.IsValid() && GenApi::IsReadable(pExposure)) {
-                            min = static_cast<double>(pExposure->GetMin());
-                            max = static_cast<double>(pExposure->GetMax());
+        if (resumed) {
+            resumed->m_executor.execute(resumed->m_handle);
+        }
+        m_frameAvailable.notify_all();
+    }
 
-                            // Applica conversioni se necessario
-                            if (name == "ExposureTimeRaw") {
-                                try {
-                                    GenApi::CFloatPtr pConvFactor = getFloatNode("ExposureTimeBaseAbs");
-                                    if (pConvFactor.IsValid()) {
-                                        double factor = pConvFactor->GetValue();
-                                        min *= factor;
-                                        max *= factor;
-                                    }
-                                }
-                                catch (...) {}
-                            }
+    bool GenICamCamera::popPulledFrame(AcquiredFrame& frame) {
+        // m_frameQueueReaders impedisce a openFrameQueue di sostituire la coda durante il prelievo
+        ++m_frameQueueReaders;
+        const bool popped = m_frameQueueOpen.load() && m_frameQueue->tryPop(frame);
+        --m_frameQueueReaders;
+        return popped;
+    }
 
-                            found = true;
-                            break;
-                        }
-                    }
-                    catch (...) {
-                        continue;
-                    }
-                }
-            }
+    bool GenICamCamera::suspendFrameAwaiter(FrameAwaiter& awaiter) {
+        // Frame già disponibile: nessuna sospensione e nessun lock
+        if (popPulledFrame(awaiter.m_frame)) {
+            return false;
+        }
 
-            // Se ancora non trovato, verifica se c'è ExposureMode
-            if (!found && isParameterAvailable("ExposureMode")) {
-                // Alcune camere potrebbero avere range diversi per modalità diverse
-                ExposureMode mode = getExposureMode();
+        std::lock_guard<std::mutex> lock(m_frameQueueMutex);
+        if (!m_frameQueueOpen) {
+            return false;   // Accesso pull chiuso: la coroutine riprende con un frame vuoto
+        }
 
-                // Prova a leggere range specifici per modalità
-                std::string modeSuffix;
-                switch (mode) {
-                case ExposureMode::Timed:
-                    modeSuffix = "Timed";
-                    break;
-                case ExposureMode::TriggerWidth:
-                    modeSuffix = "TriggerWidth";
-                    break;
-                default:
-                    break;
-                }
+        ++m_frameWaiters;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (popPulledFrame(awaiter.m_frame)) {
+            --m_frameWaiters;
+            return false;
+        }
 
-                if (!modeSuffix.empty()) {
-                    try {
-                        std::string paramName = "ExposureTime" + modeSuffix + "Min";
-                        min = std::stod(getParameter(paramName));
-                        paramName = "ExposureTime" + modeSuffix + "Max";
-                        max = std::stod(getParameter(paramName));
-                        found = true;
-                    }
-                    catch (...) {}
-                }
-            }
+        awaiter.m_next = nullptr;
+        if (m_frameAwaitersTail) {
+            m_frameAwaitersTail->m_next = &awaiter;
+        }
+        else {
+            m_frameAwaitersHead = &awaiter;
+        }
+        m_frameAwaitersTail = &awaiter;
+        return true;
+    }
 
-            // Se non trovato nulla, usa valori di default ragionevoli
-            if (!found) {
-                // Valori tipici in microsecondi
-                min = 10.0;      // 10 µs
-                max = 10000000.0; // 10 secondi
+    bool FrameAwaiter::await_suspend(std::coroutine_handle<> handle) {
+        m_handle = handle;
+        return m_camera.suspendFrameAwaiter(*this);
+    }
 
-                // Log warning per debug
-                std::cerr << "Warning: ExposureTime range non disponibile, usando valori di default" << std::endl;
-            }
+    FrameAwaiter GenICamCamera::nextFrame(FrameExecutor& executor) {
+        return FrameAwaiter(*this, executor);
+    }
 
-            // Verifica sanità dei valori
-            if (min > max) {
-                std::swap(min, max);
-            }
+    FrameStream GenICamCamera::frames(FrameExecutor& executor) {
+        return FrameStream(*this, executor);
+    }
 
-            // Assicura che non siano zero o negativi
-            if (min <= 0) {
-                min = 1.0; // Minimo 1 microsecondo
-            }
+    InlineFrameExecutor& GenICamCamera::inlineFrameExecutor() {
+        static InlineFrameExecutor executor;
+        return executor;
+    }
 
-        }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            // In caso di errore GenApi, usa valori di default
-            min = 10.0;
-            max = 10000000.0;
+    void GenICamCamera::setFrameQueueMode(FrameQueueMode mode, size_t capacity) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-            // Log per debug
-            std::cerr << "Error getting exposure range: " << e.GetDescription() << std::endl;
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile cambiare la modalità pull durante l'acquisizione");
         }
-        catch (...) {
-            // Fallback finale
-            min = 10.0;
-            max = 10000000.0;
+        if (capacity == 0) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "La capacità del ring deve essere > 0");
         }
+
+        m_frameQueueMode = mode;
+        m_frameQueueCapacity = capacity;
     }
 
-    bool GenICamCamera::isExposureTimeAvailable() const {
-        try {
-            // Prima verifica se siamo connessi
-            if (!isConnected() || !m_pNodeMap) {
-                return false;
-            }
+    FrameQueueMode GenICamCamera::getFrameQueueMode() const {
+        return m_frameQueueMode.load();
+    }
 
-            // Lista dei possibili nomi ExposureTime secondo SFNC
-            const std::vector<std::string> exposureNames = {
-                "ExposureTime",       // SFNC 2.x standard
-                "ExposureTimeAbs",    // SFNC 1.x legacy
-                "ExposureTimeRaw"     // Raw value
-            };
+    bool GenICamCamera::waitForFrame(AcquiredFrame& frame, uint32_t timeoutMs) {
+        // FIFO: il frame più vecchio, senza lock se è già disponibile
+        if (popPulledFrame(frame)) {
+            return true;
+        }
 
-            // Verifica ogni possibile nome
-            for (const auto& name : exposureNames) {
-                try {
-                    GenApi::CNodePtr node = m_pNodeMap->_GetNode(name.c_str());
+        std::unique_lock<std::mutex> lock(m_frameQueueMutex);
+        if (!m_frameQueueOpen) {
+            return false;   // Accesso pull disabilitato o acquisizione ferma
+        }
 
-                    if (node.IsValid() &&
-                        GenApi::IsImplemented(node) &&
-                        GenApi::IsAvailable(node)) {
+        AcquiredFrame pulled;
+        bool taken = false;
+        ++m_frameWaiters;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_frameAvailable.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+            [&] { return (taken = popPulledFrame(pulled)) || !m_frameQueueOpen; });
+        --m_frameWaiters;
 
-                        // Verifica che sia almeno leggibile
-                        if (GenApi::IsReadable(node)) {
-                            // Verifica il tipo di nodo
-                            GenApi::EInterfaceType nodeType = node->GetPrincipalInterfaceType();
+        if (!taken) {
+            return false;
+        }
+        frame = std::move(pulled);
+        return true;
+    }
 
-                            // ExposureTime può essere Float o Integer
-                            if (nodeType == GenApi::intfIFloat ||
-                                nodeType == GenApi::intfIInteger) {
-                                return true;
-                            }
-                        }
-                    }
-                }
-                catch (...) {
-                    // Continua con il prossimo nome
-                    continue;
-                }
-            }
+    bool GenICamCamera::tryGetLatestFrame(AcquiredFrame& frame) {
+        // Scarta i frame più vecchi: chi chiede l'ultimo frame non li leggerà più
+        AcquiredFrame latest;
+        AcquiredFrame pulled;
+        bool found = false;
+        while (popPulledFrame(pulled)) {
+            latest = std::move(pulled);
+            pulled = AcquiredFrame();
+            found = true;
+        }
 
-            // Se arriviamo qui, verifica anche se c'è ExposureMode
-            // Alcune camere potrebbero richiedere ExposureMode = Timed
-            if (isParameterAvailable("ExposureMode")) {
-                try {
-                    ExposureMode mode = getExposureMode();
+        if (!found) {
+            return false;
+        }
+        frame = std::move(latest);
+        return true;
+    }
 
-                    // Se ExposureMode esiste ma è Off, ExposureTime potrebbe non essere disponibile
-                    if (mode == ExposureMode::Off) {
-                        return false;
-                    }
+    // === Backpressure verso i worker di conversione ===
 
-                    // Se ExposureMode != Off, riprova la ricerca con modalità specifica
-                    if (mode == ExposureMode::Timed) {
-                        // Alcune camere usano nomi specifici per modalità
-                        try {
-                            GenApi::CNodePtr node = m_pNodeMap->_GetNode("ExposureTimeTimed");
-                            if (node.IsValid() &&
-                                GenApi::IsImplemented(node) &&
-                                GenApi::IsAvailable(node) &&
-                                GenApi::IsReadable(node)) {
-                                return true;
-                            }
-                        }
-                        catch (...) {}
-                    }
-                }
-                catch (...) {}
-            }
+    bool GenICamCamera::enqueueGrabbedFrame(GrabbedFrame& frame) {
+        bool queued = false;
 
-            // Verifica finale: prova a leggere il valore
-            // Questo è il test definitivo
-            try {
-                double testValue = getExposureTime();
-                // Se non lancia eccezione, è disponibile
-                return true;
+        switch (m_pipelineConfig.backpressure) {
+        case BackpressurePolicy::Block:
+            // Il buffer resta al grab finché si libera uno slot: la perdita, se c'è,
+            // avviene nel producer (underrun) e non sull'host
+            while (!queued && !m_stopAcquisition) {
+                queued = m_conversionChannel->tryPushFor(frame, std::chrono::milliseconds(5));
             }
-            catch (...) {
-                // Se getExposureTime() fallisce, non è disponibile
+            break;
+
+        case BackpressurePolicy::DropOldest:
+            while (!(queued = m_conversionChannel->tryPush(frame)) && !m_stopAcquisition) {
+                GrabbedFrame oldest;
+                if (!m_conversionChannel->tryPop(oldest)) {
+                    continue;   // Un worker ha appena liberato uno slot
+                }
+                discardQueuedFrame(oldest);
             }
+            break;
 
-            return false;
+        case BackpressurePolicy::KeepLatest: {
+            GrabbedFrame stale;
+            while (m_conversionChannel->tryPop(stale)) {
+                discardQueuedFrame(stale);
+            }
+            queued = m_conversionChannel->tryPush(frame);
+            break;
+        }
 
+        case BackpressurePolicy::DropNewest:
+        default:
+            queued = m_conversionChannel->tryPush(frame);
+            break;
         }
-        catch (...) {
-            return false;
+
+        if (queued) {
+            const uint64_t depth = m_conversionChannel->sizeApprox();
+            if (depth > m_pipelineHighWaterMark.load(std::memory_order_relaxed)) {
+                m_pipelineHighWaterMark.store(depth, std::memory_order_relaxed);
+            }
         }
+
+        return queued;
     }
 
-    // === Metodo helper aggiuntivo per debug ===
-    std::string GenICamCamera::getExposureInfo() const {
-        std::stringstream info;
+    void GenICamCamera::discardQueuedFrame(const GrabbedFrame& frame) {
+        requeueBuffer(frame.hBuffer);
+        ++m_pipelineDroppedFrames;
 
-        info << "=== Exposure Information (SFNC) ===" << std::endl;
+        std::lock_guard<std::mutex> lock(m_skippedSequencesMutex);
+        m_skippedSequences.insert(frame.sequence);
+        m_skippedSequenceCount.store(m_skippedSequences.size(), std::memory_order_release);
+    }
 
-        // Disponibilità
-        info << "ExposureTime Available: " << (isExposureTimeAvailable() ? "Yes" : "No") << std::endl;
+    bool GenICamCamera::consumeSkippedSequence(uint64_t sequence) {
+        // Percorso comune senza lock: nessun frame scartato in attesa
+        if (m_skippedSequenceCount.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
 
-        if (isExposureTimeAvailable()) {
-            try {
-                // Valore corrente
-                double current = getExposureTime();
-                info << "Current ExposureTime: " << current << " µs" << std::endl;
+        std::lock_guard<std::mutex> lock(m_skippedSequencesMutex);
+        if (m_skippedSequences.erase(sequence) == 0) {
+            return false;
+        }
+        m_skippedSequenceCount.store(m_skippedSequences.size(), std::memory_order_release);
+        return true;
+    }
 
-                // Range
-                double min, max;
-                getExposureTimeRange(min, max);
-                info << "ExposureTime Range: [" << min << " - " << max << "] µs" << std::endl;
+    void GenICamCamera::conversionThreadFunction(size_t workerIndex) {
+        applyThreadConfig(AcquisitionThreadRole::Conversion, workerIndex);
 
-                // Incremento se disponibile
-                try {
-                    const std::vector<std::string> exposureNames = {
-                        "ExposureTime", "ExposureTimeAbs", "ExposureTimeRaw"
-                    };
+        GrabbedFrame grabbed;
 
-                    for (const auto& name : exposureNames) {
-                        try {
-                            GenApi::CFloatPtr pExposure = getFloatNode(name);
-                            if (pExposure.IsValid() && pExposure->GetIncMode() != GenApi::noIncrement) {
-                                info << "ExposureTime Increment: " << pExposure->GetInc() << " µs" << std::endl;
-                                break;
-                            }
-                        }
-                        catch (...) {}
-                    }
-                }
-                catch (...) {}
+        while (m_conversionChannel->pop(grabbed)) {
+            ConvertedFrame converted = convertGrabbedFrame(grabbed);
 
-                // Access mode
-                info << "Access Mode: ";
-                bool readable = false, writable = false;
+            // Anche i frame non convertiti proseguono: la consegna non deve attendere
+            // all'infinito una sequenza mancante
+            m_deliveryChannel->push(converted);
+        }
+    }
 
-                const std::vector<std::string> exposureNames = {
-                    "ExposureTime", "ExposureTimeAbs", "ExposureTimeRaw"
-                };
+    void GenICamCamera::deliveryThreadFunction() {
+        applyThreadConfig(AcquisitionThreadRole::Delivery, 0);
 
-                for (const auto& name : exposureNames) {
-                    if (isParameterReadable(name)) readable = true;
-                    if (isParameterWritable(name)) writable = true;
-                    if (readable || writable) break;
-                }
+        // I worker completano i frame fuori ordine: si riordina per sequenza di grab,
+        // che coincide con l'ordine dei frameID ricevuti dal producer
+        std::map<uint64_t, ConvertedFrame> pending;
+        uint64_t nextSequence = 0;
+        ConvertedFrame converted;
 
-                if (readable) info << "R";
-                if (writable) info << "W";
-                info << std::endl;
+        while (m_deliveryChannel->pop(converted)) {
+            const uint64_t sequence = converted.sequence;
+            pending.emplace(sequence, std::move(converted));
 
-            }
-            catch (const std::exception& e) {
-                info << "Error reading exposure info: " << e.what() << std::endl;
+            for (;;) {
+                if (!pending.empty() && pending.begin()->first == nextSequence) {
+                    deliverFrame(pending.begin()->second);
+                    pending.erase(pending.begin());
+                    ++nextSequence;
+                }
+                else if (consumeSkippedSequence(nextSequence)) {
+                    ++nextSequence;     // Scartato dalla politica di backpressure
+                }
+                else {
+                    break;
+                }
             }
         }
 
-        // ExposureMode info
-        if (isParameterAvailable("ExposureMode")) {
-            info << "\nExposureMode: ";
-            try {
-                switch (getExposureMode()) {
-                case ExposureMode::Off: info << "Off"; break;
-                case ExposureMode::Timed: info << "Timed"; break;
-                case ExposureMode::TriggerWidth: info << "TriggerWidth"; break;
-                case ExposureMode::TriggerControlled: info << "TriggerControlled"; break;
-                }
-                info << std::endl;
+        // Canale chiuso: consegna quanto rimasto, sempre in ordine
+        for (auto& entry : pending) {
+            deliverFrame(entry.second);
+        }
+    }
 
-                // Modalità disponibili
-                auto modes = getAvailableExposureModes();
-                if (!modes.empty()) {
-                    info << "Available modes: ";
-                    for (const auto& mode : modes) {
-                        switch (mode) {
-                        case ExposureMode::Off: info << "Off "; break;
-                        case ExposureMode::Timed: info << "Timed "; break;
-                        case ExposureMode::TriggerWidth: info << "TriggerWidth "; break;
-                        case ExposureMode::TriggerControlled: info << "TriggerControlled "; break;
-                        }
-                    }
-                    info << std::endl;
-                }
-            }
-            catch (...) {}
+    void GenICamCamera::startPipeline() {
+        // Le sequenze di grab ripartono da zero a ogni avvio della pipeline; le
+        // statistiche invece sono azzerate solo da startAcquisition e sopravvivono
+        // alle riconfigurazioni
+        {
+            std::lock_guard<std::mutex> lock(m_skippedSequencesMutex);
+            m_skippedSequences.clear();
+            m_skippedSequenceCount = 0;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_appliedThreadConfigsMutex);
+            m_appliedThreadConfigs.clear();
         }
 
-        // ExposureAuto info
-        if (isExposureAutoAvailable()) {
-            info << "\nExposureAuto: ";
-            try {
-                switch (getExposureAuto()) {
-                case ExposureAuto::Off: info << "Off"; break;
-                case ExposureAuto::Once: info << "Once"; break;
-                case ExposureAuto::Continuous: info << "Continuous"; break;
-                }
-                info << std::endl;
-            }
-            catch (...) {}
+        if (m_pipelineConfig.conversionWorkers == 0) {
+            return;     // Conversione e consegna nel thread di grab
         }
 
-        return info.str();
+        m_conversionChannel = std::make_unique<PipelineChannel<GrabbedFrame>>(m_pipelineConfig.queueDepth);
+        m_deliveryChannel = std::make_unique<PipelineChannel<ConvertedFrame>>(m_pipelineConfig.queueDepth);
+
+        m_deliveryThread = std::thread(&GenICamCamera::deliveryThreadFunction, this);
+        for (size_t i = 0; i < m_pipelineConfig.conversionWorkers; ++i) {
+            m_conversionThreads.emplace_back(&GenICamCamera::conversionThreadFunction, this, i);
+        }
     }
 
+    void GenICamCamera::stopPipeline() {
+        // Da chiamare dopo la terminazione del thread di grab: i worker svuotano
+        // la coda di conversione, poi il thread di consegna svuota la propria
+        if (m_conversionChannel) {
+            m_conversionChannel->close(m_conversionThreads.size());
+        }
+        for (auto& worker : m_conversionThreads) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        m_conversionThreads.clear();
 
-    std::vector<ExposureMode> GenICamCamera::getAvailableExposureModes() const {
-        std::vector<ExposureMode> modes;
+        if (m_deliveryChannel) {
+            m_deliveryChannel->close(1);
+        }
+        if (m_deliveryThread.joinable()) {
+            m_deliveryThread.join();
+        }
 
-        try {
-            // Prima verifica se siamo connessi
-            if (!isConnected() || !m_pNodeMap) {
-                return modes; // Ritorna vector vuoto
-            }
+        m_conversionChannel.reset();
+        m_deliveryChannel.reset();
+    }
 
-            // Verifica se ExposureMode esiste
-            if (!isParameterAvailable("ExposureMode")) {
-                // Se ExposureMode non esiste, assumiamo che la camera supporti
-                // solo la modalità Timed (default SFNC)
-                modes.push_back(ExposureMode::Timed);
-                return modes;
-            }
+    void GenICamCamera::setPipelineConfig(const AcquisitionPipelineConfig& config) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-            // Ottieni il nodo ExposureMode
-            GenApi::CEnumerationPtr pExposureMode = getEnumerationNode("ExposureMode");
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare la pipeline durante l'acquisizione");
+        }
+        if (config.conversionWorkers > 0 && config.queueDepth == 0) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "La profondità delle code deve essere > 0");
+        }
 
-            if (!pExposureMode.IsValid()) {
-                // Fallback a modalità default
-                modes.push_back(ExposureMode::Timed);
-                return modes;
-            }
+        m_pipelineConfig = config;
+    }
 
-            // Ottieni tutte le entries disponibili
-            GenApi::NodeList_t entries;
-            pExposureMode->GetEntries(entries);
+    AcquisitionPipelineConfig GenICamCamera::getPipelineConfig() const {
+        return m_pipelineConfig;
+    }
 
-            // Itera su tutte le entries
-            for (auto& entry : entries) {
-                // Verifica che l'entry sia disponibile e implementata
-                if (GenApi::IsAvailable(entry) && GenApi::IsImplemented(entry)) {
-                    // Ottieni il nome simbolico dell'entry
-                    GenApi::CEnumEntryPtr pEntry(entry);
-                    if (pEntry.IsValid()) {
-                        std::string entryName = pEntry->GetSymbolic().c_str();
+    uint64_t GenICamCamera::getPipelineDroppedFrames() const {
+        return m_pipelineDroppedFrames.load();
+    }
 
-                        // Converti il nome in enum ExposureMode
-                        if (entryName == "Off") {
-                            modes.push_back(ExposureMode::Off);
-                        }
-                        else if (entryName == "Timed") {
-                            modes.push_back(ExposureMode::Timed);
-                        }
-                        else if (entryName == "TriggerWidth") {
-                            modes.push_back(ExposureMode::TriggerWidth);
-                        }
-                        else if (entryName == "TriggerControlled") {
-                            modes.push_back(ExposureMode::TriggerControlled);
-                        }
-                        // Else: modalità non standard, ignora
-                    }
-                }
-            }
+    // === Scheduling dei thread di acquisizione ===
 
-            // Se non sono state trovate modalità valide, aggiungi default
-            if (modes.empty()) {
-                // Questo può succedere se il nodo esiste ma le entries non sono standard
-                modes.push_back(ExposureMode::Timed);
+    void GenICamCamera::setThreadConfig(AcquisitionThreadRole role, const ThreadConfig& config) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-                // Log warning per debug
-                std::cerr << "Warning: ExposureMode node exists but no standard modes found" << std::endl;
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare la configurazione dei thread durante l'acquisizione");
+        }
+        if (config.policy != ThreadSchedulingPolicy::Default && config.priority <= 0) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "La priorità real-time deve essere > 0");
+        }
+        for (int cpu : config.cpuAffinity) {
+            if (cpu < 0 || cpu >= ThreadUtils::getCpuCount()) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "CPU non valida nell'affinità: " + std::to_string(cpu));
             }
+        }
+
+        m_threadConfigs[static_cast<size_t>(role)] = config;
+    }
+
+    ThreadConfig GenICamCamera::getThreadConfig(AcquisitionThreadRole role) const {
+        return m_threadConfigs[static_cast<size_t>(role)];
+    }
+
+    void GenICamCamera::setGrabWaitConfig(const GrabWaitConfig& config) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare la modalità di attesa durante l'acquisizione");
+        }
+        if (config.spinDuration.count() < 0) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "La durata dello spin deve essere >= 0");
         }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            // In caso di errore GenApi
-            std::cerr << "Error getting available exposure modes: " << e.GetDescription() << std::endl;
 
-            // Ritorna almeno la modalità di default
-            if (modes.empty()) {
-                modes.push_back(ExposureMode::Timed);
-            }
+        m_grabWaitConfig = config;
+    }
+
+    GrabWaitConfig GenICamCamera::getGrabWaitConfig() const {
+        return m_grabWaitConfig;
+    }
+
+    AcquisitionLatencyReport GenICamCamera::getLatencyReport() const {
+        AcquisitionLatencyReport report;
+        report.waitMode = m_grabWaitConfig.mode;
+        report.grabToDelivery = m_grabToDeliveryLatency.snapshot();
+        report.frameInterval = m_frameIntervalLatency.snapshot();
+        return report;
+    }
+
+    // === Correlazione clock device/host ===
+
+    void GenICamCamera::setClockCorrelationConfig(const ClockCorrelationConfig& config) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
+
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare la correlazione dei clock durante l'acquisizione");
         }
-        catch (...) {
-            // Gestione errori generici
-            if (modes.empty()) {
-                modes.push_back(ExposureMode::Timed);
-            }
+        if (config.period.count() <= 0) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Il periodo di correlazione deve essere > 0");
         }
 
-        // Rimuovi eventuali duplicati (non dovrebbero essercene, ma per sicurezza)
-        std::sort(modes.begin(), modes.end());
-        modes.erase(std::unique(modes.begin(), modes.end()), modes.end());
+        m_clockCorrelationConfig = config;
+        m_clockCorrelator.setWindowSize(config.windowSize);
+    }
 
-        return modes;
+    ClockCorrelationConfig GenICamCamera::getClockCorrelationConfig() const {
+        return m_clockCorrelationConfig;
     }
 
-    // === Metodo helper aggiuntivo per verificare se ExposureMode è disponibile ===
-    bool GenICamCamera::isExposureModeAvailable() const {
-        try {
-            if (!isConnected() || !m_pNodeMap) {
-                return false;
-            }
+    ClockMapping GenICamCamera::getClockMapping() const {
+        return *m_clockCorrelator.mapping();
+    }
 
-            GenApi::CNodePtr node = m_pNodeMap->_GetNode("ExposureMode");
-            return node.IsValid() &&
-                GenApi::IsImplemented(node) &&
-                GenApi::IsAvailable(node);
+    void GenICamCamera::startClockCorrelation() {
+        // Una mappatura di una sessione precedente non vale per la nuova
+        m_clockCorrelator.reset();
 
+        if (!m_clockCorrelationConfig.enabled) {
+            return;
         }
-        catch (...) {
-            return false;
+
+        {
+            std::lock_guard<std::mutex> lock(m_clockCorrelationMutex);
+            m_stopClockCorrelation = false;
         }
+        m_clockCorrelationThread = std::thread(&GenICamCamera::clockCorrelationThreadFunction, this);
     }
 
-    // === Metodo helper per convertire ExposureMode in stringa ===
-    std::string GenICamCamera::exposureModeToString(ExposureMode mode) const {
-        switch (mode) {
-        case ExposureMode::Off:
-            return "Off";
-        case ExposureMode::Timed:
-            return "Timed";
-        case ExposureMode::TriggerWidth:
-            return "TriggerWidth";
-        case ExposureMode::TriggerControlled:
-            return "TriggerControlled";
-        default:
-            return "Unknown";
+    void GenICamCamera::stopClockCorrelation() {
+        {
+            std::lock_guard<std::mutex> lock(m_clockCorrelationMutex);
+            m_stopClockCorrelation = true;
+        }
+        m_clockCorrelationWake.notify_all();
+
+        if (m_clockCorrelationThread.joinable()) {
+            m_clockCorrelationThread.join();
         }
     }
 
-    // === Metodo per ottenere la modalità corrente con gestione errori migliorata ===
-    std::vector<ExposureMode> GenICamCamera::getAvailableExposureModesFiltered() const {
-        std::vector<ExposureMode> allModes = getAvailableExposureModes();
-        std::vector<ExposureMode> filteredModes;
+    void GenICamCamera::clockCorrelationThreadFunction() {
+        GenApi::CCommandPtr pLatch;
+        GenApi::CIntegerPtr pLatchValue;
 
-        // Filtra solo le modalità effettivamente utilizzabili
-        for (const auto& mode : allModes) {
-            try {
-                // Salva modalità corrente
-                ExposureMode currentMode = getExposureMode();
+        try {
+            if (isParameterAvailable("TimestampLatch") && isParameterAvailable("TimestampLatchValue")) {
+                pLatch = getCommandNode("TimestampLatch");
+                pLatchValue = getIntegerNode("TimestampLatchValue");
+            }
+            else if (isParameterAvailable("GevTimestampControlLatch") && isParameterAvailable("GevTimestampValue")) {
+                pLatch = getCommandNode("GevTimestampControlLatch");
+                pLatchValue = getIntegerNode("GevTimestampValue");
+            }
+        }
+        catch (...) {
+            // Nodi non disponibili
+        }
 
-                // Prova a impostare la modalità
-                const_cast<GenICamCamera*>(this)->setExposureMode(mode);
+        if (!pLatch.IsValid() || !pLatchValue.IsValid()) {
+            std::cout << "Correlazione clock non disponibile: latch del timestamp non supportato" << std::endl;
+            return;
+        }
 
-                // Se non lancia eccezione, è utilizzabile
-                filteredModes.push_back(mode);
+        auto interval = CLOCK_FIRST_LATCH_INTERVAL;
+        std::unique_lock<std::mutex> lock(m_clockCorrelationMutex);
 
-                // Ripristina modalità originale
-                const_cast<GenICamCamera*>(this)->setExposureMode(currentMode);
+        while (!m_stopClockCorrelation) {
+            lock.unlock();
+
+            try {
+                // L'istante del latch è stimato con il punto medio della richiesta
+                const auto before = std::chrono::steady_clock::now();
+                pLatch->Execute();
+                const auto after = std::chrono::steady_clock::now();
+                const int64_t ticks = pLatchValue->GetValue(false, true);
 
+                // Richieste lente (ritrasmissioni, carico del link) darebbero campioni imprecisi
+                if (after - before <= CLOCK_LATCH_MAX_DURATION && ticks > 0) {
+                    m_clockCorrelator.addSample(static_cast<uint64_t>(ticks), before + (after - before) / 2,
+                        std::chrono::duration_cast<std::chrono::nanoseconds>((after - before) / 2));
+                }
             }
-            catch (...) {
-                // Modalità non utilizzabile, ignora
+            catch (const GENICAM_NAMESPACE::GenericException& e) {
+                std::cerr << "Errore latch timestamp: " << e.GetDescription() << std::endl;
             }
+
+            lock.lock();
+            m_clockCorrelationWake.wait_for(lock, interval, [this] { return m_stopClockCorrelation; });
+            interval = m_clockCorrelationConfig.period;
         }
+    }
 
-        return filteredModes;
+    std::chrono::microseconds GenICamCamera::getLastStopDuration() const {
+        return std::chrono::microseconds(m_lastStopDurationUs.load());
     }
 
-    // Modifica i metodi getGain() e setGain() in GenICamCamera.cpp
+    std::vector<AppliedThreadConfig> GenICamCamera::getAppliedThreadConfigs() const {
+        std::lock_guard<std::mutex> lock(m_appliedThreadConfigsMutex);
+        return m_appliedThreadConfigs;
+    }
 
-    bool GenICamCamera::setupGainSelector() const {
-        try {
-            GenApi::CEnumerationPtr pGainSelector = getEnumerationNode("GainSelector");
-            if (pGainSelector.IsValid() && GenApi::IsWritable(pGainSelector)) {
-                // Prova in ordine di preferenza
-                const std::vector<std::string> preferredSelectors = {
-                    "All",          // Gain globale
-                    "AnalogAll",    // Gain analogico globale
-                    "DigitalAll",   // Gain digitale globale
-                    "Tap1",         // Primo tap
-                    "Red",          // Per camere a colori
-                    "Sensor"        // Gain del sensore
-                };
+    void GenICamCamera::applyThreadConfig(AcquisitionThreadRole role, size_t index) {
+        ThreadConfig config = m_threadConfigs[static_cast<size_t>(role)];
 
-                GenApi::NodeList_t entries;
-                pGainSelector->GetEntries(entries);
+        // Senza affinità esplicita i thread del percorso dei frame restano sulle CPU
+        // del nodo NUMA dei buffer
+        const bool numaAffinity = config.cpuAffinity.empty() && !m_numaCpus.empty() &&
+            role != AcquisitionThreadRole::FeatureEvents;
+        if (numaAffinity) {
+            config.cpuAffinity = m_numaCpus;
+        }
 
-                // Prova i selettori preferiti
-                for (const auto& selector : preferredSelectors) {
-                    for (auto& entry : entries) {
-                        if (GenApi::IsAvailable(entry) &&
-                            entry->GetName().c_str() == selector) {
-                            *pGainSelector = selector.c_str();
-                            return true;
-                        }
-                    }
-                }
+        // Nessuna configurazione: il thread resta com'è creato da std::thread
+        if (config.cpuAffinity.empty() && config.policy == ThreadSchedulingPolicy::Default && config.name.empty()) {
+            return;
+        }
 
-                // Se nessuno dei preferiti è disponibile, usa il primo disponibile
-                for (auto& entry : entries) {
-                    if (GenApi::IsAvailable(entry)) {
-                        *pGainSelector = entry->GetName().c_str();
-                        return true;
-                    }
-                }
+        // I worker di conversione si distribuiscono un core ciascuno (l'affinità NUMA
+        // resta sull'intero nodo)
+        if (role == AcquisitionThreadRole::Conversion) {
+            if (!config.cpuAffinity.empty() && !numaAffinity) {
+                config.cpuAffinity = { config.cpuAffinity[index % config.cpuAffinity.size()] };
+            }
+            if (!config.name.empty()) {
+                config.name += "-" + std::to_string(index);
             }
         }
-        catch (...) {
-            // GainSelector non disponibile
+
+        AppliedThreadConfig applied;
+        applied.role = role;
+        applied.index = index;
+        applied.result = ThreadUtils::applyToCurrentThread(config);
+
+        for (const auto& error : applied.result.errors) {
+            std::cerr << "Configurazione thread '" << config.name << "': " << error << std::endl;
         }
-        return false;
+
+        std::lock_guard<std::mutex> lock(m_appliedThreadConfigsMutex);
+        m_appliedThreadConfigs.push_back(std::move(applied));
     }
 
-    // Metodo getGain aggiornato
-    double GenICamCamera::getGain() const {
-        try {
-            // Check cache first
-            auto it = m_parameterCache.find("Gain");
-            if (it != m_parameterCache.end()) {
-                auto now = std::chrono::steady_clock::now();
-                if (now - it->second.second < CACHE_TIMEOUT) {
-                    return std::stod(it->second.first);
-                }
-            }
+    // === Frame in prestito (FrameDeliveryMode::Loan) ===
 
-            // Setup GainSelector se necessario
-            setupGainSelector();
+    void GenICamCamera::LoanedBufferRelease::operator()(uint8_t* p) const {
+        std::lock_guard<std::mutex> lock(session->mutex);
 
-            // Lista di possibili nomi di gain in ordine di priorità
-            const std::vector<std::string> gainNames = {
-                "Gain",           // Nome standard SFNC
-                "GainRaw",        // Valore raw (integer)
-                "GainAbs",        // Valore assoluto in dB (vecchie camere)
-                "AnalogGain",     // Gain analogico
-                "DigitalGain",    // Gain digitale
-                "Brightness"      // Alcune camere USB usano questo
-            };
+        // Riaccoda solo se lo stream che ha prodotto il buffer è ancora aperto
+        if (session->streamOpen && hBuffer) {
+            session->camera->requeueBuffer(hBuffer);
+        }
 
-            for (const auto& gainName : gainNames) {
-                try {
-                    // Prima prova come float
-                    GenApi::CFloatPtr pGain = getFloatNode(gainName);
-                    if (pGain.IsValid() && GenApi::IsReadable(pGain)) {
-                        double value = pGain->GetValue();
+        if (session->outstanding > 0) {
+            --session->outstanding;
+        }
+        session->returned.notify_all();
+    }
 
-                        // Cache il valore
-                        m_parameterCache["Gain"] = { std::to_string(value),
-                                                   std::chrono::steady_clock::now() };
-                        return value;
-                    }
-                }
-                catch (...) {
-                    // Se fallisce, prova come integer
-                    try {
-                        GenApi::CIntegerPtr pGainInt = getIntegerNode(gainName);
-                        if (pGainInt.IsValid() && GenApi::IsReadable(pGainInt)) {
-                            double value = static_cast<double>(pGainInt->GetValue());
+    void GenICamCamera::openLoanSession() {
+        auto session = std::make_shared<LoanSession>();
+        session->dsHandle = m_dsHandle;
+        session->camera = this;
+        session->streamOpen = true;
+        m_loanSession.store(std::move(session));
+    }
 
-                            // Per GainRaw, potrebbe servire conversione
-                            if (gainName == "GainRaw") {
-                                try {
-                                    // Cerca un fattore di conversione
-                                    GenApi::CFloatPtr pGainFactor = getFloatNode("GainFactor");
-                                    if (pGainFactor.IsValid() && GenApi::IsReadable(pGainFactor)) {
-                                        value *= pGainFactor->GetValue();
-                                    }
-                                }
-                                catch (...) {
-                                    // Prova conversione da raw a dB
-                                    // Formula tipica: gain_dB = 20 * log10(raw_value / reference)
-                                    // Ma senza reference, restituiamo il valore raw
-                                }
-                            }
+    bool GenICamCamera::closeLoanSession() {
+        std::shared_ptr<LoanSession> session = m_loanSession.exchange(nullptr);
+        if (!session) {
+            return true;
+        }
 
-                            m_parameterCache["Gain"] = { std::to_string(value),
-                                                       std::chrono::steady_clock::now() };
-                            return value;
-                        }
-                    }
-                    catch (...) {
-                        continue;
-                    }
-                }
+        std::unique_lock<std::mutex> lock(session->mutex);
+
+        // Attendi che i listener restituiscano i frame ancora in prestito
+        bool allReturned = session->returned.wait_for(lock, LOAN_RETURN_TIMEOUT,
+            [&session] { return session->outstanding == 0; });
+
+        session->streamOpen = false;
+
+        if (!allReturned) {
+            std::cerr << "WARNING: " << session->outstanding
+                << " frame ancora in prestito alla chiusura dello stream" << std::endl;
+
+            // La memoria allocata manualmente resta valida finché esistono frame in prestito.
+            // In modalità Loan allocateBuffers non usa mai memoria del producer, che verrebbe
+            // rilasciata con la revoca dei buffer
+            for (auto& memory : m_alignedBuffers) {
+                session->retainedMemory.push_back(std::move(memory));
             }
+            m_alignedBuffers.clear();
 
-            // Se arriviamo qui, nessun gain trovato
-            THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "Parametro Gain non disponibile o non leggibile");
+            // I blocchi del pool non possono tornare disponibili per la sessione successiva
+            for (void* block : m_pooledBuffers) {
+                session->retainedPoolMemory.push_back(m_bufferPool.detach(block));
+            }
+            m_pooledBuffers.clear();
 
+            // Le regioni esterne tornano al chiamante solo con l'ultimo frame in prestito
+            session->retainedExternalBuffers = m_externalBufferLeases;
         }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore lettura gain: ") + e.GetDescription());
-        }
+        return allReturned;
     }
 
-    // Metodo setGain aggiornato
-    void GenICamCamera::setGain(double gain) {
-        try {
-            // Setup GainSelector se necessario
-            setupGainSelector();
+    void GenICamCamera::setFrameDeliveryMode(FrameDeliveryMode mode) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-            // Lista di possibili nomi
-            const std::vector<std::string> gainNames = {
-                "Gain", "GainRaw", "GainAbs", "AnalogGain", "DigitalGain", "Brightness"
-            };
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile cambiare modalità di consegna durante l'acquisizione");
+        }
 
-            bool gainSet = false;
-            std::string lastError;
+        m_deliveryMode = mode;
+    }
 
-            for (const auto& gainName : gainNames) {
-                try {
-                    // Prova come float
-                    GenApi::CFloatPtr pGain = getFloatNode(gainName);
-                    if (pGain.IsValid() && GenApi::IsWritable(pGain)) {
-                        double min = pGain->GetMin();
-                        double max = pGain->GetMax();
+    FrameDeliveryMode GenICamCamera::getFrameDeliveryMode() const {
+        return m_deliveryMode.load();
+    }
 
-                        // Verifica se ha incremento
-                        double inc = 0.0;
-                        try {
-                            if (pGain->GetIncMode() != GenApi::noIncrement) {
-                                inc = pGain->GetInc();
-                            }
-                        }
-                        catch (...) {
-                            inc = 0.0;
-                        }
+    size_t GenICamCamera::getLoanedFrameCount() const {
+        std::shared_ptr<LoanSession> session = m_loanSession.load();
+        if (!session) {
+            return 0;
+        }
 
-                        // Clamp al range valido
-                        if (gain < min) gain = min;
-                        if (gain > max) gain = max;
+        std::lock_guard<std::mutex> lock(session->mutex);
+        return session->outstanding;
+    }
 
-                        // Arrotonda all'incremento se specificato
-                        if (inc > 0) {
-                            gain = round(gain / inc) * inc;
-                        }
+    // === Parametri Camera - Implementazione Uniforme GenApi ===
+    GenApi::INodeMap* GenICamCamera::getNodeMap() const {
+       std::shared_lock<std::shared_mutex> lock(m_connectionMutex);
 
-                        pGain->SetValue(gain);
-                        gainSet = true;
-                        notifyParameterChanged("Gain", std::to_string(gain));
-                        break;
-                    }
-                }
-                catch (const std::exception& e) {
-                    lastError = e.what();
+       if (!isConnected()) {
+          THROW_GENICAM_ERROR(ErrorType::ConnectionError,
+             "Camera non connessa - NodeMap non disponibile");
+       }
 
-                    // Prova come integer
-                    try {
-                        GenApi::CIntegerPtr pGainInt = getIntegerNode(gainName);
-                        if (pGainInt.IsValid() && GenApi::IsWritable(pGainInt)) {
-                            int64_t min = pGainInt->GetMin();
-                            int64_t max = pGainInt->GetMax();
+       if (!m_nodeMapValid || !m_pNodeMap) {
+          THROW_GENICAM_ERROR(ErrorType::GenApiError,
+             "NodeMap non valido o non inizializzato");
+       }
 
-                            // Verifica se ha incremento
-                            int64_t inc = 1;
-                            try {
-                                if (pGainInt->GetIncMode() != GenApi::noIncrement) {
-                                    inc = pGainInt->GetInc();
-                                }
-                            }
-                            catch (...) {
-                                inc = 1;
-                            }
+       // Se CNodeMapRef ha un operatore di conversione o un metodo specifico
+      // Controlla la documentazione GenApi per il metodo corretto
 
-                            // Converti a integer
-                            int64_t intGain = static_cast<int64_t>(gain);
+      // Possibilità 1: Operatore di conversione implicito
+       //GenApi::INodeMap* pNodeMap = m_pNodeMap.get();
 
-                            // Per GainRaw, potrebbe servire conversione inversa
-                            if (gainName == "GainRaw") {
-                                try {
-                                    GenApi::CFloatPtr pGainFactor = getFloatNode("GainFactor");
-                                    if (pGainFactor.IsValid() && GenApi::IsReadable(pGainFactor)) {
-                                        double factor = pGainFactor->GetValue();
-                                        if (factor != 0) {
-                                            intGain = static_cast<int64_t>(gain / factor);
-                                        }
-                                    }
-                                }
-                                catch (...) {}
-                            }
+       // Possibilità 2: Metodo esplicito (verifica nella documentazione)
+       //GenApi::INodeMap* pNodeMap = m_pNodeMap->GetInterface();
 
-                            // Clamp e arrotonda
-                            if (intGain < min) intGain = min;
-                            if (intGain > max) intGain = max;
+       // Possibilità 3: Cast C-style (meno sicuro, usa solo se necessario)
+       GenApi::INodeMap* pNodeMap = (GenApi::INodeMap*)m_pNodeMap.get();
 
-                            // Arrotonda all'incremento
-                            if (inc > 1) {
-                                intGain = (intGain / inc) * inc;
-                            }
+       return pNodeMap;
+    }
 
-                            pGainInt->SetValue(intGain);
-                            gainSet = true;
-                            notifyParameterChanged("Gain", std::to_string(intGain));
-                            break;
-                        }
-                    }
-                    catch (const std::exception& e2) {
-                        lastError = e2.what();
-                        continue;
-                    }
-                }
-            }
+    GenApi::INodeMap* GenICamCamera::getStreamNodeMap() const {
+       std::shared_lock<std::shared_mutex> lock(m_connectionMutex);
 
-            if (!gainSet) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "Impossibile impostare il Gain. Ultimo errore: " + lastError);
-            }
+       if (!isConnected()) {
+          return nullptr;
+       }
 
-        }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore impostazione gain: ") + e.GetDescription());
-        }
-    }
+       // Per ora restituiamo nullptr poiché lo stream NodeMap 
+       // non è ancora implementato in questa versione.
+       // In futuro, se necessario, si può aggiungere:
+       // - Un membro m_pStreamNodeMap
+       // - Inizializzazione durante la connessione al DataStream
+       // - Gestione del ciclo di vita dello stream NodeMap
 
-    void GenICamCamera::notifyParameterChanged(const std::string& parameterName, const std::string& value) {
-        std::lock_guard<std::mutex> lock(m_callbackMutex);
+       return nullptr;
 
-        if (m_eventListener) {
-           // Notifica asincrona per evitare deadlock
-              try {
-                 // *****************************************************************************************
-                 // // DA RIMETTERE!!!!!!!!!!!!!!!!!!!!!!!
-                 //m_eventListener->OnParameterChanged(parameterName, value);
-              }
-              catch (...) {
-                 // Ignora eccezioni nel callback
-              }
-        }
+       // Implementazione futura potrebbe essere:
+       // return m_pStreamNodeMap ? m_pStreamNodeMap.get() : nullptr;
     }
 
-    // Continuazione di GenICamCamera.cpp
+    // Helper per ottenere nodi GenApi con gestione errori
+    GenApi::CNodePtr GenICamCamera::getNode(const std::string& nodeName) const {
+        std::shared_lock<std::shared_mutex> lock(m_parameterMutex);
 
-    // === ROI (Region of Interest) ===
+        // Valida il NodeMap prima dell'uso
+        validateNodeMap();
 
-    void GenICamCamera::setROI(const ROI& roi) {
-        if (m_isAcquiring) {
-            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
-                "Impossibile cambiare ROI durante l'acquisizione");
+        if (!m_pNodeMap) {
+            THROW_GENICAM_ERROR(ErrorType::ConnectionError,
+                "NodeMap non disponibile");
         }
 
-        try {
-            // Ottieni limiti del sensore
-            GenApi::CIntegerPtr pWidthMax = getIntegerNode("WidthMax");
-            GenApi::CIntegerPtr pHeightMax = getIntegerNode("HeightMax");
+        GenApi::CNodePtr node = m_pNodeMap->_GetNode(nodeName.c_str());
+        if (!node.IsValid()) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Nodo non trovato: " + nodeName);
+        }
 
-            int64_t maxWidth = pWidthMax->GetValue();
-            int64_t maxHeight = pHeightMax->GetValue();
+        return node;
+    }
 
-            if (roi.x + roi.width > static_cast<uint32_t>(maxWidth) ||
-                roi.y + roi.height > static_cast<uint32_t>(maxHeight)) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "ROI fuori dai limiti del sensore");
-            }
+    GenApi::CFloatPtr GenICamCamera::getFloatNode(const std::string& nodeName) const {
 
-            // Ordine importante: prima resetta offset, poi imposta dimensioni
-            GenApi::CIntegerPtr pOffsetX = getIntegerNode("OffsetX");
-            GenApi::CIntegerPtr pOffsetY = getIntegerNode("OffsetY");
-            GenApi::CIntegerPtr pWidth = getIntegerNode("Width");
-            GenApi::CIntegerPtr pHeight = getIntegerNode("Height");
+        // Valida il NodeMap prima dell'uso
+        validateNodeMap();
 
-            // Reset offset
-            if (GenApi::IsWritable(pOffsetX)) pOffsetX->SetValue(0);
-            if (GenApi::IsWritable(pOffsetY)) pOffsetY->SetValue(0);
+        GenApi::CNodePtr node = getNode(nodeName);
+        GenApi::CFloatPtr floatNode(node);
 
-            // Imposta dimensioni
-            if (GenApi::IsWritable(pWidth)) {
-                int64_t inc = pWidth->GetInc();
-                int64_t alignedWidth = (roi.width / inc) * inc;
-                pWidth->SetValue(alignedWidth);
-            }
+        if (!floatNode.IsValid()) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Il nodo " + nodeName + " non è di tipo Float");
+        }
 
-            if (GenApi::IsWritable(pHeight)) {
-                int64_t inc = pHeight->GetInc();
-                int64_t alignedHeight = (roi.height / inc) * inc;
-                pHeight->SetValue(alignedHeight);
-            }
+        return floatNode;
+    }
 
-            // Imposta offset
-            if (GenApi::IsWritable(pOffsetX)) {
-                int64_t inc = pOffsetX->GetInc();
-                int64_t alignedX = (roi.x / inc) * inc;
-                pOffsetX->SetValue(alignedX);
-            }
+    GenApi::CIntegerPtr GenICamCamera::getIntegerNode(const std::string& nodeName) const {
 
-            if (GenApi::IsWritable(pOffsetY)) {
-                int64_t inc = pOffsetY->GetInc();
-                int64_t alignedY = (roi.y / inc) * inc;
-                pOffsetY->SetValue(alignedY);
-            }
+        // Valida il NodeMap prima dell'uso
+        validateNodeMap();
 
-            std::stringstream ss;
-            ss << roi.width << "x" << roi.height << "@" << roi.x << "," << roi.y;
-            notifyParameterChanged("ROI", ss.str());
+        GenApi::CNodePtr node = getNode(nodeName);
+        GenApi::CIntegerPtr intNode(node);
 
+        if (!intNode.IsValid()) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Il nodo " + nodeName + " non è di tipo Integer");
         }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore impostazione ROI: ") + e.GetDescription());
-        }
+
+        return intNode;
     }
 
-    ROI GenICamCamera::getROI() const {
-        ROI roi;
+    GenApi::CEnumerationPtr GenICamCamera::getEnumerationNode(const std::string& nodeName) const {
 
-        try {
-            GenApi::CIntegerPtr pOffsetX = getIntegerNode("OffsetX");
-            GenApi::CIntegerPtr pOffsetY = getIntegerNode("OffsetY");
-            GenApi::CIntegerPtr pWidth = getIntegerNode("Width");
-            GenApi::CIntegerPtr pHeight = getIntegerNode("Height");
+        // Valida il NodeMap prima dell'uso
+        validateNodeMap();
 
-            roi.x = static_cast<uint32_t>(pOffsetX->GetValue());
-            roi.y = static_cast<uint32_t>(pOffsetY->GetValue());
-            roi.width = static_cast<uint32_t>(pWidth->GetValue());
-            roi.height = static_cast<uint32_t>(pHeight->GetValue());
+        GenApi::CNodePtr node = getNode(nodeName);
+        GenApi::CEnumerationPtr enumNode(node);
 
-        }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore lettura ROI: ") + e.GetDescription());
+        if (!enumNode.IsValid()) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Il nodo " + nodeName + " non è di tipo Enumeration");
         }
 
-        return roi;
+        return enumNode;
     }
 
-    void GenICamCamera::getSensorSize(uint32_t& width, uint32_t& height) const {
-        try {
-            GenApi::CIntegerPtr pWidthMax = getIntegerNode("WidthMax");
-            GenApi::CIntegerPtr pHeightMax = getIntegerNode("HeightMax");
+    GenApi::CCommandPtr GenICamCamera::getCommandNode(const std::string& nodeName) const {
 
-            width = static_cast<uint32_t>(pWidthMax->GetValue());
-            height = static_cast<uint32_t>(pHeightMax->GetValue());
+        // Valida il NodeMap prima dell'uso
+        validateNodeMap();
 
-        }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-           e.what();
-            // Prova con SensorWidth/SensorHeight
-            try {
-                GenApi::CIntegerPtr pSensorWidth = getIntegerNode("SensorWidth");
-                GenApi::CIntegerPtr pSensorHeight = getIntegerNode("SensorHeight");
+        GenApi::CNodePtr node = getNode(nodeName);
+        GenApi::CCommandPtr cmdNode(node);
 
-                width = static_cast<uint32_t>(pSensorWidth->GetValue());
-                height = static_cast<uint32_t>(pSensorHeight->GetValue());
-            }
-            catch (...) {
-                THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                    "Impossibile determinare le dimensioni del sensore");
-            }
+        if (!cmdNode.IsValid()) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Il nodo " + nodeName + " non è di tipo Command");
         }
-    }
-
-    // === Trigger Mode ===
 
-// === Gestione Trigger Standard SFNC ===
+        return cmdNode;
+    }
 
-    void GenICamCamera::setTriggerMode(TriggerMode mode) {
-        if (m_isAcquiring) {
-            THROW_GENICAM_ERROR(ErrorType::AcquisitionError, "Impossibile cambiare trigger durante l'acquisizione");
-        }
+// === Controllo dell'esposizione (SFNC 2.7 compliant) ===
 
+    void GenICamCamera::setExposureMode(ExposureMode mode) {
         try {
-            GenApi::CEnumerationPtr pTriggerMode = getEnumerationNode("TriggerMode");
+            GenApi::CEnumerationPtr pExposureMode = getEnumerationNode("ExposureMode");
 
-            if (!GenApi::IsWritable(pTriggerMode)) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError, "TriggerMode non scrivibile");
+            if (!GenApi::IsWritable(pExposureMode)) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "ExposureMode non scrivibile");
             }
 
-            *pTriggerMode = (mode == TriggerMode::On) ? "On" : "Off";
-            notifyParameterChanged("TriggerMode", (mode == TriggerMode::On) ? "On" : "Off");
+            std::string modeString;
+            switch (mode) {
+            case ExposureMode::Off:
+                modeString = "Off";
+                break;
+            case ExposureMode::Timed:
+                modeString = "Timed";
+                break;
+            case ExposureMode::TriggerWidth:
+                modeString = "TriggerWidth";
+                break;
+            case ExposureMode::TriggerControlled:
+                modeString = "TriggerControlled";
+                break;
+            default:
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "ExposureMode non valido");
+            }
+
+            *pExposureMode = modeString.c_str();
+            notifyParameterChanged("ExposureMode", modeString);
 
         }
         catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError, std::string("Errore impostazione TriggerMode: ") + e.GetDescription());
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore impostazione ExposureMode: ") + e.GetDescription());
         }
     }
 
-    TriggerMode GenICamCamera::getTriggerMode() const {
+    ExposureMode GenICamCamera::getExposureMode() const {
         try {
-            GenApi::CEnumerationPtr pTriggerMode = getEnumerationNode("TriggerMode");
-            std::string value = pTriggerMode->ToString().c_str();
+            // Verifica se ExposureMode esiste
+            if (!isParameterAvailable("ExposureMode")) {
+                // Se non esiste, assumiamo Timed mode (default SFNC)
+                return ExposureMode::Timed;
+            }
 
-            return (value == "On") ? TriggerMode::On : TriggerMode::Off;
+            GenApi::CEnumerationPtr pExposureMode = getEnumerationNode("ExposureMode");
+            std::string mode = pExposureMode->ToString().c_str();
 
-        }
-        catch (...) {
-            return TriggerMode::Off;
-        }
-    }
+            if (mode == "Off") return ExposureMode::Off;
+            if (mode == "Timed") return ExposureMode::Timed;
+            if (mode == "TriggerWidth") return ExposureMode::TriggerWidth;
+            if (mode == "TriggerControlled") return ExposureMode::TriggerControlled;
 
+            return ExposureMode::Timed; // Default
 
-    bool GenICamCamera::isTriggerModeAvailable() const {
-        try {
-            GenApi::CNodePtr node = m_pNodeMap->_GetNode("TriggerMode");
-            return node.IsValid() && GenApi::IsImplemented(node);
         }
         catch (...) {
-            return false;
+            return ExposureMode::Timed;
         }
     }
 
- /**
-  * @brief Converte TriggerSource enum in stringa con verifica delle capacità
-  *
-  * Questa funzione verifica quali valori sono effettivamente supportati dalla
-  * telecamera e usa mapping alternativi per massima compatibilità SFNC.
-  */
-    std::string GenICamCamera::triggerSourceToString(TriggerSource source) const {
-       // Se abbiamo già la cache, usala
-       if (m_triggerSourceMapCached) {
-          auto it = m_triggerSourceMap.find(source);
-          if (it != m_triggerSourceMap.end()) {
-             return it->second;
-          }
-       }
+    void GenICamCamera::setExposureTime(double microseconds) {
+        try {
+            // Verifica prima ExposureMode se disponibile
+            if (isParameterAvailable("ExposureMode")) {
+                ExposureMode mode = getExposureMode();
+                if (mode != ExposureMode::Timed) {
+                    // Imposta automaticamente Timed mode se necessario
+                    setExposureMode(ExposureMode::Timed);
+                }
+            }
 
-       // Mapping standard SFNC con alternative per compatibilità
-       static const std::map<TriggerSource, std::vector<std::string>> sourceMap = {
-          // Software trigger - molto standard
-          {TriggerSource::Software, {"Software", "SoftwareTrigger", "SW"}},
+            // Verifica se c'è un selector attivo
+            if (isParameterAvailable("ExposureTimeSelector")) {
+                // Il selector è già impostato, usa il valore corrente
+            }
 
-          // Linee hardware - nomi possono variare
-          {TriggerSource::Line0, {"Line0", "Line_0", "Input0", "DI0", "TTL_IN0"}},
-          {TriggerSource::Line1, {"Line1", "Line_1", "Input1", "DI1", "TTL_IN1"}},
-          {TriggerSource::Line2, {"Line2", "Line_2", "Input2", "DI2", "TTL_IN2"}},
-          {TriggerSource::Line3, {"Line3", "Line_3", "Input3", "DI3", "TTL_IN3"}},
-          {TriggerSource::Line4, {"Line4", "Line_4", "Input4", "DI4"}},
-          {TriggerSource::Line5, {"Line5", "Line_5", "Input5", "DI5"}},
-          {TriggerSource::Line6, {"Line6", "Line_6", "Input6", "DI6"}},
-          {TriggerSource::Line7, {"Line7", "Line_7", "Input7", "DI7"}},
+            // Prova i nomi SFNC in ordine di priorità
+            GenApi::CFloatPtr pExposure;
+            const std::vector<std::string> exposureNames = {
+                "ExposureTime",       // SFNC 2.x standard
+                "ExposureTimeAbs",    // Legacy SFNC 1.x
+                "ExposureTimeRaw"     // Alcune implementazioni usano Raw
+            };
 
-          // Counter end signals
-          {TriggerSource::Counter0End, {"Counter0End", "Counter0", "CounterEnd0"}},
-          {TriggerSource::Counter1End, {"Counter1End", "Counter1", "CounterEnd1"}},
-          {TriggerSource::Counter2End, {"Counter2End", "Counter2", "CounterEnd2"}},
+            bool found = false;
+            for (const auto& name : exposureNames) {
+                try {
+                    pExposure = getFloatNode(name);
+                    if (pExposure.IsValid() && GenApi::IsWritable(pExposure)) {
+                        found = true;
+                        break;
+                    }
+                }
+                catch (...) {
+                    continue;
+                }
+            }
 
-          // Timer end signals
-          {TriggerSource::Timer0End, {"Timer0End", "Timer0", "TimerEnd0"}},
-          {TriggerSource::Timer1End, {"Timer1End", "Timer1", "TimerEnd1"}},
-          {TriggerSource::Timer2End, {"Timer2End", "Timer2", "TimerEnd2"}},
+            if (!found) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "Nessun parametro ExposureTime scrivibile trovato");
+            }
 
-          // User outputs (loopback)
-          {TriggerSource::UserOutput0, {"UserOutput0", "Output0", "DO0"}},
-          {TriggerSource::UserOutput1, {"UserOutput1", "Output1", "DO1"}},
-          {TriggerSource::UserOutput2, {"UserOutput2", "Output2", "DO2"}},
+            // Verifica range
+            double min = pExposure->GetMin();
+            double max = pExposure->GetMax();
 
-          // Action commands
-          {TriggerSource::Action0, {"Action0", "ActionCommand0"}},
-          {TriggerSource::Action1, {"Action1", "ActionCommand1"}},
+            if (microseconds < min || microseconds > max) {
+                std::stringstream ss;
+                ss << "Valore esposizione fuori range [" << min << ", " << max << "] µs";
+                THROW_GENICAM_ERROR(ErrorType::ParameterError, ss.str());
+            }
 
-          // Encoder signals
-          {TriggerSource::Encoder0, {"Encoder0", "EncoderA", "Encoder"}},
-          {TriggerSource::Encoder1, {"Encoder1", "EncoderB"}},
+            // Verifica incremento se disponibile
+            if (pExposure->GetIncMode() != GenApi::noIncrement) {
+                double inc = pExposure->GetInc();
+                // Arrotonda al valore di incremento più vicino
+                microseconds = round(microseconds / inc) * inc;
+            }
 
-          // Frame triggers
-          {TriggerSource::FrameTriggerWait, {"FrameTriggerWait", "FrameTrigger", "ExternalTrigger"}},
+            pExposure->SetValue(microseconds);
 
-          // Exposure triggers  
-          {TriggerSource::ExposureActive, {"ExposureActive", "ExposureOut", "FVAL"}}
-       };
+            // Invalida cache e aggiorna il valore ombra usato per i metadati dei frame
+            m_parameterCache.erase("ExposureTime");
+            m_exposureTimeShadow = microseconds;
 
-       // Se TriggerSource non è disponibile, ritorna default
-       if (!isParameterAvailable("TriggerSource")) {
-          auto it = sourceMap.find(source);
-          if (it != sourceMap.end() && !it->second.empty()) {
-             return it->second[0]; // Ritorna il nome standard
-          }
-          return "Software"; // Default
-       }
+            notifyParameterChanged("ExposureTime", std::to_string(microseconds));
 
-       // Verifica quale valore è effettivamente supportato
-       try {
-          GenApi::CEnumerationPtr pTriggerSource = getEnumerationNode("TriggerSource");
-          GenApi::NodeList_t entries;
-          pTriggerSource->GetEntries(entries);
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore impostazione ExposureTime: ") + e.GetDescription());
+        }
+    }
 
-          auto it = sourceMap.find(source);
-          if (it != sourceMap.end()) {
-             // Cerca il primo valore supportato dalla camera
-             for (const auto& value : it->second) {
-                for (auto& entry : entries) {
-                   if (entry->GetName().c_str() == value && GenApi::IsAvailable(entry)) {
-                      return value;
-                   }
+    double GenICamCamera::getExposureTime() const {
+        try {
+            // Check cache first
+            auto it = m_parameterCache.find("ExposureTime");
+            if (it != m_parameterCache.end()) {
+                auto now = std::chrono::steady_clock::now();
+                if (now - it->second.second < CACHE_TIMEOUT) {
+                    return std::stod(it->second.first);
                 }
-             }
-          }
+            }
 
-          // Se non trovato nelle mappature predefinite, 
-          // potrebbe essere un valore custom del produttore
-          // Costruisci il nome standard e verifica se esiste
-          std::string standardName;
-          switch (source) {
-          case TriggerSource::Software: standardName = "Software"; break;
-          case TriggerSource::Line0: standardName = "Line0"; break;
-          case TriggerSource::Line1: standardName = "Line1"; break;
-          case TriggerSource::Line2: standardName = "Line2"; break;
-          case TriggerSource::Line3: standardName = "Line3"; break;
-             // ... altri casi standard ...
-          default: standardName = "Software";
-          }
+            // Prova i nomi SFNC in ordine
+            const std::vector<std::string> exposureNames = {
+                "ExposureTime",       // SFNC 2.x
+                "ExposureTimeAbs",    // SFNC 1.x
+                "ExposureTimeRaw"     // Raw value
+            };
 
-          // Verifica se il nome standard esiste
-          for (auto& entry : entries) {
-             std::string entryName = entry->GetName().c_str();
-             if (entryName == standardName && GenApi::IsAvailable(entry)) {
-                return standardName;
-             }
-          }
+            for (const auto& name : exposureNames) {
+                try {
+                    GenApi::CFloatPtr pExposure = getFloatNode(name);
+                    if (pExposure.IsValid() && GenApi::IsReadable(pExposure)) {
+                        double value = pExposure->GetValue();
 
-       }
-       catch (...) {
-          // In caso di errore, usa il default
-       }
+                        // Se è ExposureTimeRaw, potrebbe servire conversione
+                        if (name == "ExposureTimeRaw") {
+                            // Cerca un fattore di conversione
+                            try {
+                                GenApi::CFloatPtr pConvFactor = getFloatNode("ExposureTimeBaseAbs");
+                                if (pConvFactor.IsValid()) {
+                                    value *= pConvFactor->GetValue();
+                                }
+                            }
+                            catch (...) {}
+                        }
 
-       // Se tutto fallisce, ritorna il primo valore dalla mappa standard
-       auto it = sourceMap.find(source);
-       if (it != sourceMap.end() && !it->second.empty()) {
-          return it->second[0];
-       }
+                        // Update cache
+                        m_parameterCache["ExposureTime"] = {
+                            std::to_string(value),
+                            std::chrono::steady_clock::now()
+                        };
 
-       return "Software"; // Ultimate fallback
-    }
+                        return value;
+                    }
+                }
+                catch (...) {
+                    continue;
+                }
+            }
 
-       /**
- * @brief Converte stringa in TriggerSource enum
- */
-    TriggerSource GenICamCamera::stringToTriggerSource(const std::string& str) const {
-       // Mappa inversa per conversione rapida
-       static const std::map<std::string, TriggerSource> stringMap = {
-          // Software
-          {"Software", TriggerSource::Software},
-          {"SoftwareTrigger", TriggerSource::Software},
-          {"SW", TriggerSource::Software},
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "ExposureTime non disponibile");
 
-          // Linee hardware
-          {"Line0", TriggerSource::Line0},
-          {"Line_0", TriggerSource::Line0},
-          {"Input0", TriggerSource::Line0},
-          {"DI0", TriggerSource::Line0},
-          {"TTL_IN0", TriggerSource::Line0},
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore lettura ExposureTime: ") + e.GetDescription());
+        }
+    }
 
-          {"Line1", TriggerSource::Line1},
-          {"Line_1", TriggerSource::Line1},
-          {"Input1", TriggerSource::Line1},
-          {"DI1", TriggerSource::Line1},
-          {"TTL_IN1", TriggerSource::Line1},
+    void GenICamCamera::setExposureAuto(ExposureAuto mode) {
+        try {
+            GenApi::CEnumerationPtr pExposureAuto = getEnumerationNode("ExposureAuto");
 
-          {"Line2", TriggerSource::Line2},
-          {"Line_2", TriggerSource::Line2},
-          {"Input2", TriggerSource::Line2},
-          {"DI2", TriggerSource::Line2},
+            if (!GenApi::IsWritable(pExposureAuto)) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "ExposureAuto non scrivibile");
+            }
 
-          {"Line3", TriggerSource::Line3},
-          {"Line_3", TriggerSource::Line3},
-          {"Input3", TriggerSource::Line3},
-          {"DI3", TriggerSource::Line3},
+            std::string modeString;
+            switch (mode) {
+            case ExposureAuto::Off:
+                modeString = "Off";
+                break;
+            case ExposureAuto::Once:
+                modeString = "Once";
+                break;
+            case ExposureAuto::Continuous:
+                modeString = "Continuous";
+                break;
+            }
 
-          {"Line4", TriggerSource::Line4},
-          {"Line_4", TriggerSource::Line4},
+            *pExposureAuto = modeString.c_str();
+            notifyParameterChanged("ExposureAuto", modeString);
 
-          {"Line5", TriggerSource::Line5},
-          {"Line_5", TriggerSource::Line5},
+            // Se impostato su Once, attendi che completi
+            if (mode == ExposureAuto::Once) {
+                // Attendi che torni a Off
+                int maxRetries = 100;
+                while (maxRetries-- > 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    if (getExposureAuto() == ExposureAuto::Off) {
+                        break;
+                    }
+                }
+            }
 
-          {"Line6", TriggerSource::Line6},
-          {"Line_6", TriggerSource::Line6},
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore impostazione ExposureAuto: ") + e.GetDescription());
+        }
+    }
 
-          {"Line7", TriggerSource::Line7},
-          {"Line_7", TriggerSource::Line7},
+    ExposureAuto GenICamCamera::getExposureAuto() const {
+        try {
+            GenApi::CEnumerationPtr pExposureAuto = getEnumerationNode("ExposureAuto");
+            std::string mode = pExposureAuto->ToString().c_str();
 
-          // Counters
-          {"Counter0End", TriggerSource::Counter0End},
-          {"Counter0", TriggerSource::Counter0End},
-          {"Counter1End", TriggerSource::Counter1End},
-          {"Counter1", TriggerSource::Counter1End},
+            if (mode == "Off") return ExposureAuto::Off;
+            if (mode == "Once") return ExposureAuto::Once;
+            if (mode == "Continuous") return ExposureAuto::Continuous;
 
-          // Timers
-          {"Timer0End", TriggerSource::Timer0End},
-          {"Timer0", TriggerSource::Timer0End},
-          {"Timer1End", TriggerSource::Timer1End},
+            return ExposureAuto::Off;
+
+        }
+        catch (...) {
+            return ExposureAuto::Off;
+        }
+    }
+
+    bool GenICamCamera::isExposureAutoAvailable() const {
+        try {
+            GenApi::CNodePtr node = m_pNodeMap->_GetNode("ExposureAuto");
+            return node.IsValid() && GenApi::IsImplemented(node);
+        }
+        catch (...) {
+            return false;
+        }
+    }
+
+    // Helper per debug della configurazione esposizione
+    std::string GenICamCamera::getExposureConfiguration() const {
+        std::stringstream config;
+
+        config << "=== Exposure Configuration (SFNC) ===" << std::endl;
+
+        // ExposureMode
+        if (isParameterAvailable("ExposureMode")) {
+            config << "ExposureMode: ";
+            switch (getExposureMode()) {
+            case ExposureMode::Off: config << "Off"; break;
+            case ExposureMode::Timed: config << "Timed"; break;
+            case ExposureMode::TriggerWidth: config << "TriggerWidth"; break;
+            case ExposureMode::TriggerControlled: config << "TriggerControlled"; break;
+            }
+            config << std::endl;
+        }
+
+        // ExposureTime
+        if (isExposureTimeAvailable()) {
+            double min, max;
+            getExposureTimeRange(min, max);
+            config << "ExposureTime: " << getExposureTime() << " µs"
+                << " (Range: " << min << " - " << max << " µs)" << std::endl;
+        }
+
+        // ExposureAuto
+        if (isExposureAutoAvailable()) {
+            config << "ExposureAuto: ";
+            switch (getExposureAuto()) {
+            case ExposureAuto::Off: config << "Off"; break;
+            case ExposureAuto::Once: config << "Once"; break;
+            case ExposureAuto::Continuous: config << "Continuous"; break;
+            }
+            config << std::endl;
+        }
+
+        return config.str();
+    }
+
+    void GenICamCamera::getExposureTimeRange(double& min, double& max) const {
+        try {
+            // Lista dei possibili nomi per ExposureTime secondo SFNC
+            const std::vector<std::string> exposureNames = {
+                "ExposureTime",       // SFNC 2.x standard
+                "ExposureTimeAbs",    // SFNC 1.x legacy
+                "ExposureTimeRaw"     // Raw value (needs conversion)
+            };
+
+            bool found = false;
+
+            for (const auto& name : exposureNames) {
+                try {
+                    GenApi::CFloatPtr pExposure = getFloatNode(name);
+                    if (pExposure.IsValid() && GenApi::IsReadable(pExposure)) {
+                        min = pExposure->GetMin();
+                        max = pExposure->GetMax();
+
+                        // Se è ExposureTimeRaw, applica conversione
+                        if (name == "ExposureTimeRaw") {
+                            try {
+                                // Cerca il fattore di conversione per convertire da raw a microsecondi
+                                GenApi::CFloatPtr pConvFactor = getFloatNode("ExposureTimeBaseAbs");
+                                if (pConvFactor.IsValid() && GenApi::IsReadable(pConvFactor)) {
+                                    double factor = pConvFactor->GetValue();
+                                    min *= factor;
+                                    max *= factor;
+                                }
+                            }
+                            catch (...) {
+                                // Se non c'è fattore di conversione, prova con ExposureTimeBase
+                                try {
+                                    GenApi::CIntegerPtr pTimeBase = getIntegerNode("ExposureTimeBase");
+                                    if (pTimeBase.IsValid() && GenApi::IsReadable(pTimeBase)) {
+                                        double factor = static_cast<double>(pTimeBase->GetValue());
+                                        min *= factor;
+                                        max *= factor;
+                                    }
+                                }
+                                catch (...) {
+                                    // Nessun fattore di conversione trovato, usa valori raw
+                                }
+                            }
+                        }
+
+                        found = true;
+                        break;
+                    }
+                }
+                catch (...) {
+                    // Prova il prossimo nome
+                    continue;
+                }
+            }
+
+            // Se non trovato, prova con nodi Integer
+            if (!found) {
+                for (const auto& name : exposureNames) {
+                    try {
+                        GenApi::CIntegerPtr pExposure = getIntegerNode(name);
+                        if (pExposure.IsValid() && GenApi::IsReadable(pExposure)) {
+                            min = static_cast<double>(pExposure->GetMin());
+                            max = static_cast<double>(pExposure->GetMax());
+
+                            // Applica conversioni se necessario
+                            if (name == "ExposureTimeRaw") {
+                                try {
+                                    GenApi::CFloatPtr pConvFactor = getFloatNode("ExposureTimeBaseAbs");
+                                    if (pConvFactor.IsValid()) {
+                                        double factor = pConvFactor->GetValue();
+                                        min *= factor;
+                                        max *= factor;
+                                    }
+                                }
+                                catch (...) {}
+                            }
+
+                            found = true;
+                            break;
+                        }
+                    }
+                    catch (...) {
+                        continue;
+                    }
+                }
+            }
+
+            // Se ancora non trovato, verifica se c'è ExposureMode
+            if (!found && isParameterAvailable("ExposureMode")) {
+                // Alcune camere potrebbero avere range diversi per modalità diverse
+                ExposureMode mode = getExposureMode();
+
+                // Prova a leggere range specifici per modalità
+                std::string modeSuffix;
+                switch (mode) {
+                case ExposureMode::Timed:
+                    modeSuffix = "Timed";
+                    break;
+                case ExposureMode::TriggerWidth:
+                    modeSuffix = "TriggerWidth";
+                    break;
+                default:
+                    break;
+                }
+
+                if (!modeSuffix.empty()) {
+                    try {
+                        std::string paramName = "ExposureTime" + modeSuffix + "Min";
+                        min = std::stod(getParameter(paramName));
+                        paramName = "ExposureTime" + modeSuffix + "Max";
+                        max = std::stod(getParameter(paramName));
+                        found = true;
+                    }
+                    catch (...) {}
+                }
+            }
+
+            // Se non trovato nulla, usa valori di default ragionevoli
+            if (!found) {
+                // Valori tipici in microsecondi
+                min = 10.0;      // 10 µs
+                max = 10000000.0; // 10 secondi
+
+                // Log warning per debug
+                std::cerr << "Warning: ExposureTime range non disponibile, usando valori di default" << std::endl;
+            }
+
+            // Verifica sanità dei valori
+            if (min > max) {
+                std::swap(min, max);
+            }
+
+            // Assicura che non siano zero o negativi
+            if (min <= 0) {
+                min = 1.0; // Minimo 1 microsecondo
+            }
+
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            // In caso di errore GenApi, usa valori di default
+            min = 10.0;
+            max = 10000000.0;
+
+            // Log per debug
+            std::cerr << "Error getting exposure range: " << e.GetDescription() << std::endl;
+        }
+        catch (...) {
+            // Fallback finale
+            min = 10.0;
+            max = 10000000.0;
+        }
+    }
+
+    bool GenICamCamera::isExposureTimeAvailable() const {
+        try {
+            // Prima verifica se siamo connessi
+            if (!isConnected() || !m_pNodeMap) {
+                return false;
+            }
+
+            // Lista dei possibili nomi ExposureTime secondo SFNC
+            const std::vector<std::string> exposureNames = {
+                "ExposureTime",       // SFNC 2.x standard
+                "ExposureTimeAbs",    // SFNC 1.x legacy
+                "ExposureTimeRaw"     // Raw value
+            };
+
+            // Verifica ogni possibile nome
+            for (const auto& name : exposureNames) {
+                try {
+                    GenApi::CNodePtr node = m_pNodeMap->_GetNode(name.c_str());
+
+                    if (node.IsValid() &&
+                        GenApi::IsImplemented(node) &&
+                        GenApi::IsAvailable(node)) {
+
+                        // Verifica che sia almeno leggibile
+                        if (GenApi::IsReadable(node)) {
+                            // Verifica il tipo di nodo
+                            GenApi::EInterfaceType nodeType = node->GetPrincipalInterfaceType();
+
+                            // ExposureTime può essere Float o Integer
+                            if (nodeType == GenApi::intfIFloat ||
+                                nodeType == GenApi::intfIInteger) {
+                                return true;
+                            }
+                        }
+                    }
+                }
+                catch (...) {
+                    // Continua con il prossimo nome
+                    continue;
+                }
+            }
+
+            // Se arriviamo qui, verifica anche se c'è ExposureMode
+            // Alcune camere potrebbero richiedere ExposureMode = Timed
+            if (isParameterAvailable("ExposureMode")) {
+                try {
+                    ExposureMode mode = getExposureMode();
+
+                    // Se ExposureMode esiste ma è Off, ExposureTime potrebbe non essere disponibile
+                    if (mode == ExposureMode::Off) {
+                        return false;
+                    }
+
+                    // Se ExposureMode != Off, riprova la ricerca con modalità specifica
+                    if (mode == ExposureMode::Timed) {
+                        // Alcune camere usano nomi specifici per modalità
+                        try {
+                            GenApi::CNodePtr node = m_pNodeMap->_GetNode("ExposureTimeTimed");
+                            if (node.IsValid() &&
+                                GenApi::IsImplemented(node) &&
+                                GenApi::IsAvailable(node) &&
+                                GenApi::IsReadable(node)) {
+                                return true;
+                            }
+                        }
+                        catch (...) {}
+                    }
+                }
+                catch (...) {}
+            }
+
+            // Verifica finale: prova a leggere il valore
+            // Questo è il test definitivo
+            try {
+                double testValue = getExposureTime();
+                // Se non lancia eccezione, è disponibile
+                return true;
+            }
+            catch (...) {
+                // Se getExposureTime() fallisce, non è disponibile
+            }
+
+            return false;
+
+        }
+        catch (...) {
+            return false;
+        }
+    }
+
+    // === Metodo helper aggiuntivo per debug ===
+    std::string GenICamCamera::getExposureInfo() const {
+        std::stringstream info;
+
+        info << "=== Exposure Information (SFNC) ===" << std::endl;
+
+        // Disponibilità
+        info << "ExposureTime Available: " << (isExposureTimeAvailable() ? "Yes" : "No") << std::endl;
+
+        if (isExposureTimeAvailable()) {
+            try {
+                // Valore corrente
+                double current = getExposureTime();
+                info << "Current ExposureTime: " << current << " µs" << std::endl;
+
+                // Range
+                double min, max;
+                getExposureTimeRange(min, max);
+                info << "ExposureTime Range: [" << min << " - " << max << "] µs" << std::endl;
+
+                // Incremento se disponibile
+                try {
+                    const std::vector<std::string> exposureNames = {
+                        "ExposureTime", "ExposureTimeAbs", "ExposureTimeRaw"
+                    };
+
+                    for (const auto& name : exposureNames) {
+                        try {
+                            GenApi::CFloatPtr pExposure = getFloatNode(name);
+                            if (pExposure.IsValid() && pExposure->GetIncMode() != GenApi::noIncrement) {
+                                info << "ExposureTime Increment: " << pExposure->GetInc() << " µs" << std::endl;
+                                break;
+                            }
+                        }
+                        catch (...) {}
+                    }
+                }
+                catch (...) {}
+
+                // Access mode
+                info << "Access Mode: ";
+                bool readable = false, writable = false;
+
+                const std::vector<std::string> exposureNames = {
+                    "ExposureTime", "ExposureTimeAbs", "ExposureTimeRaw"
+                };
+
+                for (const auto& name : exposureNames) {
+                    if (isParameterReadable(name)) readable = true;
+                    if (isParameterWritable(name)) writable = true;
+                    if (readable || writable) break;
+                }
+
+                if (readable) info << "R";
+                if (writable) info << "W";
+                info << std::endl;
+
+            }
+            catch (const std::exception& e) {
+                info << "Error reading exposure info: " << e.what() << std::endl;
+            }
+        }
+
+        // ExposureMode info
+        if (isParameterAvailable("ExposureMode")) {
+            info << "\nExposureMode: ";
+            try {
+                switch (getExposureMode()) {
+                case ExposureMode::Off: info << "Off"; break;
+                case ExposureMode::Timed: info << "Timed"; break;
+                case ExposureMode::TriggerWidth: info << "TriggerWidth"; break;
+                case ExposureMode::TriggerControlled: info << "TriggerControlled"; break;
+                }
+                info << std::endl;
+
+                // Modalità disponibili
+                auto modes = getAvailableExposureModes();
+                if (!modes.empty()) {
+                    info << "Available modes: ";
+                    for (const auto& mode : modes) {
+                        switch (mode) {
+                        case ExposureMode::Off: info << "Off "; break;
+                        case ExposureMode::Timed: info << "Timed "; break;
+                        case ExposureMode::TriggerWidth: info << "TriggerWidth "; break;
+                        case ExposureMode::TriggerControlled: info << "TriggerControlled "; break;
+                        }
+                    }
+                    info << std::endl;
+                }
+            }
+            catch (...) {}
+        }
+
+        // ExposureAuto info
+        if (isExposureAutoAvailable()) {
+            info << "\nExposureAuto: ";
+            try {
+                switch (getExposureAuto()) {
+                case ExposureAuto::Off: info << "Off"; break;
+                case ExposureAuto::Once: info << "Once"; break;
+                case ExposureAuto::Continuous: info << "Continuous"; break;
+                }
+                info << std::endl;
+            }
+            catch (...) {}
+        }
+
+        return info.str();
+    }
+
+
+    std::vector<ExposureMode> GenICamCamera::getAvailableExposureModes() const {
+        std::vector<ExposureMode> modes;
+
+        try {
+            // Prima verifica se siamo connessi
+            if (!isConnected() || !m_pNodeMap) {
+                return modes; // Ritorna vector vuoto
+            }
+
+            // Verifica se ExposureMode esiste
+            if (!isParameterAvailable("ExposureMode")) {
+                // Se ExposureMode non esiste, assumiamo che la camera supporti
+                // solo la modalità Timed (default SFNC)
+                modes.push_back(ExposureMode::Timed);
+                return modes;
+            }
+
+            // Ottieni il nodo ExposureMode
+            GenApi::CEnumerationPtr pExposureMode = getEnumerationNode("ExposureMode");
+
+            if (!pExposureMode.IsValid()) {
+                // Fallback a modalità default
+                modes.push_back(ExposureMode::Timed);
+                return modes;
+            }
+
+            // Ottieni tutte le entries disponibili
+            GenApi::NodeList_t entries;
+            pExposureMode->GetEntries(entries);
+
+            // Itera su tutte le entries
+            for (auto& entry : entries) {
+                // Verifica che l'entry sia disponibile e implementata
+                if (GenApi::IsAvailable(entry) && GenApi::IsImplemented(entry)) {
+                    // Ottieni il nome simbolico dell'entry
+                    GenApi::CEnumEntryPtr pEntry(entry);
+                    if (pEntry.IsValid()) {
+                        std::string entryName = pEntry->GetSymbolic().c_str();
+
+                        // Converti il nome in enum ExposureMode
+                        if (entryName == "Off") {
+                            modes.push_back(ExposureMode::Off);
+                        }
+                        else if (entryName == "Timed") {
+                            modes.push_back(ExposureMode::Timed);
+                        }
+                        else if (entryName == "TriggerWidth") {
+                            modes.push_back(ExposureMode::TriggerWidth);
+                        }
+                        else if (entryName == "TriggerControlled") {
+                            modes.push_back(ExposureMode::TriggerControlled);
+                        }
+                        // Else: modalità non standard, ignora
+                    }
+                }
+            }
+
+            // Se non sono state trovate modalità valide, aggiungi default
+            if (modes.empty()) {
+                // Questo può succedere se il nodo esiste ma le entries non sono standard
+                modes.push_back(ExposureMode::Timed);
+
+                // Log warning per debug
+                std::cerr << "Warning: ExposureMode node exists but no standard modes found" << std::endl;
+            }
+
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            // In caso di errore GenApi
+            std::cerr << "Error getting available exposure modes: " << e.GetDescription() << std::endl;
+
+            // Ritorna almeno la modalità di default
+            if (modes.empty()) {
+                modes.push_back(ExposureMode::Timed);
+            }
+        }
+        catch (...) {
+            // Gestione errori generici
+            if (modes.empty()) {
+                modes.push_back(ExposureMode::Timed);
+            }
+        }
+
+        // Rimuovi eventuali duplicati (non dovrebbero essercene, ma per sicurezza)
+        std::sort(modes.begin(), modes.end());
+        modes.erase(std::unique(modes.begin(), modes.end()), modes.end());
+
+        return modes;
+    }
+
+    // === Metodo helper aggiuntivo per verificare se ExposureMode è disponibile ===
+    bool GenICamCamera::isExposureModeAvailable() const {
+        try {
+            if (!isConnected() || !m_pNodeMap) {
+                return false;
+            }
+
+            GenApi::CNodePtr node = m_pNodeMap->_GetNode("ExposureMode");
+            return node.IsValid() &&
+                GenApi::IsImplemented(node) &&
+                GenApi::IsAvailable(node);
+
+        }
+        catch (...) {
+            return false;
+        }
+    }
+
+    // === Metodo helper per convertire ExposureMode in stringa ===
+    std::string GenICamCamera::exposureModeToString(ExposureMode mode) const {
+        switch (mode) {
+        case ExposureMode::Off:
+            return "Off";
+        case ExposureMode::Timed:
+            return "Timed";
+        case ExposureMode::TriggerWidth:
+            return "TriggerWidth";
+        case ExposureMode::TriggerControlled:
+            return "TriggerControlled";
+        default:
+            return "Unknown";
+        }
+    }
+
+    // === Metodo per ottenere la modalità corrente con gestione errori migliorata ===
+    std::vector<ExposureMode> GenICamCamera::getAvailableExposureModesFiltered() const {
+        std::vector<ExposureMode> allModes = getAvailableExposureModes();
+        std::vector<ExposureMode> filteredModes;
+
+        // Filtra solo le modalità effettivamente utilizzabili
+        for (const auto& mode : allModes) {
+            try {
+                // Salva modalità corrente
+                ExposureMode currentMode = getExposureMode();
+
+                // Prova a impostare la modalità
+                const_cast<GenICamCamera*>(this)->setExposureMode(mode);
+
+                // Se non lancia eccezione, è utilizzabile
+                filteredModes.push_back(mode);
+
+                // Ripristina modalità originale
+                const_cast<GenICamCamera*>(this)->setExposureMode(currentMode);
+
+            }
+            catch (...) {
+                // Modalità non utilizzabile, ignora
+            }
+        }
+
+        return filteredModes;
+    }
+
+    // Modifica i metodi getGain() e setGain() in GenICamCamera.cpp
+
+    bool GenICamCamera::setupGainSelector() const {
+        try {
+            GenApi::CEnumerationPtr pGainSelector = getEnumerationNode("GainSelector");
+            if (pGainSelector.IsValid() && GenApi::IsWritable(pGainSelector)) {
+                // Prova in ordine di preferenza
+                const std::vector<std::string> preferredSelectors = {
+                    "All",          // Gain globale
+                    "AnalogAll",    // Gain analogico globale
+                    "DigitalAll",   // Gain digitale globale
+                    "Tap1",         // Primo tap
+                    "Red",          // Per camere a colori
+                    "Sensor"        // Gain del sensore
+                };
+
+                GenApi::NodeList_t entries;
+                pGainSelector->GetEntries(entries);
+
+                // Prova i selettori preferiti
+                for (const auto& selector : preferredSelectors) {
+                    for (auto& entry : entries) {
+                        if (GenApi::IsAvailable(entry) &&
+                            entry->GetName().c_str() == selector) {
+                            *pGainSelector = selector.c_str();
+                            return true;
+                        }
+                    }
+                }
+
+                // Se nessuno dei preferiti è disponibile, usa il primo disponibile
+                for (auto& entry : entries) {
+                    if (GenApi::IsAvailable(entry)) {
+                        *pGainSelector = entry->GetName().c_str();
+                        return true;
+                    }
+                }
+            }
+        }
+        catch (...) {
+            // GainSelector non disponibile
+        }
+        return false;
+    }
+
+    // Metodo getGain aggiornato
+    double GenICamCamera::getGain() const {
+        try {
+            // Check cache first
+            auto it = m_parameterCache.find("Gain");
+            if (it != m_parameterCache.end()) {
+                auto now = std::chrono::steady_clock::now();
+                if (now - it->second.second < CACHE_TIMEOUT) {
+                    return std::stod(it->second.first);
+                }
+            }
+
+            // Setup GainSelector se necessario
+            setupGainSelector();
+
+            // Lista di possibili nomi di gain in ordine di priorità
+            const std::vector<std::string> gainNames = {
+                "Gain",           // Nome standard SFNC
+                "GainRaw",        // Valore raw (integer)
+                "GainAbs",        // Valore assoluto in dB (vecchie camere)
+                "AnalogGain",     // Gain analogico
+                "DigitalGain",    // Gain digitale
+                "Brightness"      // Alcune camere USB usano questo
+            };
+
+            for (const auto& gainName : gainNames) {
+                try {
+                    // Prima prova come float
+                    GenApi::CFloatPtr pGain = getFloatNode(gainName);
+                    if (pGain.IsValid() && GenApi::IsReadable(pGain)) {
+                        double value = pGain->GetValue();
+
+                        // Cache il valore
+                        m_parameterCache["Gain"] = { std::to_string(value),
+                                                   std::chrono::steady_clock::now() };
+                        return value;
+                    }
+                }
+                catch (...) {
+                    // Se fallisce, prova come integer
+                    try {
+                        GenApi::CIntegerPtr pGainInt = getIntegerNode(gainName);
+                        if (pGainInt.IsValid() && GenApi::IsReadable(pGainInt)) {
+                            double value = static_cast<double>(pGainInt->GetValue());
+
+                            // Per GainRaw, potrebbe servire conversione
+                            if (gainName == "GainRaw") {
+                                try {
+                                    // Cerca un fattore di conversione
+                                    GenApi::CFloatPtr pGainFactor = getFloatNode("GainFactor");
+                                    if (pGainFactor.IsValid() && GenApi::IsReadable(pGainFactor)) {
+                                        value *= pGainFactor->GetValue();
+                                    }
+                                }
+                                catch (...) {
+                                    // Prova conversione da raw a dB
+                                    // Formula tipica: gain_dB = 20 * log10(raw_value / reference)
+                                    // Ma senza reference, restituiamo il valore raw
+                                }
+                            }
+
+                            m_parameterCache["Gain"] = { std::to_string(value),
+                                                       std::chrono::steady_clock::now() };
+                            return value;
+                        }
+                    }
+                    catch (...) {
+                        continue;
+                    }
+                }
+            }
+
+            // Se arriviamo qui, nessun gain trovato
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Parametro Gain non disponibile o non leggibile");
+
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore lettura gain: ") + e.GetDescription());
+        }
+    }
+
+    // Metodo setGain aggiornato
+    void GenICamCamera::setGain(double gain) {
+        try {
+            // Setup GainSelector se necessario
+            setupGainSelector();
+
+            // Lista di possibili nomi
+            const std::vector<std::string> gainNames = {
+                "Gain", "GainRaw", "GainAbs", "AnalogGain", "DigitalGain", "Brightness"
+            };
+
+            bool gainSet = false;
+            std::string lastError;
+
+            for (const auto& gainName : gainNames) {
+                try {
+                    // Prova come float
+                    GenApi::CFloatPtr pGain = getFloatNode(gainName);
+                    if (pGain.IsValid() && GenApi::IsWritable(pGain)) {
+                        double min = pGain->GetMin();
+                        double max = pGain->GetMax();
+
+                        // Verifica se ha incremento
+                        double inc = 0.0;
+                        try {
+                            if (pGain->GetIncMode() != GenApi::noIncrement) {
+                                inc = pGain->GetInc();
+                            }
+                        }
+                        catch (...) {
+                            inc = 0.0;
+                        }
+
+                        // Clamp al range valido
+                        if (gain < min) gain = min;
+                        if (gain > max) gain = max;
+
+                        // Arrotonda all'incremento se specificato
+                        if (inc > 0) {
+                            gain = round(gain / inc) * inc;
+                        }
+
+                        pGain->SetValue(gain);
+                        gainSet = true;
+                        m_parameterCache.erase("Gain");
+                        m_gainShadow = gain;
+                        notifyParameterChanged("Gain", std::to_string(gain));
+                        break;
+                    }
+                }
+                catch (const std::exception& e) {
+                    lastError = e.what();
+
+                    // Prova come integer
+                    try {
+                        GenApi::CIntegerPtr pGainInt = getIntegerNode(gainName);
+                        if (pGainInt.IsValid() && GenApi::IsWritable(pGainInt)) {
+                            int64_t min = pGainInt->GetMin();
+                            int64_t max = pGainInt->GetMax();
+
+                            // Verifica se ha incremento
+                            int64_t inc = 1;
+                            try {
+                                if (pGainInt->GetIncMode() != GenApi::noIncrement) {
+                                    inc = pGainInt->GetInc();
+                                }
+                            }
+                            catch (...) {
+                                inc = 1;
+                            }
+
+                            // Converti a integer
+                            int64_t intGain = static_cast<int64_t>(gain);
+
+                            // Per GainRaw, potrebbe servire conversione inversa
+                            if (gainName == "GainRaw") {
+                                try {
+                                    GenApi::CFloatPtr pGainFactor = getFloatNode("GainFactor");
+                                    if (pGainFactor.IsValid() && GenApi::IsReadable(pGainFactor)) {
+                                        double factor = pGainFactor->GetValue();
+                                        if (factor != 0) {
+                                            intGain = static_cast<int64_t>(gain / factor);
+                                        }
+                                    }
+                                }
+                                catch (...) {}
+                            }
+
+                            // Clamp e arrotonda
+                            if (intGain < min) intGain = min;
+                            if (intGain > max) intGain = max;
+
+                            // Arrotonda all'incremento
+                            if (inc > 1) {
+                                intGain = (intGain / inc) * inc;
+                            }
+
+                            pGainInt->SetValue(intGain);
+                            gainSet = true;
+                            m_parameterCache.erase("Gain");
+                            m_gainShadow = gain;
+                            notifyParameterChanged("Gain", std::to_string(intGain));
+                            break;
+                        }
+                    }
+                    catch (const std::exception& e2) {
+                        lastError = e2.what();
+                        continue;
+                    }
+                }
+            }
+
+            if (!gainSet) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "Impossibile impostare il Gain. Ultimo errore: " + lastError);
+            }
+
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore impostazione gain: ") + e.GetDescription());
+        }
+    }
+
+    void GenICamCamera::notifyParameterChanged(const std::string& parameterName, const std::string& value) {
+        // Il dispatch non trattiene più alcun mutex durante la callback: un listener
+        // può richiamare la camera senza rischio di deadlock
+        dispatchToListeners([&](CameraEventListener* listener) {
+            listener->OnParameterChanged(parameterName, value);
+        });
+    }
+
+    // Continuazione di GenICamCamera.cpp
+
+    // === ROI (Region of Interest) ===
+
+    void GenICamCamera::setROI(const ROI& roi) {
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile cambiare ROI durante l'acquisizione (usare reconfigureAcquisition)");
+        }
+
+        notifyParameterChanged("ROI", applyROI(roi));
+    }
+
+    std::string GenICamCamera::applyROI(const ROI& roi) {
+        try {
+            // Ottieni limiti del sensore
+            GenApi::CIntegerPtr pWidthMax = getIntegerNode("WidthMax");
+            GenApi::CIntegerPtr pHeightMax = getIntegerNode("HeightMax");
+
+            int64_t maxWidth = pWidthMax->GetValue();
+            int64_t maxHeight = pHeightMax->GetValue();
+
+            if (roi.x + roi.width > static_cast<uint32_t>(maxWidth) ||
+                roi.y + roi.height > static_cast<uint32_t>(maxHeight)) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "ROI fuori dai limiti del sensore");
+            }
+
+            // Ordine importante: prima resetta offset, poi imposta dimensioni
+            GenApi::CIntegerPtr pOffsetX = getIntegerNode("OffsetX");
+            GenApi::CIntegerPtr pOffsetY = getIntegerNode("OffsetY");
+            GenApi::CIntegerPtr pWidth = getIntegerNode("Width");
+            GenApi::CIntegerPtr pHeight = getIntegerNode("Height");
+
+            // Reset offset
+            if (GenApi::IsWritable(pOffsetX)) pOffsetX->SetValue(0);
+            if (GenApi::IsWritable(pOffsetY)) pOffsetY->SetValue(0);
+
+            // Imposta dimensioni
+            if (GenApi::IsWritable(pWidth)) {
+                int64_t inc = pWidth->GetInc();
+                int64_t alignedWidth = (roi.width / inc) * inc;
+                pWidth->SetValue(alignedWidth);
+            }
+
+            if (GenApi::IsWritable(pHeight)) {
+                int64_t inc = pHeight->GetInc();
+                int64_t alignedHeight = (roi.height / inc) * inc;
+                pHeight->SetValue(alignedHeight);
+            }
+
+            // Imposta offset
+            if (GenApi::IsWritable(pOffsetX)) {
+                int64_t inc = pOffsetX->GetInc();
+                int64_t alignedX = (roi.x / inc) * inc;
+                pOffsetX->SetValue(alignedX);
+            }
+
+            if (GenApi::IsWritable(pOffsetY)) {
+                int64_t inc = pOffsetY->GetInc();
+                int64_t alignedY = (roi.y / inc) * inc;
+                pOffsetY->SetValue(alignedY);
+            }
+
+            std::stringstream ss;
+            ss << roi.width << "x" << roi.height << "@" << roi.x << "," << roi.y;
+            return ss.str();
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore impostazione ROI: ") + e.GetDescription());
+        }
+    }
+
+    ROI GenICamCamera::getROI() const {
+        ROI roi;
+
+        try {
+            GenApi::CIntegerPtr pOffsetX = getIntegerNode("OffsetX");
+            GenApi::CIntegerPtr pOffsetY = getIntegerNode("OffsetY");
+            GenApi::CIntegerPtr pWidth = getIntegerNode("Width");
+            GenApi::CIntegerPtr pHeight = getIntegerNode("Height");
+
+            roi.x = static_cast<uint32_t>(pOffsetX->GetValue());
+            roi.y = static_cast<uint32_t>(pOffsetY->GetValue());
+            roi.width = static_cast<uint32_t>(pWidth->GetValue());
+            roi.height = static_cast<uint32_t>(pHeight->GetValue());
+
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore lettura ROI: ") + e.GetDescription());
+        }
+
+        return roi;
+    }
+
+    void GenICamCamera::getSensorSize(uint32_t& width, uint32_t& height) const {
+        try {
+            GenApi::CIntegerPtr pWidthMax = getIntegerNode("WidthMax");
+            GenApi::CIntegerPtr pHeightMax = getIntegerNode("HeightMax");
+
+            width = static_cast<uint32_t>(pWidthMax->GetValue());
+            height = static_cast<uint32_t>(pHeightMax->GetValue());
+
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+           e.what();
+            // Prova con SensorWidth/SensorHeight
+            try {
+                GenApi::CIntegerPtr pSensorWidth = getIntegerNode("SensorWidth");
+                GenApi::CIntegerPtr pSensorHeight = getIntegerNode("SensorHeight");
+
+                width = static_cast<uint32_t>(pSensorWidth->GetValue());
+                height = static_cast<uint32_t>(pSensorHeight->GetValue());
+            }
+            catch (...) {
+                THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                    "Impossibile determinare le dimensioni del sensore");
+            }
+        }
+    }
+
+    // === Trigger Mode ===
+
+// === Gestione Trigger Standard SFNC ===
+
+    void GenICamCamera::setTriggerMode(TriggerMode mode) {
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError, "Impossibile cambiare trigger durante l'acquisizione");
+        }
+
+        try {
+            GenApi::CEnumerationPtr pTriggerMode = getEnumerationNode("TriggerMode");
+
+            if (!GenApi::IsWritable(pTriggerMode)) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError, "TriggerMode non scrivibile");
+            }
+
+            *pTriggerMode = (mode == TriggerMode::On) ? "On" : "Off";
+            notifyParameterChanged("TriggerMode", (mode == TriggerMode::On) ? "On" : "Off");
+
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError, std::string("Errore impostazione TriggerMode: ") + e.GetDescription());
+        }
+    }
+
+    TriggerMode GenICamCamera::getTriggerMode() const {
+        try {
+            GenApi::CEnumerationPtr pTriggerMode = getEnumerationNode("TriggerMode");
+            std::string value = pTriggerMode->ToString().c_str();
+
+            return (value == "On") ? TriggerMode::On : TriggerMode::Off;
+
+        }
+        catch (...) {
+            return TriggerMode::Off;
+        }
+    }
+
+
+    bool GenICamCamera::isTriggerModeAvailable() const {
+        try {
+            GenApi::CNodePtr node = m_pNodeMap->_GetNode("TriggerMode");
+            return node.IsValid() && GenApi::IsImplemented(node);
+        }
+        catch (...) {
+            return false;
+        }
+    }
+
+ /**
+  * @brief Converte TriggerSource enum in stringa con verifica delle capacità
+  *
+  * Questa funzione verifica quali valori sono effettivamente supportati dalla
+  * telecamera e usa mapping alternativi per massima compatibilità SFNC.
+  */
+    std::string GenICamCamera::triggerSourceToString(TriggerSource source) const {
+       // Se abbiamo già la cache, usala
+       if (m_triggerSourceMapCached) {
+          auto it = m_triggerSourceMap.find(source);
+          if (it != m_triggerSourceMap.end()) {
+             return it->second;
+          }
+       }
+
+       // Mapping standard SFNC con alternative per compatibilità
+       static const std::map<TriggerSource, std::vector<std::string>> sourceMap = {
+          // Software trigger - molto standard
+          {TriggerSource::Software, {"Software", "SoftwareTrigger", "SW"}},
+
+          // Linee hardware - nomi possono variare
+          {TriggerSource::Line0, {"Line0", "Line_0", "Input0", "DI0", "TTL_IN0"}},
+          {TriggerSource::Line1, {"Line1", "Line_1", "Input1", "DI1", "TTL_IN1"}},
+          {TriggerSource::Line2, {"Line2", "Line_2", "Input2", "DI2", "TTL_IN2"}},
+          {TriggerSource::Line3, {"Line3", "Line_3", "Input3", "DI3", "TTL_IN3"}},
+          {TriggerSource::Line4, {"Line4", "Line_4", "Input4", "DI4"}},
+          {TriggerSource::Line5, {"Line5", "Line_5", "Input5", "DI5"}},
+          {TriggerSource::Line6, {"Line6", "Line_6", "Input6", "DI6"}},
+          {TriggerSource::Line7, {"Line7", "Line_7", "Input7", "DI7"}},
+
+          // Counter end signals
+          {TriggerSource::Counter0End, {"Counter0End", "Counter0", "CounterEnd0"}},
+          {TriggerSource::Counter1End, {"Counter1End", "Counter1", "CounterEnd1"}},
+          {TriggerSource::Counter2End, {"Counter2End", "Counter2", "CounterEnd2"}},
+
+          // Timer end signals
+          {TriggerSource::Timer0End, {"Timer0End", "Timer0", "TimerEnd0"}},
+          {TriggerSource::Timer1End, {"Timer1End", "Timer1", "TimerEnd1"}},
+          {TriggerSource::Timer2End, {"Timer2End", "Timer2", "TimerEnd2"}},
+
+          // User outputs (loopback)
+          {TriggerSource::UserOutput0, {"UserOutput0", "Output0", "DO0"}},
+          {TriggerSource::UserOutput1, {"UserOutput1", "Output1", "DO1"}},
+          {TriggerSource::UserOutput2, {"UserOutput2", "Output2", "DO2"}},
+
+          // Action commands
+          {TriggerSource::Action0, {"Action0", "ActionCommand0"}},
+          {TriggerSource::Action1, {"Action1", "ActionCommand1"}},
+
+          // Encoder signals
+          {TriggerSource::Encoder0, {"Encoder0", "EncoderA", "Encoder"}},
+          {TriggerSource::Encoder1, {"Encoder1", "EncoderB"}},
+
+          // Frame triggers
+          {TriggerSource::FrameTriggerWait, {"FrameTriggerWait", "FrameTrigger", "ExternalTrigger"}},
+
+          // Exposure triggers  
+          {TriggerSource::ExposureActive, {"ExposureActive", "ExposureOut", "FVAL"}}
+       };
+
+       // Se TriggerSource non è disponibile, ritorna default
+       if (!isParameterAvailable("TriggerSource")) {
+          auto it = sourceMap.find(source);
+          if (it != sourceMap.end() && !it->second.empty()) {
+             return it->second[0]; // Ritorna il nome standard
+          }
+          return "Software"; // Default
+       }
+
+       // Verifica quale valore è effettivamente supportato
+       try {
+          GenApi::CEnumerationPtr pTriggerSource = getEnumerationNode("TriggerSource");
+          GenApi::NodeList_t entries;
+          pTriggerSource->GetEntries(entries);
+
+          auto it = sourceMap.find(source);
+          if (it != sourceMap.end()) {
+             // Cerca il primo valore supportato dalla camera
+             for (const auto& value : it->second) {
+                for (auto& entry : entries) {
+                   if (entry->GetName().c_str() == value && GenApi::IsAvailable(entry)) {
+                      return value;
+                   }
+                }
+             }
+          }
+
+          // Se non trovato nelle mappature predefinite, 
+          // potrebbe essere un valore custom del produttore
+          // Costruisci il nome standard e verifica se esiste
+          std::string standardName;
+          switch (source) {
+          case TriggerSource::Software: standardName = "Software"; break;
+          case TriggerSource::Line0: standardName = "Line0"; break;
+          case TriggerSource::Line1: standardName = "Line1"; break;
+          case TriggerSource::Line2: standardName = "Line2"; break;
+          case TriggerSource::Line3: standardName = "Line3"; break;
+             // ... altri casi standard ...
+          default: standardName = "Software";
+          }
+
+          // Verifica se il nome standard esiste
+          for (auto& entry : entries) {
+             std::string entryName = entry->GetName().c_str();
+             if (entryName == standardName && GenApi::IsAvailable(entry)) {
+                return standardName;
+             }
+          }
+
+       }
+       catch (...) {
+          // In caso di errore, usa il default
+       }
+
+       // Se tutto fallisce, ritorna il primo valore dalla mappa standard
+       auto it = sourceMap.find(source);
+       if (it != sourceMap.end() && !it->second.empty()) {
+          return it->second[0];
+       }
+
+       return "Software"; // Ultimate fallback
+    }
+
+       /**
+ * @brief Converte stringa in TriggerSource enum
+ */
+    TriggerSource GenICamCamera::stringToTriggerSource(const std::string& str) const {
+       // Mappa inversa per conversione rapida
+       static const std::map<std::string, TriggerSource> stringMap = {
+          // Software
+          {"Software", TriggerSource::Software},
+          {"SoftwareTrigger", TriggerSource::Software},
+          {"SW", TriggerSource::Software},
+
+          // Linee hardware
+          {"Line0", TriggerSource::Line0},
+          {"Line_0", TriggerSource::Line0},
+          {"Input0", TriggerSource::Line0},
+          {"DI0", TriggerSource::Line0},
+          {"TTL_IN0", TriggerSource::Line0},
+
+          {"Line1", TriggerSource::Line1},
+          {"Line_1", TriggerSource::Line1},
+          {"Input1", TriggerSource::Line1},
+          {"DI1", TriggerSource::Line1},
+          {"TTL_IN1", TriggerSource::Line1},
+
+          {"Line2", TriggerSource::Line2},
+          {"Line_2", TriggerSource::Line2},
+          {"Input2", TriggerSource::Line2},
+          {"DI2", TriggerSource::Line2},
+
+          {"Line3", TriggerSource::Line3},
+          {"Line_3", TriggerSource::Line3},
+          {"Input3", TriggerSource::Line3},
+          {"DI3", TriggerSource::Line3},
+
+          {"Line4", TriggerSource::Line4},
+          {"Line_4", TriggerSource::Line4},
+
+          {"Line5", TriggerSource::Line5},
+          {"Line_5", TriggerSource::Line5},
+
+          {"Line6", TriggerSource::Line6},
+          {"Line_6", TriggerSource::Line6},
+
+          {"Line7", TriggerSource::Line7},
+          {"Line_7", TriggerSource::Line7},
+
+          // Counters
+          {"Counter0End", TriggerSource::Counter0End},
+          {"Counter0", TriggerSource::Counter0End},
+          {"Counter1End", TriggerSource::Counter1End},
+          {"Counter1", TriggerSource::Counter1End},
+
+          // Timers
+          {"Timer0End", TriggerSource::Timer0End},
+          {"Timer0", TriggerSource::Timer0End},
+          {"Timer1End", TriggerSource::Timer1End},
           {"Timer1", TriggerSource::Timer1End},
 
-          // User outputs
-          {"UserOutput0", TriggerSource::UserOutput0},
-          {"Output0", TriggerSource::UserOutput0},
-          {"DO0", TriggerSource::UserOutput0},
+          // User outputs
+          {"UserOutput0", TriggerSource::UserOutput0},
+          {"Output0", TriggerSource::UserOutput0},
+          {"DO0", TriggerSource::UserOutput0},
+
+          {"UserOutput1", TriggerSource::UserOutput1},
+          {"Output1", TriggerSource::UserOutput1},
+          {"DO1", TriggerSource::UserOutput1},
+
+          // Actions
+          {"Action0", TriggerSource::Action0},
+          {"ActionCommand0", TriggerSource::Action0},
+          {"Action1", TriggerSource::Action1},
+          {"ActionCommand1", TriggerSource::Action1},
+
+          // Encoder
+          {"Encoder0", TriggerSource::Encoder0},
+          {"EncoderA", TriggerSource::Encoder0},
+          {"Encoder", TriggerSource::Encoder0},
+
+          // Frame/Exposure
+          {"FrameTriggerWait", TriggerSource::FrameTriggerWait},
+          {"ExposureActive", TriggerSource::ExposureActive}
+       };
+
+       auto it = stringMap.find(str);
+       if (it != stringMap.end()) {
+          return it->second;
+       }
+
+       // Se non trovato, prova a dedurre dal pattern
+       if (str.find("Software") != std::string::npos) {
+          return TriggerSource::Software;
+       }
+
+       // Pattern matching per Line
+       if (str.find("Line") != std::string::npos ||
+          str.find("Input") != std::string::npos ||
+          str.find("DI") != std::string::npos) {
+
+          // Estrai il numero
+          for (char c : str) {
+             if (c >= '0' && c <= '7') {
+                int lineNum = c - '0';
+                switch (lineNum) {
+                case 0: return TriggerSource::Line0;
+                case 1: return TriggerSource::Line1;
+                case 2: return TriggerSource::Line2;
+                case 3: return TriggerSource::Line3;
+                case 4: return TriggerSource::Line4;
+                case 5: return TriggerSource::Line5;
+                case 6: return TriggerSource::Line6;
+                case 7: return TriggerSource::Line7;
+                }
+             }
+          }
+       }
+
+       // Default
+       return TriggerSource::Software;
+    }
+
+    /**
+ * @brief Cache delle mappature TriggerSource supportate dalla camera
+ */
+    void GenICamCamera::cacheTriggerSourceMappings() const {
+       if (m_triggerSourceMapCached) {
+          return; // Già in cache
+       }
+
+       m_triggerSourceMap.clear();
+
+       // Lista di tutte le sorgenti da verificare
+       const std::vector<TriggerSource> allSources = {
+           TriggerSource::Software,
+           TriggerSource::Line0, TriggerSource::Line1, TriggerSource::Line2, TriggerSource::Line3,
+           TriggerSource::Line4, TriggerSource::Line5, TriggerSource::Line6, TriggerSource::Line7,
+           TriggerSource::Counter0End, TriggerSource::Counter1End,
+           TriggerSource::Timer0End, TriggerSource::Timer1End,
+           TriggerSource::UserOutput0, TriggerSource::UserOutput1, TriggerSource::UserOutput2,
+           TriggerSource::Action0, TriggerSource::Action1,
+           TriggerSource::Encoder0, TriggerSource::Encoder1,
+           TriggerSource::FrameTriggerWait, TriggerSource::ExposureActive
+       };
+
+       // Per ogni sorgente, trova il nome supportato
+       for (auto source : allSources) {
+          std::string mappedName = triggerSourceToString(source);
+          if (!mappedName.empty()) {
+             m_triggerSourceMap[source] = mappedName;
+          }
+       }
+
+       m_triggerSourceMapCached = true;
+    }
+
+    /**
+     * @brief Ottiene la sorgente trigger corrente
+     */
+    TriggerSource GenICamCamera::getTriggerSource() const {
+       try {
+          GenApi::CEnumerationPtr pTriggerSource = getEnumerationNode("TriggerSource");
+          std::string value = pTriggerSource->ToString().c_str();
+
+          return stringToTriggerSource(value);
+
+       }
+       catch (...) {
+          return TriggerSource::Software; // Default
+       }
+    }
+
+    /**
+     * @brief Imposta la sorgente trigger con verifica
+     */
+    void GenICamCamera::setTriggerSource(TriggerSource source) {
+       try {
+          GenApi::CEnumerationPtr pTriggerSource = getEnumerationNode("TriggerSource");
+
+          if (!GenApi::IsWritable(pTriggerSource)) {
+             THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "TriggerSource non scrivibile");
+          }
+
+          // Ottieni il nome corretto per questa camera
+          std::string sourceStr = triggerSourceToString(source);
+
+          // Verifica che sia effettivamente disponibile
+          GenApi::CEnumEntryPtr pEntry = pTriggerSource->GetEntryByName(sourceStr.c_str());
+          if (!pEntry.IsValid() || !GenApi::IsAvailable(pEntry)) {
+             THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                std::string("TriggerSource non supportato: ") + sourceStr);
+          }
+
+          *pTriggerSource = sourceStr.c_str();
+          notifyParameterChanged("TriggerSource", sourceStr);
+
+       }
+       catch (const GenICamException& e) {
+          e.what();
+          throw; // Ri-solleva
+       }
+       catch (const GENICAM_NAMESPACE::GenericException& e) {
+          THROW_GENICAM_ERROR(ErrorType::GenApiError,
+             std::string("Errore impostazione TriggerSource: ") + e.GetDescription());
+       }
+    }
+    /**
+ * @brief Ottiene le sorgenti trigger disponibili
+ */
+    std::vector<TriggerSource> GenICamCamera::getAvailableTriggerSources() const {
+       std::vector<TriggerSource> sources;
+
+       try {
+          if (!isParameterAvailable("TriggerSource")) {
+             // Se non disponibile, assume almeno Software
+             sources.push_back(TriggerSource::Software);
+             return sources;
+          }
+
+          GenApi::CEnumerationPtr pTriggerSource = getEnumerationNode("TriggerSource");
+          GenApi::NodeList_t entries;
+          pTriggerSource->GetEntries(entries);
+
+          for (auto& entry : entries) {
+             if (GenApi::IsAvailable(entry)) {
+                std::string name = entry->GetName().c_str();
+                TriggerSource source = stringToTriggerSource(name);
+
+                // Evita duplicati
+                if (std::find(sources.begin(), sources.end(), source) == sources.end()) {
+                   sources.push_back(source);
+                }
+             }
+          }
+
+          // Se nessuna sorgente trovata, aggiungi almeno Software
+          if (sources.empty()) {
+             sources.push_back(TriggerSource::Software);
+          }
+
+       }
+       catch (...) {
+          // In caso di errore, ritorna almeno Software
+          sources.push_back(TriggerSource::Software);
+       }
+
+       return sources;
+    }
+
+    /**
+     * @brief Esegue trigger software con verifica compatibilità
+     */
+    uint64_t GenICamCamera::executeTriggerSoftware() {
+       if (!m_isAcquiring) {
+          THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+             "Acquisizione non attiva");
+       }
+
+       try {
+          // Verifica che il trigger software sia abilitato
+          TriggerMode mode = getTriggerMode();
+          if (mode != TriggerMode::On) {
+             THROW_GENICAM_ERROR(ErrorType::InvalidOperation,
+                "Trigger non abilitato");
+          }
+
+          // Verifica che la sorgente sia Software
+          TriggerSource source = getTriggerSource();
+          if (source != TriggerSource::Software) {
+             THROW_GENICAM_ERROR(ErrorType::InvalidOperation,
+                "TriggerSource non impostato a Software");
+          }
+
+          // Cerca il comando TriggerSoftware
+          std::vector<std::string> commandNames = {
+              "TriggerSoftware",      // SFNC standard
+              "TriggerSoftwareExecute", // Alcune implementazioni
+              "SoftwareTrigger",      // Variante
+              "TriggerCmd"            // Legacy
+          };
+
+          bool executed = false;
+          uint64_t token = 0;
+          for (const auto& cmdName : commandNames) {
+             try {
+                GenApi::CCommandPtr pTriggerCmd = getCommandNode(cmdName);
+                if (pTriggerCmd.IsValid() && GenApi::IsWritable(pTriggerCmd)) {
+                   // Il trigger va registrato prima dell'esecuzione: il frame può
+                   // arrivare al thread di grab prima che Execute ritorni
+                   {
+                      std::lock_guard<std::mutex> lock(m_triggerMutex);
+                      token = ++m_lastTriggerToken;
+                      m_pendingTriggers.push_back({ token, std::chrono::steady_clock::now() });
+                      if (m_pendingTriggers.size() > MAX_PENDING_TRIGGERS) {
+                         m_pendingTriggers.pop_front();
+                         m_triggerFramesLost.fetch_add(1, std::memory_order_relaxed);
+                      }
+                   }
+
+                   try {
+                      pTriggerCmd->Execute();
+                   }
+                   catch (...) {
+                      std::lock_guard<std::mutex> lock(m_triggerMutex);
+                      if (!m_pendingTriggers.empty() && m_pendingTriggers.back().token == token) {
+                         m_pendingTriggers.pop_back();
+                         // Token mai restituito: riutilizzabile, la sequenza resta contigua
+                         if (m_lastTriggerToken == token) {
+                            --m_lastTriggerToken;
+                         }
+                      }
+                      throw;
+                   }
+
+                   m_triggersIssued.fetch_add(1, std::memory_order_relaxed);
+                   executed = true;
+                   break;
+                }
+             }
+             catch (...) {
+                continue;
+             }
+          }
+
+          if (!executed) {
+             THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Comando TriggerSoftware non trovato o non eseguibile");
+          }
+
+          return token;
+       }
+       catch (const GenICamException& e) {
+          e.what();
+          throw;
+       }
+       catch (const GENICAM_NAMESPACE::GenericException& e) {
+          THROW_GENICAM_ERROR(ErrorType::GenApiError,
+             std::string("Errore esecuzione trigger software: ") + e.GetDescription());
+       }
+    }
+    void GenICamCamera::setTriggerActivation(TriggerActivation activation) {
+        try {
+            GenApi::CEnumerationPtr pActivation = getEnumerationNode("TriggerActivation");
+
+            if (!GenApi::IsWritable(pActivation)) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "TriggerActivation non scrivibile");
+            }
+
+            std::string activationStr;
+            switch (activation) {
+            case TriggerActivation::RisingEdge: activationStr = "RisingEdge"; break;
+            case TriggerActivation::FallingEdge: activationStr = "FallingEdge"; break;
+            case TriggerActivation::AnyEdge: activationStr = "AnyEdge"; break;
+            case TriggerActivation::LevelHigh: activationStr = "LevelHigh"; break;
+            case TriggerActivation::LevelLow: activationStr = "LevelLow"; break;
+            }
+
+            *pActivation = activationStr.c_str();
+            notifyParameterChanged("TriggerActivation", activationStr);
+
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore impostazione TriggerActivation: ") + e.GetDescription());
+        }
+    }
+
+    TriggerActivation GenICamCamera::getTriggerActivation() const {
+        try {
+            GenApi::CEnumerationPtr pActivation = getEnumerationNode("TriggerActivation");
+            std::string value = pActivation->ToString().c_str();
+
+            if (value == "RisingEdge") return TriggerActivation::RisingEdge;
+            if (value == "FallingEdge") return TriggerActivation::FallingEdge;
+            if (value == "AnyEdge") return TriggerActivation::AnyEdge;
+            if (value == "LevelHigh") return TriggerActivation::LevelHigh;
+            if (value == "LevelLow") return TriggerActivation::LevelLow;
+
+            return TriggerActivation::RisingEdge; // Default
+
+        }
+        catch (...) {
+            return TriggerActivation::RisingEdge;
+        }
+    }
+
+    /**
+     * @brief Abilita trigger software con compatibilità estesa
+     */
+    void GenICamCamera::enableSoftwareTrigger(bool enable) {
+       if (m_isAcquiring) {
+          THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+             "Impossibile modificare trigger durante l'acquisizione");
+       }
+
+       try {
+          // 1. Imposta TriggerSelector se disponibile
+          setTriggerSelector(TriggerSelector::FrameStart);
+
+          // 2. Imposta TriggerMode
+          setTriggerMode(enable ? TriggerMode::On : TriggerMode::Off);
+
+          if (enable) {
+             // 3. Imposta TriggerSource a Software
+             setTriggerSource(TriggerSource::Software);
+
+             // 4. Configura parametri opzionali se disponibili
+             configureTriggerOptions();
+          }
+
+       }
+       catch (const GenICamException& e) {
+          e.what();
+          throw; // Ri-solleva eccezioni GenICam
+       }
+       catch (const GENICAM_NAMESPACE::GenericException& e) {
+          THROW_GENICAM_ERROR(ErrorType::GenApiError,
+             std::string("Errore configurazione trigger software: ") + e.GetDescription());
+       }
+    }
+
+    /**
+ * @brief Configura opzioni trigger opzionali
+ */
+    void GenICamCamera::configureTriggerOptions() {
+       // TriggerActivation (opzionale secondo SFNC)
+       if (isParameterAvailable("TriggerActivation")) {
+          try {
+             GenApi::CEnumerationPtr pActivation = getEnumerationNode("TriggerActivation");
+             if (GenApi::IsWritable(pActivation)) {
+                // Default a RisingEdge per software trigger
+                *pActivation = "RisingEdge";
+             }
+          }
+          catch (...) {
+             // Non critico
+          }
+       }
+
+       // TriggerDelay (opzionale)
+       if (isParameterAvailable("TriggerDelay")) {
+          try {
+             GenApi::CFloatPtr pDelay = getFloatNode("TriggerDelay");
+             if (GenApi::IsWritable(pDelay)) {
+                pDelay->SetValue(0.0); // Nessun delay per default
+             }
+          }
+          catch (...) {
+             // Non critico
+          }
+       }
+
+       // TriggerDivider (opzionale)
+       if (isParameterAvailable("TriggerDivider")) {
+          try {
+             GenApi::CIntegerPtr pDivider = getIntegerNode("TriggerDivider");
+             if (GenApi::IsWritable(pDivider)) {
+                pDivider->SetValue(1); // Ogni trigger genera un frame
+             }
+          }
+          catch (...) {
+             // Non critico
+          }
+       }
+    }
+
+    void GenICamCamera::enableHardwareTrigger(TriggerSource line, TriggerActivation activation) {
+        // Verifica che la sorgente sia una linea hardware
+        if (line < TriggerSource::Line0 || line > TriggerSource::Line7) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "La sorgente deve essere una linea hardware (Line0-Line7)");
+        }
+
+        setTriggerMode(TriggerMode::On);
+        setTriggerSource(line);
+        setTriggerActivation(activation);
+
+        std::cout << "Hardware trigger abilitato su linea "
+            << static_cast<int>(line) - static_cast<int>(TriggerSource::Line0)
+            << std::endl;
+    }
+
+    bool GenICamCamera::isTriggerEnabled() const {
+        return getTriggerMode() == TriggerMode::On;
+    }
+
+    /**
+     * @brief Ottiene configurazione trigger come stringa per debug
+     */
+    std::string GenICamCamera::getTriggerConfiguration() const {
+       std::ostringstream oss;
+
+       oss << "=== Configurazione Trigger ===" << std::endl;
+
+       try {
+          // TriggerMode
+          oss << "TriggerMode: ";
+          if (isTriggerModeAvailable()) {
+             TriggerMode mode = getTriggerMode();
+             oss << (mode == TriggerMode::On ? "On" : "Off") << std::endl;
+          }
+          else {
+             oss << "Non disponibile" << std::endl;
+          }
+
+          // TriggerSelector
+          oss << "TriggerSelector: ";
+          if (isParameterAvailable("TriggerSelector")) {
+             try {
+                TriggerSelector selector = getTriggerSelector();
+                oss << triggerSelectorToString(selector) << std::endl;
+
+                // Mostra tutti i selector disponibili
+                auto selectors = getAvailableTriggerSelectors();
+                oss << "  Disponibili: ";
+                for (size_t i = 0; i < selectors.size(); ++i) {
+                   if (i > 0) oss << ", ";
+                   oss << triggerSelectorToString(selectors[i]);
+                }
+                oss << std::endl;
+             }
+             catch (...) {
+                oss << "Errore lettura" << std::endl;
+             }
+          }
+          else {
+             oss << "Non disponibile (default: FrameStart)" << std::endl;
+          }
+
+          // TriggerSource
+          oss << "TriggerSource: ";
+          try {
+             TriggerSource source = getTriggerSource();
+             oss << triggerSourceToString(source) << std::endl;
+          }
+          catch (...) {
+             oss << "Non disponibile" << std::endl;
+          }
+
+          // Altri parametri opzionali
+          if (isParameterAvailable("TriggerActivation")) {
+             oss << "TriggerActivation: " << getParameter("TriggerActivation") << std::endl;
+          }
+
+          if (isParameterAvailable("TriggerDelay")) {
+             try {
+                double delay = getTriggerDelay();
+                oss << "TriggerDelay: " << delay << " µs" << std::endl;
+             }
+             catch (...) {}
+          }
+
+       }
+       catch (...) {
+          oss << "Errore lettura configurazione trigger" << std::endl;
+       }
+
+       return oss.str();
+    }
+
+    // === Pixel Format ===
+
+    void GenICamCamera::setPixelFormat(PixelFormat format) {
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile cambiare formato pixel durante l'acquisizione (usare reconfigureAcquisition)");
+        }
+
+        notifyParameterChanged("PixelFormat", applyPixelFormat(format));
+    }
+
+    std::string GenICamCamera::applyPixelFormat(PixelFormat format) {
+        try {
+            GenApi::CEnumerationPtr pPixelFormat = getEnumerationNode("PixelFormat");
+
+            if (!GenApi::IsWritable(pPixelFormat)) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "PixelFormat non scrivibile");
+            }
+
+            std::string formatString;
+            switch (format) {
+            case PixelFormat::Mono8: formatString = "Mono8"; break;
+            case PixelFormat::Mono10: formatString = "Mono10"; break;
+            case PixelFormat::Mono12: formatString = "Mono12"; break;
+            case PixelFormat::Mono16: formatString = "Mono16"; break;
+            case PixelFormat::RGB8: formatString = "RGB8"; break;
+            case PixelFormat::BGR8: formatString = "BGR8"; break;
+            case PixelFormat::BayerRG8: formatString = "BayerRG8"; break;
+            case PixelFormat::BayerGB8: formatString = "BayerGB8"; break;
+            case PixelFormat::BayerGR8: formatString = "BayerGR8"; break;
+            case PixelFormat::BayerBG8: formatString = "BayerBG8"; break;
+            case PixelFormat::YUV422_8: formatString = "YUV422Packed"; break;
+            default:
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "Formato pixel non supportato");
+            }
+
+            // Verifica se il formato è disponibile
+            GenApi::NodeList_t entries;
+            pPixelFormat->GetEntries(entries);
+            bool found = false;
+
+            // FIX: Conversione esplicita del nome a std::string
+            for (GenApi::NodeList_t::iterator it = entries.begin();
+                it != entries.end(); ++it) {
+                GenApi::CEnumEntryPtr pEntry(*it);
+                if (pEntry.IsValid()) {
+                    // Conversione esplicita da gcstring a std::string
+                    std::string entryName(pEntry->GetSymbolic().c_str());
+                    if (entryName == formatString) {
+                        found = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!found) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "Formato pixel non disponibile: " + formatString);
+            }
+
+            *pPixelFormat = formatString.c_str();
+            return formatString;
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore impostazione formato pixel: ") + e.GetDescription());
+        }
+    }
+    /*
+    PixelFormat GenICamCamera::getPixelFormat() const {
+        try {
+            GenApi::CEnumerationPtr pPixelFormat = getEnumerationNode("PixelFormat");
+            std::string format = pPixelFormat->ToString().c_str();
+
+            if (format == "Mono8") return PixelFormat::Mono8;
+            if (format == "Mono10") return PixelFormat::Mono10;
+            if (format == "Mono12") return PixelFormat::Mono12;
+            if (format == "Mono16") return PixelFormat::Mono16;
+            if (format == "RGB8" || format == "RGB8Packed") return PixelFormat::RGB8;
+            if (format == "BGR8" || format == "BGR8Packed") return PixelFormat::BGR8;
+            if (format == "BayerRG8") return PixelFormat::BayerRG8;
+            if (format == "BayerGB8") return PixelFormat::BayerGB8;
+            if (format == "BayerGR8") return PixelFormat::BayerGR8;
+            if (format == "BayerBG8") return PixelFormat::BayerBG8;
+            if (format == "YUV422Packed" || format == "YUV422_8") return PixelFormat::YUV422_8;
 
-          {"UserOutput1", TriggerSource::UserOutput1},
-          {"Output1", TriggerSource::UserOutput1},
-          {"DO1", TriggerSource::UserOutput1},
+            return PixelFormat::Undefined;
 
-          // Actions
-          {"Action0", TriggerSource::Action0},
-          {"ActionCommand0", TriggerSource::Action0},
-          {"Action1", TriggerSource::Action1},
-          {"ActionCommand1", TriggerSource::Action1},
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            return PixelFormat::Undefined;
+        }
+    }*/
+
+    PixelFormat GenICamCamera::getPixelFormat() const {
+       try {
+          // Ottieni il nodo PixelFormat secondo SFNC
+          GenApi::CEnumerationPtr pixelFormatNode = getEnumerationNode("PixelFormat");
+          std::string format = pixelFormatNode->ToString().c_str();
+          //GenApi::CEnumerationPtr pixelFormatNode = nodeMap->GetNode("PixelFormat");
+          if (!pixelFormatNode || !GenApi::IsReadable(pixelFormatNode)) {
+             THROW_GENICAM_ERROR(ErrorType::GenApiError, "Nodo PixelFormat non accessibile");
+          }
+
+          // Ottieni il valore corrente dell'enumerazione
+          GenApi::IEnumEntry* currentEntry = pixelFormatNode->GetCurrentEntry();
+          if (!currentEntry) {
+             THROW_GENICAM_ERROR(ErrorType::GenApiError, "Impossibile ottenere il formato pixel corrente");
+          }
+
+          // Ottieni il valore numerico del formato pixel (PFNC value)
+          int64_t pfncValue = currentEntry->GetValue();
+
+          // Log per debug
+          std::string formatName = currentEntry->GetSymbolic().c_str();
+          //logMessage("Formato pixel corrente: " + formatName + " (PFNC: 0x" + toHexString(pfncValue) + ")");
+
+          // Converti dal valore PFNC al nostro enum PixelFormat
+          PixelFormat pixFormat = convertFromGenICamPixelFormat(static_cast<uint64_t>(pfncValue));
+
+          // Se il formato non è riconosciuto, proviamo a dedurlo dal nome simbolico
+          if (pixFormat == GenICamWrapper::PixelFormat::Undefined) {
+             pixFormat = getPixelFormatFromSymbolicName(formatName);
+
+             if (pixFormat != PixelFormat::Undefined) {
+                THROW_GENICAM_ERROR(ErrorType::GenApiError, "Formato dedotto dal nome simbolico: " + formatName);
+             }
+             else {
+                THROW_GENICAM_ERROR(ErrorType::GenApiError, "ATTENZIONE: Formato pixel non riconosciuto: " + formatName + " (PFNC: 0x" + toHexString(pfncValue) + ")");
+             }
+          }
+
+          return pixFormat;
+       }
+       catch (const GENICAM_NAMESPACE::GenericException& e) {
+          THROW_GENICAM_ERROR(ErrorType::GenApiError, "Errore GenApi in getPixelFormat: " + std::string(e.what()));
+       }
+       catch (const std::exception& e) {
+          THROW_GENICAM_ERROR(ErrorType::GenApiError, "Errore in getPixelFormat: " + std::string(e.what()));
+       }
+    }
+
+    // Funzione helper per dedurre il formato dal nome simbolico
+    PixelFormat GenICamCamera::getPixelFormatFromSymbolicName(const std::string& name) const {
+       // Mappa dei nomi simbolici ai formati
+       static const std::map<std::string, PixelFormat> symbolMap = {
+          // Formati monocromatici
+          {"Mono8", PixelFormat::Mono8},
+          {"Mono10", PixelFormat::Mono10},
+          {"Mono12", PixelFormat::Mono12},
+          {"Mono14", PixelFormat::Mono14},
+          {"Mono16", PixelFormat::Mono16},
+
+          // Formati monocromatici packed
+          {"Mono10Packed", PixelFormat::Mono10Packed},
+          {"Mono12Packed", PixelFormat::Mono12Packed},
+          {"Mono10p", PixelFormat::Mono10Packed},  // Alias comune
+          {"Mono12p", PixelFormat::Mono12Packed},  // Alias comune
+
+          // Formati RGB/BGR 8 bit
+          {"RGB8", PixelFormat::RGB8},
+          {"BGR8", PixelFormat::BGR8},
+          {"RGBa8", PixelFormat::RGBa8},
+          {"BGRa8", PixelFormat::BGRa8},
+          {"RGB8Packed", PixelFormat::RGB8},  // Alias
+          {"BGR8Packed", PixelFormat::BGR8},  // Alias
+
+          // Formati RGB/BGR 10/12/16 bit
+          {"RGB10", PixelFormat::RGB10},
+          {"BGR10", PixelFormat::BGR10},
+          {"RGB12", PixelFormat::RGB12},
+          {"BGR12", PixelFormat::BGR12},
+          {"RGB16", PixelFormat::RGB16},
+          {"BGR16", PixelFormat::BGR16},
+
+          // Formati Bayer 8 bit
+          {"BayerGR8", PixelFormat::BayerGR8},
+          {"BayerRG8", PixelFormat::BayerRG8},
+          {"BayerGB8", PixelFormat::BayerGB8},
+          {"BayerBG8", PixelFormat::BayerBG8},
+
+          // Formati Bayer 10 bit
+          {"BayerGR10", PixelFormat::BayerGR10},
+          {"BayerRG10", PixelFormat::BayerRG10},
+          {"BayerGB10", PixelFormat::BayerGB10},
+          {"BayerBG10", PixelFormat::BayerBG10},
+
+          // Formati Bayer 12 bit
+          {"BayerGR12", PixelFormat::BayerGR12},
+          {"BayerRG12", PixelFormat::BayerRG12},
+          {"BayerGB12", PixelFormat::BayerGB12},
+          {"BayerBG12", PixelFormat::BayerBG12},
+
+          // Formati Bayer 16 bit
+          {"BayerGR16", PixelFormat::BayerGR16},
+          {"BayerRG16", PixelFormat::BayerRG16},
+          {"BayerGB16", PixelFormat::BayerGB16},
+          {"BayerBG16", PixelFormat::BayerBG16},
+
+          // Formati Bayer packed
+          {"BayerGR10Packed", PixelFormat::BayerGR10Packed},
+          {"BayerRG10Packed", PixelFormat::BayerRG10Packed},
+          {"BayerGB10Packed", PixelFormat::BayerGB10Packed},
+          {"BayerBG10Packed", PixelFormat::BayerBG10Packed},
+          {"BayerGR12Packed", PixelFormat::BayerGR12Packed},
+          {"BayerRG12Packed", PixelFormat::BayerRG12Packed},
+          {"BayerGB12Packed", PixelFormat::BayerGB12Packed},
+          {"BayerBG12Packed", PixelFormat::BayerBG12Packed},
+
+          // Alias comuni per formati Bayer packed
+          {"BayerGR10p", PixelFormat::BayerGR10Packed},
+          {"BayerRG10p", PixelFormat::BayerRG10Packed},
+          {"BayerGB10p", PixelFormat::BayerGB10Packed},
+          {"BayerBG10p", PixelFormat::BayerBG10Packed},
+          {"BayerGR12p", PixelFormat::BayerGR12Packed},
+          {"BayerRG12p", PixelFormat::BayerRG12Packed},
+          {"BayerGB12p", PixelFormat::BayerGB12Packed},
+          {"BayerBG12p", PixelFormat::BayerBG12Packed},
+
+          // Formati YUV
+          {"YUV422_8", PixelFormat::YUV422_8},
+          {"YUV422_8_UYVY", PixelFormat::YUV422_8_UYVY},
+          {"YUV422_8_YUYV", PixelFormat::YUV422_8_YUYV},
+          {"YUV444_8", PixelFormat::YUV444_8},
+          {"YCbCr422_8", PixelFormat::YUV422_8},  // Alias
+          {"UYVY", PixelFormat::YUV422_8_UYVY},   // Alias
+          {"YUYV", PixelFormat::YUV422_8_YUYV},   // Alias
+          {"YUY2", PixelFormat::YUV422_8_YUYV},   // Alias comune
+
+          // Formati 3D e speciali
+          {"Coord3D_ABC32f", PixelFormat::Coord3D_ABC32f},
+          {"Coord3D_ABC16", PixelFormat::Coord3D_ABC16},
+          {"Confidence8", PixelFormat::Confidence8},
+          {"Confidence16", PixelFormat::Confidence16}
+       };
+
+       auto it = symbolMap.find(name);
+       if (it != symbolMap.end()) {
+          return it->second;
+       }
+
+       return PixelFormat::Undefined;
+    }
+
+    // Funzione helper per ottenere informazioni dettagliate sul formato pixel
+    PixelFormatInfo GenICamCamera::getPixelFormatInfo() const {
+       PixelFormatInfo info;
+
+       try {
+          info.format = getPixelFormat();
+
+          if (info.format == PixelFormat::Undefined) {
+             info.isValid = false;
+             return info;
+          }
+
+          // Ottieni informazioni aggiuntive dal nodo
+          GenApi::CEnumerationPtr pixelFormatNode = getEnumerationNode("PixelFormat");
+          if (pixelFormatNode && GenApi::IsReadable(pixelFormatNode)) {
+             GenApi::IEnumEntry* currentEntry = pixelFormatNode->GetCurrentEntry();
+             if (currentEntry) {
+                info.name = currentEntry->GetSymbolic().c_str();
+                info.pfncValue = static_cast<uint64_t>(currentEntry->GetValue());
+                info.format = convertFromGenICamPixelFormat(info.pfncValue);
+
+                info.isValid = true;
+             }
+          }
+
+          // Calcola bytes per pixel
+          info.bitsPerPixel = getBitsPerPixel(info.format);
+          info.bytesPerPixel = info.bitsPerPixel / 8.0;
+          info.isPacked = (info.bitsPerPixel == 10 || info.bitsPerPixel == 12);
+
+          // Determina se è un formato Bayer
+          info.isBayer = (info.format >= PixelFormat::BayerGR8 &&
+             info.format <= PixelFormat::BayerBG12Packed);
+
+          // Determina se è un formato colore
+          info.isColor = info.isBayer ||
+             (info.format >= PixelFormat::RGB8 && info.format <= PixelFormat::BGR16) ||
+             (info.format >= PixelFormat::YUV422_8 && info.format <= PixelFormat::YUV444_8);
+
+       }
+       catch (const std::exception& e) {
+          e.what();
+          info.isValid = false;
+          info.format = PixelFormat::Undefined;
+       }
+
+       return info;
+    }
+
+    // Bit per pixel del formato così come trasmesso (packed inclusi)
+    int GenICamCamera::getBitsPerPixel(PixelFormat format) const {
+       switch (format) {
+       case PixelFormat::Mono8:
+       case PixelFormat::BayerGR8:
+       case PixelFormat::BayerRG8:
+       case PixelFormat::BayerGB8:
+       case PixelFormat::BayerBG8:
+       case PixelFormat::Confidence8:
+          return 8;
+
+       case PixelFormat::Mono10Packed:
+       case PixelFormat::BayerGR10Packed:
+       case PixelFormat::BayerRG10Packed:
+       case PixelFormat::BayerGB10Packed:
+       case PixelFormat::BayerBG10Packed:
+          return 10;
+
+       case PixelFormat::Mono12Packed:
+       case PixelFormat::BayerGR12Packed:
+       case PixelFormat::BayerRG12Packed:
+       case PixelFormat::BayerGB12Packed:
+       case PixelFormat::BayerBG12Packed:
+          return 12;
+
+       case PixelFormat::Mono10:
+       case PixelFormat::Mono12:
+       case PixelFormat::Mono14:
+       case PixelFormat::Mono16:
+       case PixelFormat::BayerGR10:
+       case PixelFormat::BayerRG10:
+       case PixelFormat::BayerGB10:
+       case PixelFormat::BayerBG10:
+       case PixelFormat::BayerGR12:
+       case PixelFormat::BayerRG12:
+       case PixelFormat::BayerGB12:
+       case PixelFormat::BayerBG12:
+       case PixelFormat::BayerGR16:
+       case PixelFormat::BayerRG16:
+       case PixelFormat::BayerGB16:
+       case PixelFormat::BayerBG16:
+       case PixelFormat::Confidence16:
+          return 16;
 
-          // Encoder
-          {"Encoder0", TriggerSource::Encoder0},
-          {"EncoderA", TriggerSource::Encoder0},
-          {"Encoder", TriggerSource::Encoder0},
+       case PixelFormat::RGB8:
+       case PixelFormat::BGR8:
+       case PixelFormat::YUV444_8:
+          return 24;
 
-          // Frame/Exposure
-          {"FrameTriggerWait", TriggerSource::FrameTriggerWait},
-          {"ExposureActive", TriggerSource::ExposureActive}
-       };
+       case PixelFormat::RGBa8:
+       case PixelFormat::BGRa8:
+          return 32;
 
-       auto it = stringMap.find(str);
-       if (it != stringMap.end()) {
-          return it->second;
-       }
+       case PixelFormat::YUV422_8:
+       case PixelFormat::YUV422_8_UYVY:
+       case PixelFormat::YUV422_8_YUYV:
+          return 16;
 
-       // Se non trovato, prova a dedurre dal pattern
-       if (str.find("Software") != std::string::npos) {
-          return TriggerSource::Software;
-       }
+       case PixelFormat::RGB10:
+       case PixelFormat::BGR10:
+       case PixelFormat::RGB12:
+       case PixelFormat::BGR12:
+       case PixelFormat::RGB16:
+       case PixelFormat::BGR16:
+       case PixelFormat::Coord3D_ABC16:
+          return 48;
 
-       // Pattern matching per Line
-       if (str.find("Line") != std::string::npos ||
-          str.find("Input") != std::string::npos ||
-          str.find("DI") != std::string::npos) {
+       case PixelFormat::Coord3D_ABC32f:
+          return 96;
 
-          // Estrai il numero
-          for (char c : str) {
-             if (c >= '0' && c <= '7') {
-                int lineNum = c - '0';
-                switch (lineNum) {
-                case 0: return TriggerSource::Line0;
-                case 1: return TriggerSource::Line1;
-                case 2: return TriggerSource::Line2;
-                case 3: return TriggerSource::Line3;
-                case 4: return TriggerSource::Line4;
-                case 5: return TriggerSource::Line5;
-                case 6: return TriggerSource::Line6;
-                case 7: return TriggerSource::Line7;
-                }
-             }
-          }
+       default:
+          return 0;
        }
+    }
 
-       // Default
-       return TriggerSource::Software;
+    // Funzione helper per convertire valore esadecimale in stringa
+    std::string GenICamCamera::toHexString(uint64_t value) const {
+       std::stringstream ss;
+       ss << std::hex << std::uppercase << value;
+       return ss.str();
     }
 
-    /**
- * @brief Cache delle mappature TriggerSource supportate dalla camera
- */
-    void GenICamCamera::cacheTriggerSourceMappings() const {
-       if (m_triggerSourceMapCached) {
-          return; // Già in cache
-       }
+    std::vector<PixelFormat> GenICamCamera::getAvailablePixelFormats() const {
+        std::vector<PixelFormat> formats;
 
-       m_triggerSourceMap.clear();
+        try {
+            GenApi::CEnumerationPtr pPixelFormat = getEnumerationNode("PixelFormat");
+            GenApi::NodeList_t entries;
+            pPixelFormat->GetEntries(entries);
 
-       // Lista di tutte le sorgenti da verificare
-       const std::vector<TriggerSource> allSources = {
-           TriggerSource::Software,
-           TriggerSource::Line0, TriggerSource::Line1, TriggerSource::Line2, TriggerSource::Line3,
-           TriggerSource::Line4, TriggerSource::Line5, TriggerSource::Line6, TriggerSource::Line7,
-           TriggerSource::Counter0End, TriggerSource::Counter1End,
-           TriggerSource::Timer0End, TriggerSource::Timer1End,
-           TriggerSource::UserOutput0, TriggerSource::UserOutput1, TriggerSource::UserOutput2,
-           TriggerSource::Action0, TriggerSource::Action1,
-           TriggerSource::Encoder0, TriggerSource::Encoder1,
-           TriggerSource::FrameTriggerWait, TriggerSource::ExposureActive
-       };
+            for (auto& entry : entries) {
+                if (GenApi::IsAvailable(entry)) {
+                    std::string name = entry->GetName().c_str();
 
-       // Per ogni sorgente, trova il nome supportato
-       for (auto source : allSources) {
-          std::string mappedName = triggerSourceToString(source);
-          if (!mappedName.empty()) {
-             m_triggerSourceMap[source] = mappedName;
-          }
-       }
+                    if (name == "Mono8") formats.push_back(PixelFormat::Mono8);
+                    else if (name == "Mono10") formats.push_back(PixelFormat::Mono10);
+                    else if (name == "Mono12") formats.push_back(PixelFormat::Mono12);
+                    else if (name == "Mono16") formats.push_back(PixelFormat::Mono16);
+                    else if (name == "RGB8" || name == "RGB8Packed")
+                        formats.push_back(PixelFormat::RGB8);
+                    else if (name == "BGR8" || name == "BGR8Packed")
+                        formats.push_back(PixelFormat::BGR8);
+                    else if (name == "BayerRG8") formats.push_back(PixelFormat::BayerRG8);
+                    else if (name == "BayerGB8") formats.push_back(PixelFormat::BayerGB8);
+                    else if (name == "BayerGR8") formats.push_back(PixelFormat::BayerGR8);
+                    else if (name == "BayerBG8") formats.push_back(PixelFormat::BayerBG8);
+                    else if (name == "YUV422Packed") formats.push_back(PixelFormat::YUV422_8);
+                }
+            }
 
-       m_triggerSourceMapCached = true;
+        }
+        catch (...) {
+            // Return empty vector
+        }
+
+        return formats;
     }
 
-    /**
-     * @brief Ottiene la sorgente trigger corrente
-     */
-    TriggerSource GenICamCamera::getTriggerSource() const {
-       try {
-          GenApi::CEnumerationPtr pTriggerSource = getEnumerationNode("TriggerSource");
-          std::string value = pTriggerSource->ToString().c_str();
+    // === Frame Rate ===
 
-          return stringToTriggerSource(value);
+    void GenICamCamera::setFrameRate(double fps) {
+        try {
+            GenApi::CFloatPtr pFrameRate;
 
-       }
-       catch (...) {
-          return TriggerSource::Software; // Default
-       }
-    }
+            // Prova diversi nomi possibili
+            const std::vector<std::string> frameRateNames = {
+                "AcquisitionFrameRate", "FrameRate", "AcquisitionFrameRateAbs"
+            };
 
-    /**
-     * @brief Imposta la sorgente trigger con verifica
-     */
-    void GenICamCamera::setTriggerSource(TriggerSource source) {
-       try {
-          GenApi::CEnumerationPtr pTriggerSource = getEnumerationNode("TriggerSource");
+            for (const auto& name : frameRateNames) {
+                try {
+                    pFrameRate = getFloatNode(name);
+                    if (GenApi::IsWritable(pFrameRate)) {
+                        break;
+                    }
+                }
+                catch (...) {
+                    continue;
+                }
+            }
 
-          if (!GenApi::IsWritable(pTriggerSource)) {
-             THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "TriggerSource non scrivibile");
-          }
+            if (!pFrameRate.IsValid() || !GenApi::IsWritable(pFrameRate)) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,"Frame rate non disponibile o non scrivibile");
+            }
 
-          // Ottieni il nome corretto per questa camera
-          std::string sourceStr = triggerSourceToString(source);
+            double min = pFrameRate->GetMin();
+            double max = pFrameRate->GetMax();
 
-          // Verifica che sia effettivamente disponibile
-          GenApi::CEnumEntryPtr pEntry = pTriggerSource->GetEntryByName(sourceStr.c_str());
-          if (!pEntry.IsValid() || !GenApi::IsAvailable(pEntry)) {
-             THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                std::string("TriggerSource non supportato: ") + sourceStr);
-          }
+            if (fps < min || fps > max) {
+                std::stringstream ss;
+                ss << "Frame rate fuori range [" << min << ", " << max << "]";
+                THROW_GENICAM_ERROR(ErrorType::ParameterError, ss.str());
+            }
 
-          *pTriggerSource = sourceStr.c_str();
-          notifyParameterChanged("TriggerSource", sourceStr);
+            pFrameRate->SetValue(fps);
+            notifyParameterChanged("FrameRate", std::to_string(fps));
 
-       }
-       catch (const GenICamException& e) {
-          e.what();
-          throw; // Ri-solleva
-       }
-       catch (const GENICAM_NAMESPACE::GenericException& e) {
-          THROW_GENICAM_ERROR(ErrorType::GenApiError,
-             std::string("Errore impostazione TriggerSource: ") + e.GetDescription());
-       }
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore impostazione frame rate: ") + e.GetDescription());
+        }
     }
-    /**
- * @brief Ottiene le sorgenti trigger disponibili
- */
-    std::vector<TriggerSource> GenICamCamera::getAvailableTriggerSources() const {
-       std::vector<TriggerSource> sources;
 
-       try {
-          if (!isParameterAvailable("TriggerSource")) {
-             // Se non disponibile, assume almeno Software
-             sources.push_back(TriggerSource::Software);
-             return sources;
-          }
+    double GenICamCamera::getFrameRate() const {
+        try {
+            const std::vector<std::string> frameRateNames = {
+                "AcquisitionFrameRate", "FrameRate", "AcquisitionFrameRateAbs"
+            };
 
-          GenApi::CEnumerationPtr pTriggerSource = getEnumerationNode("TriggerSource");
-          GenApi::NodeList_t entries;
-          pTriggerSource->GetEntries(entries);
+            for (const auto& name : frameRateNames) {
+                try {
+                    GenApi::CFloatPtr pFrameRate = getFloatNode(name);
+                    if (GenApi::IsReadable(pFrameRate)) {
+                        return pFrameRate->GetValue();
+                    }
+                }
+                catch (...) {
+                    continue;
+                }
+            }
 
-          for (auto& entry : entries) {
-             if (GenApi::IsAvailable(entry)) {
-                std::string name = entry->GetName().c_str();
-                TriggerSource source = stringToTriggerSource(name);
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Frame rate non disponibile");
 
-                // Evita duplicati
-                if (std::find(sources.begin(), sources.end(), source) == sources.end()) {
-                   sources.push_back(source);
-                }
-             }
-          }
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore lettura frame rate: ") + e.GetDescription());
+        }
+    }
 
-          // Se nessuna sorgente trovata, aggiungi almeno Software
-          if (sources.empty()) {
-             sources.push_back(TriggerSource::Software);
-          }
+    bool GenICamCamera::isFrameRateAvailable() const {
+        const std::vector<std::string> frameRateNames = {
+            "AcquisitionFrameRate", "FrameRate", "AcquisitionFrameRateAbs"
+        };
 
-       }
-       catch (...) {
-          // In caso di errore, ritorna almeno Software
-          sources.push_back(TriggerSource::Software);
-       }
+        for (const auto& name : frameRateNames) {
+            try {
+                GenApi::CNodePtr node = m_pNodeMap->_GetNode(name.c_str());
+                if (node.IsValid() && GenApi::IsImplemented(node)) {
+                    return true;
+                }
+            }
+            catch (...) {
+                continue;
+            }
+        }
 
-       return sources;
+        return false;
     }
 
-    /**
-     * @brief Esegue trigger software con verifica compatibilità
-     */
-    void GenICamCamera::executeTriggerSoftware() {
-       if (!m_isAcquiring) {
-          THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
-             "Acquisizione non attiva");
-       }
+    // === Acquisition Mode Implementation ===
 
-       try {
-          // Verifica che il trigger software sia abilitato
-          TriggerMode mode = getTriggerMode();
-          if (mode != TriggerMode::On) {
-             THROW_GENICAM_ERROR(ErrorType::InvalidOperation,
-                "Trigger non abilitato");
-          }
+    void GenICamCamera::setAcquisitionMode(AcquisitionMode mode) {
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile cambiare AcquisitionMode durante l'acquisizione");
+        }
 
-          // Verifica che la sorgente sia Software
-          TriggerSource source = getTriggerSource();
-          if (source != TriggerSource::Software) {
-             THROW_GENICAM_ERROR(ErrorType::InvalidOperation,
-                "TriggerSource non impostato a Software");
-          }
+        try {
+            GenApi::CEnumerationPtr pAcqMode = getEnumerationNode("AcquisitionMode");
 
-          // Cerca il comando TriggerSoftware
-          std::vector<std::string> commandNames = {
-              "TriggerSoftware",      // SFNC standard
-              "TriggerSoftwareExecute", // Alcune implementazioni
-              "SoftwareTrigger",      // Variante
-              "TriggerCmd"            // Legacy
-          };
+            if (!GenApi::IsWritable(pAcqMode)) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "AcquisitionMode non scrivibile");
+            }
 
-          bool executed = false;
-          for (const auto& cmdName : commandNames) {
-             try {
-                GenApi::CCommandPtr pTriggerCmd = getCommandNode(cmdName);
-                if (pTriggerCmd.IsValid() && GenApi::IsWritable(pTriggerCmd)) {
-                   pTriggerCmd->Execute();
-                   executed = true;
-                   break;
-                }
-             }
-             catch (...) {
-                continue;
-             }
-          }
+            std::string modeString;
+            switch (mode) {
+            case AcquisitionMode::SingleFrame:
+                modeString = "SingleFrame";
+                break;
+            case AcquisitionMode::MultiFrame:
+                modeString = "MultiFrame";
+                break;
+            case AcquisitionMode::Continuous:
+                modeString = "Continuous";
+                break;
+            default:
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "Modalità di acquisizione non valida");
+            }
+            // Imposta il valore
+            *pAcqMode = modeString.c_str();
+            // Notifica il cambio
+            notifyParameterChanged("AcquisitionMode", modeString);
 
-          if (!executed) {
-             THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "Comando TriggerSoftware non trovato o non eseguibile");
-          }
+            // Se stiamo passando a MultiFrame, potrebbe essere necessario 
+            // impostare anche AcquisitionFrameCount
+            if (mode == AcquisitionMode::MultiFrame) {
+                try {
+                    // Verifica se AcquisitionFrameCount esiste ed è configurabile
+                    if (isParameterAvailable("AcquisitionFrameCount") &&
+                        isParameterWritable("AcquisitionFrameCount")) {
+                        // Se non è già impostato, usa un default
+                        GenApi::CIntegerPtr pFrameCount = getIntegerNode("AcquisitionFrameCount");
+                        if (pFrameCount->GetValue() == 0) {
+                            pFrameCount->SetValue(10); // Default 10 frame
+                        }
+                    }
+                }
+                catch (...) {
+                    // Non critico se AcquisitionFrameCount non è disponibile
+                }
+            }
 
-       }
-       catch (const GenICamException& e) {
-          e.what();
-          throw;
-       }
-       catch (const GENICAM_NAMESPACE::GenericException& e) {
-          THROW_GENICAM_ERROR(ErrorType::GenApiError,
-             std::string("Errore esecuzione trigger software: ") + e.GetDescription());
-       }
+        }
+        catch (const GENICAM_NAMESPACE::GenericException& e) {
+            THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                std::string("Errore impostazione AcquisitionMode: ") + e.GetDescription());
+        }
     }
-    void GenICamCamera::setTriggerActivation(TriggerActivation activation) {
+
+    AcquisitionMode GenICamCamera::getAcquisitionMode() const {
         try {
-            GenApi::CEnumerationPtr pActivation = getEnumerationNode("TriggerActivation");
+            // Check cache first
+            auto it = m_parameterCache.find("AcquisitionMode");
+            if (it != m_parameterCache.end()) {
+                auto now = std::chrono::steady_clock::now();
+                if (now - it->second.second < CACHE_TIMEOUT) {
+                    std::string cachedValue = it->second.first;
 
-            if (!GenApi::IsWritable(pActivation)) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "TriggerActivation non scrivibile");
+                    if (cachedValue == "SingleFrame") return AcquisitionMode::SingleFrame;
+                    if (cachedValue == "MultiFrame") return AcquisitionMode::MultiFrame;
+                    if (cachedValue == "Continuous") return AcquisitionMode::Continuous;
+                }
             }
 
-            std::string activationStr;
-            switch (activation) {
-            case TriggerActivation::RisingEdge: activationStr = "RisingEdge"; break;
-            case TriggerActivation::FallingEdge: activationStr = "FallingEdge"; break;
-            case TriggerActivation::AnyEdge: activationStr = "AnyEdge"; break;
-            case TriggerActivation::LevelHigh: activationStr = "LevelHigh"; break;
-            case TriggerActivation::LevelLow: activationStr = "LevelLow"; break;
+            GenApi::CEnumerationPtr pAcqMode = getEnumerationNode("AcquisitionMode");
+
+            if (!GenApi::IsReadable(pAcqMode)) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "AcquisitionMode non leggibile");
             }
 
-            *pActivation = activationStr.c_str();
-            notifyParameterChanged("TriggerActivation", activationStr);
+            std::string modeString = pAcqMode->ToString().c_str();
+
+            // Update cache
+            m_parameterCache["AcquisitionMode"] = { modeString,
+                                                    std::chrono::steady_clock::now() };
+
+            // Converti stringa in enum
+            if (modeString == "SingleFrame") return AcquisitionMode::SingleFrame;
+            if (modeString == "MultiFrame") return AcquisitionMode::MultiFrame;
+            if (modeString == "Continuous") return AcquisitionMode::Continuous;
+
+            // Se arriviamo qui, la camera ha un valore non standard
+            // Default a Continuous
+            return AcquisitionMode::Continuous;
 
         }
         catch (const GENICAM_NAMESPACE::GenericException& e) {
             THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore impostazione TriggerActivation: ") + e.GetDescription());
+                std::string("Errore lettura AcquisitionMode: ") + e.GetDescription());
         }
     }
 
-    TriggerActivation GenICamCamera::getTriggerActivation() const {
+    bool GenICamCamera::isAcquisitionModeAvailable() const {
         try {
-            GenApi::CEnumerationPtr pActivation = getEnumerationNode("TriggerActivation");
-            std::string value = pActivation->ToString().c_str();
+            GenApi::CNodePtr node = m_pNodeMap->_GetNode("AcquisitionMode");
+            return node.IsValid() && GenApi::IsImplemented(node);
+        }
+        catch (...) {
+            return false;
+        }
+    }
 
-            if (value == "RisingEdge") return TriggerActivation::RisingEdge;
-            if (value == "FallingEdge") return TriggerActivation::FallingEdge;
-            if (value == "AnyEdge") return TriggerActivation::AnyEdge;
-            if (value == "LevelHigh") return TriggerActivation::LevelHigh;
-            if (value == "LevelLow") return TriggerActivation::LevelLow;
+    std::vector<AcquisitionMode> GenICamCamera::getAvailableAcquisitionModes() const {
+        std::vector<AcquisitionMode> modes;
+
+        try {
+            GenApi::CEnumerationPtr pAcqMode = getEnumerationNode("AcquisitionMode");
+            GenApi::NodeList_t entries;
+            pAcqMode->GetEntries(entries);
+
+            for (auto& entry : entries) {
+                if (GenApi::IsAvailable(entry)) {
+                    std::string name = entry->GetName().c_str();
+
+                    if (name == "SingleFrame") {
+                        modes.push_back(AcquisitionMode::SingleFrame);
+                    }
+                    else if (name == "MultiFrame") {
+                        modes.push_back(AcquisitionMode::MultiFrame);
+                    }
+                    else if (name == "Continuous") {
+                        modes.push_back(AcquisitionMode::Continuous);
+                    }
+                }
+            }
+        }
+        catch (...) {
+            // Se c'è un errore, ritorna vector vuoto
+        }
+
+        return modes;
+    }
+
+    // === Helper function per debug ===
+    std::string GenICamCamera::getAcquisitionModeString(AcquisitionMode mode) {
+        switch (mode) {
+        case AcquisitionMode::SingleFrame: return "SingleFrame";
+        case AcquisitionMode::MultiFrame: return "MultiFrame";
+        case AcquisitionMode::Continuous: return "Continuous";
+        default: return "Unknown";
+        }
+    }
+
+    // === Utilities e Helper ===
+
+    cv::Mat GenICamCamera::convertBufferToMat(void* buffer, size_t size, uint32_t width, uint32_t height, PixelFormat format, bool shareBuffer) const {
+       if (!buffer || size == 0 || width == 0 || height == 0) {
+          return cv::Mat();
+       }
+
+       cv::Mat resultMat;
+
+       // Uscite e intermedi dal pool: la memoria torna disponibile al rilascio del frame
+       auto pooledMat = [&](int type) {
+          return m_matPool.create(static_cast<int>(height), static_cast<int>(width), type);
+       };
+       auto pooledCopy = [&](const cv::Mat& source) {
+          cv::Mat copy = m_matPool.create(source.rows, source.cols, source.type());
+          source.copyTo(copy);
+          return copy;
+       };
+
+       switch (format) {
+          // Formati monocromatici standard
+       case PixelFormat::Mono8:
+       {
+          size_t expectedSize = width * height;
+          if (size < expectedSize) return cv::Mat();
+          resultMat = cv::Mat(height, width, CV_8UC1, buffer);
+          if (!shareBuffer) resultMat = pooledCopy(resultMat);
+          break;
+       }
 
-            return TriggerActivation::RisingEdge; // Default
+       case PixelFormat::Mono10:
+       case PixelFormat::Mono12:
+       case PixelFormat::Mono14:
+       case PixelFormat::Mono16:
+       {
+          size_t expectedSize = width * height * 2;
+          if (size < expectedSize) return cv::Mat();
+          resultMat = cv::Mat(height, width, CV_16UC1, buffer);
+          if (!shareBuffer) resultMat = pooledCopy(resultMat);
+          break;
+       }
 
-        }
-        catch (...) {
-            return TriggerActivation::RisingEdge;
-        }
-    }
+       // Formati monocromatici packed
+       case PixelFormat::Mono10Packed:
+       {
+          // 4 pixel in 5 byte
+          size_t packedSize = ((width * height * 10 + 7) / 8);
+          if (size < packedSize) return cv::Mat();
 
-    /**
-     * @brief Abilita trigger software con compatibilità estesa
-     */
-    void GenICamCamera::enableSoftwareTrigger(bool enable) {
-       if (m_isAcquiring) {
-          THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
-             "Impossibile modificare trigger durante l'acquisizione");
+          cv::Mat unpackedMat = pooledMat(CV_16UC1);
+          unpackMono10Packed(static_cast<uint8_t*>(buffer), reinterpret_cast<uint16_t*>(unpackedMat.data), width, height);
+          resultMat = unpackedMat;
+          break;
        }
 
-       try {
-          // 1. Imposta TriggerSelector se disponibile
-          setTriggerSelector(TriggerSelector::FrameStart);
-
-          // 2. Imposta TriggerMode
-          setTriggerMode(enable ? TriggerMode::On : TriggerMode::Off);
+       case PixelFormat::Mono12Packed:
+       {
+          // 2 pixel in 3 byte
+          size_t packedSize = ((width * height * 12 + 7) / 8);
+          if (size < packedSize) return cv::Mat();
 
-          if (enable) {
-             // 3. Imposta TriggerSource a Software
-             setTriggerSource(TriggerSource::Software);
+          cv::Mat unpackedMat = pooledMat(CV_16UC1);
+          unpackMono12Packed(static_cast<uint8_t*>(buffer), reinterpret_cast<uint16_t*>(unpackedMat.data), width, height);
+          resultMat = unpackedMat;
+          break;
+       }
 
-             // 4. Configura parametri opzionali se disponibili
-             configureTriggerOptions();
-          }
+       // Formati RGB/BGR 8 bit
+       case PixelFormat::RGB8:
+       {
+          size_t expectedSize = width * height * 3;
+          if (size < expectedSize) return cv::Mat();
+          cv::Mat rgbMat(height, width, CV_8UC3, buffer);
+          resultMat = pooledMat(CV_8UC3);
+          cv::cvtColor(rgbMat, resultMat, cv::COLOR_RGB2BGR);
+          break;
+       }
 
+       case PixelFormat::BGR8:
+       {
+          size_t expectedSize = width * height * 3;
+          if (size < expectedSize) return cv::Mat();
+          resultMat = cv::Mat(height, width, CV_8UC3, buffer);
+          if (!shareBuffer) resultMat = pooledCopy(resultMat);
+          break;
        }
-       catch (const GenICamException& e) {
-          e.what();
-          throw; // Ri-solleva eccezioni GenICam
+
+       case PixelFormat::RGBa8:
+       {
+          size_t expectedSize = width * height * 4;
+          if (size < expectedSize) return cv::Mat();
+          cv::Mat rgbaMat(height, width, CV_8UC4, buffer);
+          resultMat = pooledMat(CV_8UC4);
+          cv::cvtColor(rgbaMat, resultMat, cv::COLOR_RGBA2BGRA);
+          break;
        }
-       catch (const GENICAM_NAMESPACE::GenericException& e) {
-          THROW_GENICAM_ERROR(ErrorType::GenApiError,
-             std::string("Errore configurazione trigger software: ") + e.GetDescription());
+
+       case PixelFormat::BGRa8:
+       {
+          size_t expectedSize = width * height * 4;
+          if (size < expectedSize) return cv::Mat();
+          resultMat = cv::Mat(height, width, CV_8UC4, buffer);
+          if (!shareBuffer) resultMat = pooledCopy(resultMat);
+          break;
        }
-    }
 
-    /**
- * @brief Configura opzioni trigger opzionali
- */
-    void GenICamCamera::configureTriggerOptions() {
-       // TriggerActivation (opzionale secondo SFNC)
-       if (isParameterAvailable("TriggerActivation")) {
-          try {
-             GenApi::CEnumerationPtr pActivation = getEnumerationNode("TriggerActivation");
-             if (GenApi::IsWritable(pActivation)) {
-                // Default a RisingEdge per software trigger
-                *pActivation = "RisingEdge";
-             }
-          }
-          catch (...) {
-             // Non critico
-          }
+       // Formati RGB/BGR 10/12/16 bit
+       case PixelFormat::RGB10:
+       case PixelFormat::RGB12:
+       case PixelFormat::RGB16:
+       {
+          size_t expectedSize = width * height * 3 * 2;
+          if (size < expectedSize) return cv::Mat();
+          cv::Mat rgbMat(height, width, CV_16UC3, buffer);
+          resultMat = pooledMat(CV_16UC3);
+          cv::cvtColor(rgbMat, resultMat, cv::COLOR_RGB2BGR);
+          break;
        }
 
-       // TriggerDelay (opzionale)
-       if (isParameterAvailable("TriggerDelay")) {
-          try {
-             GenApi::CFloatPtr pDelay = getFloatNode("TriggerDelay");
-             if (GenApi::IsWritable(pDelay)) {
-                pDelay->SetValue(0.0); // Nessun delay per default
-             }
-          }
-          catch (...) {
-             // Non critico
-          }
+       case PixelFormat::BGR10:
+       case PixelFormat::BGR12:
+       case PixelFormat::BGR16:
+       {
+          size_t expectedSize = width * height * 3 * 2;
+          if (size < expectedSize) return cv::Mat();
+          resultMat = cv::Mat(height, width, CV_16UC3, buffer);
+          if (!shareBuffer) resultMat = pooledCopy(resultMat);
+          break;
        }
 
-       // TriggerDivider (opzionale)
-       if (isParameterAvailable("TriggerDivider")) {
-          try {
-             GenApi::CIntegerPtr pDivider = getIntegerNode("TriggerDivider");
-             if (GenApi::IsWritable(pDivider)) {
-                pDivider->SetValue(1); // Ogni trigger genera un frame
-             }
-          }
-          catch (...) {
-             // Non critico
+       // Formati Bayer 8 bit
+       case PixelFormat::BayerGR8:
+       case PixelFormat::BayerRG8:
+       case PixelFormat::BayerGB8:
+       case PixelFormat::BayerBG8:
+       {
+          size_t expectedSize = width * height;
+          if (size < expectedSize) return cv::Mat();
+          cv::Mat bayerMat(height, width, CV_8UC1, buffer);
+
+          // Converti Bayer a BGR usando il pattern appropriato
+          int conversionCode;
+          switch (format) {
+          case PixelFormat::BayerGR8: conversionCode = cv::COLOR_BayerGR2BGR; break;
+          case PixelFormat::BayerRG8: conversionCode = cv::COLOR_BayerRG2BGR; break;
+          case PixelFormat::BayerGB8: conversionCode = cv::COLOR_BayerGB2BGR; break;
+          case PixelFormat::BayerBG8: conversionCode = cv::COLOR_BayerBG2BGR; break;
+          default: return cv::Mat();
           }
+          resultMat = pooledMat(CV_8UC3);
+          cv::cvtColor(bayerMat, resultMat, conversionCode);
+          break;
        }
-    }
-
-    void GenICamCamera::enableHardwareTrigger(TriggerSource line, TriggerActivation activation) {
-        // Verifica che la sorgente sia una linea hardware
-        if (line < TriggerSource::Line0 || line > TriggerSource::Line7) {
-            THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "La sorgente deve essere una linea hardware (Line0-Line7)");
-        }
 
-        setTriggerMode(TriggerMode::On);
-        setTriggerSource(line);
-        setTriggerActivation(activation);
+       // Formati Bayer 10/12/16 bit
+       case PixelFormat::BayerGR10:
+       case PixelFormat::BayerRG10:
+       case PixelFormat::BayerGB10:
+       case PixelFormat::BayerBG10:
+       case PixelFormat::BayerGR12:
+       case PixelFormat::BayerRG12:
+       case PixelFormat::BayerGB12:
+       case PixelFormat::BayerBG12:
+       case PixelFormat::BayerGR16:
+       case PixelFormat::BayerRG16:
+       case PixelFormat::BayerGB16:
+       case PixelFormat::BayerBG16:
+       {
+          size_t expectedSize = width * height * 2;
+          if (size < expectedSize) return cv::Mat();
+          cv::Mat bayerMat(height, width, CV_16UC1, buffer);
 
-        std::cout << "Hardware trigger abilitato su linea "
-            << static_cast<int>(line) - static_cast<int>(TriggerSource::Line0)
-            << std::endl;
-    }
+          // Determina il codice di conversione corretto
+          int conversionCode;
+          if (format == PixelFormat::BayerGR10 || format == PixelFormat::BayerGR12 || format == PixelFormat::BayerGR16) {
+             conversionCode = cv::COLOR_BayerGR2BGR;
+          }
+          else if (format == PixelFormat::BayerRG10 || format == PixelFormat::BayerRG12 || format == PixelFormat::BayerRG16) {
+             conversionCode = cv::COLOR_BayerRG2BGR;
+          }
+          else if (format == PixelFormat::BayerGB10 || format == PixelFormat::BayerGB12 || format == PixelFormat::BayerGB16) {
+             conversionCode = cv::COLOR_BayerGB2BGR;
+          }
+          else {
+             conversionCode = cv::COLOR_BayerBG2BGR;
+          }
 
-    bool GenICamCamera::isTriggerEnabled() const {
-        return getTriggerMode() == TriggerMode::On;
-    }
+          // Converti a 8 bit per la demosaicizzazione
+          cv::Mat bayer8bit = pooledMat(CV_8UC1);
+          bayerMat.convertTo(bayer8bit, CV_8U, 255.0 / 65535.0);
+          resultMat = pooledMat(CV_8UC3);
+          cv::cvtColor(bayer8bit, resultMat, conversionCode);
+          break;
+       }
 
-    /**
-     * @brief Ottiene configurazione trigger come stringa per debug
-     */
-    std::string GenICamCamera::getTriggerConfiguration() const {
-       std::ostringstream oss;
+       // Formati Bayer packed
+       case PixelFormat::BayerGR10Packed:
+       case PixelFormat::BayerRG10Packed:
+       case PixelFormat::BayerGB10Packed:
+       case PixelFormat::BayerBG10Packed:
+       {
+          size_t packedSize = ((width * height * 10 + 7) / 8);
+          if (size < packedSize) return cv::Mat();
 
-       oss << "=== Configurazione Trigger ===" << std::endl;
+          cv::Mat unpackedMat = pooledMat(CV_16UC1);
+          unpackMono10Packed(static_cast<uint8_t*>(buffer),
+             reinterpret_cast<uint16_t*>(unpackedMat.data),
+             width, height);
 
-       try {
-          // TriggerMode
-          oss << "TriggerMode: ";
-          if (isTriggerModeAvailable()) {
-             TriggerMode mode = getTriggerMode();
-             oss << (mode == TriggerMode::On ? "On" : "Off") << std::endl;
-          }
-          else {
-             oss << "Non disponibile" << std::endl;
+          // Converti Bayer a BGR
+          int conversionCode;
+          switch (format) {
+          case PixelFormat::BayerGR10Packed: conversionCode = cv::COLOR_BayerGR2BGR; break;
+          case PixelFormat::BayerRG10Packed: conversionCode = cv::COLOR_BayerRG2BGR; break;
+          case PixelFormat::BayerGB10Packed: conversionCode = cv::COLOR_BayerGB2BGR; break;
+          case PixelFormat::BayerBG10Packed: conversionCode = cv::COLOR_BayerBG2BGR; break;
+          default: return cv::Mat();
           }
 
-          // TriggerSelector
-          oss << "TriggerSelector: ";
-          if (isParameterAvailable("TriggerSelector")) {
-             try {
-                TriggerSelector selector = getTriggerSelector();
-                oss << triggerSelectorToString(selector) << std::endl;
+          cv::Mat bayer8bit = pooledMat(CV_8UC1);
+          unpackedMat.convertTo(bayer8bit, CV_8U, 255.0 / 1023.0);
+          resultMat = pooledMat(CV_8UC3);
+          cv::cvtColor(bayer8bit, resultMat, conversionCode);
+          break;
+       }
+
+       case PixelFormat::BayerGR12Packed:
+       case PixelFormat::BayerRG12Packed:
+       case PixelFormat::BayerGB12Packed:
+       case PixelFormat::BayerBG12Packed:
+       {
+          size_t packedSize = ((width * height * 12 + 7) / 8);
+          if (size < packedSize) return cv::Mat();
 
-                // Mostra tutti i selector disponibili
-                auto selectors = getAvailableTriggerSelectors();
-                oss << "  Disponibili: ";
-                for (size_t i = 0; i < selectors.size(); ++i) {
-                   if (i > 0) oss << ", ";
-                   oss << triggerSelectorToString(selectors[i]);
-                }
-                oss << std::endl;
-             }
-             catch (...) {
-                oss << "Errore lettura" << std::endl;
-             }
-          }
-          else {
-             oss << "Non disponibile (default: FrameStart)" << std::endl;
-          }
+          cv::Mat unpackedMat = pooledMat(CV_16UC1);
+          unpackMono12Packed(static_cast<uint8_t*>(buffer),
+             reinterpret_cast<uint16_t*>(unpackedMat.data),
+             width, height);
 
-          // TriggerSource
-          oss << "TriggerSource: ";
-          try {
-             TriggerSource source = getTriggerSource();
-             oss << triggerSourceToString(source) << std::endl;
-          }
-          catch (...) {
-             oss << "Non disponibile" << std::endl;
+          // Converti Bayer a BGR
+          int conversionCode;
+          switch (format) {
+          case PixelFormat::BayerGR12Packed: conversionCode = cv::COLOR_BayerGR2BGR; break;
+          case PixelFormat::BayerRG12Packed: conversionCode = cv::COLOR_BayerRG2BGR; break;
+          case PixelFormat::BayerGB12Packed: conversionCode = cv::COLOR_BayerGB2BGR; break;
+          case PixelFormat::BayerBG12Packed: conversionCode = cv::COLOR_BayerBG2BGR; break;
+          default: return cv::Mat();
           }
 
-          // Altri parametri opzionali
-          if (isParameterAvailable("TriggerActivation")) {
-             oss << "TriggerActivation: " << getParameter("TriggerActivation") << std::endl;
-          }
+          cv::Mat bayer8bit = pooledMat(CV_8UC1);
+          unpackedMat.convertTo(bayer8bit, CV_8U, 255.0 / 4095.0);
+          resultMat = pooledMat(CV_8UC3);
+          cv::cvtColor(bayer8bit, resultMat, conversionCode);
+          break;
+       }
 
-          if (isParameterAvailable("TriggerDelay")) {
-             try {
-                double delay = getTriggerDelay();
-                oss << "TriggerDelay: " << delay << " µs" << std::endl;
-             }
-             catch (...) {}
-          }
+       // Formati YUV
+       case PixelFormat::YUV422_8:
+       case PixelFormat::YUV422_8_UYVY:
+       {
+          size_t expectedSize = width * height * 2;
+          if (size < expectedSize) return cv::Mat();
+          cv::Mat yuvMat(height, width, CV_8UC2, buffer);
+          resultMat = pooledMat(CV_8UC3);
+          cv::cvtColor(yuvMat, resultMat, cv::COLOR_YUV2BGR_UYVY);
+          break;
+       }
 
+       case PixelFormat::YUV422_8_YUYV:
+       {
+          size_t expectedSize = width * height * 2;
+          if (size < expectedSize) return cv::Mat();
+          cv::Mat yuvMat(height, width, CV_8UC2, buffer);
+          resultMat = pooledMat(CV_8UC3);
+          cv::cvtColor(yuvMat, resultMat, cv::COLOR_YUV2BGR_YUYV);
+          break;
        }
-       catch (...) {
-          oss << "Errore lettura configurazione trigger" << std::endl;
+
+       case PixelFormat::YUV444_8:
+       {
+          size_t expectedSize = width * height * 3;
+          if (size < expectedSize) return cv::Mat();
+          cv::Mat yuvMat(height, width, CV_8UC3, buffer);
+          resultMat = pooledMat(CV_8UC3);
+          cv::cvtColor(yuvMat, resultMat, cv::COLOR_YUV2BGR);
+          break;
        }
 
-       return oss.str();
-    }
+       // Formati 3D
+       case PixelFormat::Coord3D_ABC32f:
+       {
+          size_t expectedSize = width * height * 3 * sizeof(float);
+          if (size < expectedSize) return cv::Mat();
+          resultMat = cv::Mat(height, width, CV_32FC3, buffer);
+          if (!shareBuffer) resultMat = pooledCopy(resultMat);
+          break;
+       }
 
-    // === Pixel Format ===
+       case PixelFormat::Coord3D_ABC16:
+       {
+          size_t expectedSize = width * height * 3 * sizeof(uint16_t);
+          if (size < expectedSize) return cv::Mat();
+          resultMat = cv::Mat(height, width, CV_16UC3, buffer);
+          if (!shareBuffer) resultMat = pooledCopy(resultMat);
+          break;
+       }
 
-    void GenICamCamera::setPixelFormat(PixelFormat format) {
-        if (m_isAcquiring) {
-            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
-                "Impossibile cambiare formato pixel durante l'acquisizione");
-        }
+       case PixelFormat::Confidence8:
+       {
+          size_t expectedSize = width * height;
+          if (size < expectedSize) return cv::Mat();
+          resultMat = cv::Mat(height, width, CV_8UC1, buffer);
+          if (!shareBuffer) resultMat = pooledCopy(resultMat);
+          break;
+       }
 
-        try {
-            GenApi::CEnumerationPtr pPixelFormat = getEnumerationNode("PixelFormat");
+       case PixelFormat::Confidence16:
+       {
+          size_t expectedSize = width * height * 2;
+          if (size < expectedSize) return cv::Mat();
+          resultMat = cv::Mat(height, width, CV_16UC1, buffer);
+          if (!shareBuffer) resultMat = pooledCopy(resultMat);
+          break;
+       }
 
-            if (!GenApi::IsWritable(pPixelFormat)) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "PixelFormat non scrivibile");
-            }
+       default:
+          // Formato non supportato
+          return cv::Mat();
+       }
 
-            std::string formatString;
-            switch (format) {
-            case PixelFormat::Mono8: formatString = "Mono8"; break;
-            case PixelFormat::Mono10: formatString = "Mono10"; break;
-            case PixelFormat::Mono12: formatString = "Mono12"; break;
-            case PixelFormat::Mono16: formatString = "Mono16"; break;
-            case PixelFormat::RGB8: formatString = "RGB8"; break;
-            case PixelFormat::BGR8: formatString = "BGR8"; break;
-            case PixelFormat::BayerRG8: formatString = "BayerRG8"; break;
-            case PixelFormat::BayerGB8: formatString = "BayerGB8"; break;
-            case PixelFormat::BayerGR8: formatString = "BayerGR8"; break;
-            case PixelFormat::BayerBG8: formatString = "BayerBG8"; break;
-            case PixelFormat::YUV422_8: formatString = "YUV422Packed"; break;
-            default:
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "Formato pixel non supportato");
-            }
+       return resultMat;
+    }
 
-            // Verifica se il formato è disponibile
-            GenApi::NodeList_t entries;
-            pPixelFormat->GetEntries(entries);
-            bool found = false;
+    // Funzioni helper per la decompressione
+    void GenICamCamera::unpackMono10Packed(const uint8_t* src, uint16_t* dst, uint32_t width, uint32_t height) const {
+       for (uint32_t y = 0; y < height; ++y) {
+          const uint8_t* srcRow = src + y * ((width * 10 + 7) / 8);
+          uint16_t* dstRow = dst + y * width;
 
-            // FIX: Conversione esplicita del nome a std::string
-            for (GenApi::NodeList_t::iterator it = entries.begin();
-                it != entries.end(); ++it) {
-                GenApi::CEnumEntryPtr pEntry(*it);
-                if (pEntry.IsValid()) {
-                    // Conversione esplicita da gcstring a std::string
-                    std::string entryName(pEntry->GetSymbolic().c_str());
-                    if (entryName == formatString) {
-                        found = true;
-                        break;
-                    }
+          for (uint32_t x = 0; x < width; x += 4) {
+             if (x + 3 < width) {
+                // Decompressione gruppo completo di 4 pixel
+                dstRow[x] = (static_cast<uint16_t>(srcRow[0]) << 2) | (srcRow[1] >> 6);
+                dstRow[x + 1] = ((static_cast<uint16_t>(srcRow[1]) & 0x3F) << 4) | (srcRow[2] >> 4);
+                dstRow[x + 2] = ((static_cast<uint16_t>(srcRow[2]) & 0x0F) << 6) | (srcRow[3] >> 2);
+                dstRow[x + 3] = ((static_cast<uint16_t>(srcRow[3]) & 0x03) << 8) | srcRow[4];
+                srcRow += 5;
+             }
+             else {
+                // Gestione pixel rimanenti
+                for (uint32_t i = x; i < width; ++i) {
+                   dstRow[i] = static_cast<uint16_t>(*srcRow++) << 2;
                 }
-            }
-
-            if (!found) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "Formato pixel non disponibile: " + formatString);
-            }
+             }
+          }
+       }
+    }
 
-            *pPixelFormat = formatString.c_str();
-            notifyParameterChanged("PixelFormat", formatString);
+    void GenICamCamera::unpackMono12Packed(const uint8_t* src, uint16_t* dst, uint32_t width, uint32_t height) const {
+       for (uint32_t y = 0; y < height; ++y) {
+          const uint8_t* srcRow = src + y * ((width * 12 + 7) / 8);
+          uint16_t* dstRow = dst + y * width;
 
-        }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore impostazione formato pixel: ") + e.GetDescription());
-        }
+          for (uint32_t x = 0; x < width; x += 2) {
+             if (x + 1 < width) {
+                // Decompressione gruppo completo di 2 pixel
+                dstRow[x] = (static_cast<uint16_t>(srcRow[0]) << 4) | (srcRow[1] >> 4);
+                dstRow[x + 1] = ((static_cast<uint16_t>(srcRow[1]) & 0x0F) << 8) | srcRow[2];
+                srcRow += 3;
+             }
+             else {
+                // Ultimo pixel dispari
+                dstRow[x] = (static_cast<uint16_t>(srcRow[0]) << 4) | (srcRow[1] >> 4);
+             }
+          }
+       }
     }
-    /*
-    PixelFormat GenICamCamera::getPixelFormat() const {
-        try {
-            GenApi::CEnumerationPtr pPixelFormat = getEnumerationNode("PixelFormat");
-            std::string format = pPixelFormat->ToString().c_str();
+    PixelFormat GenICamCamera::convertFromGenICamPixelFormat(uint64_t genICamFormat) const {
+       // Mappatura basata su PFNC (Pixel Format Naming Convention) v2.5
+       switch (genICamFormat) {
+          // Formati monocromatici
+       case 0x01080001: return PixelFormat::Mono8;
+       case 0x01100003: return PixelFormat::Mono10;
+       case 0x01100005: return PixelFormat::Mono12;
+       case 0x01100009: return PixelFormat::Mono14;
+       case 0x01100007: return PixelFormat::Mono16;
 
-            if (format == "Mono8") return PixelFormat::Mono8;
-            if (format == "Mono10") return PixelFormat::Mono10;
-            if (format == "Mono12") return PixelFormat::Mono12;
-            if (format == "Mono16") return PixelFormat::Mono16;
-            if (format == "RGB8" || format == "RGB8Packed") return PixelFormat::RGB8;
-            if (format == "BGR8" || format == "BGR8Packed") return PixelFormat::BGR8;
-            if (format == "BayerRG8") return PixelFormat::BayerRG8;
-            if (format == "BayerGB8") return PixelFormat::BayerGB8;
-            if (format == "BayerGR8") return PixelFormat::BayerGR8;
-            if (format == "BayerBG8") return PixelFormat::BayerBG8;
-            if (format == "YUV422Packed" || format == "YUV422_8") return PixelFormat::YUV422_8;
+          // Formati monocromatici packed
+       case 0x010C0004: return PixelFormat::Mono10Packed;
+       case 0x010C0006: return PixelFormat::Mono12Packed;
 
-            return PixelFormat::Undefined;
+          // Formati RGB 8 bit
+       case 0x02180014: return PixelFormat::RGB8;
+       case 0x02180015: return PixelFormat::BGR8;
+       case 0x02200016: return PixelFormat::RGBa8;
+       case 0x02200017: return PixelFormat::BGRa8;
 
-        }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            return PixelFormat::Undefined;
-        }
-    }*/
+          // Formati RGB 10/12/16 bit
+       case 0x02300018: return PixelFormat::RGB10;
+       case 0x02300019: return PixelFormat::BGR10;
+       case 0x0230001C: return PixelFormat::RGB12;
+       case 0x0230001D: return PixelFormat::BGR12;
+       case 0x02300033: return PixelFormat::RGB16;
+       case 0x0230004B: return PixelFormat::BGR16;
 
-    PixelFormat GenICamCamera::getPixelFormat() const {
-       try {
-          // Ottieni il nodo PixelFormat secondo SFNC
-          GenApi::CEnumerationPtr pixelFormatNode = getEnumerationNode("PixelFormat");
-          std::string format = pixelFormatNode->ToString().c_str();
-          //GenApi::CEnumerationPtr pixelFormatNode = nodeMap->GetNode("PixelFormat");
-          if (!pixelFormatNode || !GenApi::IsReadable(pixelFormatNode)) {
-             THROW_GENICAM_ERROR(ErrorType::GenApiError, "Nodo PixelFormat non accessibile");
-          }
+          // Formati Bayer 8 bit
+       case 0x01080008: return PixelFormat::BayerGR8;
+       case 0x01080009: return PixelFormat::BayerRG8;
+       case 0x0108000A: return PixelFormat::BayerGB8;
+       case 0x0108000B: return PixelFormat::BayerBG8;
 
-          // Ottieni il valore corrente dell'enumerazione
-          GenApi::IEnumEntry* currentEntry = pixelFormatNode->GetCurrentEntry();
-          if (!currentEntry) {
-             THROW_GENICAM_ERROR(ErrorType::GenApiError, "Impossibile ottenere il formato pixel corrente");
-          }
+          // Formati Bayer 10 bit
+       case 0x0110000C: return PixelFormat::BayerGR10;
+       case 0x0110000D: return PixelFormat::BayerRG10;
+       case 0x0110000E: return PixelFormat::BayerGB10;
+       case 0x0110000F: return PixelFormat::BayerBG10;
 
-          // Ottieni il valore numerico del formato pixel (PFNC value)
-          int64_t pfncValue = currentEntry->GetValue();
+          // Formati Bayer 12 bit
+       case 0x01100010: return PixelFormat::BayerGR12;
+       case 0x01100011: return PixelFormat::BayerRG12;
+       case 0x01100012: return PixelFormat::BayerGB12;
+       case 0x01100013: return PixelFormat::BayerBG12;
 
-          // Log per debug
-          std::string formatName = currentEntry->GetSymbolic().c_str();
-          //logMessage("Formato pixel corrente: " + formatName + " (PFNC: 0x" + toHexString(pfncValue) + ")");
+          // Formati Bayer 16 bit
+       case 0x0110002E: return PixelFormat::BayerGR16;
+       case 0x0110002F: return PixelFormat::BayerRG16;
+       case 0x01100030: return PixelFormat::BayerGB16;
+       case 0x01100031: return PixelFormat::BayerBG16;
 
-          // Converti dal valore PFNC al nostro enum PixelFormat
-          PixelFormat pixFormat = convertFromGenICamPixelFormat(static_cast<uint64_t>(pfncValue));
+          // Formati Bayer packed
+       case 0x010C0026: return PixelFormat::BayerGR10Packed;
+       case 0x010C0027: return PixelFormat::BayerRG10Packed;
+       case 0x010C0028: return PixelFormat::BayerGB10Packed;
+       case 0x010C0029: return PixelFormat::BayerBG10Packed;
+       case 0x010C002A: return PixelFormat::BayerGR12Packed;
+       case 0x010C002B: return PixelFormat::BayerRG12Packed;
+       case 0x010C002C: return PixelFormat::BayerGB12Packed;
+       case 0x010C002D: return PixelFormat::BayerBG12Packed;
 
-          // Se il formato non è riconosciuto, proviamo a dedurlo dal nome simbolico
-          if (pixFormat == GenICamWrapper::PixelFormat::Undefined) {
-             pixFormat = getPixelFormatFromSymbolicName(formatName);
+          // Formati YUV
+       case 0x02100032: return PixelFormat::YUV422_8;      // YUV422_8 generico
+       case 0x0210001F: return PixelFormat::YUV422_8_UYVY; // UYVY
+       case 0x02100022: return PixelFormat::YUV422_8_YUYV; // YUYV  
+       case 0x02180020: return PixelFormat::YUV444_8;
 
-             if (pixFormat != PixelFormat::Undefined) {
-                THROW_GENICAM_ERROR(ErrorType::GenApiError, "Formato dedotto dal nome simbolico: " + formatName);
-             }
-             else {
-                THROW_GENICAM_ERROR(ErrorType::GenApiError, "ATTENZIONE: Formato pixel non riconosciuto: " + formatName + " (PFNC: 0x" + toHexString(pfncValue) + ")");
-             }
-          }
+          // Formati 3D e speciali
+       case 0x023000C0: return PixelFormat::Coord3D_ABC32f;
+       case 0x023000C1: return PixelFormat::Coord3D_ABC16;
+       case 0x010800C4: return PixelFormat::Confidence8;
+       case 0x011000C5: return PixelFormat::Confidence16;
 
-          return pixFormat;
-       }
-       catch (const GENICAM_NAMESPACE::GenericException& e) {
-          THROW_GENICAM_ERROR(ErrorType::GenApiError, "Errore GenApi in getPixelFormat: " + std::string(e.what()));
-       }
-       catch (const std::exception& e) {
-          THROW_GENICAM_ERROR(ErrorType::GenApiError, "Errore in getPixelFormat: " + std::string(e.what()));
+          // Formato non riconosciuto
+       default: return PixelFormat::Undefined;
        }
     }
 
-    // Funzione helper per dedurre il formato dal nome simbolico
-    PixelFormat GenICamCamera::getPixelFormatFromSymbolicName(const std::string& name) const {
-       // Mappa dei nomi simbolici ai formati
-       static const std::map<std::string, PixelFormat> symbolMap = {
+    uint64_t GenICamCamera::convertToGenICamPixelFormat(PixelFormat format) const {
+       switch (format) {
           // Formati monocromatici
-          {"Mono8", PixelFormat::Mono8},
-          {"Mono10", PixelFormat::Mono10},
-          {"Mono12", PixelFormat::Mono12},
-          {"Mono14", PixelFormat::Mono14},
-          {"Mono16", PixelFormat::Mono16},
+       case PixelFormat::Mono8:         return 0x01080001;
+       case PixelFormat::Mono10:        return 0x01100003;
+       case PixelFormat::Mono12:        return 0x01100005;
+       case PixelFormat::Mono14:        return 0x01100009;
+       case PixelFormat::Mono16:        return 0x01100007;
 
           // Formati monocromatici packed
-          {"Mono10Packed", PixelFormat::Mono10Packed},
-          {"Mono12Packed", PixelFormat::Mono12Packed},
-          {"Mono10p", PixelFormat::Mono10Packed},  // Alias comune
-          {"Mono12p", PixelFormat::Mono12Packed},  // Alias comune
+       case PixelFormat::Mono10Packed:  return 0x010C0004;
+       case PixelFormat::Mono12Packed:  return 0x010C0006;
 
-          // Formati RGB/BGR 8 bit
-          {"RGB8", PixelFormat::RGB8},
-          {"BGR8", PixelFormat::BGR8},
-          {"RGBa8", PixelFormat::RGBa8},
-          {"BGRa8", PixelFormat::BGRa8},
-          {"RGB8Packed", PixelFormat::RGB8},  // Alias
-          {"BGR8Packed", PixelFormat::BGR8},  // Alias
+          // Formati RGB 8 bit
+       case PixelFormat::RGB8:          return 0x02180014;
+       case PixelFormat::BGR8:          return 0x02180015;
+       case PixelFormat::RGBa8:         return 0x02200016;
+       case PixelFormat::BGRa8:         return 0x02200017;
 
-          // Formati RGB/BGR 10/12/16 bit
-          {"RGB10", PixelFormat::RGB10},
-          {"BGR10", PixelFormat::BGR10},
-          {"RGB12", PixelFormat::RGB12},
-          {"BGR12", PixelFormat::BGR12},
-          {"RGB16", PixelFormat::RGB16},
-          {"BGR16", PixelFormat::BGR16},
+          // Formati RGB 10/12/16 bit
+       case PixelFormat::RGB10:         return 0x02300018;
+       case PixelFormat::BGR10:         return 0x02300019;
+       case PixelFormat::RGB12:         return 0x0230001C;
+       case PixelFormat::BGR12:         return 0x0230001D;
+       case PixelFormat::RGB16:         return 0x02300033;
+       case PixelFormat::BGR16:         return 0x0230004B;
 
           // Formati Bayer 8 bit
-          {"BayerGR8", PixelFormat::BayerGR8},
-          {"BayerRG8", PixelFormat::BayerRG8},
-          {"BayerGB8", PixelFormat::BayerGB8},
-          {"BayerBG8", PixelFormat::BayerBG8},
+       case PixelFormat::BayerGR8:      return 0x01080008;
+       case PixelFormat::BayerRG8:      return 0x01080009;
+       case PixelFormat::BayerGB8:      return 0x0108000A;
+       case PixelFormat::BayerBG8:      return 0x0108000B;
 
           // Formati Bayer 10 bit
-          {"BayerGR10", PixelFormat::BayerGR10},
-          {"BayerRG10", PixelFormat::BayerRG10},
-          {"BayerGB10", PixelFormat::BayerGB10},
-          {"BayerBG10", PixelFormat::BayerBG10},
+       case PixelFormat::BayerGR10:     return 0x0110000C;
+       case PixelFormat::BayerRG10:     return 0x0110000D;
+       case PixelFormat::BayerGB10:     return 0x0110000E;
+       case PixelFormat::BayerBG10:     return 0x0110000F;
 
           // Formati Bayer 12 bit
-          {"BayerGR12", PixelFormat::BayerGR12},
-          {"BayerRG12", PixelFormat::BayerRG12},
-          {"BayerGB12", PixelFormat::BayerGB12},
-          {"BayerBG12", PixelFormat::BayerBG12},
+       case PixelFormat::BayerGR12:     return 0x01100010;
+       case PixelFormat::BayerRG12:     return 0x01100011;
+       case PixelFormat::BayerGB12:     return 0x01100012;
+       case PixelFormat::BayerBG12:     return 0x01100013;
 
           // Formati Bayer 16 bit
-          {"BayerGR16", PixelFormat::BayerGR16},
-          {"BayerRG16", PixelFormat::BayerRG16},
-          {"BayerGB16", PixelFormat::BayerGB16},
-          {"BayerBG16", PixelFormat::BayerBG16},
+       case PixelFormat::BayerGR16:     return 0x0110002E;
+       case PixelFormat::BayerRG16:     return 0x0110002F;
+       case PixelFormat::BayerGB16:     return 0x01100030;
+       case PixelFormat::BayerBG16:     return 0x01100031;
 
           // Formati Bayer packed
-          {"BayerGR10Packed", PixelFormat::BayerGR10Packed},
-          {"BayerRG10Packed", PixelFormat::BayerRG10Packed},
-          {"BayerGB10Packed", PixelFormat::BayerGB10Packed},
-          {"BayerBG10Packed", PixelFormat::BayerBG10Packed},
-          {"BayerGR12Packed", PixelFormat::BayerGR12Packed},
-          {"BayerRG12Packed", PixelFormat::BayerRG12Packed},
-          {"BayerGB12Packed", PixelFormat::BayerGB12Packed},
-          {"BayerBG12Packed", PixelFormat::BayerBG12Packed},
-
-          // Alias comuni per formati Bayer packed
-          {"BayerGR10p", PixelFormat::BayerGR10Packed},
-          {"BayerRG10p", PixelFormat::BayerRG10Packed},
-          {"BayerGB10p", PixelFormat::BayerGB10Packed},
-          {"BayerBG10p", PixelFormat::BayerBG10Packed},
-          {"BayerGR12p", PixelFormat::BayerGR12Packed},
-          {"BayerRG12p", PixelFormat::BayerRG12Packed},
-          {"BayerGB12p", PixelFormat::BayerGB12Packed},
-          {"BayerBG12p", PixelFormat::BayerBG12Packed},
+       case PixelFormat::BayerGR10Packed: return 0x010C0026;
+       case PixelFormat::BayerRG10Packed: return 0x010C0027;
+       case PixelFormat::BayerGB10Packed: return 0x010C0028;
+       case PixelFormat::BayerBG10Packed: return 0x010C0029;
+       case PixelFormat::BayerGR12Packed: return 0x010C002A;
+       case PixelFormat::BayerRG12Packed: return 0x010C002B;
+       case PixelFormat::BayerGB12Packed: return 0x010C002C;
+       case PixelFormat::BayerBG12Packed: return 0x010C002D;
 
           // Formati YUV
-          {"YUV422_8", PixelFormat::YUV422_8},
-          {"YUV422_8_UYVY", PixelFormat::YUV422_8_UYVY},
-          {"YUV422_8_YUYV", PixelFormat::YUV422_8_YUYV},
-          {"YUV444_8", PixelFormat::YUV444_8},
-          {"YCbCr422_8", PixelFormat::YUV422_8},  // Alias
-          {"UYVY", PixelFormat::YUV422_8_UYVY},   // Alias
-          {"YUYV", PixelFormat::YUV422_8_YUYV},   // Alias
-          {"YUY2", PixelFormat::YUV422_8_YUYV},   // Alias comune
+       case PixelFormat::YUV422_8:      return 0x02100032;
+       case PixelFormat::YUV422_8_UYVY: return 0x0210001F;
+       case PixelFormat::YUV422_8_YUYV: return 0x02100022;
+       case PixelFormat::YUV444_8:      return 0x02180020;
 
           // Formati 3D e speciali
-          {"Coord3D_ABC32f", PixelFormat::Coord3D_ABC32f},
-          {"Coord3D_ABC16", PixelFormat::Coord3D_ABC16},
-          {"Confidence8", PixelFormat::Confidence8},
-          {"Confidence16", PixelFormat::Confidence16}
-       };
+       case PixelFormat::Coord3D_ABC32f: return 0x023000C0;
+       case PixelFormat::Coord3D_ABC16:  return 0x023000C1;
+       case PixelFormat::Confidence8:    return 0x010800C4;
+       case PixelFormat::Confidence16:   return 0x011000C5;
+
+          // Formato non definito
+       case PixelFormat::Undefined:
+       default:                         return 0x00000000;
+       }
+    }
+    std::string GenICamCamera::getGenTLErrorString(GenTL::GC_ERROR error) const {
+        return GenICamException::getGenTLErrorString(error);
+    }
+
+    // === Grab Single Frame ===
+    cv::Mat GenICamCamera::grabSingleFrame(uint32_t timeoutMs) {
+       if (!isConnected()) {
+          THROW_GENICAM_ERROR(ErrorType::ConnectionError, "Camera non connessa");
+       }
+
+       if (m_isAcquiring) {
+          THROW_GENICAM_ERROR(ErrorType::AcquisitionError, "Acquisizione continua in corso");
+       }
+
+       cv::Mat result;
+       GenTL::GC_ERROR err;
+
+       try {
+          //configureHikrobotGigE(); // Configura la camera per SingleFrame
+          debugAcquisitionStart();
+          prepareTransportLayerForAcquisition();
+          setTransportLayerLock(false);   // nel caso in cui fosse stato bloccato prima malamentemente
+
+          //PRIMA configura la camera per SingleFrame (PRIMA di aprire il DataStream)
+          std::cout << "1. Configurazione camera per acquisizione singola..." << std::endl;
+          // Imposta AcquisitionMode PRIMA di tutto
+          if (isAcquisitionModeAvailable()) {
+             setAcquisitionMode(AcquisitionMode::Continuous);
+          }
+
+          // i parametri che pilotano l'acquisizione devono essere impostati prima del blocco dei parametri GenTL
+          if (isTriggerModeAvailable()) {
+             setTriggerMode(TriggerMode::On);
+             if (getTriggerMode() == TriggerMode::On)
+                setTriggerSource(TriggerSource::Software);
+          }
+
+          // bisogna bloccare i parametri Transport Layer prima di proseguire dello streaming!!!!...e sbloccarli appena dopo le deallocazione dello streaming
+          setTransportLayerLock(true);
 
-       auto it = symbolMap.find(name);
-       if (it != symbolMap.end()) {
-          return it->second;
-       }
+          // 2. ORA apri il DataStream
+          std::cout << "2. Apertura DataStream..." << std::endl;
 
-       return PixelFormat::Undefined;
-    }
+          openDataStream();
 
-    // Funzione helper per ottenere informazioni dettagliate sul formato pixel
-    PixelFormatInfo GenICamCamera::getPixelFormatInfo() const {
-       PixelFormatInfo info;
+          // 3. Ottieni dimensione buffer
+          updateBufferSize();
 
-       try {
-          info.format = getPixelFormat();
+          std::cout << "3. Buffer size calcolato: " << m_bufferSize << " bytes" << std::endl;
 
-          if (info.format == PixelFormat::Undefined) {
-             info.isValid = false;
-             return info;
+          // 4. Alloca e registra buffer
+          allocateBuffers(1);
+
+          // 5. Metti il buffer in coda
+          for (auto& hBuffer : m_bufferHandles) {
+             err = GENTL_CALL(DSQueueBuffer)(m_dsHandle, hBuffer);
+             if (err != GenTL::GC_ERR_SUCCESS) {
+                THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, "Impossibile accodare il buffer", err);
+             }
           }
 
-          // Ottieni informazioni aggiuntive dal nodo
-          GenApi::CEnumerationPtr pixelFormatNode = getEnumerationNode("PixelFormat");
-          if (pixelFormatNode && GenApi::IsReadable(pixelFormatNode)) {
-             GenApi::IEnumEntry* currentEntry = pixelFormatNode->GetCurrentEntry();
-             if (currentEntry) {
-                info.name = currentEntry->GetSymbolic().c_str();
-                info.pfncValue = static_cast<uint64_t>(currentEntry->GetValue());
-                info.format = convertFromGenICamPixelFormat(info.pfncValue);
+          // 8. IMPORTANTE: Per Hikrobot, potrebbe essere necessario un piccolo delay
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-                info.isValid = true;
-             }
+          // 6. Registra evento
+          err = GENTL_CALL(GCRegisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER, &m_eventHandle);
+          if (err != GenTL::GC_ERR_SUCCESS) {
+             THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Impossibile registrare l'evento NEW_BUFFER", err);
           }
 
-          // Calcola bytes per pixel
-          switch (info.format) {
-          case PixelFormat::Mono8:
-          case PixelFormat::BayerGR8:
-          case PixelFormat::BayerRG8:
-          case PixelFormat::BayerGB8:
-          case PixelFormat::BayerBG8:
-          case PixelFormat::Confidence8:
-             info.bytesPerPixel = 1.0;
-             info.bitsPerPixel = 8;
-             break;
-
-          case PixelFormat::Mono10Packed:
-          case PixelFormat::BayerGR10Packed:
-          case PixelFormat::BayerRG10Packed:
-          case PixelFormat::BayerGB10Packed:
-          case PixelFormat::BayerBG10Packed:
-             info.bytesPerPixel = 1.25;  // 10 bits = 1.25 bytes
-             info.bitsPerPixel = 10;
-             info.isPacked = true;
-             break;
-
-          case PixelFormat::Mono12Packed:
-          case PixelFormat::BayerGR12Packed:
-          case PixelFormat::BayerRG12Packed:
-          case PixelFormat::BayerGB12Packed:
-          case PixelFormat::BayerBG12Packed:
-             info.bytesPerPixel = 1.5;   // 12 bits = 1.5 bytes
-             info.bitsPerPixel = 12;
-             info.isPacked = true;
-             break;
-
-          case PixelFormat::Mono10:
-          case PixelFormat::Mono12:
-          case PixelFormat::Mono14:
-          case PixelFormat::Mono16:
-          case PixelFormat::BayerGR10:
-          case PixelFormat::BayerRG10:
-          case PixelFormat::BayerGB10:
-          case PixelFormat::BayerBG10:
-          case PixelFormat::BayerGR12:
-          case PixelFormat::BayerRG12:
-          case PixelFormat::BayerGB12:
-          case PixelFormat::BayerBG12:
-          case PixelFormat::BayerGR16:
-          case PixelFormat::BayerRG16:
-          case PixelFormat::BayerGB16:
-          case PixelFormat::BayerBG16:
-          case PixelFormat::Confidence16:
-             info.bytesPerPixel = 2.0;
-             info.bitsPerPixel = 16;
-             break;
-
-          case PixelFormat::RGB8:
-          case PixelFormat::BGR8:
-          case PixelFormat::YUV444_8:
-             info.bytesPerPixel = 3.0;
-             info.bitsPerPixel = 24;
-             break;
-
-          case PixelFormat::RGBa8:
-          case PixelFormat::BGRa8:
-             info.bytesPerPixel = 4.0;
-             info.bitsPerPixel = 32;
-             break;
-
-          case PixelFormat::YUV422_8:
-          case PixelFormat::YUV422_8_UYVY:
-          case PixelFormat::YUV422_8_YUYV:
-             info.bytesPerPixel = 2.0;
-             info.bitsPerPixel = 16;
-             break;
-
-          case PixelFormat::RGB10:
-          case PixelFormat::BGR10:
-          case PixelFormat::RGB12:
-          case PixelFormat::BGR12:
-          case PixelFormat::RGB16:
-          case PixelFormat::BGR16:
-          case PixelFormat::Coord3D_ABC16:
-             info.bytesPerPixel = 6.0;
-             info.bitsPerPixel = 48;
-             break;
-
-          case PixelFormat::Coord3D_ABC32f:
-             info.bytesPerPixel = 12.0;
-             info.bitsPerPixel = 96;
-             break;
-
-          default:
-             info.bytesPerPixel = 0.0;
-             info.bitsPerPixel = 0;
-             break;
+          size_t numDelivered = 0, numQueued = 0, numStarted = 0, isGrabbing = 0, numAnnounced = 0, numAwaitDelivery = 0;
+
+          GenTL::INFO_DATATYPE dt;
+          size_t sz = sizeof(numQueued);
+          GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_QUEUED, &dt, &numQueued, &sz);
+          std::cout << "   - Queued prima di DSAcquisition: " << numQueued << std::endl;
+
+          // 7. Avvia il DataStream
+          std::cout << "4. Avvio DataStream..." << std::endl;
+          err = GENTL_CALL(DSStartAcquisition)(m_dsHandle, GenTL::ACQ_START_FLAGS_DEFAULT, GENTL_INFINITE);
+          if (err != GenTL::GC_ERR_SUCCESS) {
+             THROW_GENICAM_ERROR_CODE(ErrorType::AcquisitionError, "Impossibile avviare l'acquisizione sul data stream", err);
           }
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-          // Determina se è un formato Bayer
-          info.isBayer = (info.format >= PixelFormat::BayerGR8 &&
-             info.format <= PixelFormat::BayerBG12Packed);
+          // 10. Per SingleFrame, potrebbe essere necessario un trigger
+/*            if (getAcquisitionMode() == AcquisitionMode::SingleFrame) {
+                // Alcune telecamere Hikrobot richiedono un comando specifico
+                try {
+                    GenApi::CCommandPtr pFrameStart = getCommandNode("TriggerSoftware");
+                    if (pFrameStart.IsValid() && GenApi::IsWritable(pFrameStart)) {
+                        std::cout << "6. Esecuzione TriggerSoftware per SingleFrame..." << std::endl;
+                        pFrameStart->Execute();
+                    }
+                }
+                catch (...) {
+                    // Non critico se non disponibile
+                }
+            }*/
 
-          // Determina se è un formato colore
-          info.isColor = info.isBayer ||
-             (info.format >= PixelFormat::RGB8 && info.format <= PixelFormat::BGR16) ||
-             (info.format >= PixelFormat::YUV422_8 && info.format <= PixelFormat::YUV444_8);
+            // 9. Avvia acquisizione sulla camera
+          std::cout << "5. Avvio acquisizione camera..." << std::endl;
 
-       }
-       catch (const std::exception& e) {
-          e.what();
-          info.isValid = false;
-          info.format = PixelFormat::Undefined;
-       }
+          try {
+             //GenApi::CCommandPtr pAcqStart = getCommandNode("AcquisitionStart");
+             GenApi::CCommandPtr pAcqStart = m_pNodeMap->_GetNode("AcquisitionStart");
+             refreshNodeMap();
+             
+             if (pAcqStart.IsValid()) {
+                pAcqStart->Execute();
 
-       return info;
-    }
+                // Attendi che il comando sia completato
+                int waitCount = 0;
+                while (!pAcqStart->IsDone() && waitCount < 100) {
+                   std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                   waitCount++;
+                }
+                m_isAcquiring = true;
+                m_stopAcquisition = false;
+                std::cout << "   AcquisitionStart eseguito con successo" << std::endl;
+             }
+             else {
+                std::cout << "   WARNING: AcquisitionStart non disponibile" << std::endl;
+             }
+          }
+          catch (const GENICAM_NAMESPACE::GenericException& e) {
+             std::cout << "   WARNING: AcquisitionStart fallito: " << e.GetDescription() << std::endl;
+             // Continua comunque, alcune camere non richiedono questo comando
+          }
 
-    // Funzione helper per convertire valore esadecimale in stringa
-    std::string GenICamCamera::toHexString(uint64_t value) const {
-       std::stringstream ss;
-       ss << std::hex << std::uppercase << value;
-       return ss.str();
-    }
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+          if (getTriggerMode() == TriggerMode::On)
+             executeTriggerSoftware();
 
-    std::vector<PixelFormat> GenICamCamera::getAvailablePixelFormats() const {
-        std::vector<PixelFormat> formats;
+          // 11. Attendi il frame
+          GenTL::EVENT_NEW_BUFFER_DATA bufferData;
+          size_t bufferDataSize = sizeof(bufferData);
 
-        try {
-            GenApi::CEnumerationPtr pPixelFormat = getEnumerationNode("PixelFormat");
-            GenApi::NodeList_t entries;
-            pPixelFormat->GetEntries(entries);
+          std::cout << "7. Attesa frame (timeout: " << timeoutMs << "ms)..." << std::endl;
 
-            for (auto& entry : entries) {
-                if (GenApi::IsAvailable(entry)) {
-                    std::string name = entry->GetName().c_str();
+          err = GENTL_CALL(EventGetData)(m_eventHandle, &bufferData, &bufferDataSize, timeoutMs);
 
-                    if (name == "Mono8") formats.push_back(PixelFormat::Mono8);
-                    else if (name == "Mono10") formats.push_back(PixelFormat::Mono10);
-                    else if (name == "Mono12") formats.push_back(PixelFormat::Mono12);
-                    else if (name == "Mono16") formats.push_back(PixelFormat::Mono16);
-                    else if (name == "RGB8" || name == "RGB8Packed")
-                        formats.push_back(PixelFormat::RGB8);
-                    else if (name == "BGR8" || name == "BGR8Packed")
-                        formats.push_back(PixelFormat::BGR8);
-                    else if (name == "BayerRG8") formats.push_back(PixelFormat::BayerRG8);
-                    else if (name == "BayerGB8") formats.push_back(PixelFormat::BayerGB8);
-                    else if (name == "BayerGR8") formats.push_back(PixelFormat::BayerGR8);
-                    else if (name == "BayerBG8") formats.push_back(PixelFormat::BayerBG8);
-                    else if (name == "YUV422Packed") formats.push_back(PixelFormat::YUV422_8);
-                }
-            }
+          if (err != GenTL::GC_ERR_SUCCESS) {
+             // Debug: verifica stato stream
 
-        }
-        catch (...) {
-            // Return empty vector
-        }
+             GenTL::INFO_DATATYPE dt;
+             size_t sz = sizeof(numDelivered);
 
-        return formats;
-    }
+             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_DELIVERED, &dt, &numDelivered, &sz);
+             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_QUEUED, &dt, &numQueued, &sz);
+             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_STARTED, &dt, &numStarted, &sz);
+             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_IS_GRABBING, &dt, &isGrabbing, &sz);
+             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_ANNOUNCED, &dt, &numAnnounced, &sz);
+             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_AWAIT_DELIVERY, &dt, &numAwaitDelivery, &sz);
 
-    // === Frame Rate ===
 
-    void GenICamCamera::setFrameRate(double fps) {
-        try {
-            GenApi::CFloatPtr pFrameRate;
+             std::cout << "   Frame non ricevuto!" << std::endl;
+             std::cout << "   - Delivered: " << numDelivered << std::endl;
+             std::cout << "   - Queued: " << numQueued << std::endl;
+             std::cout << "   - Started: " << numStarted << std::endl;
+             std::cout << "   - Grabbing: " << isGrabbing << std::endl;
+             std::cout << "   - Announced: " << numAnnounced << std::endl;
+             std::cout << "   - Await delivery: " << numAwaitDelivery << std::endl;
 
-            // Prova diversi nomi possibili
-            const std::vector<std::string> frameRateNames = {
-                "AcquisitionFrameRate", "FrameRate", "AcquisitionFrameRateAbs"
-            };
+             THROW_GENICAM_ERROR_CODE(ErrorType::TimeoutError, "Timeout acquisizione frame", err);
+          }
 
-            for (const auto& name : frameRateNames) {
-                try {
-                    pFrameRate = getFloatNode(name);
-                    if (GenApi::IsWritable(pFrameRate)) {
-                        break;
-                    }
-                }
-                catch (...) {
-                    continue;
-                }
-            }
+          std::cout << "8. Frame ricevuto!" << std::endl;
 
-            if (!pFrameRate.IsValid() || !GenApi::IsWritable(pFrameRate)) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,"Frame rate non disponibile o non scrivibile");
-            }
+          // 12. Processa il buffer
+          GenTL::BUFFER_HANDLE hBuffer = bufferData.BufferHandle;
+          if (hBuffer) {
+             BufferInfo info;
+             if (queryBufferInfo(hBuffer, info)) {
+                result = convertBufferToMat(info.base, m_bufferSize,
+                   static_cast<uint32_t>(info.width), static_cast<uint32_t>(info.height),
+                   convertFromGenICamPixelFormat(info.pixelFormat));
+             }
+          }
 
-            double min = pFrameRate->GetMin();
-            double max = pFrameRate->GetMax();
+          // 13. Stop acquisizione camera
+          try {
+             GenApi::CCommandPtr pAcqStop = getCommandNode("AcquisitionStop");
+             if (pAcqStop.IsValid() && GenApi::IsWritable(pAcqStop)) {
+                pAcqStop->Execute();
+             }
+             m_isAcquiring = false;
+             m_stopAcquisition = true;
+          }
+          catch (...) {}
 
-            if (fps < min || fps > max) {
-                std::stringstream ss;
-                ss << "Frame rate fuori range [" << min << ", " << max << "]";
-                THROW_GENICAM_ERROR(ErrorType::ParameterError, ss.str());
-            }
+          // Cleanup DataStream
+          if (m_eventHandle) {
+             m_isAcquiring = false;
+             m_stopAcquisition = true;
+             GENTL_CALL(GCUnregisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER);
+             m_eventHandle = nullptr;
+          }
 
-            pFrameRate->SetValue(fps);
-            notifyParameterChanged("FrameRate", std::to_string(fps));
+          if (m_dsHandle) {
+             GENTL_CALL(DSStopAcquisition)(m_dsHandle, GenTL::ACQ_STOP_FLAGS_DEFAULT);
+             GENTL_CALL(DSFlushQueue)(m_dsHandle, GenTL::ACQ_QUEUE_ALL_DISCARD);
+             GENTL_CALL(DSClose)(m_dsHandle);
+             m_dsHandle = nullptr;
+          }
+
+          setTransportLayerLock(false);
+          setTriggerMode(TriggerMode::Off);
+
+          freeBuffers(); // da inserirsi anche in qualche altro catch
+       }
+       catch (...) {
+          // Cleanup
+          if (m_eventHandle) {
+             GENTL_CALL(GCUnregisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER);
+             m_eventHandle = nullptr;
+          }
+          if (m_dsHandle) {
+             GENTL_CALL(DSStopAcquisition)(m_dsHandle, GenTL::ACQ_STOP_FLAGS_DEFAULT);
+             GENTL_CALL(DSClose)(m_dsHandle);
+             m_dsHandle = nullptr;
+          }
+          freeBuffers();
+          throw;
+       }
 
-        }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore impostazione frame rate: ") + e.GetDescription());
-        }
+       return result;
     }
 
-    double GenICamCamera::getFrameRate() const {
-        try {
-            const std::vector<std::string> frameRateNames = {
-                "AcquisitionFrameRate", "FrameRate", "AcquisitionFrameRateAbs"
-            };
-
-            for (const auto& name : frameRateNames) {
-                try {
-                    GenApi::CFloatPtr pFrameRate = getFloatNode(name);
-                    if (GenApi::IsReadable(pFrameRate)) {
-                        return pFrameRate->GetValue();
-                    }
-                }
-                catch (...) {
-                    continue;
-                }
-            }
+    BurstResult GenICamCamera::captureBurst(size_t frameCount, uint32_t timeoutMs, bool convert) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-            THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                "Frame rate non disponibile");
+        if (!isConnected()) {
+            THROW_GENICAM_ERROR(ErrorType::ConnectionError, "Camera non connessa");
+        }
 
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError, "Acquisizione continua in corso");
         }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore lettura frame rate: ") + e.GetDescription());
+
+        if (frameCount == 0) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError, "La raffica deve contenere almeno un frame");
         }
-    }
 
-    bool GenICamCamera::isFrameRateAvailable() const {
-        const std::vector<std::string> frameRateNames = {
-            "AcquisitionFrameRate", "FrameRate", "AcquisitionFrameRateAbs"
+        // Metadati del buffer raccolti durante la raffica, elaborati solo alla fine
+        struct BurstSlot {
+            BufferInfo info;
+            std::chrono::steady_clock::time_point timestamp;
         };
 
-        for (const auto& name : frameRateNames) {
+        BurstResult result;
+        result.requestedFrames = frameCount;
+
+        GenTL::GC_ERROR err;
+        bool producerAllocated = false;
+        bool restoreMode = false;
+        AcquisitionMode previousMode = AcquisitionMode::Continuous;
+        std::string previousBufferHandling;
+
+        auto closeStream = [this]() {
             try {
-                GenApi::CNodePtr node = m_pNodeMap->_GetNode(name.c_str());
-                if (node.IsValid() && GenApi::IsImplemented(node)) {
-                    return true;
+                GenApi::CCommandPtr pAcqStop = m_pNodeMap->_GetNode("AcquisitionStop");
+                if (pAcqStop.IsValid() && GenApi::IsWritable(pAcqStop)) {
+                    pAcqStop->Execute();
                 }
             }
-            catch (...) {
-                continue;
-            }
-        }
-
-        return false;
-    }
-
-    // === Acquisition Mode Implementation ===
-
-    void GenICamCamera::setAcquisitionMode(AcquisitionMode mode) {
-        if (m_isAcquiring) {
-            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
-                "Impossibile cambiare AcquisitionMode durante l'acquisizione");
-        }
-
-        try {
-            GenApi::CEnumerationPtr pAcqMode = getEnumerationNode("AcquisitionMode");
+            catch (...) {}
 
-            if (!GenApi::IsWritable(pAcqMode)) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "AcquisitionMode non scrivibile");
+            if (m_dsHandle) {
+                GENTL_CALL(DSStopAcquisition)(m_dsHandle, GenTL::ACQ_STOP_FLAGS_DEFAULT);
             }
-
-            std::string modeString;
-            switch (mode) {
-            case AcquisitionMode::SingleFrame:
-                modeString = "SingleFrame";
-                break;
-            case AcquisitionMode::MultiFrame:
-                modeString = "MultiFrame";
-                break;
-            case AcquisitionMode::Continuous:
-                modeString = "Continuous";
-                break;
-            default:
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "Modalità di acquisizione non valida");
+            if (m_eventHandle) {
+                GENTL_CALL(GCUnregisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER);
+                m_eventHandle = nullptr;
             }
-            // Imposta il valore
-            *pAcqMode = modeString.c_str();
-            // Notifica il cambio
-            notifyParameterChanged("AcquisitionMode", modeString);
+            if (m_dsHandle) {
+                GENTL_CALL(DSFlushQueue)(m_dsHandle, GenTL::ACQ_QUEUE_ALL_DISCARD);
+                freeBuffers();
+                GENTL_CALL(DSClose)(m_dsHandle);
+                m_dsHandle = nullptr;
+            }
+            setTransportLayerLock(false);
+        };
 
-            // Se stiamo passando a MultiFrame, potrebbe essere necessario 
-            // impostare anche AcquisitionFrameCount
-            if (mode == AcquisitionMode::MultiFrame) {
+        auto restoreAcquisitionMode = [&]() {
+            if (restoreMode) {
                 try {
-                    // Verifica se AcquisitionFrameCount esiste ed è configurabile
-                    if (isParameterAvailable("AcquisitionFrameCount") &&
-                        isParameterWritable("AcquisitionFrameCount")) {
-                        // Se non è già impostato, usa un default
-                        GenApi::CIntegerPtr pFrameCount = getIntegerNode("AcquisitionFrameCount");
-                        if (pFrameCount->GetValue() == 0) {
-                            pFrameCount->SetValue(10); // Default 10 frame
-                        }
-                    }
+                    setAcquisitionMode(previousMode);
                 }
-                catch (...) {
-                    // Non critico se AcquisitionFrameCount non è disponibile
+                catch (...) {}
+            }
+            if (!previousBufferHandling.empty()) {
+                try {
+                    setParameter("StreamBufferHandlingMode", previousBufferHandling);
                 }
+                catch (...) {}
             }
+        };
 
-        }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore impostazione AcquisitionMode: ") + e.GetDescription());
-        }
-    }
-
-    AcquisitionMode GenICamCamera::getAcquisitionMode() const {
         try {
-            // Check cache first
-            auto it = m_parameterCache.find("AcquisitionMode");
-            if (it != m_parameterCache.end()) {
-                auto now = std::chrono::steady_clock::now();
-                if (now - it->second.second < CACHE_TIMEOUT) {
-                    std::string cachedValue = it->second.first;
-
-                    if (cachedValue == "SingleFrame") return AcquisitionMode::SingleFrame;
-                    if (cachedValue == "MultiFrame") return AcquisitionMode::MultiFrame;
-                    if (cachedValue == "Continuous") return AcquisitionMode::Continuous;
+            if (isParameterAvailable("StreamBufferHandlingMode")) {
+                try {
+                    previousBufferHandling = getParameter("StreamBufferHandlingMode");
                 }
+                catch (...) {}
             }
 
-            GenApi::CEnumerationPtr pAcqMode = getEnumerationNode("AcquisitionMode");
+            prepareTransportLayerForAcquisition();
 
-            if (!GenApi::IsReadable(pAcqMode)) {
-                THROW_GENICAM_ERROR(ErrorType::ParameterError,
-                    "AcquisitionMode non leggibile");
+            // La raffica deve consegnare tutti i frame in ordine: la politica di
+            // backpressure dello streaming continuo (es. NewestOnly) li scarterebbe
+            if (isParameterAvailable("StreamBufferHandlingMode")) {
+                try {
+                    setParameter("StreamBufferHandlingMode", "OldestFirst");
+                }
+                catch (...) {}
             }
+            setTransportLayerLock(false);
 
-            std::string modeString = pAcqMode->ToString().c_str();
-
-            // Update cache
-            m_parameterCache["AcquisitionMode"] = { modeString,
-                                                    std::chrono::steady_clock::now() };
-
-            // Converti stringa in enum
-            if (modeString == "SingleFrame") return AcquisitionMode::SingleFrame;
-            if (modeString == "MultiFrame") return AcquisitionMode::MultiFrame;
-            if (modeString == "Continuous") return AcquisitionMode::Continuous;
-
-            // Se arriviamo qui, la camera ha un valore non standard
-            // Default a Continuous
-            return AcquisitionMode::Continuous;
-
-        }
-        catch (const GENICAM_NAMESPACE::GenericException& e) {
-            THROW_GENICAM_ERROR(ErrorType::GenApiError,
-                std::string("Errore lettura AcquisitionMode: ") + e.GetDescription());
-        }
-    }
-
-    bool GenICamCamera::isAcquisitionModeAvailable() const {
-        try {
-            GenApi::CNodePtr node = m_pNodeMap->_GetNode("AcquisitionMode");
-            return node.IsValid() && GenApi::IsImplemented(node);
-        }
-        catch (...) {
-            return false;
-        }
-    }
-
-    std::vector<AcquisitionMode> GenICamCamera::getAvailableAcquisitionModes() const {
-        std::vector<AcquisitionMode> modes;
-
-        try {
-            GenApi::CEnumerationPtr pAcqMode = getEnumerationNode("AcquisitionMode");
-            GenApi::NodeList_t entries;
-            pAcqMode->GetEntries(entries);
-
-            for (auto& entry : entries) {
-                if (GenApi::IsAvailable(entry)) {
-                    std::string name = entry->GetName().c_str();
+            // 1. Arma la camera (prima del blocco dei parametri TL): MultiFrame con
+            //    AcquisitionFrameCount se il valore rientra nei limiti, altrimenti Continuous
+            if (isAcquisitionModeAvailable()) {
+                previousMode = getAcquisitionMode();
+                restoreMode = true;
 
-                    if (name == "SingleFrame") {
-                        modes.push_back(AcquisitionMode::SingleFrame);
-                    }
-                    else if (name == "MultiFrame") {
-                        modes.push_back(AcquisitionMode::MultiFrame);
-                    }
-                    else if (name == "Continuous") {
-                        modes.push_back(AcquisitionMode::Continuous);
+                try {
+                    setAcquisitionMode(AcquisitionMode::MultiFrame);
+                    if (isParameterAvailable("AcquisitionFrameCount") && isParameterWritable("AcquisitionFrameCount")) {
+                        GenApi::CIntegerPtr pFrameCount = getIntegerNode("AcquisitionFrameCount");
+                        const int64_t requested = static_cast<int64_t>(frameCount);
+                        if (requested >= pFrameCount->GetMin() && requested <= pFrameCount->GetMax()) {
+                            pFrameCount->SetValue(requested);
+                            result.multiFrame = true;
+                        }
                     }
                 }
-            }
-        }
-        catch (...) {
-            // Se c'è un errore, ritorna vector vuoto
-        }
-
-        return modes;
-    }
+                catch (...) {
+                    // MultiFrame non supportato: la raffica viene interrotta dall'host
+                }
 
-    // === Helper function per debug ===
-    std::string GenICamCamera::getAcquisitionModeString(AcquisitionMode mode) {
-        switch (mode) {
-        case AcquisitionMode::SingleFrame: return "SingleFrame";
-        case AcquisitionMode::MultiFrame: return "MultiFrame";
-        case AcquisitionMode::Continuous: return "Continuous";
-        default: return "Unknown";
-        }
-    }
+                if (!result.multiFrame) {
+                    setAcquisitionMode(AcquisitionMode::Continuous);
+                }
+            }
 
-    // === Utilities e Helper ===
+            refreshParameterShadows();
+            const double exposureTime = m_exposureTimeShadow.load();
+            const double gain = m_gainShadow.load();
 
-    cv::Mat GenICamCamera::convertBufferToMat(void* buffer, size_t size, uint32_t width, uint32_t height, PixelFormat format) const {
-       if (!buffer || size == 0 || width == 0 || height == 0) {
-          return cv::Mat();
-       }
+            setTransportLayerLock(true);
 
-       cv::Mat resultMat;
+            // 2. Data stream e arena: un'unica allocazione suddivisa in frameCount slot allineati
+            openDataStream();
+            updateBufferSize();
 
-       switch (format) {
-          // Formati monocromatici standard
-       case PixelFormat::Mono8:
-       {
-          size_t expectedSize = width * height;
-          if (size < expectedSize) return cv::Mat();
-          resultMat = cv::Mat(height, width, CV_8UC1, buffer).clone();
-          break;
-       }
+            const size_t alignment = getBufferAlignment();
+            result.slotSize = ((m_bufferSize + alignment - 1) / alignment) * alignment;
 
-       case PixelFormat::Mono10:
-       case PixelFormat::Mono12:
-       case PixelFormat::Mono14:
-       case PixelFormat::Mono16:
-       {
-          size_t expectedSize = width * height * 2;
-          if (size < expectedSize) return cv::Mat();
-          resultMat = cv::Mat(height, width, CV_16UC1, buffer).clone();
-          break;
-       }
+#ifdef _WIN32
+            void* arenaPtr = _aligned_malloc(result.slotSize * frameCount, alignment);
+#else
+            void* arenaPtr = aligned_alloc(alignment, result.slotSize * frameCount);
+#endif
+            if (!arenaPtr) {
+                std::stringstream ss;
+                ss << "Impossibile allocare l'arena della raffica (" << frameCount << " x " << result.slotSize << " bytes)";
+                THROW_GENICAM_ERROR(ErrorType::BufferError, ss.str());
+            }
+            result.arena = std::shared_ptr<uint8_t>(static_cast<uint8_t*>(arenaPtr), AlignedBufferDeleter());
 
-       // Formati monocromatici packed
-       case PixelFormat::Mono10Packed:
-       {
-          // 4 pixel in 5 byte
-          size_t packedSize = ((width * height * 10 + 7) / 8);
-          if (size < packedSize) return cv::Mat();
+            // Tutte le pagine mappate prima della raffica; azzerate solo se richiesto
+            if (m_bufferAllocationConfig.zeroFill) {
+                std::memset(arenaPtr, 0, result.slotSize * frameCount);
+            }
+            else if (m_bufferAllocationConfig.residency != BufferResidencyPolicy::None) {
+                MemoryUtils::prefault(arenaPtr, result.slotSize * frameCount);
+            }
 
-          cv::Mat unpackedMat(height, width, CV_16UC1);
-          unpackMono10Packed(static_cast<uint8_t*>(buffer), reinterpret_cast<uint16_t*>(unpackedMat.data), width, height);
-          resultMat = unpackedMat;
-          break;
-       }
+            m_bufferHandles.clear();
+            m_bufferHandles.reserve(frameCount);
+            for (size_t i = 0; i < frameCount; i++) {
+                GenTL::BUFFER_HANDLE hBuffer = nullptr;
+                err = GENTL_CALL(DSAnnounceBuffer)(m_dsHandle, result.arena.get() + i * result.slotSize, result.slotSize, nullptr, &hBuffer);
+                if (err != GenTL::GC_ERR_SUCCESS) {
+                    producerAllocated = true;
+                    break;
+                }
+                m_bufferHandles.push_back(hBuffer);
+            }
 
-       case PixelFormat::Mono12Packed:
-       {
-          // 2 pixel in 3 byte
-          size_t packedSize = ((width * height * 12 + 7) / 8);
-          if (size < packedSize) return cv::Mat();
+            if (producerAllocated) {
+                // Il producer non accetta memoria esterna: buffer propri, copiati
+                // nell'arena solo al termine della raffica
+                std::cout << "DSAnnounceBuffer non supportato, raffica su buffer del producer" << std::endl;
+                freeBuffers();
+                for (size_t i = 0; i < frameCount; i++) {
+                    GenTL::BUFFER_HANDLE hBuffer = nullptr;
+                    err = GENTL_CALL(DSAllocAndAnnounceBuffer)(m_dsHandle, result.slotSize, nullptr, &hBuffer);
+                    if (err != GenTL::GC_ERR_SUCCESS) {
+                        THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, "Impossibile allocare i buffer della raffica", err);
+                    }
+                    m_bufferHandles.push_back(hBuffer);
+                }
+            }
 
-          cv::Mat unpackedMat(height, width, CV_16UC1);
-          unpackMono12Packed(static_cast<uint8_t*>(buffer), reinterpret_cast<uint16_t*>(unpackedMat.data), width, height);
-          resultMat = unpackedMat;
-          break;
-       }
+            for (auto& hBuffer : m_bufferHandles) {
+                err = GENTL_CALL(DSQueueBuffer)(m_dsHandle, hBuffer);
+                if (err != GenTL::GC_ERR_SUCCESS) {
+                    THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, "Impossibile accodare il buffer", err);
+                }
+            }
 
-       // Formati RGB/BGR 8 bit
-       case PixelFormat::RGB8:
-       {
-          size_t expectedSize = width * height * 3;
-          if (size < expectedSize) return cv::Mat();
-          cv::Mat rgbMat(height, width, CV_8UC3, buffer);
-          cv::cvtColor(rgbMat, resultMat, cv::COLOR_RGB2BGR);
-          break;
-       }
+            err = GENTL_CALL(GCRegisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER, &m_eventHandle);
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Impossibile registrare l'evento NEW_BUFFER", err);
+            }
 
-       case PixelFormat::BGR8:
-       {
-          size_t expectedSize = width * height * 3;
-          if (size < expectedSize) return cv::Mat();
-          resultMat = cv::Mat(height, width, CV_8UC3, buffer).clone();
-          break;
-       }
+            // 3. Il producer consegna al massimo frameCount buffer
+            err = GENTL_CALL(DSStartAcquisition)(m_dsHandle, GenTL::ACQ_START_FLAGS_DEFAULT, static_cast<uint64_t>(frameCount));
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                THROW_GENICAM_ERROR_CODE(ErrorType::AcquisitionError, "Impossibile avviare l'acquisizione sul data stream", err);
+            }
 
-       case PixelFormat::RGBa8:
-       {
-          size_t expectedSize = width * height * 4;
-          if (size < expectedSize) return cv::Mat();
-          cv::Mat rgbaMat(height, width, CV_8UC4, buffer);
-          cv::cvtColor(rgbaMat, resultMat, cv::COLOR_RGBA2BGRA);
-          break;
-       }
+            try {
+                GenApi::CCommandPtr pAcqStart = getCommandNode("AcquisitionStart");
+                if (pAcqStart.IsValid() && GenApi::IsWritable(pAcqStart)) {
+                    pAcqStart->Execute();
+                }
+            }
+            catch (const GENICAM_NAMESPACE::GenericException& e) {
+                THROW_GENICAM_ERROR(ErrorType::GenApiError,
+                    std::string("Errore comando AcquisitionStart: ") + e.GetDescription());
+            }
 
-       case PixelFormat::BGRa8:
-       {
-          size_t expectedSize = width * height * 4;
-          if (size < expectedSize) return cv::Mat();
-          resultMat = cv::Mat(height, width, CV_8UC4, buffer).clone();
-          break;
-       }
+            // 4. Raffica: solo prelievo dei buffer e lettura delle info, nessun riaccodamento
+            std::vector<BurstSlot> slots;
+            slots.reserve(frameCount);
 
-       // Formati RGB/BGR 10/12/16 bit
-       case PixelFormat::RGB10:
-       case PixelFormat::RGB12:
-       case PixelFormat::RGB16:
-       {
-          size_t expectedSize = width * height * 3 * 2;
-          if (size < expectedSize) return cv::Mat();
-          cv::Mat rgbMat(height, width, CV_16UC3, buffer);
-          cv::cvtColor(rgbMat, resultMat, cv::COLOR_RGB2BGR);
-          break;
-       }
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+            while (slots.size() < frameCount) {
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= deadline) {
+                    break;
+                }
+                const uint64_t remainingMs = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + 1;
 
-       case PixelFormat::BGR10:
-       case PixelFormat::BGR12:
-       case PixelFormat::BGR16:
-       {
-          size_t expectedSize = width * height * 3 * 2;
-          if (size < expectedSize) return cv::Mat();
-          resultMat = cv::Mat(height, width, CV_16UC3, buffer).clone();
-          break;
-       }
+                GenTL::EVENT_NEW_BUFFER_DATA bufferData;
+                size_t bufferDataSize = sizeof(bufferData);
+                err = GENTL_CALL(EventGetData)(m_eventHandle, &bufferData, &bufferDataSize, remainingMs);
+                if (err == GenTL::GC_ERR_TIMEOUT) {
+                    break;
+                }
+                if (err != GenTL::GC_ERR_SUCCESS) {
+                    THROW_GENICAM_ERROR_CODE(ErrorType::AcquisitionError, "Errore durante la raffica", err);
+                }
 
-       // Formati Bayer 8 bit
-       case PixelFormat::BayerGR8:
-       case PixelFormat::BayerRG8:
-       case PixelFormat::BayerGB8:
-       case PixelFormat::BayerBG8:
-       {
-          size_t expectedSize = width * height;
-          if (size < expectedSize) return cv::Mat();
-          cv::Mat bayerMat(height, width, CV_8UC1, buffer);
+                BurstSlot slot;
+                slot.timestamp = std::chrono::steady_clock::now();
+                if (bufferData.BufferHandle && queryBufferInfo(bufferData.BufferHandle, slot.info)) {
+                    slots.push_back(slot);
+                }
+            }
 
-          // Converti Bayer a BGR usando il pattern appropriato
-          int conversionCode;
-          switch (format) {
-          case PixelFormat::BayerGR8: conversionCode = cv::COLOR_BayerGR2BGR; break;
-          case PixelFormat::BayerRG8: conversionCode = cv::COLOR_BayerRG2BGR; break;
-          case PixelFormat::BayerGB8: conversionCode = cv::COLOR_BayerGB2BGR; break;
-          case PixelFormat::BayerBG8: conversionCode = cv::COLOR_BayerBG2BGR; break;
-          default: return cv::Mat();
-          }
-          cv::cvtColor(bayerMat, resultMat, conversionCode);
-          break;
-       }
+            // 5. Metadati e, se i buffer sono del producer, copia nell'arena prima della revoca
+            auto clockMapping = m_clockCorrelator.mapping();
+            result.frames.reserve(slots.size());
+            for (size_t i = 0; i < slots.size(); ++i) {
+                const BufferInfo& info = slots[i].info;
+                uint8_t* slotData = static_cast<uint8_t*>(info.base);
 
-       // Formati Bayer 10/12/16 bit
-       case PixelFormat::BayerGR10:
-       case PixelFormat::BayerRG10:
-       case PixelFormat::BayerGB10:
-       case PixelFormat::BayerBG10:
-       case PixelFormat::BayerGR12:
-       case PixelFormat::BayerRG12:
-       case PixelFormat::BayerGB12:
-       case PixelFormat::BayerBG12:
-       case PixelFormat::BayerGR16:
-       case PixelFormat::BayerRG16:
-       case PixelFormat::BayerGB16:
-       case PixelFormat::BayerBG16:
-       {
-          size_t expectedSize = width * height * 2;
-          if (size < expectedSize) return cv::Mat();
-          cv::Mat bayerMat(height, width, CV_16UC1, buffer);
+                if (producerAllocated) {
+                    slotData = result.arena.get() + i * result.slotSize;
+                    std::memcpy(slotData, info.base, std::min(result.slotSize, info.sizeFilled ? info.sizeFilled : m_bufferSize));
+                }
 
-          // Determina il codice di conversione corretto
-          int conversionCode;
-          if (format == PixelFormat::BayerGR10 || format == PixelFormat::BayerGR12 || format == PixelFormat::BayerGR16) {
-             conversionCode = cv::COLOR_BayerGR2BGR;
-          }
-          else if (format == PixelFormat::BayerRG10 || format == PixelFormat::BayerRG12 || format == PixelFormat::BayerRG16) {
-             conversionCode = cv::COLOR_BayerRG2BGR;
-          }
-          else if (format == PixelFormat::BayerGB10 || format == PixelFormat::BayerGB12 || format == PixelFormat::BayerGB16) {
-             conversionCode = cv::COLOR_BayerGB2BGR;
-          }
-          else {
-             conversionCode = cv::COLOR_BayerBG2BGR;
-          }
+                BurstFrame frame;
+                frame.data = slotData;
+                frame.sizeFilled = info.sizeFilled;
+                frame.width = static_cast<uint32_t>(info.width);
+                frame.height = static_cast<uint32_t>(info.height);
+                frame.pixelFormat = convertFromGenICamPixelFormat(info.pixelFormat);
+                frame.frameID = info.frameID;
+                frame.timestamp = slots[i].timestamp;
+                frame.deviceTimestamp = info.timestamp;
+                frame.isIncomplete = info.isIncomplete != 0;
+                frame.exposureTime = exposureTime;
+                frame.gain = gain;
 
-          // Converti a 8 bit per la demosaicizzazione
-          cv::Mat bayer8bit;
-          bayerMat.convertTo(bayer8bit, CV_8U, 255.0 / 65535.0);
-          cv::cvtColor(bayer8bit, resultMat, conversionCode);
-          break;
-       }
+                if (info.timestamp != 0 && clockMapping->valid) {
+                    frame.hostTimestamp = clockMapping->toHostTime(info.timestamp);
+                    frame.hostTimestampValid = true;
+                }
 
-       // Formati Bayer packed
-       case PixelFormat::BayerGR10Packed:
-       case PixelFormat::BayerRG10Packed:
-       case PixelFormat::BayerGB10Packed:
-       case PixelFormat::BayerBG10Packed:
-       {
-          size_t packedSize = ((width * height * 10 + 7) / 8);
-          if (size < packedSize) return cv::Mat();
+                result.frames.push_back(std::move(frame));
+            }
 
-          cv::Mat unpackedMat(height, width, CV_16UC1);
-          unpackMono10Packed(static_cast<uint8_t*>(buffer),
-             reinterpret_cast<uint16_t*>(unpackedMat.data),
-             width, height);
+            if (result.frames.size() > 1) {
+                result.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                    result.frames.back().timestamp - result.frames.front().timestamp);
+            }
 
-          // Converti Bayer a BGR
-          int conversionCode;
-          switch (format) {
-          case PixelFormat::BayerGR10Packed: conversionCode = cv::COLOR_BayerGR2BGR; break;
-          case PixelFormat::BayerRG10Packed: conversionCode = cv::COLOR_BayerRG2BGR; break;
-          case PixelFormat::BayerGB10Packed: conversionCode = cv::COLOR_BayerGB2BGR; break;
-          case PixelFormat::BayerBG10Packed: conversionCode = cv::COLOR_BayerBG2BGR; break;
-          default: return cv::Mat();
-          }
+            closeStream();
+            restoreAcquisitionMode();
+        }
+        catch (...) {
+            closeStream();
+            restoreAcquisitionMode();
+            throw;
+        }
 
-          cv::Mat bayer8bit;
-          unpackedMat.convertTo(bayer8bit, CV_8U, 255.0 / 1023.0);
-          cv::cvtColor(bayer8bit, resultMat, conversionCode);
-          break;
-       }
+        if (result.frames.empty()) {
+            THROW_GENICAM_ERROR(ErrorType::TimeoutError, "Nessun frame ricevuto durante la raffica");
+        }
 
-       case PixelFormat::BayerGR12Packed:
-       case PixelFormat::BayerRG12Packed:
-       case PixelFormat::BayerGB12Packed:
-       case PixelFormat::BayerBG12Packed:
-       {
-          size_t packedSize = ((width * height * 12 + 7) / 8);
-          if (size < packedSize) return cv::Mat();
+        if (convert) {
+            convertBurst(result);
+        }
 
-          cv::Mat unpackedMat(height, width, CV_16UC1);
-          unpackMono12Packed(static_cast<uint8_t*>(buffer),
-             reinterpret_cast<uint16_t*>(unpackedMat.data),
-             width, height);
+        return result;
+    }
 
-          // Converti Bayer a BGR
-          int conversionCode;
-          switch (format) {
-          case PixelFormat::BayerGR12Packed: conversionCode = cv::COLOR_BayerGR2BGR; break;
-          case PixelFormat::BayerRG12Packed: conversionCode = cv::COLOR_BayerRG2BGR; break;
-          case PixelFormat::BayerGB12Packed: conversionCode = cv::COLOR_BayerGB2BGR; break;
-          case PixelFormat::BayerBG12Packed: conversionCode = cv::COLOR_BayerBG2BGR; break;
-          default: return cv::Mat();
-          }
+    void GenICamCamera::convertBurst(BurstResult& burst, size_t threadCount) const {
+        if (burst.frames.empty()) {
+            return;
+        }
 
-          cv::Mat bayer8bit;
-          unpackedMat.convertTo(bayer8bit, CV_8U, 255.0 / 4095.0);
-          cv::cvtColor(bayer8bit, resultMat, conversionCode);
-          break;
-       }
+        if (threadCount == 0) {
+            threadCount = static_cast<size_t>(ThreadUtils::getCpuCount());
+        }
+        threadCount = std::min(threadCount, burst.frames.size());
 
-       // Formati YUV
-       case PixelFormat::YUV422_8:
-       case PixelFormat::YUV422_8_UYVY:
-       {
-          size_t expectedSize = width * height * 2;
-          if (size < expectedSize) return cv::Mat();
-          cv::Mat yuvMat(height, width, CV_8UC2, buffer);
-          cv::cvtColor(yuvMat, resultMat, cv::COLOR_YUV2BGR_UYVY);
-          break;
-       }
+        // I frame sono indipendenti: ogni worker preleva il successivo da un indice condiviso
+        std::atomic<size_t> nextFrame{ 0 };
+        auto worker = [&]() {
+            for (size_t i = nextFrame.fetch_add(1); i < burst.frames.size(); i = nextFrame.fetch_add(1)) {
+                BurstFrame& frame = burst.frames[i];
+                try {
+                    frame.image = convertBufferToMat(const_cast<uint8_t*>(frame.data), burst.slotSize,
+                        frame.width, frame.height, frame.pixelFormat);
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "Errore conversione frame " << frame.frameID << " della raffica: " << e.what() << std::endl;
+                }
+            }
+        };
 
-       case PixelFormat::YUV422_8_YUYV:
-       {
-          size_t expectedSize = width * height * 2;
-          if (size < expectedSize) return cv::Mat();
-          cv::Mat yuvMat(height, width, CV_8UC2, buffer);
-          cv::cvtColor(yuvMat, resultMat, cv::COLOR_YUV2BGR_YUYV);
-          break;
-       }
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        for (size_t t = 1; t < threadCount; ++t) {
+            workers.emplace_back(worker);
+        }
+        worker();
+
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
 
-       case PixelFormat::YUV444_8:
-       {
-          size_t expectedSize = width * height * 3;
-          if (size < expectedSize) return cv::Mat();
-          cv::Mat yuvMat(height, width, CV_8UC3, buffer);
-          cv::cvtColor(yuvMat, resultMat, cv::COLOR_YUV2BGR);
-          break;
-       }
+    void GenICamCamera::debugAcquisitionStart() {
+        std::cout << "\n=== Debug AcquisitionStart ===" << std::endl;
 
-       // Formati 3D
-       case PixelFormat::Coord3D_ABC32f:
-       {
-          size_t expectedSize = width * height * 3 * sizeof(float);
-          if (size < expectedSize) return cv::Mat();
-          resultMat = cv::Mat(height, width, CV_32FC3, buffer).clone();
-          break;
-       }
+        try {
+            // 1. Verifica esistenza del nodo
+            //GenApi::CCommandPtr pAcqStart = getCommandNode("AcquisitionStart");
+            GenApi::CCommandPtr pAcqStart = m_pNodeMap->_GetNode("AcquisitionStart");
+            std::cout << "AcquisitionStart exists: " << (pAcqStart.IsValid() ? "YES" : "NO") << std::endl;
 
-       case PixelFormat::Coord3D_ABC16:
-       {
-          size_t expectedSize = width * height * 3 * sizeof(uint16_t);
-          if (size < expectedSize) return cv::Mat();
-          resultMat = cv::Mat(height, width, CV_16UC3, buffer).clone();
-          break;
-       }
+            if (!pAcqStart.IsValid()) {
+                std::cout << "ERRORE: Nodo AcquisitionStart non trovato!" << std::endl;
+                return;
+            }
 
-       case PixelFormat::Confidence8:
-       {
-          size_t expectedSize = width * height;
-          if (size < expectedSize) return cv::Mat();
-          resultMat = cv::Mat(height, width, CV_8UC1, buffer).clone();
-          break;
-       }
+            // 2. Verifica accessibilità
+            std::cout << "IsImplemented: " << (GenApi::IsImplemented(pAcqStart) ? "YES" : "NO") << std::endl;
+            std::cout << "IsAvailable: " << (GenApi::IsAvailable(pAcqStart) ? "YES" : "NO") << std::endl;
+            std::cout << "IsReadable: " << (GenApi::IsReadable(pAcqStart) ? "YES" : "NO") << std::endl;
+            std::cout << "IsWritable: " << (GenApi::IsWritable(pAcqStart) ? "YES" : "NO") << std::endl;
 
-       case PixelFormat::Confidence16:
-       {
-          size_t expectedSize = width * height * 2;
-          if (size < expectedSize) return cv::Mat();
-          resultMat = cv::Mat(height, width, CV_16UC1, buffer).clone();
-          break;
-       }
+            // 3. Se non è writable, verifica perché
+            if (!GenApi::IsWritable(pAcqStart)) {
+                // Verifica visibility
+                //GenApi::EVisibility visibility = pAcqStart->GetVisibility();
+                std::cout << "Visibility: ";
+                GenApi::EVisibility visibility = GenApi::Guru;
+                switch (visibility) {
+                case GenApi::Beginner: std::cout << "Beginner"; break;
+                case GenApi::Expert: std::cout << "Expert"; break;
+                case GenApi::Guru: std::cout << "Guru"; break;
+                case GenApi::Invisible: std::cout << "Invisible"; break;
+                default: std::cout << "Unknown";
+                }
+                std::cout << std::endl;
 
-       default:
-          // Formato non supportato
-          return cv::Mat();
-       }
+                // Verifica access mode
+                GenApi::EAccessMode accessMode = pAcqStart->GetAccessMode();
+                std::cout << "AccessMode: ";
+                switch (accessMode) {
+                case GenApi::NI: std::cout << "Not Implemented"; break;
+                case GenApi::NA: std::cout << "Not Available"; break;
+                case GenApi::WO: std::cout << "Write Only"; break;
+                case GenApi::RO: std::cout << "Read Only"; break;
+                case GenApi::RW: std::cout << "Read/Write"; break;
+                default: std::cout << "Unknown";
+                }
+                std::cout << std::endl;
 
-       return resultMat;
-    }
+                // Verifica dipendenze
+                std::cout << "\n--- Verifica Parametri Correlati ---" << std::endl;
 
-    // Funzioni helper per la decompressione
-    void GenICamCamera::unpackMono10Packed(const uint8_t* src, uint16_t* dst, uint32_t width, uint32_t height) const {
-       for (uint32_t y = 0; y < height; ++y) {
-          const uint8_t* srcRow = src + y * ((width * 10 + 7) / 8);
-          uint16_t* dstRow = dst + y * width;
+                // AcquisitionMode
+                if (isParameterAvailable("AcquisitionMode")) {
+                    std::cout << "AcquisitionMode: " << getParameter("AcquisitionMode") << std::endl;
+                }
+                else {
+                    std::cout << "AcquisitionMode: NON DISPONIBILE" << std::endl;
+                }
 
-          for (uint32_t x = 0; x < width; x += 4) {
-             if (x + 3 < width) {
-                // Decompressione gruppo completo di 4 pixel
-                dstRow[x] = (static_cast<uint16_t>(srcRow[0]) << 2) | (srcRow[1] >> 6);
-                dstRow[x + 1] = ((static_cast<uint16_t>(srcRow[1]) & 0x3F) << 4) | (srcRow[2] >> 4);
-                dstRow[x + 2] = ((static_cast<uint16_t>(srcRow[2]) & 0x0F) << 6) | (srcRow[3] >> 2);
-                dstRow[x + 3] = ((static_cast<uint16_t>(srcRow[3]) & 0x03) << 8) | srcRow[4];
-                srcRow += 5;
-             }
-             else {
-                // Gestione pixel rimanenti
-                for (uint32_t i = x; i < width; ++i) {
-                   dstRow[i] = static_cast<uint16_t>(*srcRow++) << 2;
+                // TriggerMode
+                if (isParameterAvailable("TriggerMode")) {
+                    std::cout << "TriggerMode: " << getParameter("TriggerMode") << std::endl;
+                }
+                else {
+                    std::cout << "TriggerMode: NON DISPONIBILE" << std::endl;
                 }
-             }
-          }
-       }
-    }
 
-    void GenICamCamera::unpackMono12Packed(const uint8_t* src, uint16_t* dst, uint32_t width, uint32_t height) const {
-       for (uint32_t y = 0; y < height; ++y) {
-          const uint8_t* srcRow = src + y * ((width * 12 + 7) / 8);
-          uint16_t* dstRow = dst + y * width;
+                // AcquisitionStatus
+                if (isParameterAvailable("AcquisitionStatus")) {
+                    std::cout << "AcquisitionStatus: " << getParameter("AcquisitionStatus") << std::endl;
+                }
 
-          for (uint32_t x = 0; x < width; x += 2) {
-             if (x + 1 < width) {
-                // Decompressione gruppo completo di 2 pixel
-                dstRow[x] = (static_cast<uint16_t>(srcRow[0]) << 4) | (srcRow[1] >> 4);
-                dstRow[x + 1] = ((static_cast<uint16_t>(srcRow[1]) & 0x0F) << 8) | srcRow[2];
-                srcRow += 3;
-             }
-             else {
-                // Ultimo pixel dispari
-                dstRow[x] = (static_cast<uint16_t>(srcRow[0]) << 4) | (srcRow[1] >> 4);
-             }
-          }
-       }
-    }
-    PixelFormat GenICamCamera::convertFromGenICamPixelFormat(uint64_t genICamFormat) const {
-       // Mappatura basata su PFNC (Pixel Format Naming Convention) v2.5
-       switch (genICamFormat) {
-          // Formati monocromatici
-       case 0x01080001: return PixelFormat::Mono8;
-       case 0x01100003: return PixelFormat::Mono10;
-       case 0x01100005: return PixelFormat::Mono12;
-       case 0x01100009: return PixelFormat::Mono14;
-       case 0x01100007: return PixelFormat::Mono16;
+                // Per GigE
+                if (isParameterAvailable("GevCCP")) {
+                    std::cout << "GevCCP (Control Privilege): " << getParameter("GevCCP") << std::endl;
+                }
 
-          // Formati monocromatici packed
-       case 0x010C0004: return PixelFormat::Mono10Packed;
-       case 0x010C0006: return PixelFormat::Mono12Packed;
+                // StreamGrabbing status
+                if (isParameterAvailable("StreamIsGrabbing")) {
+                    std::cout << "StreamIsGrabbing: " << getParameter("StreamIsGrabbing") << std::endl;
+                }
+            }
 
-          // Formati RGB 8 bit
-       case 0x02180014: return PixelFormat::RGB8;
-       case 0x02180015: return PixelFormat::BGR8;
-       case 0x02200016: return PixelFormat::RGBa8;
-       case 0x02200017: return PixelFormat::BGRa8;
+        }
+        catch (const std::exception& e) {
+            std::cout << "Errore durante debug: " << e.what() << std::endl;
+        }
+    }
 
-          // Formati RGB 10/12/16 bit
-       case 0x02300018: return PixelFormat::RGB10;
-       case 0x02300019: return PixelFormat::BGR10;
-       case 0x0230001C: return PixelFormat::RGB12;
-       case 0x0230001D: return PixelFormat::BGR12;
-       case 0x02300033: return PixelFormat::RGB16;
-       case 0x0230004B: return PixelFormat::BGR16;
+    void GenICamCamera::configureHikrobotGigE() {
+        try {
+            // 1. Packet Size (importante per GigE)
+            if (isParameterAvailable("GevSCPSPacketSize")) {
+                setParameter("GevSCPSPacketSize", "1500"); // o "9000" per Jumbo frames
+            }
 
-          // Formati Bayer 8 bit
-       case 0x01080008: return PixelFormat::BayerGR8;
-       case 0x01080009: return PixelFormat::BayerRG8;
-       case 0x0108000A: return PixelFormat::BayerGB8;
-       case 0x0108000B: return PixelFormat::BayerBG8;
+            // 2. Packet Delay (per evitare perdita pacchetti)
+            if (isParameterAvailable("GevSCPD")) {
+                setParameter("GevSCPD", "1000"); // microsecondi
+            }
 
-          // Formati Bayer 10 bit
-       case 0x0110000C: return PixelFormat::BayerGR10;
-       case 0x0110000D: return PixelFormat::BayerRG10;
-       case 0x0110000E: return PixelFormat::BayerGB10;
-       case 0x0110000F: return PixelFormat::BayerBG10;
+            // 3. Disabilita features che potrebbero interferire
+            if (isParameterAvailable("ChunkModeActive")) {
+                setParameter("ChunkModeActive", "false");
+            }
 
-          // Formati Bayer 12 bit
-       case 0x01100010: return PixelFormat::BayerGR12;
-       case 0x01100011: return PixelFormat::BayerRG12;
-       case 0x01100012: return PixelFormat::BayerGB12;
-       case 0x01100013: return PixelFormat::BayerBG12;
+            // 4. Frame timeout
+            if (isParameterAvailable("GevSCFTD")) {
+                setParameter("GevSCFTD", "3000000"); // 3 secondi
+            }
 
-          // Formati Bayer 16 bit
-       case 0x0110002E: return PixelFormat::BayerGR16;
-       case 0x0110002F: return PixelFormat::BayerRG16;
-       case 0x01100030: return PixelFormat::BayerGB16;
-       case 0x01100031: return PixelFormat::BayerBG16;
+            // 5. Imposta modalità trasferimento
+            if (isParameterAvailable("StreamBufferHandlingMode")) {
+                setParameter("StreamBufferHandlingMode", "NewestOnly");
+            }
 
-          // Formati Bayer packed
-       case 0x010C0026: return PixelFormat::BayerGR10Packed;
-       case 0x010C0027: return PixelFormat::BayerRG10Packed;
-       case 0x010C0028: return PixelFormat::BayerGB10Packed;
-       case 0x010C0029: return PixelFormat::BayerBG10Packed;
-       case 0x010C002A: return PixelFormat::BayerGR12Packed;
-       case 0x010C002B: return PixelFormat::BayerRG12Packed;
-       case 0x010C002C: return PixelFormat::BayerGB12Packed;
-       case 0x010C002D: return PixelFormat::BayerBG12Packed;
+            if (isParameterAvailable("GevCCP")) {
+                setParameter("GevCCP", "ExclusiveAccess");
+                std::cout << "Control Channel Privilege acquisito" << std::endl;
+            }
 
-          // Formati YUV
-       case 0x02100032: return PixelFormat::YUV422_8;      // YUV422_8 generico
-       case 0x0210001F: return PixelFormat::YUV422_8_UYVY; // UYVY
-       case 0x02100022: return PixelFormat::YUV422_8_YUYV; // YUYV  
-       case 0x02180020: return PixelFormat::YUV444_8;
+            // Verifica il privilegio
+            if (isParameterAvailable("GevCCP")) {
+                std::string privilege = getParameter("GevCCP");
+                std::cout << "Privilegio corrente: " << privilege << std::endl;
+            }
+        }
+        catch (...) {
+            // Non critico se alcuni parametri non sono disponibili
+        }
+    }
+    // === Gestione Buffer ===
 
-          // Formati 3D e speciali
-       case 0x023000C0: return PixelFormat::Coord3D_ABC32f;
-       case 0x023000C1: return PixelFormat::Coord3D_ABC16;
-       case 0x010800C4: return PixelFormat::Confidence8;
-       case 0x011000C5: return PixelFormat::Confidence16;
+    void GenICamCamera::openDataStream() {
+        GenTL::GC_ERROR err;
+
+        uint32_t numStreams = 0;
+        err = GENTL_CALL(DevGetNumDataStreams)(m_devHandle, &numStreams);
+        if (err != GenTL::GC_ERR_SUCCESS || numStreams == 0) {
+            THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Nessun data stream disponibile", err);
+        }
 
-          // Formato non riconosciuto
-       default: return PixelFormat::Undefined;
-       }
+        char streamID[256] = { 0 };
+        size_t streamIDSize = sizeof(streamID);
+        err = GENTL_CALL(DevGetDataStreamID)(m_devHandle, 0, streamID, &streamIDSize);
+        if (err != GenTL::GC_ERR_SUCCESS) {
+            THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Impossibile ottenere l'ID dello stream", err);
+        }
+
+        err = GENTL_CALL(DevOpenDataStream)(m_devHandle, streamID, &m_dsHandle);
+        if (err != GenTL::GC_ERR_SUCCESS) {
+            THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Impossibile aprire il data stream", err);
+        }
     }
 
-    uint64_t GenICamCamera::convertToGenICamPixelFormat(PixelFormat format) const {
-       switch (format) {
-          // Formati monocromatici
-       case PixelFormat::Mono8:         return 0x01080001;
-       case PixelFormat::Mono10:        return 0x01100003;
-       case PixelFormat::Mono12:        return 0x01100005;
-       case PixelFormat::Mono14:        return 0x01100009;
-       case PixelFormat::Mono16:        return 0x01100007;
+    void GenICamCamera::updateBufferSize() {
+        GenTL::GC_ERROR err;
+        GenTL::INFO_DATATYPE dataType;
+        bool8_t definesPayloadSize = 0;
+        size_t infoSize = sizeof(definesPayloadSize);
 
-          // Formati monocromatici packed
-       case PixelFormat::Mono10Packed:  return 0x010C0004;
-       case PixelFormat::Mono12Packed:  return 0x010C0006;
+        err = GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_DEFINES_PAYLOADSIZE, &dataType, &definesPayloadSize, &infoSize);
 
-          // Formati RGB 8 bit
-       case PixelFormat::RGB8:          return 0x02180014;
-       case PixelFormat::BGR8:          return 0x02180015;
-       case PixelFormat::RGBa8:         return 0x02200016;
-       case PixelFormat::BGRa8:         return 0x02200017;
+        if (definesPayloadSize) {
+            infoSize = sizeof(m_bufferSize);
+            err = GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_PAYLOAD_SIZE, &dataType, &m_bufferSize, &infoSize);
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, "Impossibile determinare la dimensione del buffer", err);
+            }
+            return;
+        }
 
-          // Formati RGB 10/12/16 bit
-       case PixelFormat::RGB10:         return 0x02300018;
-       case PixelFormat::BGR10:         return 0x02300019;
-       case PixelFormat::RGB12:         return 0x0230001C;
-       case PixelFormat::BGR12:         return 0x0230001D;
-       case PixelFormat::RGB16:         return 0x02300033;
-       case PixelFormat::BGR16:         return 0x0230004B;
+        GenApi::IInteger* pp = dynamic_cast<GenApi::IInteger*>(m_pNodeMap->_GetNode("PayloadSize"));
+        if (GenApi::IsReadable(pp)) {
+            m_bufferSize = static_cast<size_t>(pp->GetValue());
+            return;
+        }
 
-          // Formati Bayer 8 bit
-       case PixelFormat::BayerGR8:      return 0x01080008;
-       case PixelFormat::BayerRG8:      return 0x01080009;
-       case PixelFormat::BayerGB8:      return 0x0108000A;
-       case PixelFormat::BayerBG8:      return 0x0108000B;
+        // Calcola manualmente per telecamere che non definiscono PayloadSize
+        ROI roi = getROI();
+        PixelFormat pf = getPixelFormat();
+
+        int bytesPerPixel = 1;
+        switch (pf) {
+        case PixelFormat::Mono8:
+        case PixelFormat::BayerRG8:
+        case PixelFormat::BayerGB8:
+        case PixelFormat::BayerGR8:
+        case PixelFormat::BayerBG8:
+            bytesPerPixel = 1;
+            break;
+        case PixelFormat::Mono10:
+        case PixelFormat::Mono12:
+        case PixelFormat::Mono16:
+            bytesPerPixel = 2;
+            break;
+        case PixelFormat::RGB8:
+        case PixelFormat::BGR8:
+            bytesPerPixel = 3;
+            break;
+        default:
+            bytesPerPixel = 1;
+        }
 
-          // Formati Bayer 10 bit
-       case PixelFormat::BayerGR10:     return 0x0110000C;
-       case PixelFormat::BayerRG10:     return 0x0110000D;
-       case PixelFormat::BayerGB10:     return 0x0110000E;
-       case PixelFormat::BayerBG10:     return 0x0110000F;
+        m_bufferSize = roi.width * roi.height * bytesPerPixel;
+    }
 
-          // Formati Bayer 12 bit
-       case PixelFormat::BayerGR12:     return 0x01100010;
-       case PixelFormat::BayerRG12:     return 0x01100011;
-       case PixelFormat::BayerGB12:     return 0x01100012;
-       case PixelFormat::BayerBG12:     return 0x01100013;
+    size_t GenICamCamera::getBufferAlignment() const {
+        size_t alignment = 1;
+        size_t alignInfoSize = sizeof(alignment);
+        GenTL::INFO_DATATYPE dataType;
 
-          // Formati Bayer 16 bit
-       case PixelFormat::BayerGR16:     return 0x0110002E;
-       case PixelFormat::BayerRG16:     return 0x0110002F;
-       case PixelFormat::BayerGB16:     return 0x01100030;
-       case PixelFormat::BayerBG16:     return 0x01100031;
+        GenTL::GC_ERROR err = GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_BUF_ALIGNMENT, &dataType, &alignment, &alignInfoSize);
+        if (err != GenTL::GC_ERR_SUCCESS || alignment == 0) {
+            alignment = 64;  // Default sicuro per la maggior parte delle telecamere
+        }
 
-          // Formati Bayer packed
-       case PixelFormat::BayerGR10Packed: return 0x010C0026;
-       case PixelFormat::BayerRG10Packed: return 0x010C0027;
-       case PixelFormat::BayerGB10Packed: return 0x010C0028;
-       case PixelFormat::BayerBG10Packed: return 0x010C0029;
-       case PixelFormat::BayerGR12Packed: return 0x010C002A;
-       case PixelFormat::BayerRG12Packed: return 0x010C002B;
-       case PixelFormat::BayerGB12Packed: return 0x010C002C;
-       case PixelFormat::BayerBG12Packed: return 0x010C002D;
+        // aligned_alloc richiede una potenza di 2
+        size_t powerOf2 = 1;
+        while (powerOf2 < alignment) {
+            powerOf2 <<= 1;
+        }
+        return powerOf2;
+    }
 
-          // Formati YUV
-       case PixelFormat::YUV422_8:      return 0x02100032;
-       case PixelFormat::YUV422_8_UYVY: return 0x0210001F;
-       case PixelFormat::YUV422_8_YUYV: return 0x02100022;
-       case PixelFormat::YUV444_8:      return 0x02180020;
+    void GenICamCamera::allocateBuffers(size_t count) {
+        if (count == 0) {
+            THROW_GENICAM_ERROR(ErrorType::BufferError,
+                "Il numero di buffer deve essere > 0");
+        }
 
-          // Formati 3D e speciali
-       case PixelFormat::Coord3D_ABC32f: return 0x023000C0;
-       case PixelFormat::Coord3D_ABC16:  return 0x023000C1;
-       case PixelFormat::Confidence8:    return 0x010800C4;
-       case PixelFormat::Confidence16:   return 0x011000C5;
+        // Cleanup di eventuali buffer esistenti
+        freeBuffers();
 
-          // Formato non definito
-       case PixelFormat::Undefined:
-       default:                         return 0x00000000;
-       }
-    }
-    std::string GenICamCamera::getGenTLErrorString(GenTL::GC_ERROR error) const {
-        return GenICamException::getGenTLErrorString(error);
-    }
+        // Nodo NUMA dei buffer, usato anche dai thread avviati dopo l'allocazione
+        resolveNumaPlacement();
 
-    void GenICamCamera::setEventListener(CameraEventListener* listener) {
-        std::lock_guard<std::mutex> lock(m_callbackMutex);
-        m_eventListener = listener;
-    }
+        // Clear dei vettori
+        m_bufferHandles.clear();
+        m_alignedBuffers.clear();
 
-    // === Grab Single Frame ===
-    cv::Mat GenICamCamera::grabSingleFrame(uint32_t timeoutMs) {
-       if (!isConnected()) {
-          THROW_GENICAM_ERROR(ErrorType::ConnectionError, "Camera non connessa");
-       }
+        // Riserva spazio per evitare riallocazioni
+        m_bufferHandles.reserve(count);
+        m_alignedBuffers.reserve(count);
 
-       if (m_isAcquiring) {
-          THROW_GENICAM_ERROR(ErrorType::AcquisitionError, "Acquisizione continua in corso");
-       }
+        GenTL::GC_ERROR err;
 
-       cv::Mat result;
-       GenTL::GC_ERROR err;
+        // Ottieni requisiti di allineamento dal data stream
+        size_t alignment = 1;
+        size_t alignInfoSize = sizeof(alignment);
+        GenTL::INFO_DATATYPE dataType;
 
-       try {
-          //configureHikrobotGigE(); // Configura la camera per SingleFrame
-          debugAcquisitionStart();
-          prepareTransportLayerForAcquisition();
-          setTransportLayerLock(false);   // nel caso in cui fosse stato bloccato prima malamentemente
+        err = GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_BUF_ALIGNMENT, &dataType, &alignment, &alignInfoSize);
 
-          //PRIMA configura la camera per SingleFrame (PRIMA di aprire il DataStream)
-          std::cout << "1. Configurazione camera per acquisizione singola..." << std::endl;
-          // Imposta AcquisitionMode PRIMA di tutto
-          if (isAcquisitionModeAvailable()) {
-             setAcquisitionMode(AcquisitionMode::Continuous);
-          }
+        if (err != GenTL::GC_ERR_SUCCESS || alignment == 0) {
+            alignment = 64;  // Default sicuro per la maggior parte delle telecamere
+            std::cout << "Warning: Using default alignment of " << alignment << " bytes" << std::endl;
+        }
+        else {
+            std::cout << "Buffer alignment requirement: " << alignment << " bytes" << std::endl;
+        }
 
-          // i parametri che pilotano l'acquisizione devono essere impostati prima del blocco dei parametri GenTL
-          if (isTriggerModeAvailable()) {
-             setTriggerMode(TriggerMode::On);
-             if (getTriggerMode() == TriggerMode::On)
-                setTriggerSource(TriggerSource::Software);
-          }
+        // Allinea la dimensione del buffer ai requisiti
+        size_t alignedBufferSize = ((m_bufferSize + alignment - 1) / alignment) * alignment;
 
-          // bisogna bloccare i parametri Transport Layer prima di proseguire dello streaming!!!!...e sbloccarli appena dopo le deallocazione dello streaming
-          setTransportLayerLock(true);
+        if (alignedBufferSize != m_bufferSize) {
+            std::cout << "Buffer size aligned from " << m_bufferSize
+                << " to " << alignedBufferSize << " bytes" << std::endl;
+        }
 
-          // 2. ORA apri il DataStream
-          std::cout << "2. Apertura DataStream..." << std::endl;
+        // Memoria del chiamante: nessuna allocazione
+        if (!m_externalBuffers.empty()) {
+            if (count != m_externalBuffers.size()) {
+                std::cout << "Using " << m_externalBuffers.size() << " external buffers (requested "
+                    << count << ")" << std::endl;
+            }
+            announceExternalBuffers(alignedBufferSize);
+            applyBufferResidency();
+            return;
+        }
 
-          uint32_t numStreams = 0;
-          err = GENTL_CALL(DevGetNumDataStreams)(m_devHandle, &numStreams);
-          if (err != GenTL::GC_ERR_SUCCESS || numStreams == 0) {
-             THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError,
-                "Nessun data stream disponibile", err);
-          }
+        // Pool persistente: la memoria è già allocata dalle sessioni precedenti,
+        // a ogni avvio i buffer vengono soltanto annunciati
+        if (m_bufferAllocationConfig.usePool &&
+            announcePooledBuffers(count, alignedBufferSize, getBufferAlignment())) {
+            applyBufferResidency();
+            return;
+        }
 
-          char streamID[256] = { 0 };
-          size_t streamIDSize = sizeof(streamID);
-          err = GENTL_CALL(DevGetDataStreamID)(m_devHandle, 0, streamID, &streamIDSize);
-          if (err != GenTL::GC_ERR_SUCCESS) {
-             THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError,
-                "Impossibile ottenere l'ID dello stream", err);
-          }
+        // Usati per i buffer aggiunti durante lo streaming (allocati dal producer)
+        m_announcedBufferSize = alignedBufferSize;
+        m_announcedBufferAlignment = alignment;
 
-          err = GENTL_CALL(DevOpenDataStream)(m_devHandle, streamID, &m_dsHandle);
-          if (err != GenTL::GC_ERR_SUCCESS) {
-             THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError,
-                "Impossibile aprire il data stream", err);
-          }
+        // Flag per decidere il metodo di allocazione. In modalità Loan i listener possono
+        // trattenere i buffer oltre lo stop: serve memoria del wrapper, che closeLoanSession
+        // trattiene, mentre quella del producer verrebbe liberata dalla revoca
+        bool useProducerAllocation = (m_deliveryMode.load() != FrameDeliveryMode::Loan);
 
-          // 3. Ottieni dimensione buffer
-          GenTL::INFO_DATATYPE dataType;
-          bool8_t definesPayloadSize = 0;
-          size_t infoSize = sizeof(definesPayloadSize);
+        // Prima tentativo: lascia che il producer allochi la memoria
+        if (useProducerAllocation) {
+            std::cout << "Trying producer-managed buffer allocation..." << std::endl;
 
-          err = GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_DEFINES_PAYLOADSIZE, &dataType, &definesPayloadSize, &infoSize);
+            for (size_t i = 0; i < count; i++) {
+                GenTL::BUFFER_HANDLE hBuffer = nullptr;
 
-          if (definesPayloadSize) {
-             infoSize = sizeof(m_bufferSize);
-             err = GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_PAYLOAD_SIZE, &dataType, &m_bufferSize, &infoSize);
-             if (err != GenTL::GC_ERR_SUCCESS) {
-                THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, "Impossibile determinare la dimensione del buffer", err);
-             }
-          }
-          else {
-             // meglio cosi' pero'
-             GenApi::IInteger* pp = dynamic_cast<GenApi::IInteger*>(m_pNodeMap->_GetNode("PayloadSize"));
-             if (GenApi::IsReadable(pp))
-                m_bufferSize = static_cast<size_t>(pp->GetValue());
-             else {
-                // Calcola manualmente per telecamere che non definiscono PayloadSize
-                ROI roi = getROI();
-                PixelFormat pf = getPixelFormat();
-
-                int bytesPerPixel = 1;
-                switch (pf) {
-                case PixelFormat::Mono8:
-                case PixelFormat::BayerRG8:
-                case PixelFormat::BayerGB8:
-                case PixelFormat::BayerGR8:
-                case PixelFormat::BayerBG8:
-                   bytesPerPixel = 1;
-                   break;
-                case PixelFormat::Mono10:
-                case PixelFormat::Mono12:
-                case PixelFormat::Mono16:
-                   bytesPerPixel = 2;
-                   break;
-                case PixelFormat::RGB8:
-                case PixelFormat::BGR8:
-                   bytesPerPixel = 3;
-                   break;
-                default:
-                   bytesPerPixel = 1;
+                err = GENTL_CALL(DSAllocAndAnnounceBuffer)(m_dsHandle, alignedBufferSize, nullptr, &hBuffer);
+
+                if (err == GenTL::GC_ERR_SUCCESS) {
+                    m_bufferHandles.push_back(hBuffer);
+                }
+                else {
+                    std::cout << "Producer allocation failed: " << getGenTLErrorString(err)
+                        << ", falling back to manual allocation" << std::endl;
+
+                    // Pulisci i buffer già allocati
+                    for (auto& handle : m_bufferHandles) {
+                        GENTL_CALL(DSRevokeBuffer)(m_dsHandle, handle, nullptr, nullptr);
+                    }
+                    m_bufferHandles.clear();
+
+                    useProducerAllocation = false;
+                    break;
                 }
+            }
+        }
 
-                m_bufferSize = roi.width * roi.height * bytesPerPixel;
-             }
-          }
+        // Se l'allocazione del producer ha avuto successo, siamo a posto
+        if (useProducerAllocation) {
+            std::cout << "Successfully allocated " << count
+                << " buffers using producer allocation" << std::endl;
+            applyBufferResidency();
+            return;
+        }
 
-          std::cout << "3. Buffer size calcolato: " << m_bufferSize << " bytes" << std::endl;
+        // Secondo tentativo: allocazione manuale con memoria allineata
+        std::cout << "Using manual buffer allocation with "
+            << alignment << "-byte alignment" << std::endl;
 
-          // 4. Alloca e registra buffer
-          allocateBuffers(1);
+        for (size_t i = 0; i < count; i++) {
+            // Alloca memoria allineata
+            void* alignedPtr = allocateAlignedMemory(alignedBufferSize, alignment);
 
-          // 5. Metti il buffer in coda
-          for (auto& hBuffer : m_bufferHandles) {
-             err = GENTL_CALL(DSQueueBuffer)(m_dsHandle, hBuffer);
-             if (err != GenTL::GC_ERR_SUCCESS) {
-                THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, "Impossibile accodare il buffer", err);
-             }
-          }
+            if (!alignedPtr) {
+                freeBuffers();
+                std::stringstream ss;
+                ss << "Impossibile allocare " << alignedBufferSize
+                    << " bytes con allineamento " << alignment;
+                THROW_GENICAM_ERROR(ErrorType::BufferError, ss.str());
+            }
 
-          // 8. IMPORTANTE: Per Hikrobot, potrebbe essere necessario un piccolo delay
-          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            // Azzera la memoria (alcune telecamere lo richiedono)
+            if (m_bufferAllocationConfig.zeroFill) {
+                std::memset(alignedPtr, 0, alignedBufferSize);
+            }
 
-          // 6. Registra evento
-          err = GENTL_CALL(GCRegisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER, &m_eventHandle);
-          if (err != GenTL::GC_ERR_SUCCESS) {
-             THROW_GENICAM_ERROR_CODE(ErrorType::GenTLError, "Impossibile registrare l'evento NEW_BUFFER", err);
-          }
+            // Gestisci la memoria con unique_ptr e custom deleter
+            m_alignedBuffers.push_back(std::unique_ptr<void, AlignedBufferDeleter>(alignedPtr));
 
-          size_t numDelivered = 0, numQueued = 0, numStarted = 0, isGrabbing = 0, numAnnounced = 0, numAwaitDelivery = 0;
+            // Annuncia il buffer al data stream
+            GenTL::BUFFER_HANDLE hBuffer = nullptr;
+            err = GENTL_CALL(DSAnnounceBuffer)(m_dsHandle, alignedPtr, alignedBufferSize, nullptr, &hBuffer);
+
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                // Log dettagliato dell'errore
+                std::cerr << "DSAnnounceBuffer failed:" << std::endl;
+                std::cerr << "  Error: " << getGenTLErrorString(err)
+                    << " (0x" << std::hex << err << std::dec << ")" << std::endl;
+                std::cerr << "  Buffer " << i << " of " << count << std::endl;
+                std::cerr << "  Address: " << alignedPtr << std::endl;
+                std::cerr << "  Size: " << alignedBufferSize << " bytes" << std::endl;
+                std::cerr << "  Alignment: " << alignment << " bytes" << std::endl;
+
+                freeBuffers();
 
-          GenTL::INFO_DATATYPE dt;
-          size_t sz = sizeof(numQueued);
-          GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_QUEUED, &dt, &numQueued, &sz);
-          std::cout << "   - Queued prima di DSAcquisition: " << numQueued << std::endl;
+                THROW_GENICAM_ERROR_CODE(ErrorType::BufferError,
+                    "Impossibile annunciare il buffer", err);
+            }
 
-          // 7. Avvia il DataStream
-          std::cout << "4. Avvio DataStream..." << std::endl;
-          err = GENTL_CALL(DSStartAcquisition)(m_dsHandle, GenTL::ACQ_START_FLAGS_DEFAULT, GENTL_INFINITE);
-          if (err != GenTL::GC_ERR_SUCCESS) {
-             THROW_GENICAM_ERROR_CODE(ErrorType::AcquisitionError, "Impossibile avviare l'acquisizione sul data stream", err);
-          }
-          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            m_bufferHandles.push_back(hBuffer);
+        }
 
-          // 10. Per SingleFrame, potrebbe essere necessario un trigger
-/*            if (getAcquisitionMode() == AcquisitionMode::SingleFrame) {
-                // Alcune telecamere Hikrobot richiedono un comando specifico
-                try {
-                    GenApi::CCommandPtr pFrameStart = getCommandNode("TriggerSoftware");
-                    if (pFrameStart.IsValid() && GenApi::IsWritable(pFrameStart)) {
-                        std::cout << "6. Esecuzione TriggerSoftware per SingleFrame..." << std::endl;
-                        pFrameStart->Execute();
-                    }
-                }
-                catch (...) {
-                    // Non critico se non disponibile
-                }
-            }*/
+        std::cout << "Successfully allocated " << count
+            << " buffers using manual allocation" << std::endl;
+        std::cout << "Buffer size: " << alignedBufferSize
+            << " bytes each" << std::endl;
+        applyBufferResidency();
+    }
 
-            // 9. Avvia acquisizione sulla camera
-          std::cout << "5. Avvio acquisizione camera..." << std::endl;
+    void* GenICamCamera::allocateAlignedMemory(size_t size, size_t alignment) {
+#ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+#else
+        // Assicurati che alignment sia una potenza di 2
+        size_t powerOf2 = 1;
+        while (powerOf2 < alignment) {
+            powerOf2 <<= 1;
+        }
+        return aligned_alloc(powerOf2, size);
+#endif
+    }
 
-          try {
-             //GenApi::CCommandPtr pAcqStart = getCommandNode("AcquisitionStart");
-             GenApi::CCommandPtr pAcqStart = m_pNodeMap->_GetNode("AcquisitionStart");
-             refreshNodeMap();
-             
-             if (pAcqStart.IsValid()) {
-                pAcqStart->Execute();
+    bool GenICamCamera::announcePooledBuffers(size_t count, size_t bufferSize, size_t alignment) {
+        m_announcedBufferSize = bufferSize;
+        m_announcedBufferAlignment = alignment;
+        m_pooledBuffers = m_bufferPool.acquire(count, bufferSize, alignment,
+            m_bufferAllocationConfig.memoryPolicy, m_numaNode.load(), m_bufferAllocationConfig.zeroFill);
+        if (m_pooledBuffers.empty()) {
+            std::cout << "Buffer pool allocation failed, falling back to producer allocation" << std::endl;
+            return false;
+        }
 
-                // Attendi che il comando sia completato
-                int waitCount = 0;
-                while (!pAcqStart->IsDone() && waitCount < 100) {
-                   std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                   waitCount++;
-                }
-                m_isAcquiring = true;
-                m_stopAcquisition = false;
-                std::cout << "   AcquisitionStart eseguito con successo" << std::endl;
-             }
-             else {
-                std::cout << "   WARNING: AcquisitionStart non disponibile" << std::endl;
-             }
-          }
-          catch (const GENICAM_NAMESPACE::GenericException& e) {
-             std::cout << "   WARNING: AcquisitionStart fallito: " << e.GetDescription() << std::endl;
-             // Continua comunque, alcune camere non richiedono questo comando
-          }
+        for (void* block : m_pooledBuffers) {
+            GenTL::BUFFER_HANDLE hBuffer = nullptr;
+            GenTL::GC_ERROR err = GENTL_CALL(DSAnnounceBuffer)(m_dsHandle, block, bufferSize, nullptr, &hBuffer);
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                std::cout << "DSAnnounceBuffer on pooled memory failed: " << getGenTLErrorString(err)
+                    << ", falling back to producer allocation" << std::endl;
+                // Revoca gli annunci già fatti e restituisce tutti i blocchi al pool
+                freeBuffers();
+                return false;
+            }
+            m_bufferHandles.push_back(hBuffer);
+        }
 
-          std::this_thread::sleep_for(std::chrono::milliseconds(100));
-          if (getTriggerMode() == TriggerMode::On)
-             executeTriggerSoftware();
+        const BufferPoolStatistics stats = m_bufferPool.statistics();
+        std::cout << "Announced " << count << " pooled buffers of " << bufferSize
+            << " bytes (pool: " << stats.totalBuffers << " buffers, "
+            << stats.reuses << " reuses, " << stats.allocations << " allocations)" << std::endl;
+        if (stats.requestedPolicy != BufferMemoryPolicy::Default) {
+            std::cout << "Buffer memory policy " << BufferPool::policyToString(stats.requestedPolicy)
+                << ": " << stats.hugePage1GBuffers << " x 1G, " << stats.hugePage2MBuffers << " x 2M, "
+                << stats.transparentHugePageBuffers << " x THP, " << stats.standardPageBuffers << " x 4K" << std::endl;
+            if (!stats.lastFallbackReason.empty()) {
+                std::cout << "  Fallback: " << stats.lastFallbackReason << std::endl;
+            }
+        }
+        if (stats.numaNode >= 0) {
+            std::cout << "NUMA node " << stats.numaNode << ": " << stats.numaBoundBuffers
+                << " of " << stats.totalBuffers << " buffers bound" << std::endl;
+        }
+        return true;
+    }
 
-          // 11. Attendi il frame
-          GenTL::EVENT_NEW_BUFFER_DATA bufferData;
-          size_t bufferDataSize = sizeof(bufferData);
+    void GenICamCamera::announceExternalBuffers(size_t bufferSize) {
+        const size_t alignment = getBufferAlignment();
+        m_announcedBufferSize = bufferSize;
+        m_announcedBufferAlignment = alignment;
 
-          std::cout << "7. Attesa frame (timeout: " << timeoutMs << "ms)..." << std::endl;
+        // Verifica completa prima di annunciare: nessun annuncio parziale su errore
+        for (size_t i = 0; i < m_externalBuffers.size(); i++) {
+            const ExternalBuffer& buffer = m_externalBuffers[i];
+            if (buffer.size < m_bufferSize) {
+                std::stringstream ss;
+                ss << "Buffer esterno " << i << " troppo piccolo: " << buffer.size
+                    << " bytes, PayloadSize " << m_bufferSize;
+                THROW_GENICAM_ERROR(ErrorType::BufferError, ss.str());
+            }
+            if (reinterpret_cast<uintptr_t>(buffer.data) % alignment != 0) {
+                std::stringstream ss;
+                ss << "Buffer esterno " << i << " non allineato a " << alignment << " bytes";
+                THROW_GENICAM_ERROR(ErrorType::BufferError, ss.str());
+            }
+        }
 
-          err = GENTL_CALL(EventGetData)(m_eventHandle, &bufferData, &bufferDataSize, timeoutMs);
+        for (size_t i = 0; i < m_externalBuffers.size(); i++) {
+            const ExternalBuffer& buffer = m_externalBuffers[i];
+            GenTL::BUFFER_HANDLE hBuffer = nullptr;
+            GenTL::GC_ERROR err = GENTL_CALL(DSAnnounceBuffer)(m_dsHandle, buffer.data, buffer.size, buffer.userContext, &hBuffer);
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                // Nessun ripiego: il chiamante si aspetta i frame nella propria memoria
+                freeBuffers();
+                std::stringstream ss;
+                ss << "Impossibile annunciare il buffer esterno " << i;
+                THROW_GENICAM_ERROR_CODE(ErrorType::BufferError, ss.str(), err);
+            }
+            m_bufferHandles.push_back(hBuffer);
 
-          if (err != GenTL::GC_ERR_SUCCESS) {
-             // Debug: verifica stato stream
+            auto onReleased = m_externalBufferCallbacks.onReleased;
+            m_externalBufferLeases.push_back(std::shared_ptr<void>(buffer.data, [buffer, onReleased](void*) {
+                if (onReleased) {
+                    onReleased(buffer);
+                }
+            }));
 
-             GenTL::INFO_DATATYPE dt;
-             size_t sz = sizeof(numDelivered);
+            if (m_externalBufferCallbacks.onAnnounced) {
+                m_externalBufferCallbacks.onAnnounced(buffer);
+            }
+        }
 
-             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_DELIVERED, &dt, &numDelivered, &sz);
-             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_QUEUED, &dt, &numQueued, &sz);
-             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_STARTED, &dt, &numStarted, &sz);
-             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_IS_GRABBING, &dt, &isGrabbing, &sz);
-             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_ANNOUNCED, &dt, &numAnnounced, &sz);
-             GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_AWAIT_DELIVERY, &dt, &numAwaitDelivery, &sz);
+        std::cout << "Announced " << m_externalBuffers.size() << " external buffers" << std::endl;
+    }
 
+    void GenICamCamera::setExternalBuffers(const std::vector<ExternalBuffer>& buffers, ExternalBufferCallbacks callbacks) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-             std::cout << "   Frame non ricevuto!" << std::endl;
-             std::cout << "   - Delivered: " << numDelivered << std::endl;
-             std::cout << "   - Queued: " << numQueued << std::endl;
-             std::cout << "   - Started: " << numStarted << std::endl;
-             std::cout << "   - Grabbing: " << isGrabbing << std::endl;
-             std::cout << "   - Announced: " << numAnnounced << std::endl;
-             std::cout << "   - Await delivery: " << numAwaitDelivery << std::endl;
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare i buffer esterni durante l'acquisizione");
+        }
+        if (buffers.empty()) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Nessun buffer esterno specificato");
+        }
 
-             THROW_GENICAM_ERROR_CODE(ErrorType::TimeoutError, "Timeout acquisizione frame", err);
-          }
+        for (size_t i = 0; i < buffers.size(); i++) {
+            if (!buffers[i].data || buffers[i].size == 0) {
+                std::stringstream ss;
+                ss << "Buffer esterno " << i << " non valido (indirizzo nullo o dimensione 0)";
+                THROW_GENICAM_ERROR(ErrorType::ParameterError, ss.str());
+            }
+        }
 
-          std::cout << "8. Frame ricevuto!" << std::endl;
+        // Il producer non può scrivere due frame nella stessa memoria
+        std::vector<const ExternalBuffer*> sorted;
+        for (const auto& buffer : buffers) {
+            sorted.push_back(&buffer);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const ExternalBuffer* a, const ExternalBuffer* b) {
+            return reinterpret_cast<uintptr_t>(a->data) < reinterpret_cast<uintptr_t>(b->data);
+        });
+        for (size_t i = 1; i < sorted.size(); i++) {
+            const uintptr_t previousEnd = reinterpret_cast<uintptr_t>(sorted[i - 1]->data) + sorted[i - 1]->size;
+            if (reinterpret_cast<uintptr_t>(sorted[i]->data) < previousEnd) {
+                THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                    "Buffer esterni sovrapposti");
+            }
+        }
 
-          // 12. Processa il buffer
-          GenTL::BUFFER_HANDLE hBuffer = bufferData.BufferHandle;
-          if (hBuffer) {
-             void* pBuffer = nullptr;
-             size_t infoSize = sizeof(pBuffer);
-             GenTL::INFO_DATATYPE dataType;
+        m_externalBuffers = buffers;
+        m_externalBufferCallbacks = std::move(callbacks);
+    }
 
-             err = GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_BASE, &dataType, &pBuffer, &infoSize);
+    void GenICamCamera::clearExternalBuffers() {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-             if (err == GenTL::GC_ERR_SUCCESS && pBuffer) {
-                uint32_t width = 0, height = 0;
-                uint64_t pixelFormat = 0;
-                size_t tempSize = sizeof(uint32_t);
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare i buffer esterni durante l'acquisizione");
+        }
 
-                GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_WIDTH, &dataType, &width, &tempSize);
-                GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_HEIGHT, &dataType, &height, &tempSize);
+        m_externalBuffers.clear();
+        m_externalBufferCallbacks = {};
+    }
 
-                tempSize = sizeof(uint64_t);
-                GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_PIXELFORMAT, &dataType, &pixelFormat, &tempSize);
+    size_t GenICamCamera::getExternalBufferCount() const {
+        return m_externalBuffers.size();
+    }
 
-                result = convertBufferToMat(pBuffer, m_bufferSize, width, height, convertFromGenICamPixelFormat(pixelFormat));
-             }
-          }
+    // === Anello di frame condiviso ===
 
-          // 13. Stop acquisizione camera
-          try {
-             GenApi::CCommandPtr pAcqStop = getCommandNode("AcquisitionStop");
-             if (pAcqStop.IsValid() && GenApi::IsWritable(pAcqStop)) {
-                pAcqStop->Execute();
-             }
-             m_isAcquiring = false;
-             m_stopAcquisition = true;
-          }
-          catch (...) {}
+    void GenICamCamera::enableSharedFrameRing(const SharedFrameRingConfig& config) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-          // Cleanup DataStream
-          if (m_eventHandle) {
-             m_isAcquiring = false;
-             m_stopAcquisition = true;
-             GENTL_CALL(GCUnregisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER);
-             m_eventHandle = nullptr;
-          }
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare l'anello condiviso durante l'acquisizione");
+        }
+        if (config.name.empty() || config.slotCount < 2) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "L'anello condiviso richiede un nome e almeno 2 slot");
+        }
 
-          if (m_dsHandle) {
-             GENTL_CALL(DSStopAcquisition)(m_dsHandle, GenTL::ACQ_STOP_FLAGS_DEFAULT);
-             GENTL_CALL(DSFlushQueue)(m_dsHandle, GenTL::ACQ_QUEUE_ALL_DISCARD);
-             GENTL_CALL(DSClose)(m_dsHandle);
-             m_dsHandle = nullptr;
-          }
+        size_t slotCapacity = config.slotCapacity;
+        if (slotCapacity == 0) {
+            if (!isConnected()) {
+                THROW_GENICAM_ERROR(ErrorType::ConnectionError,
+                    "Camera non connessa: impossibile calcolare la capacità degli slot");
+            }
 
-          setTransportLayerLock(false);
-          setTriggerMode(TriggerMode::Off);
+            // Raw: dimensione del payload; Converted: fino a 3 canali per pixel (es. Bayer -> BGR)
+            const ROI roi = getROI();
+            const int bitsPerPixel = getBitsPerPixel(getPixelFormat());
+            const size_t rawSize = (static_cast<size_t>(roi.width) * roi.height * bitsPerPixel + 7) / 8;
+            const size_t bytesPerChannel = bitsPerPixel > 8 ? 2 : 1;
+            slotCapacity = config.content == SharedFrameRingContent::Raw
+                ? std::max(rawSize, m_bufferSize)
+                : std::max(rawSize, static_cast<size_t>(roi.width) * roi.height * 3 * bytesPerChannel);
+        }
 
-          freeBuffers(); // da inserirsi anche in qualche altro catch
-       }
-       catch (...) {
-          // Cleanup
-          if (m_eventHandle) {
-             GENTL_CALL(GCUnregisterEvent)(m_dsHandle, GenTL::EVENT_NEW_BUFFER);
-             m_eventHandle = nullptr;
-          }
-          if (m_dsHandle) {
-             GENTL_CALL(DSStopAcquisition)(m_dsHandle, GenTL::ACQ_STOP_FLAGS_DEFAULT);
-             GENTL_CALL(DSClose)(m_dsHandle);
-             m_dsHandle = nullptr;
-          }
-          freeBuffers();
-          throw;
-       }
+        std::string error;
+        if (!m_sharedFrameRing.create(config.name, config.slotCount, slotCapacity, error)) {
+            THROW_GENICAM_ERROR(ErrorType::BufferError,
+                "Impossibile creare l'anello condiviso " + config.name + ": " + error);
+        }
 
-       return result;
+        m_sharedRingConfig = config;
+        m_sharedRingConfig.slotCapacity = slotCapacity;
+        m_sharedRingOversized = 0;
     }
 
-    void GenICamCamera::debugAcquisitionStart() {
-        std::cout << "\n=== Debug AcquisitionStart ===" << std::endl;
+    void GenICamCamera::disableSharedFrameRing() {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-        try {
-            // 1. Verifica esistenza del nodo
-            //GenApi::CCommandPtr pAcqStart = getCommandNode("AcquisitionStart");
-            GenApi::CCommandPtr pAcqStart = m_pNodeMap->_GetNode("AcquisitionStart");
-            std::cout << "AcquisitionStart exists: " << (pAcqStart.IsValid() ? "YES" : "NO") << std::endl;
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare l'anello condiviso durante l'acquisizione");
+        }
+
+        m_sharedFrameRing.close();
+    }
+
+    SharedFrameRingStatistics GenICamCamera::getSharedFrameRingStatistics() const {
+        SharedFrameRingStatistics stats;
+        stats.open = m_sharedFrameRing.isOpen();
+        stats.name = m_sharedFrameRing.name();
+        stats.slotCapacity = m_sharedFrameRing.slotCapacity();
+        stats.publishedFrames = m_sharedFrameRing.publishedCount();
+        stats.oversizedFrames = m_sharedRingOversized.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void GenICamCamera::publishRawFrame(const GrabbedFrame& frame) {
+        SharedFrameMetadata metadata;
+        metadata.frameID = frame.frameID;
+        metadata.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(frame.timestamp.time_since_epoch()).count();
+        metadata.deviceTimestamp = frame.deviceTimestamp;
+        metadata.triggerToken = frame.triggerToken;
+        metadata.width = frame.width;
+        metadata.height = frame.height;
+        metadata.pixelFormat = static_cast<uint32_t>(convertFromGenICamPixelFormat(frame.pixelFormat));
+        metadata.exposureTime = frame.hasChunkExposureTime ? frame.chunkExposureTime : m_exposureTimeShadow.load();
+        metadata.gain = frame.hasChunkGain ? frame.chunkGain : m_gainShadow.load();
+
+        if (frame.deviceTimestamp != 0) {
+            auto clockMapping = m_clockCorrelator.mapping();
+            if (clockMapping->valid) {
+                metadata.hostTimestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    clockMapping->toHostTime(frame.deviceTimestamp).time_since_epoch()).count();
+                metadata.hostTimestampErrorNs = static_cast<int64_t>(clockMapping->errorNs);
+                metadata.hostTimestampValid = 1;
+            }
+        }
+
+        // Righe del buffer (con l'eventuale padding X) se il payload è completo,
+        // altrimenti i byte ricevuti come blocco unico
+        const size_t dataSize = frame.sizeFilled > 0 ? frame.sizeFilled : m_bufferSize;
+        const size_t stride = (static_cast<size_t>(frame.width) * getBitsPerPixel(static_cast<PixelFormat>(metadata.pixelFormat)) + 7) / 8 + frame.xPadding;
+        const bool rows = frame.height > 0 && stride * frame.height <= dataSize;
+
+        const bool published = rows
+            ? m_sharedFrameRing.publish(metadata, frame.pBuffer, stride, frame.height, stride)
+            : m_sharedFrameRing.publish(metadata, frame.pBuffer, dataSize, 1, dataSize);
+        if (!published) {
+            m_sharedRingOversized.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void GenICamCamera::publishConvertedFrame(const ConvertedFrame& frame) {
+        const ImageData& imageData = *frame.imageData;
+        const cv::Mat& image = frame.image;
+
+        SharedFrameMetadata metadata;
+        metadata.frameID = imageData.frameID;
+        metadata.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(imageData.timestamp.time_since_epoch()).count();
+        metadata.deviceTimestamp = imageData.deviceTimestamp;
+        metadata.hostTimestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(imageData.hostTimestamp.time_since_epoch()).count();
+        metadata.hostTimestampErrorNs = imageData.hostTimestampError.count();
+        metadata.hostTimestampValid = imageData.hostTimestampValid ? 1 : 0;
+        metadata.triggerToken = imageData.triggerToken;
+        metadata.width = static_cast<uint32_t>(image.cols);
+        metadata.height = static_cast<uint32_t>(image.rows);
+        metadata.pixelFormat = static_cast<uint32_t>(imageData.pixelFormat);
+        metadata.cvType = image.type();
+        metadata.exposureTime = imageData.exposureTime;
+        metadata.gain = imageData.gain;
+
+        // Righe compatte nello slot anche se il cv::Mat è una sotto-regione
+        const size_t rowBytes = static_cast<size_t>(image.cols) * image.elemSize();
+        if (!m_sharedFrameRing.publish(metadata, image.data, rowBytes, static_cast<size_t>(image.rows), image.step[0])) {
+            m_sharedRingOversized.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void GenICamCamera::resolveNumaPlacement() {
+        m_numaNode = -1;
+        m_numaCpus.clear();
+
+        const int nodeCount = NumaUtils::getNodeCount();
+        if (!m_numaConfig.enabled || nodeCount <= 1) {
+            return;
+        }
 
-            if (!pAcqStart.IsValid()) {
-                std::cout << "ERRORE: Nodo AcquisitionStart non trovato!" << std::endl;
+        int node = m_numaConfig.node;
+        if (node < 0 && m_ifHandle) {
+            // Località dell'interfaccia GenTL: l'ID o il nome riportano di norma la NIC
+            // (GigE Vision) o l'indirizzo PCI del dispositivo (frame grabber, USB3)
+            std::string identifier;
+            const GenTL::INTERFACE_INFO_CMD infoCommands[] = { GenTL::INTERFACE_INFO_ID, GenTL::INTERFACE_INFO_DISPLAYNAME };
+            for (auto infoCommand : infoCommands) {
+                char value[512] = { 0 };
+                size_t size = sizeof(value);
+                GenTL::INFO_DATATYPE dataType;
+                if (GENTL_CALL(IFGetInfo)(m_ifHandle, infoCommand, &dataType, value, &size) == GenTL::GC_ERR_SUCCESS) {
+                    identifier += std::string(value) + " ";
+                }
+            }
+            node = NumaUtils::findDeviceNode(identifier);
+            if (node < 0) {
+                std::cout << "NUMA: nodo dell'interfaccia '" << identifier << "' non determinabile" << std::endl;
                 return;
             }
+        }
 
-            // 2. Verifica accessibilità
-            std::cout << "IsImplemented: " << (GenApi::IsImplemented(pAcqStart) ? "YES" : "NO") << std::endl;
-            std::cout << "IsAvailable: " << (GenApi::IsAvailable(pAcqStart) ? "YES" : "NO") << std::endl;
-            std::cout << "IsReadable: " << (GenApi::IsReadable(pAcqStart) ? "YES" : "NO") << std::endl;
-            std::cout << "IsWritable: " << (GenApi::IsWritable(pAcqStart) ? "YES" : "NO") << std::endl;
+        if (node < 0 || node >= nodeCount) {
+            return;
+        }
 
-            // 3. Se non è writable, verifica perché
-            if (!GenApi::IsWritable(pAcqStart)) {
-                // Verifica visibility
-                //GenApi::EVisibility visibility = pAcqStart->GetVisibility();
-                std::cout << "Visibility: ";
-                GenApi::EVisibility visibility = GenApi::Guru;
-                switch (visibility) {
-                case GenApi::Beginner: std::cout << "Beginner"; break;
-                case GenApi::Expert: std::cout << "Expert"; break;
-                case GenApi::Guru: std::cout << "Guru"; break;
-                case GenApi::Invisible: std::cout << "Invisible"; break;
-                default: std::cout << "Unknown";
-                }
-                std::cout << std::endl;
+        m_numaCpus = NumaUtils::getNodeCpus(node);
+        m_numaNode = node;
+    }
+
+    void GenICamCamera::setNumaConfig(const NumaPlacementConfig& config) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
+
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare il collocamento NUMA durante l'acquisizione");
+        }
+        if (config.node >= NumaUtils::getNodeCount()) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Nodo NUMA " + std::to_string(config.node) + " inesistente");
+        }
+
+        m_numaConfig = config;
+    }
+
+    NumaPlacementConfig GenICamCamera::getNumaConfig() const {
+        return m_numaConfig;
+    }
 
-                // Verifica access mode
-                GenApi::EAccessMode accessMode = pAcqStart->GetAccessMode();
-                std::cout << "AccessMode: ";
-                switch (accessMode) {
-                case GenApi::NI: std::cout << "Not Implemented"; break;
-                case GenApi::NA: std::cout << "Not Available"; break;
-                case GenApi::WO: std::cout << "Write Only"; break;
-                case GenApi::RO: std::cout << "Read Only"; break;
-                case GenApi::RW: std::cout << "Read/Write"; break;
-                default: std::cout << "Unknown";
-                }
-                std::cout << std::endl;
+    int GenICamCamera::getNumaNode() const {
+        return m_numaNode.load();
+    }
 
-                // Verifica dipendenze
-                std::cout << "\n--- Verifica Parametri Correlati ---" << std::endl;
+    // === Numero di buffer adattivo ===
 
-                // AcquisitionMode
-                if (isParameterAvailable("AcquisitionMode")) {
-                    std::cout << "AcquisitionMode: " << getParameter("AcquisitionMode") << std::endl;
-                }
-                else {
-                    std::cout << "AcquisitionMode: NON DISPONIBILE" << std::endl;
-                }
+    void GenICamCamera::requeueBuffer(GenTL::BUFFER_HANDLE hBuffer) {
+        // Buffer in eccesso: invece di tornare al producer viene revocato
+        if (m_pendingBufferRevokes.load(std::memory_order_relaxed) > 0 && tryRevokeBuffer(hBuffer)) {
+            return;
+        }
+        GENTL_CALL(DSQueueBuffer)(m_dsHandle, hBuffer);
+    }
 
-                // TriggerMode
-                if (isParameterAvailable("TriggerMode")) {
-                    std::cout << "TriggerMode: " << getParameter("TriggerMode") << std::endl;
-                }
-                else {
-                    std::cout << "TriggerMode: NON DISPONIBILE" << std::endl;
-                }
+    bool GenICamCamera::tryRevokeBuffer(GenTL::BUFFER_HANDLE hBuffer) {
+        std::lock_guard<std::mutex> lock(m_bufferHandlesMutex);
 
-                // AcquisitionStatus
-                if (isParameterAvailable("AcquisitionStatus")) {
-                    std::cout << "AcquisitionStatus: " << getParameter("AcquisitionStatus") << std::endl;
-                }
+        const size_t pending = m_pendingBufferRevokes.load();
+        if (pending == 0 || m_announcedBufferCount.load() <= m_adaptiveBufferConfig.minBuffers) {
+            return false;
+        }
 
-                // Per GigE
-                if (isParameterAvailable("GevCCP")) {
-                    std::cout << "GevCCP (Control Privilege): " << getParameter("GevCCP") << std::endl;
-                }
+        // Il buffer è fuori da entrambe le code del producer: può essere revocato
+        unlockBufferRegion(hBuffer);
+        void* pBuffer = nullptr;
+        if (GENTL_CALL(DSRevokeBuffer)(m_dsHandle, hBuffer, &pBuffer, nullptr) != GenTL::GC_ERR_SUCCESS) {
+            return false;
+        }
 
-                // StreamGrabbing status
-                if (isParameterAvailable("StreamIsGrabbing")) {
-                    std::cout << "StreamIsGrabbing: " << getParameter("StreamIsGrabbing") << std::endl;
-                }
-            }
+        m_pendingBufferRevokes = pending - 1;
+        m_bufferHandles.erase(std::remove(m_bufferHandles.begin(), m_bufferHandles.end(), hBuffer), m_bufferHandles.end());
 
+        auto pooled = std::find(m_pooledBuffers.begin(), m_pooledBuffers.end(), pBuffer);
+        if (pooled != m_pooledBuffers.end()) {
+            m_bufferPool.release(pBuffer);
+            m_pooledBuffers.erase(pooled);
         }
-        catch (const std::exception& e) {
-            std::cout << "Errore durante debug: " << e.what() << std::endl;
+        else {
+            // Memoria allocata manualmente; quella del producer è già liberata dalla revoca
+            m_alignedBuffers.erase(std::remove_if(m_alignedBuffers.begin(), m_alignedBuffers.end(),
+                [pBuffer](const std::unique_ptr<void, AlignedBufferDeleter>& memory) { return memory.get() == pBuffer; }),
+                m_alignedBuffers.end());
         }
+
+        --m_announcedBufferCount;
+        m_statBuffersRevoked.fetch_add(1, std::memory_order_relaxed);
+        return true;
     }
 
-    void GenICamCamera::configureHikrobotGigE() {
-        try {
-            // 1. Packet Size (importante per GigE)
-            if (isParameterAvailable("GevSCPSPacketSize")) {
-                setParameter("GevSCPSPacketSize", "1500"); // o "9000" per Jumbo frames
-            }
+    void GenICamCamera::growBuffers(size_t count) {
+        std::lock_guard<std::mutex> lock(m_bufferHandlesMutex);
 
-            // 2. Packet Delay (per evitare perdita pacchetti)
-            if (isParameterAvailable("GevSCPD")) {
-                setParameter("GevSCPD", "1000"); // microsecondi
+        // Stessa origine della memoria dei buffer iniziali: pool, memoria allineata
+        // del wrapper (sempre in modalità Loan) o producer
+        const bool pooled = !m_pooledBuffers.empty();
+        const bool manual = !pooled && !m_alignedBuffers.empty();
+        std::vector<void*> blocks;
+        if (pooled) {
+            blocks = m_bufferPool.acquire(count, m_announcedBufferSize, m_announcedBufferAlignment,
+                m_bufferAllocationConfig.memoryPolicy, m_numaNode.load(), m_bufferAllocationConfig.zeroFill);
+            if (blocks.empty()) {
+                return;
             }
+        }
 
-            // 3. Disabilita features che potrebbero interferire
-            if (isParameterAvailable("ChunkModeActive")) {
-                setParameter("ChunkModeActive", "false");
+        size_t added = 0;
+        for (; added < count; ++added) {
+            GenTL::BUFFER_HANDLE hBuffer = nullptr;
+            GenTL::GC_ERROR err;
+            if (manual) {
+                std::unique_ptr<void, AlignedBufferDeleter> memory(
+                    allocateAlignedMemory(m_announcedBufferSize, m_announcedBufferAlignment));
+                if (!memory) {
+                    break;
+                }
+                if (m_bufferAllocationConfig.zeroFill) {
+                    std::memset(memory.get(), 0, m_announcedBufferSize);
+                }
+                err = GENTL_CALL(DSAnnounceBuffer)(m_dsHandle, memory.get(), m_announcedBufferSize, nullptr, &hBuffer);
+                if (err == GenTL::GC_ERR_SUCCESS) {
+                    m_alignedBuffers.push_back(std::move(memory));
+                }
             }
-
-            // 4. Frame timeout
-            if (isParameterAvailable("GevSCFTD")) {
-                setParameter("GevSCFTD", "3000000"); // 3 secondi
+            else {
+                err = pooled
+                    ? GENTL_CALL(DSAnnounceBuffer)(m_dsHandle, blocks[added], m_announcedBufferSize, nullptr, &hBuffer)
+                    : GENTL_CALL(DSAllocAndAnnounceBuffer)(m_dsHandle, m_announcedBufferSize, nullptr, &hBuffer);
+            }
+            if (err != GenTL::GC_ERR_SUCCESS) {
+                break;
             }
 
-            // 5. Imposta modalità trasferimento
-            if (isParameterAvailable("StreamBufferHandlingMode")) {
-                setParameter("StreamBufferHandlingMode", "NewestOnly");
+            {
+                std::lock_guard<std::mutex> statsLock(m_residencyStatsMutex);
+                makeBufferResident(hBuffer, m_residencyStats);
             }
 
-            if (isParameterAvailable("GevCCP")) {
-                setParameter("GevCCP", "ExclusiveAccess");
-                std::cout << "Control Channel Privilege acquisito" << std::endl;
+            if (GENTL_CALL(DSQueueBuffer)(m_dsHandle, hBuffer) != GenTL::GC_ERR_SUCCESS) {
+                unlockBufferRegion(hBuffer);
+                GENTL_CALL(DSRevokeBuffer)(m_dsHandle, hBuffer, nullptr, nullptr);
+                if (manual) {
+                    m_alignedBuffers.pop_back();
+                }
+                break;
             }
 
-            // Verifica il privilegio
-            if (isParameterAvailable("GevCCP")) {
-                std::string privilege = getParameter("GevCCP");
-                std::cout << "Privilegio corrente: " << privilege << std::endl;
+            m_bufferHandles.push_back(hBuffer);
+            if (pooled) {
+                m_pooledBuffers.push_back(blocks[added]);
             }
+            ++m_announcedBufferCount;
+            m_statBuffersAdded.fetch_add(1, std::memory_order_relaxed);
         }
-        catch (...) {
-            // Non critico se alcuni parametri non sono disponibili
+
+        // Blocchi non annunciati: restano liberi nel pool
+        for (size_t i = added; i < blocks.size(); ++i) {
+            m_bufferPool.release(blocks[i]);
         }
     }
-    // === Gestione Buffer ===
 
-    void GenICamCamera::allocateBuffers(size_t count) {
-        if (count == 0) {
-            THROW_GENICAM_ERROR(ErrorType::BufferError,
-                "Il numero di buffer deve essere > 0");
+    void GenICamCamera::startBufferMonitor() {
+        // Il numero delle regioni esterne è deciso dal chiamante
+        if (!m_adaptiveBufferConfig.enabled || !m_externalBuffers.empty()) {
+            return;
         }
 
-        // Cleanup di eventuali buffer esistenti
-        freeBuffers();
-
-        // Clear dei vettori
-        m_bufferHandles.clear();
-        m_alignedBuffers.clear();
+        {
+            std::lock_guard<std::mutex> lock(m_bufferMonitorMutex);
+            m_stopBufferMonitor = false;
+        }
+        m_bufferMonitorThread = std::thread(&GenICamCamera::bufferMonitorThreadFunction, this);
+    }
 
-        // Riserva spazio per evitare riallocazioni
-        m_bufferHandles.reserve(count);
-        m_alignedBuffers.reserve(count);
+    void GenICamCamera::stopBufferMonitor() {
+        {
+            std::lock_guard<std::mutex> lock(m_bufferMonitorMutex);
+            m_stopBufferMonitor = true;
+        }
+        m_bufferMonitorWake.notify_all();
 
-        GenTL::GC_ERROR err;
+        if (m_bufferMonitorThread.joinable()) {
+            m_bufferMonitorThread.join();
+        }
+        m_pendingBufferRevokes = 0;
+    }
 
-        // Ottieni requisiti di allineamento dal data stream
-        size_t alignment = 1;
-        size_t alignInfoSize = sizeof(alignment);
-        GenTL::INFO_DATATYPE dataType;
+    void GenICamCamera::bufferMonitorThreadFunction() {
+        const AdaptiveBufferConfig config = m_adaptiveBufferConfig;
 
-        err = GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_BUF_ALIGNMENT, &dataType, &alignment, &alignInfoSize);
+        uint64_t lastFrames = m_statFramesReceived.load(std::memory_order_relaxed);
+        uint64_t lastUnderruns = m_statProducerUnderruns.load(std::memory_order_relaxed);
+        auto lastTime = std::chrono::steady_clock::now();
+        size_t surplusPeriods = 0;
 
-        if (err != GenTL::GC_ERR_SUCCESS || alignment == 0) {
-            alignment = 64;  // Default sicuro per la maggior parte delle telecamere
-            std::cout << "Warning: Using default alignment of " << alignment << " bytes" << std::endl;
-        }
-        else {
-            std::cout << "Buffer alignment requirement: " << alignment << " bytes" << std::endl;
+        // Limite superiore effettivo: numero massimo e tetto di memoria
+        size_t maxBuffers = config.maxBuffers;
+        if (config.maxMemoryBytes > 0 && m_announcedBufferSize > 0) {
+            maxBuffers = std::min(maxBuffers, config.maxMemoryBytes / m_announcedBufferSize);
         }
+        maxBuffers = std::max(maxBuffers, config.minBuffers);
 
-        // Allinea la dimensione del buffer ai requisiti
-        size_t alignedBufferSize = ((m_bufferSize + alignment - 1) / alignment) * alignment;
+        std::unique_lock<std::mutex> lock(m_bufferMonitorMutex);
 
-        if (alignedBufferSize != m_bufferSize) {
-            std::cout << "Buffer size aligned from " << m_bufferSize
-                << " to " << alignedBufferSize << " bytes" << std::endl;
-        }
+        while (!m_bufferMonitorWake.wait_for(lock, config.evaluationPeriod, [this] { return m_stopBufferMonitor; })) {
+            lock.unlock();
 
-        // Flag per decidere il metodo di allocazione
-        bool useProducerAllocation = true;
+            const auto now = std::chrono::steady_clock::now();
+            const uint64_t frames = m_statFramesReceived.load(std::memory_order_relaxed);
+            const double seconds = std::chrono::duration<double>(now - lastTime).count();
+            const double frameRate = seconds > 0.0 ? static_cast<double>(frames - lastFrames) / seconds : 0.0;
+            lastFrames = frames;
+            lastTime = now;
 
-        // Prima tentativo: lascia che il producer allochi la memoria
-        std::cout << "Trying producer-managed buffer allocation..." << std::endl;
+            refreshProducerUnderruns();
+            const uint64_t underruns = m_statProducerUnderruns.load(std::memory_order_relaxed);
+            const bool underrun = underruns > lastUnderruns;
+            lastUnderruns = underruns;
 
-        for (size_t i = 0; i < count; i++) {
-            GenTL::BUFFER_HANDLE hBuffer = nullptr;
+            size_t queued = 0;
+            size_t awaitDelivery = 0;
+            size_t infoSize = sizeof(size_t);
+            GenTL::INFO_DATATYPE dataType;
+            GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_QUEUED, &dataType, &queued, &infoSize);
+            infoSize = sizeof(size_t);
+            GENTL_CALL(DSGetInfo)(m_dsHandle, GenTL::STREAM_INFO_NUM_AWAIT_DELIVERY, &dataType, &awaitDelivery, &infoSize);
 
-            err = GENTL_CALL(DSAllocAndAnnounceBuffer)(m_dsHandle, alignedBufferSize, nullptr, &hBuffer);
+            const size_t hostQueued = m_conversionChannel ? m_conversionChannel->sizeApprox() : 0;
+            const size_t hostCapacity = m_conversionChannel ? m_conversionChannel->capacity() : 0;
 
-            if (err == GenTL::GC_ERR_SUCCESS) {
-                m_bufferHandles.push_back(hBuffer);
+            // Buffer liberi necessari per coprire targetHeadroom al frame rate misurato
+            const double headroomSeconds = std::chrono::duration<double>(config.targetHeadroom).count();
+            const size_t targetFree = std::max<size_t>(1, static_cast<size_t>(std::ceil(frameRate * headroomSeconds)));
+
+            const size_t announced = m_announcedBufferCount.load();
+            size_t target = announced;
+
+            if (underrun || queued < targetFree) {
+                // I buffer pieni (in attesa o nella coda host) restano occupati: si aggiunge
+                // la differenza; dopo un underrun si cresce almeno del 50%
+                target = announced + (targetFree > queued ? targetFree - queued : 0);
+                if (underrun) {
+                    target = std::max(target, announced + std::max<size_t>(announced / 2, 1));
+                }
+                surplusPeriods = 0;
+            }
+            else if (queued > 2 * targetFree && awaitDelivery == 0 && hostQueued <= hostCapacity / 4) {
+                // Eccesso stabile con consumatori al passo: riduzione graduale
+                if (++surplusPeriods >= BUFFER_SHRINK_PERIODS) {
+                    target = announced - (queued - targetFree) / 2;
+                    surplusPeriods = 0;
+                }
             }
             else {
-                std::cout << "Producer allocation failed: " << getGenTLErrorString(err)
-                    << ", falling back to manual allocation" << std::endl;
+                surplusPeriods = 0;
+            }
 
-                // Pulisci i buffer già allocati
-                for (auto& handle : m_bufferHandles) {
-                    GENTL_CALL(DSRevokeBuffer)(m_dsHandle, handle, nullptr, nullptr);
-                }
-                m_bufferHandles.clear();
+            target = std::clamp(target, config.minBuffers, maxBuffers);
 
-                useProducerAllocation = false;
-                break;
+            if (target > announced) {
+                m_pendingBufferRevokes = 0;
+                growBuffers(target - announced);
             }
+            else if (target < announced) {
+                // Revocati dai thread del percorso dei frame al riaccodamento
+                m_pendingBufferRevokes = announced - target;
+            }
+
+            lock.lock();
         }
+    }
 
-        // Se l'allocazione del producer ha avuto successo, siamo a posto
-        if (useProducerAllocation) {
-            std::cout << "Successfully allocated " << count
-                << " buffers using producer allocation" << std::endl;
-            return;
+    void GenICamCamera::setAdaptiveBufferConfig(const AdaptiveBufferConfig& config) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
+
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare il numero di buffer adattivo durante l'acquisizione");
+        }
+        if (config.minBuffers == 0 || config.maxBuffers < config.minBuffers) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "Limiti del numero di buffer non validi (minBuffers > 0, maxBuffers >= minBuffers)");
+        }
+        if (config.targetHeadroom.count() <= 0 || config.evaluationPeriod.count() <= 0) {
+            THROW_GENICAM_ERROR(ErrorType::ParameterError,
+                "targetHeadroom ed evaluationPeriod devono essere > 0");
         }
 
-        // Secondo tentativo: allocazione manuale con memoria allineata
-        std::cout << "Using manual buffer allocation with "
-            << alignment << "-byte alignment" << std::endl;
+        m_adaptiveBufferConfig = config;
+    }
 
-        for (size_t i = 0; i < count; i++) {
-            // Alloca memoria allineata
-            void* alignedPtr = nullptr;
+    AdaptiveBufferConfig GenICamCamera::getAdaptiveBufferConfig() const {
+        return m_adaptiveBufferConfig;
+    }
 
-#ifdef _WIN32
-            alignedPtr = _aligned_malloc(alignedBufferSize, alignment);
-#else
-            // Assicurati che alignment sia una potenza di 2
-            if (alignment & (alignment - 1)) {
-                // Se non è potenza di 2, trova la prossima potenza di 2
-                size_t powerOf2 = 1;
-                while (powerOf2 < alignment) {
-                    powerOf2 <<= 1;
-                }
-                alignment = powerOf2;
-            }
-            alignedPtr = aligned_alloc(alignment, alignedBufferSize);
-#endif
+    MatPoolStatistics GenICamCamera::getConversionPoolStatistics() const {
+        return m_matPool.statistics();
+    }
 
-            if (!alignedPtr) {
-                freeBuffers();
-                std::stringstream ss;
-                ss << "Impossibile allocare " << alignedBufferSize
-                    << " bytes con allineamento " << alignment;
-                THROW_GENICAM_ERROR(ErrorType::BufferError, ss.str());
-            }
+    void GenICamCamera::setConversionPoolLimit(size_t maxCachedBytes) {
+        m_matPool.setMaxCachedBytes(maxCachedBytes);
+    }
 
-            // Azzera la memoria (alcune telecamere lo richiedono)
-            std::memset(alignedPtr, 0, alignedBufferSize);
+    void GenICamCamera::setBufferAllocationConfig(const BufferAllocationConfig& config) {
+        std::lock_guard<std::mutex> lock(m_acquisitionMutex);
 
-            // Gestisci la memoria con unique_ptr e custom deleter
-            m_alignedBuffers.push_back(std::unique_ptr<void, AlignedBufferDeleter>(alignedPtr));
+        if (m_isAcquiring) {
+            THROW_GENICAM_ERROR(ErrorType::AcquisitionError,
+                "Impossibile modificare l'allocazione dei buffer durante l'acquisizione");
+        }
 
-            // Annuncia il buffer al data stream
-            GenTL::BUFFER_HANDLE hBuffer = nullptr;
-            err = GENTL_CALL(DSAnnounceBuffer)(m_dsHandle, alignedPtr, alignedBufferSize, nullptr, &hBuffer);
+        m_bufferAllocationConfig = config;
+        if (!config.usePool) {
+            m_bufferPool.trim();
+        }
+    }
 
-            if (err != GenTL::GC_ERR_SUCCESS) {
-                // Log dettagliato dell'errore
-                std::cerr << "DSAnnounceBuffer failed:" << std::endl;
-                std::cerr << "  Error: " << getGenTLErrorString(err)
-                    << " (0x" << std::hex << err << std::dec << ")" << std::endl;
-                std::cerr << "  Buffer " << i << " of " << count << std::endl;
-                std::cerr << "  Address: " << alignedPtr << std::endl;
-                std::cerr << "  Size: " << alignedBufferSize << " bytes" << std::endl;
-                std::cerr << "  Alignment: " << alignment << " bytes" << std::endl;
+    BufferAllocationConfig GenICamCamera::getBufferAllocationConfig() const {
+        return m_bufferAllocationConfig;
+    }
 
-                freeBuffers();
+    BufferPoolStatistics GenICamCamera::getBufferPoolStatistics() const {
+        return m_bufferPool.statistics();
+    }
 
-                THROW_GENICAM_ERROR_CODE(ErrorType::BufferError,
-                    "Impossibile annunciare il buffer", err);
+    void GenICamCamera::trimBufferPool() {
+        m_bufferPool.trim();
+    }
+
+    BufferResidencyStatistics GenICamCamera::getBufferResidencyStatistics() const {
+        std::lock_guard<std::mutex> lock(m_residencyStatsMutex);
+        return m_residencyStats;
+    }
+
+    void GenICamCamera::applyBufferResidency() {
+        BufferResidencyStatistics stats;
+        stats.requestedPolicy = m_bufferAllocationConfig.residency;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (auto hBuffer : m_bufferHandles) {
+            makeBufferResident(hBuffer, stats);
+        }
+        stats.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        if (stats.requestedPolicy != BufferResidencyPolicy::None) {
+            std::cout << "Buffer residency: " << stats.lockedBuffers << " locked (" << stats.lockedBytes << " bytes), "
+                << stats.prefaultedBuffers << " prefaulted of " << stats.buffers << " buffers in "
+                << stats.duration.count() << " us" << std::endl;
+            if (!stats.lastError.empty()) {
+                std::cout << "  " << stats.lastError << std::endl;
             }
+        }
 
-            m_bufferHandles.push_back(hBuffer);
+        std::lock_guard<std::mutex> lock(m_residencyStatsMutex);
+        m_residencyStats = stats;
+    }
+
+    void GenICamCamera::makeBufferResident(GenTL::BUFFER_HANDLE hBuffer, BufferResidencyStatistics& stats) {
+        ++stats.buffers;
+        if (stats.requestedPolicy == BufferResidencyPolicy::None) {
+            return;
         }
 
-        std::cout << "Successfully allocated " << count
-            << " buffers using manual allocation" << std::endl;
-        std::cout << "Buffer size: " << alignedBufferSize
-            << " bytes each" << std::endl;
+        // Indirizzo e dimensione effettivi: valgono anche per la memoria del producer
+        void* base = nullptr;
+        size_t size = 0;
+        size_t baseSize = sizeof(base);
+        size_t sizeSize = sizeof(size);
+        GenTL::INFO_DATATYPE dataType;
+        GenTL::GC_ERROR err = GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_BASE, &dataType, &base, &baseSize);
+        if (err == GenTL::GC_ERR_SUCCESS) {
+            err = GENTL_CALL(DSGetBufferInfo)(m_dsHandle, hBuffer, GenTL::BUFFER_INFO_SIZE, &dataType, &size, &sizeSize);
+        }
+        if (err != GenTL::GC_ERR_SUCCESS || !base || size == 0) {
+            ++stats.unresolvedBuffers;
+            stats.lastError = "Indirizzo del buffer non disponibile dal producer";
+            return;
+        }
+
+        if (stats.requestedPolicy == BufferResidencyPolicy::Lock) {
+            std::string error;
+            if (MemoryUtils::lock(base, size, error)) {
+                m_lockedBufferRegions.push_back({ hBuffer, base, size });
+                ++stats.lockedBuffers;
+                stats.lockedBytes += size;
+                return;
+            }
+            stats.lastError = error;
+        }
+
+        MemoryUtils::prefault(base, size);
+        ++stats.prefaultedBuffers;
+    }
+
+    void GenICamCamera::unlockBufferRegion(GenTL::BUFFER_HANDLE hBuffer) {
+        for (auto it = m_lockedBufferRegions.begin(); it != m_lockedBufferRegions.end(); ++it) {
+            if (it->hBuffer == hBuffer) {
+                MemoryUtils::unlock(it->ptr, it->size);
+                m_lockedBufferRegions.erase(it);
+                return;
+            }
+        }
     }
 
     void GenICamCamera::freeBuffers() {
+        // Sblocca la memoria prima della revoca (che libera quella allocata dal producer)
+        for (const auto& region : m_lockedBufferRegions) {
+            MemoryUtils::unlock(region.ptr, region.size);
+        }
+        m_lockedBufferRegions.clear();
+
         // Revoca tutti i buffer dal data stream
         for (auto& hBuffer : m_bufferHandles) {
             if (hBuffer && m_dsHandle) {
@@ -4982,6 +7666,15 @@ namespace GenICamWrapper {
         // grazie al custom deleter quando si fa clear()
         m_alignedBuffers.clear();
 
+        // La memoria del pool resta allocata per la sessione successiva
+        for (void* block : m_pooledBuffers) {
+            m_bufferPool.release(block);
+        }
+        m_pooledBuffers.clear();
+
+        // Regioni esterne revocate: onReleased per quelle senza frame in prestito
+        m_externalBufferLeases.clear();
+
         // Se avevi anche il vecchio m_bufferMemory, puliscilo
         //m_bufferMemory.clear();
     }
@@ -6264,6 +8957,17 @@ namespace GenICamWrapper {
 
         return true; // Ritorna sempre true per non bloccare l'acquisizione
     }
+
+    static const char* bufferHandlingModeToString(BackpressurePolicy policy) {
+        switch (policy) {
+        case BackpressurePolicy::DropOldest: return "OldestFirstOverwrite";
+        case BackpressurePolicy::KeepLatest: return "NewestOnly";
+        case BackpressurePolicy::Block:
+        case BackpressurePolicy::DropNewest:
+        default: return "OldestFirst";
+        }
+    }
+
     /**
      * @brief Prepara i parametri Transport Layer per l'acquisizione
      *
@@ -6316,15 +9020,15 @@ namespace GenICamWrapper {
             }
         }
 
-        // 3. Gestione Buffer Mode secondo SFNC
+        // 3. Gestione Buffer Mode secondo SFNC: coerente con la politica di backpressure
+        //    dell'host, così producer e coda di conversione scartano gli stessi frame
         if (isParameterAvailable("StreamBufferHandlingMode")) {
             try {
-                // "NewestOnly" è raccomandato per applicazioni real-time
-                setParameter("StreamBufferHandlingMode", "NewestOnly");
+                setParameter("StreamBufferHandlingMode", bufferHandlingModeToString(m_pipelineConfig.backpressure));
             }
             catch (...) {
                 try {
-                    // Fallback a "OldestFirst" se NewestOnly non disponibile
+                    // Fallback a "OldestFirst" se la modalità non è disponibile
                     setParameter("StreamBufferHandlingMode", "OldestFirst");
                 }
                 catch (...) {
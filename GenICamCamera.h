@@ -2,6 +2,8 @@
 
 #include <string>
 #include <vector>
+#include <set>
+#include <deque>
 #include <memory>
 #include <functional>
 #include <mutex>
@@ -9,15 +11,27 @@
 #include <chrono>
 #include <atomic>
 #include <thread>
+#include <coroutine>
 #include <opencv2/opencv.hpp>
 #include <GenICam.h>
 #include <GenTL/GenTL.h>
 #include "GenTLLoader.h"
 #include "ImageTypes.h"
 #include "CameraEventListener.h"
+#include "LockFreeQueue.h"
+#include "ThreadUtils.h"
+#include "LatencyHistogram.h"
+#include "ClockCorrelator.h"
+#include "BufferPool.h"
+#include "NumaUtils.h"
+#include "MemoryUtils.h"
+#include "SharedFrameRing.h"
+#include "MatPool.h"
 
 namespace GenICamWrapper {
 
+    class ChunkDataManager;
+
     // Enumerazioni aggiuntive per I/O
     enum class LineSelector {
         Line0,
@@ -104,7 +118,7 @@ namespace GenICamWrapper {
     };
 
     /**
-     * @brief Modalit di acquisizione secondo SFNC
+     * @brief Modalità di acquisizione secondo SFNC
      */
     enum class AcquisitionMode {
         SingleFrame,    // Acquisisce un singolo frame
@@ -127,7 +141,7 @@ namespace GenICamWrapper {
     };
 
     /**
- * @brief Modalit di trigger supportate
+ * @brief Modalità di trigger supportate
  */
     enum class TriggerMode {
         Off,    // Trigger disabilitato
@@ -208,6 +222,425 @@ namespace GenICamWrapper {
         }
     };
 
+    /**
+     * @brief Modalità di consegna dei frame ai listener
+     *
+     * Copy: il frame viene convertito in un cv::Mat proprietario e il buffer GenTL
+     *       viene riaccodato subito dopo la callback (comportamento storico).
+     * Loan: il listener riceve un ImageData in prestito che punta direttamente al
+     *       buffer GenTL annunciato; il buffer viene riaccodato (DSQueueBuffer) solo
+     *       quando viene rilasciato l'ultimo riferimento al frame. I buffer usano
+     *       sempre memoria del wrapper (pool, allineata o esterna), mai del producer:
+     *       un frame trattenuto oltre lo stop resta valido.
+     */
+    enum class FrameDeliveryMode {
+        Copy,
+        Loan
+    };
+
+    /**
+     * @brief Politica applicata quando i consumatori sono più lenti della camera
+     *
+     * Applicata alla coda tra il thread di grab e i worker di conversione; determina
+     * anche StreamBufferHandlingMode del producer:
+     * Block:      il grab attende uno slot libero (OldestFirst, nessuna perdita sull'host
+     *             finché il producer ha buffer disponibili).
+     * DropOldest: scarta il frame in coda da più tempo (OldestFirstOverwrite).
+     * DropNewest: scarta il frame appena acquisito (OldestFirst).
+     * KeepLatest: in coda resta solo il frame più recente (NewestOnly, default come
+     *             nelle versioni precedenti).
+     *
+     * Con conversionWorkers = 0 non esiste la coda di conversione: la politica agisce
+     * solo tramite StreamBufferHandlingMode, cioè sui buffer in attesa nel producer
+     * mentre il thread di grab converte e consegna. In particolare Block e DropNewest
+     * si comportano entrambe come OldestFirst.
+     */
+    enum class BackpressurePolicy {
+        Block,
+        DropOldest,
+        DropNewest,
+        KeepLatest
+    };
+
+    /**
+     * @brief Configurazione della pipeline di acquisizione
+     *
+     * Il thread di grab preleva solo i buffer GenTL; la conversione viene eseguita
+     * da conversionWorkers thread e la consegna ai listener da un thread dedicato
+     * che ripristina l'ordine di acquisizione. Gli stadi comunicano tramite code
+     * lock-free bounded di profondità queueDepth.
+     */
+    struct AcquisitionPipelineConfig {
+        size_t queueDepth = 16;         // Profondità delle code tra gli stadi
+        size_t conversionWorkers = 2;   // 0 = conversione e consegna nel thread di grab
+        BackpressurePolicy backpressure = BackpressurePolicy::KeepLatest;  // Con 0 worker solo StreamBufferHandlingMode
+        bool dropIncompleteFrames = false;  // true = i frame incompleti non vengono consegnati
+    };
+
+    /**
+     * @brief Statistiche di perdita frame della sessione di acquisizione corrente
+     *
+     * Le perdite sono classificate per causa:
+     * - camera:    frameID mancanti non spiegati da underrun del producer
+     *              (frame mai arrivati all'host, inclusi i blocchi GigE scartati interi)
+     * - transport: buffer consegnati incompleti (IS_INCOMPLETE o SIZE_FILLED insufficiente);
+     *              sono consegnati con ImageData::isIncomplete salvo dropIncompleteFrames
+     * - host:      buffer non disponibili nel producer (underrun) o coda di conversione piena
+     *
+     * I frameID a 16 bit di GigE Vision 1.x (65535 -> 1) sono gestiti come rollover.
+     */
+    struct AcquisitionStatistics {
+        uint64_t framesReceived = 0;            // Buffer ricevuti dal producer
+        uint64_t cameraDroppedFrames = 0;
+        uint64_t transportIncompleteFrames = 0;
+        uint64_t hostDroppedFrames = 0;         // producerUnderruns + pipelineDroppedFrames
+
+        // Dettaglio
+        uint64_t missingFrameIds = 0;           // Totale buchi nella sequenza dei frameID
+        uint64_t producerUnderruns = 0;         // STREAM_INFO_NUM_UNDERRUN
+        uint64_t pipelineDroppedFrames = 0;     // Scartati dalla politica di backpressure
+        uint64_t pipelineHighWaterMark = 0;     // Occupazione massima della coda di conversione
+        uint64_t frameIdResets = 0;             // Sequenza ripartita (es. reset della camera)
+        uint64_t lastFrameId = 0;
+
+        // Buffer annunciati al producer (variano con AdaptiveBufferConfig)
+        uint64_t announcedBuffers = 0;
+        uint64_t buffersAdded = 0;
+        uint64_t buffersRevoked = 0;
+
+        // Memoria dei cv::Mat di conversione: a regime allocationsPerFrame tende a 0
+        uint64_t conversionAllocations = 0;
+        uint64_t conversionReuses = 0;
+        double conversionAllocationsPerFrame = 0.0;
+    };
+
+    /**
+     * @brief Modalità di attesa dei buffer nel thread di grab
+     *
+     * Blocking: EventGetData con attesa infinita (default, nessun consumo di CPU).
+     * BusyPoll: EventGetData con timeout 0 in un loop attivo per spinDuration dopo
+     *           l'ultimo frame, poi attesa bloccante fino al frame successivo. Elimina
+     *           la latenza di risveglio dello scheduler; da usare con il thread di grab
+     *           vincolato a un core isolato (setThreadConfig con AcquisitionThreadRole::Grab).
+     */
+    enum class GrabWaitMode {
+        Blocking,
+        BusyPoll
+    };
+
+    struct GrabWaitConfig {
+        GrabWaitMode mode = GrabWaitMode::Blocking;
+        // Spin dopo ogni frame prima di passare all'attesa bloccante; per non bloccare
+        // mai a frame rate costante deve superare il periodo tra i frame
+        std::chrono::microseconds spinDuration{ 2000 };
+    };
+
+    /**
+     * @brief Istogrammi di latenza dell'acquisizione corrente
+     *
+     * grabToDelivery: dal prelievo del buffer (EventGetData) alla consegna ai listener.
+     * frameInterval:  intervallo tra buffer consecutivi visto dal thread di grab; a frame
+     *                 rate costante la sua dispersione misura il jitter di risveglio.
+     */
+    struct AcquisitionLatencyReport {
+        GrabWaitMode waitMode = GrabWaitMode::Blocking;
+        LatencyHistogramSnapshot grabToDelivery;
+        LatencyHistogramSnapshot frameInterval;
+    };
+
+    /**
+     * @brief Contatore usato per associare i frame ai trigger software
+     *
+     * TriggerCounter: ChunkCounterValue di un contatore con CounterEventSource = FrameTrigger
+     *                 (conta anche i trigger ignorati dalla camera, es. in overtrigger).
+     * ChunkFrameId:   ChunkFrameID dai chunk del frame.
+     * BufferFrameId:  frameID del buffer GenTL (block ID GigE Vision, con rollover a 16 bit).
+     *
+     * I valori dei chunk sono letti direttamente dal buffer: se il nodo non è un registro
+     * a indirizzo fisso nel chunk la correlazione usa BufferFrameId.
+     */
+    enum class TriggerCorrelationSource {
+        BufferFrameId,
+        ChunkFrameId,
+        TriggerCounter
+    };
+
+    /**
+     * @brief Statistiche dei trigger software dell'acquisizione corrente
+     *
+     * Un trigger è perso quando arriva un frame successivo al frame che avrebbe
+     * dovuto produrre; i trigger in attesa sono quelli il cui frame non è ancora
+     * arrivato (o non arriverà: oldestPendingAge ne indica l'età).
+     */
+    struct TriggerStatistics {
+        TriggerCorrelationSource source = TriggerCorrelationSource::BufferFrameId;
+        uint64_t triggersIssued = 0;
+        uint64_t framesMatched = 0;
+        uint64_t framesLost = 0;
+        uint64_t pendingTriggers = 0;
+        std::chrono::microseconds oldestPendingAge{ 0 };
+        LatencyHistogramSnapshot triggerToGrab;         // Dal trigger al prelievo del buffer
+        LatencyHistogramSnapshot triggerToDelivery;     // Dal trigger alla callback dei listener
+    };
+
+    /**
+     * @brief Configurazione della correlazione tra clock del device e clock host
+     *
+     * Durante l'acquisizione un thread esegue periodicamente TimestampLatch (SFNC) o
+     * GevTimestampControlLatch (GigE Vision) e legge il valore latchato; i campioni
+     * alimentano un fit lineare usato per riportare ImageData::deviceTimestamp sul
+     * clock host (ImageData::hostTimestamp). Disabilitata per default: il latch
+     * periodico occupa il canale di controllo.
+     */
+    struct ClockCorrelationConfig {
+        bool enabled = false;
+        std::chrono::milliseconds period{ 1000 };   // Intervallo tra i latch
+        size_t windowSize = 16;                     // Campioni usati per il fit
+    };
+
+    /**
+     * @brief Residenza in memoria fisica dei buffer di acquisizione
+     *
+     * None:     le pagine vengono mappate al primo frame che le scrive.
+     * Prefault: tutte le pagine sono toccate prima dell'avvio dello streaming.
+     * Lock:     le pagine sono bloccate in RAM (mlock / VirtualLock), niente swap;
+     *           se il sistema lo nega si ripiega su Prefault.
+     */
+    enum class BufferResidencyPolicy {
+        None,
+        Prefault,
+        Lock
+    };
+
+    /**
+     * @brief Esito dell'applicazione di BufferResidencyPolicy all'ultima allocazione
+     */
+    struct BufferResidencyStatistics {
+        BufferResidencyPolicy requestedPolicy = BufferResidencyPolicy::None;
+        size_t buffers = 0;
+        size_t prefaultedBuffers = 0;
+        size_t lockedBuffers = 0;
+        size_t lockedBytes = 0;
+        size_t unresolvedBuffers = 0;       // Indirizzo non fornito dal producer
+        std::chrono::microseconds duration{ 0 };
+        std::string lastError;
+    };
+
+    /**
+     * @brief Configurazione dell'allocazione dei buffer di acquisizione
+     */
+    struct BufferAllocationConfig {
+        // Memoria dei buffer presa da un pool persistente tra le sessioni: a ogni
+        // avvio i buffer vengono solo annunciati (DSAnnounceBuffer). Se il producer
+        // rifiuta la memoria esterna si ripiega su DSAllocAndAnnounceBuffer.
+        bool usePool = true;
+
+        // Pagine della memoria del pool (huge page con ripiego automatico);
+        // la politica ottenuta è riportata da getBufferPoolStatistics
+        BufferMemoryPolicy memoryPolicy = BufferMemoryPolicy::Default;
+
+        // Residenza dei buffer (di ogni origine) prima dell'avvio dello streaming;
+        // l'esito è riportato da getBufferResidencyStatistics
+        BufferResidencyPolicy residency = BufferResidencyPolicy::Prefault;
+
+        // Azzeramento della memoria allocata dal wrapper: serve solo alle camere che
+        // non scrivono l'intero buffer; altrimenti basta il prefault
+        bool zeroFill = false;
+    };
+
+    /**
+     * @brief Regione di memoria del chiamante usata come buffer di acquisizione
+     *
+     * Il producer vi scrive direttamente i frame (DSAnnounceBuffer): con
+     * FrameDeliveryMode::Loan ImageData::buffer punta dentro la regione.
+     */
+    struct ExternalBuffer {
+        void* data = nullptr;
+        size_t size = 0;
+        void* userContext = nullptr;    // Restituito invariato nelle callback
+    };
+
+    /**
+     * @brief Notifiche sul ciclo di vita delle regioni esterne
+     *
+     * onAnnounced: la regione è stata annunciata, da ora il producer può scriverci
+     *              (chiamata da startAcquisition).
+     * onReleased:  la regione è stata revocata e nessun frame in prestito la
+     *              referenzia più: il chiamante può riutilizzarla o liberarla
+     *              (chiamata da stopAcquisition o dal rilascio dell'ultimo frame).
+     */
+    struct ExternalBufferCallbacks {
+        std::function<void(const ExternalBuffer&)> onAnnounced;
+        std::function<void(const ExternalBuffer&)> onReleased;
+    };
+
+    /**
+     * @brief Contenuto pubblicato nell'anello di frame condiviso
+     *
+     * Converted: il cv::Mat consegnato ai listener (cvType >= 0 nei metadati).
+     * Raw:       il buffer GenTL così come ricevuto, copiato prima del riaccodamento.
+     */
+    enum class SharedFrameRingContent {
+        Converted,
+        Raw
+    };
+
+    /**
+     * @brief Pubblicazione dei frame in memoria condivisa per altri processi
+     *
+     * I processi consumatori usano SharedFrameRingReader con lo stesso name.
+     */
+    struct SharedFrameRingConfig {
+        std::string name;
+        size_t slotCount = 8;
+        size_t slotCapacity = 0;    // Bytes per slot; 0 = calcolata da ROI e formato correnti
+        SharedFrameRingContent content = SharedFrameRingContent::Converted;
+    };
+
+    /**
+     * @brief Modifiche applicabili con reconfigureAcquisition
+     *
+     * Solo i campi abilitati vengono scritti; binning a 0 = invariato.
+     */
+    struct StreamReconfiguration {
+        bool changeRoi = false;
+        ROI roi;
+        bool changePixelFormat = false;
+        PixelFormat pixelFormat = PixelFormat::Mono8;
+        uint32_t binningHorizontal = 0;
+        uint32_t binningVertical = 0;
+    };
+
+    struct ReconfigurationResult {
+        bool buffersReallocated = false;    // PayloadSize cresciuto o frame ancora in prestito
+        size_t previousPayloadSize = 0;
+        size_t payloadSize = 0;
+        std::chrono::microseconds duration{ 0 };
+    };
+
+    struct SharedFrameRingStatistics {
+        bool open = false;
+        std::string name;
+        size_t slotCapacity = 0;
+        uint64_t publishedFrames = 0;
+        uint64_t oversizedFrames = 0;   // Frame più grandi di uno slot, non pubblicati
+    };
+
+    /**
+     * @brief Numero di buffer adattivo durante lo streaming
+     *
+     * Un thread di controllo misura a ogni evaluationPeriod il frame rate, i buffer
+     * liberi nel producer (STREAM_INFO_NUM_QUEUED), quelli pieni in attesa
+     * (NUM_AWAIT_DELIVERY), gli underrun (NUM_UNDERRUN) e la coda di conversione
+     * dell'host. Se i buffer liberi non coprono targetHeadroom al frame rate corrente
+     * (o il producer è andato in underrun) ne annuncia di nuovi; se l'eccesso persiste
+     * per più valutazioni li revoca al loro riaccodamento. Il numero resta entro
+     * [minBuffers, maxBuffers] e la memoria entro maxMemoryBytes.
+     */
+    struct AdaptiveBufferConfig {
+        bool enabled = false;
+        std::chrono::milliseconds targetHeadroom{ 100 };
+        size_t minBuffers = 4;
+        size_t maxBuffers = 256;
+        size_t maxMemoryBytes = 0;      // 0 = nessun limite
+        std::chrono::milliseconds evaluationPeriod{ 250 };
+    };
+
+    /**
+     * @brief Collocamento NUMA di buffer e thread dell'acquisizione
+     *
+     * Con più nodi NUMA i buffer del pool vengono allocati sul nodo scelto e i thread
+     * di grab, conversione e consegna vincolati alle sue CPU (salvo affinità esplicita
+     * impostata con setThreadConfig). Con node = -1 il nodo è quello a cui è collegata
+     * l'interfaccia GenTL (NIC o dispositivo PCIe), se determinabile.
+     */
+    struct NumaPlacementConfig {
+        bool enabled = true;
+        int node = -1;      // -1 = automatico
+    };
+
+    /**
+     * @brief Thread interni dell'acquisizione configurabili con setThreadConfig
+     */
+    enum class AcquisitionThreadRole {
+        Grab,           // Thread di grab (EventGetData e metadati dei buffer)
+        FeatureEvents,  // Gestione eventi di invalidazione delle feature
+        Conversion,     // Worker di conversione della pipeline
+        Delivery        // Consegna ordinata ai listener
+    };
+
+    /**
+     * @brief Configurazione effettivamente ottenuta da un thread di acquisizione
+     */
+    struct AppliedThreadConfig {
+        AcquisitionThreadRole role = AcquisitionThreadRole::Grab;
+        size_t index = 0;               // Indice del worker per Conversion, altrimenti 0
+        ThreadConfigResult result;
+    };
+
+    /**
+     * @brief Modalità di accesso pull ai frame (waitForFrame / tryGetLatestFrame)
+     *
+     * Disabled:   i frame sono consegnati solo ai listener (default).
+     * Queue:      ring preallocato FIFO; se pieno viene sovrascritto il frame più vecchio.
+     * LatestOnly: mailbox con il solo frame più recente, per i loop di controllo.
+     */
+    enum class FrameQueueMode {
+        Disabled,
+        Queue,
+        LatestOnly
+    };
+
+    /**
+     * @brief Frame restituito dall'accesso pull
+     * @note In modalità FrameDeliveryMode::Loan trattenere il frame tiene occupato
+     *       un buffer GenTL: la capacità del ring deve restare inferiore al numero di buffer.
+     */
+    struct AcquiredFrame {
+        std::shared_ptr<const ImageData> imageData;
+        cv::Mat image;      // Stessa immagine passata a OnFrameReady
+
+        bool empty() const { return !imageData; }
+    };
+
+    /**
+     * @brief Frame di una raffica acquisita con captureBurst
+     *
+     * data punta allo slot del frame nell'arena di BurstResult (nessuna copia):
+     * resta valido finché esiste BurstResult::arena. image è vuota finché la
+     * raffica non viene convertita (captureBurst con convert = true o convertBurst).
+     */
+    struct BurstFrame {
+        const uint8_t* data = nullptr;
+        size_t sizeFilled = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        PixelFormat pixelFormat = PixelFormat::Undefined;
+        uint64_t frameID = 0;
+        std::chrono::steady_clock::time_point timestamp;    // Istante host del prelievo del buffer
+        uint64_t deviceTimestamp = 0;                       // Tick del device
+        std::chrono::steady_clock::time_point hostTimestamp;
+        bool hostTimestampValid = false;
+        bool isIncomplete = false;
+        double exposureTime = 0.0;      // Letti una volta prima della raffica
+        double gain = 0.0;
+        cv::Mat image;
+    };
+
+    /**
+     * @brief Risultato di captureBurst
+     */
+    struct BurstResult {
+        std::vector<BurstFrame> frames;         // In ordine di arrivo
+        std::shared_ptr<uint8_t> arena;         // Memoria contigua dei frame (requestedFrames slot)
+        size_t slotSize = 0;                    // Dimensione allineata di uno slot
+        size_t requestedFrames = 0;
+        bool multiFrame = false;                // Armata con AcquisitionMode MultiFrame + AcquisitionFrameCount
+        std::chrono::microseconds duration{ 0 };   // Dal primo all'ultimo frame ricevuto
+
+        bool complete() const { return frames.size() == requestedFrames; }
+    };
+
     struct PixelFormatInfo {
        PixelFormat format = PixelFormat::Undefined;
        std::string name;           // Nome simbolico (es. "Mono8")
@@ -216,9 +649,9 @@ namespace GenICamWrapper {
        uint64_t pfncValue = 0;     // Valore PFNC
        double bytesPerPixel = 0.0; // Bytes per pixel
        int bitsPerPixel = 0;       // Bits per pixel
-       bool isPacked = false;      // Se  un formato packed
-       bool isBayer = false;       // Se  un formato Bayer
-       bool isColor = false;       // Se  un formato a colori
+       bool isPacked = false;      // Se è un formato packed
+       bool isBayer = false;       // Se è un formato Bayer
+       bool isColor = false;       // Se è un formato a colori
        bool isValid = false;       // Se le informazioni sono valide
     };
 
@@ -227,10 +660,87 @@ namespace GenICamWrapper {
        std::string userID;
     };
 
+    class GenICamCamera;
+
+    /**
+     * @brief Executor su cui riprendono le coroutine in attesa di un frame
+     *
+     * execute() viene chiamato dal thread di consegna (o da stopAcquisition) fuori da
+     * ogni lock; l'implementazione decide su quale thread riprendere la coroutine.
+     * Per non allocare a ogni frame l'executor deve accodare l'handle in una
+     * struttura preallocata (l'handle è un semplice puntatore).
+     */
+    class FrameExecutor {
+    public:
+        virtual ~FrameExecutor() = default;
+        virtual void execute(std::coroutine_handle<> handle) = 0;
+    };
+
+    /**
+     * @brief Executor che riprende la coroutine direttamente nel thread di consegna
+     */
+    class InlineFrameExecutor : public FrameExecutor {
+    public:
+        void execute(std::coroutine_handle<> handle) override {
+            handle.resume();
+        }
+    };
+
+    /**
+     * @brief Awaitable restituito da GenICamCamera::nextFrame
+     *
+     * co_await restituisce il frame più vecchio del ring pull (AcquiredFrame vuoto se
+     * l'accesso pull è disabilitato o l'acquisizione termina). L'awaiter vive nel
+     * frame della coroutine ed è collegato in una lista intrusiva: l'attesa non
+     * alloca memoria.
+     *
+     * @note La coroutine non deve essere distrutta mentre è sospesa su co_await;
+     *       stopAcquisition riprende tutte le coroutine in attesa.
+     */
+    class FrameAwaiter {
+    public:
+        FrameAwaiter(GenICamCamera& camera, FrameExecutor& executor)
+            : m_camera(camera), m_executor(executor) {
+        }
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle);
+        AcquiredFrame await_resume() { return std::move(m_frame); }
+
+    private:
+        friend class GenICamCamera;
+
+        GenICamCamera& m_camera;
+        FrameExecutor& m_executor;
+        std::coroutine_handle<> m_handle;
+        AcquiredFrame m_frame;
+        FrameAwaiter* m_next = nullptr;
+    };
+
+    /**
+     * @brief Sequenza asincrona dei frame per le coroutine
+     *
+     * Uso: for (;;) { auto frame = co_await stream.next(); if (frame.empty()) break; ... }
+     * Non è a sua volta una coroutine: non richiede allocazioni né per la sequenza
+     * né per i singoli frame.
+     */
+    class FrameStream {
+    public:
+        FrameStream(GenICamCamera& camera, FrameExecutor& executor)
+            : m_camera(camera), m_executor(executor) {
+        }
+
+        FrameAwaiter next() { return FrameAwaiter(m_camera, m_executor); }
+
+    private:
+        GenICamCamera& m_camera;
+        FrameExecutor& m_executor;
+    };
+
     /**
      * @brief Classe principale per la gestione della telecamera GenICam
      *
-     * Thread Safety: Questa classe  thread-safe. Tutti i metodi pubblici possono
+     * Thread Safety: Questa classe è thread-safe. Tutti i metodi pubblici possono
      * essere chiamati da thread diversi senza sincronizzazione esterna.
      */
     class GenICamCamera {
@@ -259,7 +769,7 @@ namespace GenICamWrapper {
 
         /**
          * @brief Connette alla prima telecamera disponibile
-         * @throws GenICamException se nessuna telecamera  disponibile
+         * @throws GenICamException se nessuna telecamera è disponibile
          */
         void connectFirst(const std::string& cameraUserID);
 
@@ -269,7 +779,7 @@ namespace GenICamWrapper {
         void disconnect();
 
         /**
-         * @brief Verifica se la telecamera  connessa
+         * @brief Verifica se la telecamera è connessa
          * @return true se connessa
          */
         bool isConnected() const;
@@ -290,9 +800,16 @@ namespace GenICamWrapper {
 
         /**
          * @brief Ferma l'acquisizione
+         * @note Il thread di grab viene risvegliato con EventKill: lo stop non attende timeout
          */
         void stopAcquisition();
 
+        /**
+         * @brief Durata dell'ultima stopAcquisition (dalla chiamata alla notifica ai listener)
+         * @note Include l'attesa della restituzione di eventuali frame in prestito
+         */
+        std::chrono::microseconds getLastStopDuration() const;
+
         /**
          * @brief Acquisisce un singolo frame
          * @param timeoutMs Timeout in millisecondi
@@ -300,6 +817,32 @@ namespace GenICamWrapper {
          * @throws GenICamException in caso di timeout o errore
          */
         cv::Mat grabSingleFrame(uint32_t timeoutMs = 5000);
+
+        /**
+         * @brief Acquisisce una raffica di frame alla velocità massima della camera
+         * @param frameCount Numero di frame della raffica
+         * @param timeoutMs Timeout complessivo della raffica in millisecondi
+         * @param convert Se true converte i frame in parallelo al termine della raffica
+         * @return Frame con i relativi metadati; se il timeout scade prima di frameCount
+         *         frame il risultato è parziale (complete() == false)
+         * @throws GenICamException se è in corso un'acquisizione continua o se non
+         *         arriva nessun frame entro il timeout
+         * @note Tutti i buffer sono preallocati in un'unica arena (uno slot per frame) e
+         *       annunciati prima dell'avvio: durante la raffica nessun buffer viene
+         *       riaccodato e nessun frame convertito. La camera viene armata in MultiFrame
+         *       con AcquisitionFrameCount = frameCount se supportato, altrimenti in
+         *       Continuous con stop dopo frameCount frame. StreamBufferHandlingMode è
+         *       forzato a OldestFirst per la durata della raffica e poi ripristinato.
+         *       La configurazione del trigger non viene modificata.
+         */
+        BurstResult captureBurst(size_t frameCount, uint32_t timeoutMs = 5000, bool convert = false);
+
+        /**
+         * @brief Converte in cv::Mat i frame di una raffica
+         * @param burst Raffica restituita da captureBurst
+         * @param threadCount Thread di conversione (0 = numero di CPU)
+         */
+        void convertBurst(BurstResult& burst, size_t threadCount = 0) const;
         void configureHikrobotGigE();
         void debugAcquisitionStart();
 
@@ -307,28 +850,28 @@ namespace GenICamWrapper {
 
         // === Acquisition Mode ===
         /**
-         * @brief Imposta la modalit di acquisizione
-         * @param mode Modalit di acquisizione desiderata
-         * @throws GenICamException se il parametro non  disponibile o scrivibile
+         * @brief Imposta la modalità di acquisizione
+         * @param mode Modalità di acquisizione desiderata
+         * @throws GenICamException se il parametro non è disponibile o scrivibile
          */
         void setAcquisitionMode(AcquisitionMode mode);
 
         /**
-         * @brief Ottiene la modalit di acquisizione corrente
-         * @return Modalit di acquisizione attuale
-         * @throws GenICamException se il parametro non  disponibile o leggibile
+         * @brief Ottiene la modalità di acquisizione corrente
+         * @return Modalità di acquisizione attuale
+         * @throws GenICamException se il parametro non è disponibile o leggibile
          */
         AcquisitionMode getAcquisitionMode() const;
 
         /**
-         * @brief Verifica se AcquisitionMode  disponibile
-         * @return true se il parametro  disponibile
+         * @brief Verifica se AcquisitionMode è disponibile
+         * @return true se il parametro è disponibile
          */
         bool isAcquisitionModeAvailable() const;
 
         /**
-         * @brief Ottiene le modalit di acquisizione disponibili
-         * @return Vector con le modalit supportate dalla camera
+         * @brief Ottiene le modalità di acquisizione disponibili
+         * @return Vector con le modalità supportate dalla camera
          */
         std::vector<AcquisitionMode> getAvailableAcquisitionModes() const;
 
@@ -345,7 +888,7 @@ namespace GenICamWrapper {
         ExposureAuto getExposureAuto() const;
         bool isExposureAutoAvailable() const;
 
-        // ExposureTime (gi esistente ma da aggiornare)
+        // ExposureTime (già esistente ma da aggiornare)
         void setExposureTime(double microseconds);
         double getExposureTime() const;
         void getExposureTimeRange(double& min, double& max) const;
@@ -382,6 +925,26 @@ namespace GenICamWrapper {
         PixelFormat getPixelFormat() const;
         std::vector<PixelFormat> getAvailablePixelFormats() const;
 
+        /**
+         * @brief Cambia ROI, formato pixel e binning senza riavviare l'acquisizione
+         *
+         * Durante lo streaming la camera viene messa in pausa (AcquisitionStop e
+         * DSStopAcquisition) e gli stadi di grab, conversione e consegna vengono svuotati
+         * come in uno stop, attendendo la restituzione dei frame in prestito; i parametri
+         * bloccati dal TL vengono sbloccati, scritti e ribloccati. Se il nuovo PayloadSize
+         * sta nei buffer annunciati lo streaming riprende sugli stessi buffer (i frame
+         * non ancora prelevati vengono scartati); i buffer vengono riallocati solo se il
+         * payload cresce o se restano frame in prestito. Lo stream non viene chiuso e i
+         * listener non ricevono OnAcquisitionStopped; le notifiche OnParameterChanged
+         * partono al termine, fuori dai lock dell'acquisizione.
+         * A camera ferma equivale ai singoli setter. Con buffer esterni troppo piccoli per
+         * il nuovo payload, o ancora in prestito, lo stream resta in pausa e la camera
+         * passa in stato Error.
+         * @throws GenICamException se un parametro non può essere applicato: lo streaming
+         *         riprende comunque con i valori effettivamente in vigore
+         */
+        ReconfigurationResult reconfigureAcquisition(const StreamReconfiguration& change);
+
         // Frame Rate
         void setFrameRate(double fps);
         double getFrameRate() const;
@@ -391,11 +954,239 @@ namespace GenICamWrapper {
         // === Callback ===
         /**
          * @brief Imposta il listener per gli eventi
-         * @param listener Puntatore al listener (pu essere nullptr)
-         * @note Il listener deve rimanere valido per tutta la durata dell'uso
+         * @param listener Puntatore al listener (può essere nullptr)
+         * @note Il listener deve rimanere valido per tutta la durata dell'uso.
+         *       Sostituisce tutti i listener registrati con subscribe().
          */
         void setEventListener(CameraEventListener* listener);
 
+        /**
+         * @brief Aggiunge un listener a quelli già registrati
+         * @param listener Puntatore al listener (non nullo)
+         * @throws GenICamException se listener è nullptr
+         * @note Le callback sono invocate senza mutex: più listener e più thread
+         *       della pipeline possono essere attivi contemporaneamente.
+         */
+        void subscribe(CameraEventListener* listener);
+
+        /**
+         * @brief Rimuove un listener
+         * @param listener Puntatore al listener da rimuovere
+         * @note Al ritorno nessuna callback è più in esecuzione sul listener, che può
+         *       essere distrutto; se chiamato da una callback, quella callback esclusa.
+         */
+        void unsubscribe(CameraEventListener* listener);
+
+        /**
+         * @brief Imposta la modalità di consegna dei frame (Copy o Loan)
+         * @param mode Modalità desiderata
+         * @throws GenICamException se l'acquisizione è in corso
+         * @note In modalità Loan i frame sono consegnati tramite
+         *       CameraEventListener::OnFrameLoaned; trattenere lo shared_ptr
+         *       oltre la callback tiene occupato un buffer del producer.
+         */
+        void setFrameDeliveryMode(FrameDeliveryMode mode);
+        FrameDeliveryMode getFrameDeliveryMode() const;
+
+        /**
+         * @brief Numero di frame in prestito non ancora rilasciati dai listener
+         */
+        size_t getLoanedFrameCount() const;
+
+        /**
+         * @brief Configura la pipeline grab -> conversione -> consegna
+         * @param config Profondità delle code e numero di worker di conversione
+         * @throws GenICamException se l'acquisizione è in corso o la configurazione non è valida
+         */
+        void setPipelineConfig(const AcquisitionPipelineConfig& config);
+        AcquisitionPipelineConfig getPipelineConfig() const;
+
+        /**
+         * @brief Frame scartati dal grab perché la coda di conversione era piena
+         */
+        uint64_t getPipelineDroppedFrames() const;
+
+        /**
+         * @brief Statistiche di perdita frame per causa (camera, trasporto, host)
+         * @note Legge solo contatori atomici: può essere chiamato durante lo streaming
+         *       senza accessi al producer. Azzerate a ogni startAcquisition.
+         */
+        AcquisitionStatistics getAcquisitionStatistics() const;
+
+        /**
+         * @brief Configura la modalità di attesa dei buffer (bloccante o busy-poll)
+         * @throws GenICamException se l'acquisizione è in corso
+         * @note Applicata alla startAcquisition successiva
+         */
+        void setGrabWaitConfig(const GrabWaitConfig& config);
+        GrabWaitConfig getGrabWaitConfig() const;
+
+        /**
+         * @brief Istogrammi di latenza, azzerati a ogni startAcquisition
+         */
+        AcquisitionLatencyReport getLatencyReport() const;
+
+        // === Correlazione clock device/host ===
+        /**
+         * @brief Configura la correlazione dei clock
+         * @throws GenICamException se l'acquisizione è in corso o il periodo non è valido
+         */
+        void setClockCorrelationConfig(const ClockCorrelationConfig& config);
+        ClockCorrelationConfig getClockCorrelationConfig() const;
+
+        /**
+         * @brief Mappatura tick del device -> clock host attualmente in uso
+         * @note valid = false se il device non supporta il latch del timestamp o
+         *       non sono ancora stati raccolti almeno 2 campioni
+         */
+        ClockMapping getClockMapping() const;
+
+        // === Buffer di acquisizione ===
+        /**
+         * @brief Configura l'allocazione dei buffer GenTL
+         * @throws GenICamException se l'acquisizione è in corso
+         * @note Disabilitando il pool la memoria trattenuta viene liberata
+         */
+        void setBufferAllocationConfig(const BufferAllocationConfig& config);
+        BufferAllocationConfig getBufferAllocationConfig() const;
+
+        /**
+         * @brief Stato del pool di buffer (blocchi, byte trattenuti, riutilizzi)
+         */
+        BufferPoolStatistics getBufferPoolStatistics() const;
+
+        /**
+         * @brief Libera la memoria del pool non utilizzata dall'acquisizione corrente
+         */
+        void trimBufferPool();
+
+        /**
+         * @brief Stato del pool dei cv::Mat prodotti dalla conversione dei frame
+         */
+        MatPoolStatistics getConversionPoolStatistics() const;
+
+        /**
+         * @brief Limite della memoria libera trattenuta dal pool di conversione
+         */
+        void setConversionPoolLimit(size_t maxCachedBytes);
+
+        /**
+         * @brief Prefault e blocco in RAM ottenuti per i buffer dell'ultima allocazione
+         */
+        BufferResidencyStatistics getBufferResidencyStatistics() const;
+
+        /**
+         * @brief Usa regioni di memoria del chiamante come buffer di acquisizione
+         * @param buffers Regioni non sovrapposte; ad ogni avvio vengono annunciate tutte,
+         *        indipendentemente dal bufferCount di startAcquisition
+         * @throws GenICamException se l'acquisizione è in corso o le regioni non sono valide
+         * @note Dimensione (>= PayloadSize) e allineamento (STREAM_INFO_BUF_ALIGNMENT)
+         *       sono verificati all'avvio, con lo stream aperto. Le regioni esterne
+         *       escludono il pool e il numero di buffer adattivo.
+         */
+        void setExternalBuffers(const std::vector<ExternalBuffer>& buffers, ExternalBufferCallbacks callbacks = {});
+
+        /**
+         * @brief Torna all'allocazione interna dei buffer
+         * @throws GenICamException se l'acquisizione è in corso
+         */
+        void clearExternalBuffers();
+        size_t getExternalBufferCount() const;
+
+        // === Anello di frame condiviso ===
+        /**
+         * @brief Crea l'anello in memoria condivisa e vi pubblica ogni frame acquisito
+         * @throws GenICamException se l'acquisizione è in corso, la configurazione non è
+         *         valida o il segmento non può essere creato
+         * @note La pubblicazione non attende mai i reader: un reader troppo lento
+         *       riceve SharedFrameReadStatus::Overwritten
+         */
+        void enableSharedFrameRing(const SharedFrameRingConfig& config);
+        void disableSharedFrameRing();
+        SharedFrameRingStatistics getSharedFrameRingStatistics() const;
+
+        /**
+         * @brief Configura l'adattamento del numero di buffer durante lo streaming
+         * @throws GenICamException se l'acquisizione è in corso o i limiti non sono coerenti
+         * @note Con enabled il bufferCount di startAcquisition è il numero iniziale,
+         *       limitato a [minBuffers, maxBuffers]
+         */
+        void setAdaptiveBufferConfig(const AdaptiveBufferConfig& config);
+        AdaptiveBufferConfig getAdaptiveBufferConfig() const;
+
+        /**
+         * @brief Configura il collocamento NUMA di buffer e thread
+         * @throws GenICamException se l'acquisizione è in corso o il nodo non esiste
+         * @note Applicato all'allocazione dei buffer successiva
+         */
+        void setNumaConfig(const NumaPlacementConfig& config);
+        NumaPlacementConfig getNumaConfig() const;
+
+        /**
+         * @brief Nodo NUMA usato dall'ultima allocazione dei buffer (-1 = nessun vincolo)
+         */
+        int getNumaNode() const;
+
+        // === Scheduling dei thread di acquisizione ===
+        /**
+         * @brief Imposta affinità CPU, politica real-time e nome per un ruolo di thread
+         * @param role Thread a cui applicare la configurazione
+         * @param config Configurazione; per Conversion il worker i viene vincolato alla
+         *               CPU cpuAffinity[i % n] e al nome viene aggiunto l'indice
+         * @throws GenICamException se l'acquisizione è in corso
+         * @note Applicata da ciascun thread all'avvio dell'acquisizione successiva;
+         *       FeatureEvents alla connessione successiva (il thread vive quanto la connessione)
+         */
+        void setThreadConfig(AcquisitionThreadRole role, const ThreadConfig& config);
+        ThreadConfig getThreadConfig(AcquisitionThreadRole role) const;
+
+        /**
+         * @brief Impostazioni ottenute dai thread dell'acquisizione corrente
+         * @return Una voce per thread avviato, con eventuali errori (es. privilegi RT mancanti)
+         */
+        std::vector<AppliedThreadConfig> getAppliedThreadConfigs() const;
+
+        // === Accesso pull ai frame ===
+        /**
+         * @brief Abilita l'accesso pull ai frame durante l'acquisizione continua
+         * @param mode Modalità del ring (Disabled, Queue, LatestOnly)
+         * @param capacity Numero di slot del ring in modalità Queue (ignorato per LatestOnly)
+         * @throws GenICamException se l'acquisizione è in corso o capacity è 0
+         * @note Il ring è alimentato in aggiunta ai listener, che restano attivi
+         */
+        void setFrameQueueMode(FrameQueueMode mode, size_t capacity = 4);
+        FrameQueueMode getFrameQueueMode() const;
+
+        /**
+         * @brief Attende il prossimo frame disponibile
+         * @param frame Frame estratto (il più vecchio in modalità Queue)
+         * @param timeoutMs Timeout in millisecondi
+         * @return false in caso di timeout, acquisizione ferma o accesso pull disabilitato
+         */
+        bool waitForFrame(AcquiredFrame& frame, uint32_t timeoutMs);
+
+        /**
+         * @brief Preleva il frame più recente senza attendere
+         * @param frame Frame estratto; i frame più vecchi ancora nel ring vengono scartati
+         * @return false se non ci sono frame disponibili
+         */
+        bool tryGetLatestFrame(AcquiredFrame& frame);
+
+        /**
+         * @brief Attesa asincrona del prossimo frame: co_await camera.nextFrame(executor)
+         * @param executor Executor su cui riprende la coroutine (default: thread di consegna)
+         * @note Usa il ring pull (setFrameQueueMode): le coroutine in attesa ricevono i
+         *       frame prima dei thread bloccati in waitForFrame
+         */
+        FrameAwaiter nextFrame(FrameExecutor& executor = inlineFrameExecutor());
+
+        /**
+         * @brief Sequenza asincrona dei frame, ripresa sempre sullo stesso executor
+         */
+        FrameStream frames(FrameExecutor& executor = inlineFrameExecutor());
+
+        static InlineFrameExecutor& inlineFrameExecutor();
+
         // === Informazioni ===
         std::string getCameraInfo() const;
         std::string getCameraModel() const;
@@ -409,7 +1200,7 @@ namespace GenICamWrapper {
          * @brief Ottiene il valore di un parametro generico
          * @param parameterName Nome del parametro GenApi
          * @return Valore del parametro come stringa
-         * @throws GenICamException se il parametro non esiste o non  leggibile
+         * @throws GenICamException se il parametro non esiste o non è leggibile
          */
         std::string getParameter(const std::string& parameterName) const;
 
@@ -417,7 +1208,7 @@ namespace GenICamWrapper {
          * @brief Imposta il valore di un parametro generico
          * @param parameterName Nome del parametro GenApi
          * @param value Valore da impostare
-         * @throws GenICamException se il parametro non esiste o non  scrivibile
+         * @throws GenICamException se il parametro non esiste o non è scrivibile
          */
         void setParameter(const std::string& parameterName, const std::string& value);
 
@@ -428,23 +1219,23 @@ namespace GenICamWrapper {
         std::vector<std::string> getAvailableParameters() const;
 
         /**
-         * @brief Verifica se un parametro  disponibile
+         * @brief Verifica se un parametro è disponibile
          * @param parameterName Nome del parametro
-         * @return true se il parametro esiste ed  implementato
+         * @return true se il parametro esiste ed è implementato
          */
         bool isParameterAvailable(const std::string& parameterName) const;
 
         /**
-         * @brief Verifica se un parametro  leggibile
+         * @brief Verifica se un parametro è leggibile
          * @param parameterName Nome del parametro
-         * @return true se il parametro  leggibile
+         * @return true se il parametro è leggibile
          */
         bool isParameterReadable(const std::string& parameterName) const;
 
         /**
-         * @brief Verifica se un parametro  scrivibile
+         * @brief Verifica se un parametro è scrivibile
          * @param parameterName Nome del parametro
-         * @return true se il parametro  scrivibile
+         * @return true se il parametro è scrivibile
          */
         bool isParameterWritable(const std::string& parameterName) const;
 
@@ -468,9 +1259,16 @@ namespace GenICamWrapper {
 
         /**
          * @brief Esegue un trigger software
-         * @note Funziona solo se TriggerSource  impostato su Software
+         * @return Token del trigger, riportato in ImageData::triggerToken del frame prodotto
+         * @note Funziona solo se TriggerSource è impostato su Software
          */
-        void executeTriggerSoftware();
+        uint64_t executeTriggerSoftware();
+
+        /**
+         * @brief Trigger emessi, frame associati, trigger persi e latenze trigger -> frame
+         * @note Azzerate a ogni startAcquisition
+         */
+        TriggerStatistics getTriggerStatistics() const;
 
         /**
          * @brief Imposta il ritardo del trigger in microsecondi
@@ -495,8 +1293,8 @@ namespace GenICamWrapper {
             TriggerActivation activation = TriggerActivation::RisingEdge);
 
         /**
-         * @brief Verifica se il trigger  configurato e attivo
-         * @return true se un trigger  abilitato
+         * @brief Verifica se il trigger è configurato e attivo
+         * @return true se un trigger è abilitato
          */
         bool isTriggerEnabled() const;
 
@@ -517,8 +1315,8 @@ namespace GenICamWrapper {
         uint32_t getTriggerDivider() const;
 
         /**
-         * @brief Imposta la modalit overlap del trigger
-         * @param overlap Modalit overlap
+         * @brief Imposta la modalità overlap del trigger
+         * @param overlap Modalità overlap
          */
         void setTriggerOverlap(TriggerOverlap overlap);
         TriggerOverlap getTriggerOverlap() const;
@@ -547,8 +1345,8 @@ namespace GenICamWrapper {
         std::vector<LineSelector> getAvailableLines() const;
 
         /**
-         * @brief Configura la modalit della linea (input/output)
-         * @param mode Modalit della linea
+         * @brief Configura la modalità della linea (input/output)
+         * @param mode Modalità della linea
          */
         void setLineMode(LineMode mode);
         LineMode getLineMode() const;
@@ -634,7 +1432,7 @@ namespace GenICamWrapper {
         double getStrobeDelay() const;
 
         /**
-         * @brief Imposta la polarit dello strobe
+         * @brief Imposta la polarità dello strobe
          * @param activeHigh true per attivo alto
          */
         void setStrobePolarity(bool activeHigh);
@@ -795,11 +1593,11 @@ namespace GenICamWrapper {
         /**
          * @brief Ottiene il puntatore al NodeMap del dispositivo
          *
-         * Questo metodo  necessario per inizializzare componenti esterni
+         * Questo metodo è necessario per inizializzare componenti esterni
          * come ChunkDataManager che necessitano accesso diretto al NodeMap.
          *
          * @return Puntatore al NodeMap del dispositivo, nullptr se non connesso
-         * @throws GenICamException se la camera non  connessa
+         * @throws GenICamException se la camera non è connessa
          */
         GenApi::INodeMap* getNodeMap() const;
 
@@ -807,9 +1605,9 @@ namespace GenICamWrapper {
          * @brief Ottiene il puntatore al NodeMap dello stream (se disponibile)
          *
          * Alcune implementazioni GenTL forniscono un NodeMap separato per lo stream.
-         * Questo  particolarmente utile per la gestione dei chunk data.
+         * Questo è particolarmente utile per la gestione dei chunk data.
          *
-         * @return Puntatore al NodeMap dello stream, pu essere nullptr
+         * @return Puntatore al NodeMap dello stream, può essere nullptr
          * @note Non tutte le implementazioni supportano uno stream NodeMap separato
          */
         GenApi::INodeMap* getStreamNodeMap() const;
@@ -822,7 +1620,7 @@ namespace GenICamWrapper {
         mutable std::shared_mutex m_connectionMutex;  // Per stato connessione
         mutable std::shared_mutex m_parameterMutex;   // Per accesso parametri
         std::mutex m_acquisitionMutex;                // Per controllo acquisizione
-        std::mutex m_callbackMutex;                   // Per gestione callback
+        std::mutex m_callbackMutex;                   // Serializza gli aggiornamenti della lista listener
 
         // === Handles GenTL ===
         GenTL::TL_HANDLE m_tlHandle;
@@ -834,6 +1632,12 @@ namespace GenICamWrapper {
 
         GenTL::EVENT_HANDLE m_featureEventHandle;
 
+        // Thread dedicato agli eventi di invalidazione (attesa bloccante, stop con EventKill)
+        std::thread m_featureEventThread;
+        std::atomic<bool> m_stopFeatureEvents{ false };
+        static constexpr std::chrono::milliseconds FEATURE_EVENT_COALESCE_WINDOW{ 5 };
+        static constexpr std::chrono::milliseconds FEATURE_EVENT_RETRY_DELAY{ 100 };
+
         // === GenApi ===
         std::unique_ptr<GenApi::CNodeMapRef> m_pNodeMap;
 
@@ -842,6 +1646,59 @@ namespace GenICamWrapper {
         std::vector<std::unique_ptr<void, AlignedBufferDeleter>> m_alignedBuffers;
         size_t m_bufferSize;
 
+        // Memoria dei buffer annunciati presa dal pool, restituita da freeBuffers
+        BufferAllocationConfig m_bufferAllocationConfig;
+        BufferPool m_bufferPool;
+        std::vector<void*> m_pooledBuffers;
+
+        // cv::Mat di uscita della conversione, riciclati al rilascio dell'ultimo riferimento
+        mutable MatPool m_matPool;
+
+        // Anello condiviso: aperto e chiuso solo fuori dall'acquisizione
+        SharedFrameRingConfig m_sharedRingConfig;
+        SharedFrameRingWriter m_sharedFrameRing;
+        std::atomic<uint64_t> m_sharedRingOversized{ 0 };
+
+        // Regioni esterne: un riferimento per regione annunciata, la callback onReleased
+        // scatta al rilascio dell'ultimo (freeBuffers o ultimo frame in prestito)
+        std::vector<ExternalBuffer> m_externalBuffers;
+        ExternalBufferCallbacks m_externalBufferCallbacks;
+        std::vector<std::shared_ptr<void>> m_externalBufferLeases;
+
+        // Range bloccati in RAM per buffer, sbloccati alla revoca (protetti da m_bufferHandlesMutex)
+        struct LockedBufferRegion {
+            GenTL::BUFFER_HANDLE hBuffer;
+            void* ptr;
+            size_t size;
+        };
+        std::vector<LockedBufferRegion> m_lockedBufferRegions;
+        mutable std::mutex m_residencyStatsMutex;
+        BufferResidencyStatistics m_residencyStats;
+
+        // Dimensione e allineamento dei buffer annunciati, per le aggiunte durante lo streaming
+        size_t m_announcedBufferSize = 0;
+        size_t m_announcedBufferAlignment = 0;
+
+        // === Numero di buffer adattivo ===
+        // m_bufferHandlesMutex protegge m_bufferHandles e la memoria associata mentre
+        // il thread di controllo annuncia buffer e i thread del percorso dei frame li revocano
+        AdaptiveBufferConfig m_adaptiveBufferConfig;
+        std::mutex m_bufferHandlesMutex;
+        std::atomic<size_t> m_announcedBufferCount{ 0 };
+        std::atomic<size_t> m_pendingBufferRevokes{ 0 };
+        std::atomic<uint64_t> m_statBuffersAdded{ 0 };
+        std::atomic<uint64_t> m_statBuffersRevoked{ 0 };
+        std::thread m_bufferMonitorThread;
+        std::mutex m_bufferMonitorMutex;
+        std::condition_variable m_bufferMonitorWake;
+        bool m_stopBufferMonitor = false;
+        static constexpr size_t BUFFER_SHRINK_PERIODS = 4;     // Valutazioni in eccesso prima di revocare
+
+        // Nodo NUMA risolto a ogni allocazione dei buffer e relative CPU per i thread
+        NumaPlacementConfig m_numaConfig;
+        std::atomic<int> m_numaNode{ -1 };
+        std::vector<int> m_numaCpus;
+
         // === Stato ===
         std::atomic<CameraState> m_state;
         std::atomic<bool> m_isAcquiring;
@@ -850,11 +1707,204 @@ namespace GenICamWrapper {
         // === Thread Acquisizione ===
         std::thread m_acquisitionThread;
         std::atomic<bool> m_stopAcquisition{ false };
+        std::atomic<int64_t> m_lastStopDurationUs{ 0 };
         std::condition_variable m_stopCondition;
         std::mutex m_stopMutex;
 
         // === Callback ===
-        CameraEventListener* m_eventListener;
+        // Lista immutabile in stile RCU: il dispatch legge uno snapshot senza mutex,
+        // subscribe/unsubscribe pubblicano una copia aggiornata
+        using ListenerList = std::vector<CameraEventListener*>;
+        std::atomic<std::shared_ptr<const ListenerList>> m_listeners;
+
+        // Snapshot sostituiti ma forse ancora in uso da dispatch in corso (protetti da
+        // m_callbackMutex): il grace period li copre tutti, non solo l'ultimo
+        std::vector<std::weak_ptr<const ListenerList>> m_retiredListeners;
+
+        template<typename Callback>
+        void dispatchToListeners(Callback&& callback);
+        void retireListenerSnapshot(std::shared_ptr<const ListenerList> previous);
+        void waitForListenerReaders(CameraEventListener* removed);
+
+        // === Frame in prestito (FrameDeliveryMode::Loan) ===
+        // Stato condiviso tra lo stream e i frame consegnati ai listener: sopravvive
+        // allo stream finché esiste un frame in prestito, così un rilascio tardivo
+        // non riaccoda mai un buffer su un data stream già chiuso.
+        struct LoanSession {
+            std::mutex mutex;
+            std::condition_variable returned;
+            GenTL::DS_HANDLE dsHandle = nullptr;
+            GenICamCamera* camera = nullptr;    // Valido finché streamOpen
+            bool streamOpen = false;
+            size_t outstanding = 0;
+            // Memoria allocata manualmente, trattenuta se allo stop restano prestiti aperti
+            std::vector<std::unique_ptr<void, AlignedBufferDeleter>> retainedMemory;
+            std::vector<std::shared_ptr<void>> retainedPoolMemory;
+            std::vector<std::shared_ptr<void>> retainedExternalBuffers;
+        };
+
+        // Custom deleter per ImageData::buffer in modalità Loan
+        struct LoanedBufferRelease {
+            std::shared_ptr<LoanSession> session;
+            GenTL::BUFFER_HANDLE hBuffer;
+            void operator()(uint8_t* p) const;
+        };
+
+        std::atomic<FrameDeliveryMode> m_deliveryMode{ FrameDeliveryMode::Copy };
+        std::atomic<std::shared_ptr<LoanSession>> m_loanSession;
+
+        // === Pipeline di acquisizione ===
+        // Informazioni di un buffer GenTL lette con un'unica chiamata al producer
+        // (tipi secondo la specifica GenTL: size_t per le dimensioni, 1 byte per i flag)
+        struct BufferInfo {
+            void* base = nullptr;
+            size_t sizeFilled = 0;
+            size_t width = 0;
+            size_t height = 0;
+            size_t xPadding = 0;
+            size_t payloadType = 0;
+            uint64_t pixelFormat = 0;
+            uint64_t frameID = 0;
+            uint64_t timestamp = 0;         // Timestamp del device (tick del producer)
+            uint8_t isIncomplete = 0;       // bool8_t GenTL (1 byte)
+        };
+
+        // Frame prelevato dal grab, in attesa di conversione
+        struct GrabbedFrame {
+            uint64_t sequence = 0;          // Ordine di grab, usato per riordinare la consegna
+            GenTL::BUFFER_HANDLE hBuffer = nullptr;
+            void* pBuffer = nullptr;
+            uint32_t width = 0;
+            uint32_t height = 0;
+            uint64_t pixelFormat = 0;
+            uint64_t frameID = 0;
+            std::chrono::steady_clock::time_point timestamp;
+            uint64_t deviceTimestamp = 0;
+            size_t sizeFilled = 0;
+            size_t xPadding = 0;
+            size_t payloadType = 0;
+            bool isIncomplete = false;
+            bool hasChunkExposureTime = false;
+            bool hasChunkGain = false;
+            bool hasChunkFrameId = false;
+            bool hasChunkTriggerCounter = false;
+            double chunkExposureTime = 0.0;
+            double chunkGain = 0.0;
+            uint64_t chunkFrameId = 0;
+            uint64_t chunkTriggerCounter = 0;
+            uint64_t triggerToken = 0;
+            std::chrono::steady_clock::time_point triggerTime;
+        };
+
+        // Frame convertito, in attesa di consegna ai listener
+        struct ConvertedFrame {
+            uint64_t sequence = 0;
+            std::shared_ptr<ImageData> imageData;   // nullptr se la conversione è fallita
+            cv::Mat image;
+            std::chrono::steady_clock::time_point triggerTime;  // Valido se imageData->triggerToken != 0
+        };
+
+        AcquisitionPipelineConfig m_pipelineConfig;
+        std::unique_ptr<PipelineChannel<GrabbedFrame>> m_conversionChannel;
+        std::unique_ptr<PipelineChannel<ConvertedFrame>> m_deliveryChannel;
+        std::vector<std::thread> m_conversionThreads;
+        std::thread m_deliveryThread;
+        std::atomic<uint64_t> m_pipelineDroppedFrames{ 0 };
+        std::atomic<uint64_t> m_pipelineHighWaterMark{ 0 };
+
+        // false dopo che il producer ha rifiutato DSGetBufferInfoStacked (GenTL < 1.6)
+        std::atomic<bool> m_stackedBufferInfoSupported{ true };
+
+        // Correlazione clock device/host
+        ClockCorrelationConfig m_clockCorrelationConfig;
+        ClockCorrelator m_clockCorrelator;
+        std::thread m_clockCorrelationThread;
+        std::mutex m_clockCorrelationMutex;
+        std::condition_variable m_clockCorrelationWake;
+        bool m_stopClockCorrelation = false;
+        static constexpr std::chrono::milliseconds CLOCK_FIRST_LATCH_INTERVAL{ 100 };
+        static constexpr std::chrono::milliseconds CLOCK_LATCH_MAX_DURATION{ 5 };
+
+        // Attesa dei buffer e latenze
+        GrabWaitConfig m_grabWaitConfig;
+        LatencyHistogram m_grabToDeliveryLatency;
+        LatencyHistogram m_frameIntervalLatency;
+
+        // Scheduling dei thread, indicizzato per AcquisitionThreadRole
+        static constexpr size_t THREAD_ROLE_COUNT = 4;
+        ThreadConfig m_threadConfigs[THREAD_ROLE_COUNT];
+        mutable std::mutex m_appliedThreadConfigsMutex;
+        std::vector<AppliedThreadConfig> m_appliedThreadConfigs;
+
+        // Sequenze scartate dopo essere entrate in coda (DropOldest/KeepLatest):
+        // il thread di consegna le salta invece di attenderle
+        std::mutex m_skippedSequencesMutex;
+        std::set<uint64_t> m_skippedSequences;
+        std::atomic<size_t> m_skippedSequenceCount{ 0 };
+
+        // === Statistiche di perdita frame (scritte solo dal thread di grab) ===
+        std::atomic<uint64_t> m_statFramesReceived{ 0 };
+        std::atomic<uint64_t> m_statMissingFrameIds{ 0 };
+        std::atomic<uint64_t> m_statIncompleteFrames{ 0 };
+        std::atomic<uint64_t> m_statProducerUnderruns{ 0 };
+        std::atomic<uint64_t> m_statFrameIdResets{ 0 };
+        std::atomic<uint64_t> m_statLastFrameId{ 0 };
+        bool m_hasLastFrameId = false;
+        static constexpr uint64_t GEV1_MAX_BLOCK_ID = 0xFFFF;
+
+        // === Correlazione trigger software -> frame ===
+        // Trigger emessi e non ancora associati a un frame, in ordine di emissione.
+        // Il thread di grab ricava il token atteso dall'avanzamento del contatore
+        // di correlazione rispetto all'ultimo frame associato.
+        struct PendingTrigger {
+            uint64_t token;
+            std::chrono::steady_clock::time_point time;
+        };
+        mutable std::mutex m_triggerMutex;
+        std::deque<PendingTrigger> m_pendingTriggers;
+        uint64_t m_lastTriggerToken = 0;        // Token crescenti per tutta la vita dell'oggetto
+        bool m_triggerSynced = false;
+        uint64_t m_triggerLastKey = 0;
+        uint64_t m_triggerLastMatchedToken = 0;
+        std::atomic<TriggerCorrelationSource> m_triggerCorrelationSource{ TriggerCorrelationSource::BufferFrameId };
+        std::atomic<uint64_t> m_triggersIssued{ 0 };
+        std::atomic<uint64_t> m_triggerFramesMatched{ 0 };
+        std::atomic<uint64_t> m_triggerFramesLost{ 0 };
+        LatencyHistogram m_triggerToGrabLatency;
+        LatencyHistogram m_triggerToDeliveryLatency;
+        static constexpr size_t MAX_PENDING_TRIGGERS = 1024;
+
+        // === Accesso pull ai frame ===
+        // Ring e mailbox LatestOnly sono una BoundedMPMCQueue lock-free: il mutex serve
+        // solo a parcheggiare thread e coroutine in attesa e il thread di consegna lo
+        // prende soltanto se m_frameWaiters > 0
+        std::atomic<FrameQueueMode> m_frameQueueMode{ FrameQueueMode::Disabled };
+        size_t m_frameQueueCapacity = 4;
+        std::unique_ptr<BoundedMPMCQueue<AcquiredFrame>> m_frameQueue;
+        size_t m_frameQueueLimit = 0;       // Capacità richiesta (la coda arrotonda a potenza di 2)
+        std::atomic<bool> m_frameQueueOpen{ false };
+        std::atomic<int> m_frameQueueReaders{ 0 };  // Consumatori dentro m_frameQueue
+        std::mutex m_frameQueueMutex;
+        std::condition_variable m_frameAvailable;
+        std::atomic<int> m_frameWaiters{ 0 };       // Thread e coroutine parcheggiati
+
+        // Coroutine sospese su nextFrame (lista FIFO intrusiva, protetta da m_frameQueueMutex)
+        friend class FrameAwaiter;
+        FrameAwaiter* m_frameAwaitersHead = nullptr;
+        FrameAwaiter* m_frameAwaitersTail = nullptr;
+
+        // === Metadati di esposizione per frame ===
+        // Valori ombra aggiornati dai setter e dagli eventi di invalidazione:
+        // il percorso dei frame non legge mai i registri della camera
+        std::atomic<double> m_exposureTimeShadow{ 0.0 };
+        std::atomic<double> m_gainShadow{ 0.0 };
+
+        // Chunk data letti dal buffer tramite ChunkDataManager quando ChunkModeActive è attivo:
+        // il thread di grab legge solo il contatore dei trigger dai byte del chunk,
+        // esposizione e guadagno sono decodificati via GenApi dai worker di conversione
+        bool m_chunkMetadataActive = false;
+        std::unique_ptr<ChunkDataManager> m_chunkReader;
+        static constexpr size_t MAX_CHUNKS_PER_FRAME = 64;
 
         // === Cache Parametri (per performance) ===
         mutable std::map<std::string, std::pair<std::string, std::chrono::steady_clock::time_point>> m_parameterCache;
@@ -866,13 +1916,77 @@ namespace GenICamWrapper {
         void allocateBuffers(size_t count);
         void freeBuffers();
         void acquisitionThreadFunction();
+        void conversionThreadFunction(size_t workerIndex);
+        void applyThreadConfig(AcquisitionThreadRole role, size_t index);
+        void startClockCorrelation();
+        void stopClockCorrelation();
+        void clockCorrelationThreadFunction();
+        void deliveryThreadFunction();
+        void startPipeline();
+        void stopPipeline();
+        bool readBufferInfo(GenTL::BUFFER_HANDLE hBuffer, GrabbedFrame& frame);
+        bool queryBufferInfo(GenTL::BUFFER_HANDLE hBuffer, BufferInfo& info);
+        void openDataStream();
+        void updateBufferSize();
+        static void* allocateAlignedMemory(size_t size, size_t alignment);
+        bool announcePooledBuffers(size_t count, size_t bufferSize, size_t alignment);
+        void announceExternalBuffers(size_t bufferSize);
+        void publishRawFrame(const GrabbedFrame& frame);
+        void publishConvertedFrame(const ConvertedFrame& frame);
+        void applyBufferResidency();
+        void makeBufferResident(GenTL::BUFFER_HANDLE hBuffer, BufferResidencyStatistics& stats);
+        void unlockBufferRegion(GenTL::BUFFER_HANDLE hBuffer);
+        void requeueBuffer(GenTL::BUFFER_HANDLE hBuffer);
+        bool tryRevokeBuffer(GenTL::BUFFER_HANDLE hBuffer);
+        void growBuffers(size_t count);
+        void startBufferMonitor();
+        void stopBufferMonitor();
+        void bufferMonitorThreadFunction();
+        void resolveNumaPlacement();
+        size_t getBufferAlignment() const;
+        void resetAcquisitionStatistics();
+        bool enqueueGrabbedFrame(GrabbedFrame& frame);
+        void discardQueuedFrame(const GrabbedFrame& frame);
+        bool consumeSkippedSequence(uint64_t sequence);
+        void trackFrameId(uint64_t frameID);
+        void correlateTrigger(GrabbedFrame& frame);
+        void resetTriggerTracking();
+        bool isFrameIncomplete(const GrabbedFrame& frame) const;
+        void refreshProducerUnderruns();
+        ConvertedFrame convertGrabbedFrame(GrabbedFrame& frame);
+        void deliverFrame(ConvertedFrame& frame);
+        void refreshParameterShadows(bool exposure = true, bool gain = true);
+        void setupChunkMetadata();
+        // Notifiche OnParameterChanged raccolte sotto lock e inviate dopo il rilascio
+        using ParameterNotifications = std::vector<std::pair<std::string, std::string>>;
+        std::string applyROI(const ROI& roi);
+        std::string applyPixelFormat(PixelFormat format);
+        void applyStreamReconfiguration(const StreamReconfiguration& change, ParameterNotifications& notifications);
+        std::exception_ptr reconfigureStreaming(const StreamReconfiguration& change,
+            ParameterNotifications& notifications, ReconfigurationResult& result);
+        bool stopStreamStages();
+        void startStreamStages();
+        void reallocateStreamBuffers();
+        void executeAcquisitionStart();
+        void executeAcquisitionStop();
+        void readChunkMetadata(GrabbedFrame& frame);
+        void readChunkTriggerKey(GrabbedFrame& frame);
+        void openFrameQueue();
+        void closeFrameQueue();
+        void publishPulledFrame(const ConvertedFrame& frame);
+        bool popPulledFrame(AcquiredFrame& frame);
+        bool suspendFrameAwaiter(FrameAwaiter& awaiter);
         void loadXMLFromDevice();
         void parseAndLoadXMLFromURL(const std::string& urlString);
         bool setupGainSelector() const;
 
         cv::Mat convertBufferToMat(void* buffer, size_t size,
             uint32_t width, uint32_t height,
-            PixelFormat format) const;
+            PixelFormat format, bool shareBuffer = false) const;
+        int getBitsPerPixel(PixelFormat format) const;
+
+        void openLoanSession();
+        bool closeLoanSession();
 
         PixelFormat convertFromGenICamPixelFormat(uint64_t genICamFormat) const;
         uint64_t convertToGenICamPixelFormat(PixelFormat format) const;
@@ -900,7 +2014,7 @@ namespace GenICamWrapper {
         // Metodi per gestione NodeMap
         void validateNodeMap() const;
         void refreshNodeMap();
-        void handleFeatureInvalidation(const std::string& featureName);
+        void handleFeatureInvalidations(const std::set<std::string>& featureNames, bool refreshAll);
         bool isNodeMapStale() const;
 
         // Cache per i selettori supportati
@@ -919,6 +2033,9 @@ namespace GenICamWrapper {
         // Event handler per invalidazione features
         void registerFeatureInvalidationEvents();
         void unregisterFeatureInvalidationEvents();
+        void featureEventThreadFunction();
+        void stopFeatureEventThread();
+        GenTL::GC_ERROR readFeatureEvent(uint64_t timeoutMs, std::string& featureName);
 
         void exploreNode(GenApi::CNodePtr pNode, std::vector<std::string>& parameters) const;
         void notifyParameterChanged(const std::string& parameterName, const std::string& value);
@@ -944,6 +2061,7 @@ namespace GenICamWrapper {
         // Timeout per operazioni critiche
         static constexpr auto ACQUISITION_STOP_TIMEOUT = std::chrono::seconds(5);
         static constexpr auto BUFFER_WAIT_TIMEOUT = std::chrono::milliseconds(100);
+        static constexpr auto LOAN_RETURN_TIMEOUT = std::chrono::seconds(2);
     };
 
 } // namespace GenICamWrapper
\ No newline at end of file
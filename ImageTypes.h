@@ -117,7 +117,24 @@ namespace GenICamWrapper {
 
         // Metadati temporali
         uint64_t frameID;       // ID univoco del frame
-        std::chrono::steady_clock::time_point timestamp;
+        std::chrono::steady_clock::time_point timestamp;    // Istante host del prelievo del buffer
+
+        // Timestamp hardware del device (BUFFER_INFO_TIMESTAMP, in tick del device)
+        uint64_t deviceTimestamp;
+
+        // deviceTimestamp riportato sul clock host tramite la correlazione dei clock:
+        // confrontabile tra camere diverse e con timestamp; valido solo se hostTimestampValid
+        std::chrono::steady_clock::time_point hostTimestamp;
+        std::chrono::nanoseconds hostTimestampError;        // Stima dell'errore della mappatura
+        bool hostTimestampValid;
+
+        // Token restituito da executeTriggerSoftware per il trigger che ha prodotto
+        // il frame (0 = frame non associato a un trigger software)
+        uint64_t triggerToken;
+
+        // Buffer consegnato incompleto dal transport layer (pacchetti persi):
+        // le righe non ricevute contengono dati non validi
+        bool isIncomplete;
 
         // Informazioni di acquisizione
         double exposureTime;    // in microsecondi
@@ -129,7 +146,8 @@ namespace GenICamWrapper {
         ImageData()
             : buffer(nullptr), bufferSize(0), width(0), height(0),
             pixelFormat(PixelFormat::Undefined), stride(0),
-            frameID(0), exposureTime(0.0), gain(0.0) {
+            frameID(0), deviceTimestamp(0), hostTimestampError(0), hostTimestampValid(false),
+            triggerToken(0), isIncomplete(false), exposureTime(0.0), gain(0.0) {
             timestamp = std::chrono::steady_clock::now();
         }
 
@@ -221,12 +239,12 @@ namespace GenICamWrapper {
            case PixelFormat::BayerGB10Packed:
            case PixelFormat::BayerBG10Packed:
            {
-              // Mono10Packed: 4 pixel in 5 byte
-              size_t unpackedSize = width * height * sizeof(uint16_t);
-              std::unique_ptr<uint16_t[]> unpackedBuffer(new uint16_t[width * height]);
+              // Mono10Packed: 4 pixel in 5 byte, decompressi direttamente nel risultato
+              cvType = CV_16UC1;
+              resultMat.create(height, width, cvType);
 
               const uint8_t* srcPtr = buffer.get();
-              uint16_t* dstPtr = unpackedBuffer.get();
+              uint16_t* dstPtr = reinterpret_cast<uint16_t*>(resultMat.data);
 
               // Decompressione: ogni gruppo di 5 byte contiene 4 pixel da 10 bit
               for (size_t y = 0; y < height; ++y) {
@@ -264,8 +282,6 @@ namespace GenICamWrapper {
                  }
               }
 
-              cvType = CV_16UC1;
-              resultMat = cv::Mat(height, width, cvType, unpackedBuffer.get()).clone();
               break;
            }
 
@@ -275,12 +291,12 @@ namespace GenICamWrapper {
            case PixelFormat::BayerGB12Packed:
            case PixelFormat::BayerBG12Packed:
            {
-              // Mono12Packed: 2 pixel in 3 byte
-              size_t unpackedSize = width * height * sizeof(uint16_t);
-              std::unique_ptr<uint16_t[]> unpackedBuffer(new uint16_t[width * height]);
+              // Mono12Packed: 2 pixel in 3 byte, decompressi direttamente nel risultato
+              cvType = CV_16UC1;
+              resultMat.create(height, width, cvType);
 
               const uint8_t* srcPtr = buffer.get();
-              uint16_t* dstPtr = unpackedBuffer.get();
+              uint16_t* dstPtr = reinterpret_cast<uint16_t*>(resultMat.data);
 
               // Decompressione: ogni gruppo di 3 byte contiene 2 pixel da 12 bit
               for (size_t y = 0; y < height; ++y) {
@@ -314,8 +330,6 @@ namespace GenICamWrapper {
                  }
               }
 
-              cvType = CV_16UC1;
-              resultMat = cv::Mat(height, width, cvType, unpackedBuffer.get()).clone();
               break;
            }
 
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <vector>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief Copia dei contatori di un LatencyHistogram
+     *
+     * I bucket sono log-lineari in microsecondi: 4 sotto-bucket per ogni potenza
+     * di 2, quindi l'errore relativo di un percentile è al massimo del 25%.
+     */
+    struct LatencyHistogramSnapshot {
+        std::vector<uint64_t> buckets;
+        uint64_t count = 0;
+        uint64_t minUs = 0;
+        uint64_t maxUs = 0;
+        double meanUs = 0.0;
+
+        /**
+         * @brief Limite superiore del bucket che contiene il percentile richiesto
+         * @param percentile Valore in [0, 100]
+         */
+        uint64_t percentileUs(double percentile) const;
+    };
+
+    /**
+     * @brief Istogramma di latenze lock-free
+     *
+     * record() usa solo incrementi atomici relaxed: può essere chiamato dai thread
+     * dell'acquisizione senza influenzarne la temporizzazione. snapshot() può essere
+     * letto in qualsiasi momento da un altro thread.
+     */
+    class LatencyHistogram {
+    public:
+        static constexpr size_t SUB_BUCKETS = 4;
+        static constexpr size_t MAX_MSB = 32;       // ~71 minuti
+        static constexpr size_t BUCKET_COUNT = (MAX_MSB - 1) * SUB_BUCKETS + SUB_BUCKETS;
+
+        LatencyHistogram() {
+            reset();
+        }
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        void record(std::chrono::steady_clock::duration latency) {
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+            recordUs(us > 0 ? static_cast<uint64_t>(us) : 0);
+        }
+
+        void recordUs(uint64_t us) {
+            m_buckets[bucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            m_sumUs.fetch_add(us, std::memory_order_relaxed);
+
+            uint64_t current = m_minUs.load(std::memory_order_relaxed);
+            while (us < current && !m_minUs.compare_exchange_weak(current, us, std::memory_order_relaxed)) {
+            }
+            current = m_maxUs.load(std::memory_order_relaxed);
+            while (us > current && !m_maxUs.compare_exchange_weak(current, us, std::memory_order_relaxed)) {
+            }
+        }
+
+        void reset() {
+            for (auto& bucket : m_buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            m_count.store(0, std::memory_order_relaxed);
+            m_sumUs.store(0, std::memory_order_relaxed);
+            m_minUs.store(UINT64_MAX, std::memory_order_relaxed);
+            m_maxUs.store(0, std::memory_order_relaxed);
+        }
+
+        LatencyHistogramSnapshot snapshot() const {
+            LatencyHistogramSnapshot result;
+            result.buckets.resize(BUCKET_COUNT);
+            for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+                result.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+            }
+            result.count = m_count.load(std::memory_order_relaxed);
+            if (result.count > 0) {
+                result.minUs = m_minUs.load(std::memory_order_relaxed);
+                result.maxUs = m_maxUs.load(std::memory_order_relaxed);
+                result.meanUs = static_cast<double>(m_sumUs.load(std::memory_order_relaxed)) / result.count;
+            }
+            return result;
+        }
+
+        /**
+         * @brief Limite superiore (escluso) del bucket index, in microsecondi
+         */
+        static uint64_t bucketUpperBoundUs(size_t index) {
+            if (index < SUB_BUCKETS) {
+                return index + 1;
+            }
+            const size_t msb = index / SUB_BUCKETS + 1;
+            const size_t sub = index % SUB_BUCKETS;
+            return static_cast<uint64_t>(SUB_BUCKETS + sub + 1) << (msb - 2);
+        }
+
+    private:
+        static size_t bucketIndex(uint64_t us) {
+            if (us < SUB_BUCKETS) {
+                return static_cast<size_t>(us);
+            }
+            size_t msb = static_cast<size_t>(std::bit_width(us)) - 1;
+            if (msb >= MAX_MSB) {
+                return BUCKET_COUNT - 1;
+            }
+            const size_t sub = static_cast<size_t>(us >> (msb - 2)) & (SUB_BUCKETS - 1);
+            return (msb - 1) * SUB_BUCKETS + sub;
+        }
+
+        std::atomic<uint64_t> m_buckets[BUCKET_COUNT];
+        std::atomic<uint64_t> m_count{ 0 };
+        std::atomic<uint64_t> m_sumUs{ 0 };
+        std::atomic<uint64_t> m_minUs{ UINT64_MAX };
+        std::atomic<uint64_t> m_maxUs{ 0 };
+    };
+
+    inline uint64_t LatencyHistogramSnapshot::percentileUs(double percentile) const {
+        if (count == 0) {
+            return 0;
+        }
+
+        const double target = (percentile / 100.0) * static_cast<double>(count);
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            cumulative += buckets[i];
+            if (cumulative > 0 && static_cast<double>(cumulative) >= target) {
+                return LatencyHistogram::bucketUpperBoundUs(i);
+            }
+        }
+        return maxUs;
+    }
+
+} // namespace GenICamWrapper
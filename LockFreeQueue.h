@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <semaphore>
+#include <utility>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief Coda bounded MPMC lock-free (schema di D. Vyukov)
+     *
+     * Ogni cella ha un numero di sequenza che indica se è libera per il produttore
+     * o pronta per il consumatore: push e pop usano solo operazioni atomiche,
+     * senza mutex. La capacità viene arrotondata alla potenza di 2 successiva.
+     *
+     * Thread Safety: push e pop possono essere chiamati da più thread contemporaneamente.
+     */
+    template<typename T>
+    class BoundedMPMCQueue {
+    public:
+        explicit BoundedMPMCQueue(size_t capacity)
+            : m_capacity(roundUpToPowerOf2(capacity < 2 ? 2 : capacity))
+            , m_mask(m_capacity - 1)
+            , m_cells(new Cell[m_capacity]) {
+            for (size_t i = 0; i < m_capacity; ++i) {
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+        BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+        /**
+         * @brief Inserisce un elemento senza bloccare
+         * @return false se la coda è piena (value non viene modificato)
+         */
+        bool tryPush(T& value) {
+            Cell* cell;
+            size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+            for (;;) {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+                if (diff == 0) {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (diff < 0) {
+                    return false;   // Coda piena
+                }
+                else {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->data = std::move(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Estrae un elemento senza bloccare
+         * @return false se la coda è vuota
+         */
+        bool tryPop(T& value) {
+            Cell* cell;
+            size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+            for (;;) {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+                if (diff == 0) {
+                    if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (diff < 0) {
+                    return false;   // Coda vuota
+                }
+                else {
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            value = std::move(cell->data);
+            cell->data = T();
+            cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t capacity() const { return m_capacity; }
+
+        /**
+         * @brief Numero approssimato di elementi presenti (solo a scopo diagnostico)
+         */
+        size_t sizeApprox() const {
+            size_t enq = m_enqueuePos.load(std::memory_order_relaxed);
+            size_t deq = m_dequeuePos.load(std::memory_order_relaxed);
+            return enq >= deq ? enq - deq : 0;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        static size_t roundUpToPowerOf2(size_t v) {
+            size_t p = 1;
+            while (p < v) {
+                p <<= 1;
+            }
+            return p;
+        }
+
+        // Padding per evitare false sharing tra indici di produttori e consumatori
+        static constexpr size_t CACHE_LINE_SIZE = 64;
+
+        const size_t m_capacity;
+        const size_t m_mask;
+        std::unique_ptr<Cell[]> m_cells;
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePos{ 0 };
+        alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_dequeuePos{ 0 };
+    };
+
+    /**
+     * @brief Canale tra due stadi della pipeline di acquisizione
+     *
+     * Il trasferimento dei dati avviene sulla BoundedMPMCQueue lock-free; due
+     * semafori servono solo a sospendere i thread quando la coda è vuota (consumatori)
+     * o piena (produttori che scelgono di attendere).
+     */
+    template<typename T>
+    class PipelineChannel {
+    public:
+        explicit PipelineChannel(size_t capacity)
+            : m_queue(capacity)
+            , m_items(0)
+            , m_slots(static_cast<std::ptrdiff_t>(m_queue.capacity())) {
+        }
+
+        PipelineChannel(const PipelineChannel&) = delete;
+        PipelineChannel& operator=(const PipelineChannel&) = delete;
+
+        /**
+         * @brief Inserisce senza attendere
+         * @return false se il canale è pieno o chiuso
+         */
+        bool tryPush(T& value) {
+            if (m_closed.load(std::memory_order_acquire) || !m_slots.try_acquire()) {
+                return false;
+            }
+            if (!reserveAfterWait()) {
+                return false;
+            }
+            publish(value);
+            return true;
+        }
+
+        /**
+         * @brief Inserisce attendendo uno slot libero
+         * @return false se il canale viene chiuso durante l'attesa
+         */
+        bool push(T& value) {
+            if (m_closed.load(std::memory_order_acquire)) {
+                return false;
+            }
+            m_slots.acquire();
+            if (!reserveAfterWait()) {
+                return false;
+            }
+            publish(value);
+            return true;
+        }
+
+        /**
+         * @brief Inserisce attendendo al massimo timeout uno slot libero
+         * @return false se il canale è chiuso o resta pieno per tutto il timeout
+         */
+        template<typename Rep, typename Period>
+        bool tryPushFor(T& value, const std::chrono::duration<Rep, Period>& timeout) {
+            if (m_closed.load(std::memory_order_acquire) || !m_slots.try_acquire_for(timeout)) {
+                return false;
+            }
+            if (!reserveAfterWait()) {
+                return false;
+            }
+            publish(value);
+            return true;
+        }
+
+        /**
+         * @brief Estrae un elemento senza attendere
+         * @return false se il canale è vuoto o chiuso
+         * @note Usato dal produttore per scartare gli elementi più vecchi
+         */
+        bool tryPop(T& value) {
+            if (m_closed.load(std::memory_order_acquire) || !m_items.try_acquire()) {
+                return false;
+            }
+            while (!m_queue.tryPop(value)) {
+                std::this_thread::yield();
+            }
+            m_slots.release();
+            return true;
+        }
+
+        /**
+         * @brief Estrae un elemento attendendo se il canale è vuoto
+         * @return false quando il canale è chiuso e completamente svuotato
+         */
+        bool pop(T& value) {
+            m_items.acquire();
+
+            // Il token può precedere di poco la pubblicazione della cella da parte
+            // di un altro produttore: attendi attivamente solo in quel caso
+            while (!m_queue.tryPop(value)) {
+                if (m_closed.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                std::this_thread::yield();
+            }
+
+            m_slots.release();
+            return true;
+        }
+
+        /**
+         * @brief Chiude il canale e risveglia consumatori e produttori
+         * @param consumers Numero di consumatori in attesa su pop()
+         * @note Gli elementi già presenti restano estraibili. Per i produttori basta
+         *       un token: ciascuno lo ripassa al successivo (vedi reserveAfterWait)
+         */
+        void close(size_t consumers) {
+            m_closed.store(true, std::memory_order_release);
+            m_items.release(static_cast<std::ptrdiff_t>(consumers));
+            m_slots.release();
+        }
+
+        size_t capacity() const { return m_queue.capacity(); }
+        size_t sizeApprox() const { return m_queue.sizeApprox(); }
+
+    private:
+        /**
+         * @brief Verifica, dopo aver ottenuto uno slot, che il canale sia ancora aperto
+         * @return false se il token proviene da close(): viene restituito per
+         *         risvegliare il prossimo produttore in attesa
+         */
+        bool reserveAfterWait() {
+            if (m_closed.load(std::memory_order_acquire)) {
+                m_slots.release();
+                return false;
+            }
+            return true;
+        }
+
+        void publish(T& value) {
+            // Lo slot è già riservato dal semaforo: tryPush non può fallire
+            while (!m_queue.tryPush(value)) {
+                std::this_thread::yield();
+            }
+            m_items.release();
+        }
+
+        BoundedMPMCQueue<T> m_queue;
+        std::counting_semaphore<> m_items;
+        std::counting_semaphore<> m_slots;
+        std::atomic<bool> m_closed{ false };
+    };
+
+} // namespace GenICamWrapper
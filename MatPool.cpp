@@ -0,0 +1,252 @@
+#include "MatPool.h"
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief MatAllocator con lista di buffer liberi per (dimensione in byte, tipo)
+     *
+     * Sul modello di cv::StdMatAllocator; deallocate() non libera la memoria ma la
+     * rimette nella lista corrispondente. Dopo close() i buffer restituiti vengono
+     * liberati e l'ultimo distrugge l'allocatore.
+     */
+    class MatPool::Allocator : public cv::MatAllocator {
+    public:
+        explicit Allocator(size_t maxCachedBytes)
+            : m_maxCachedBytes(maxCachedBytes) {
+        }
+
+        cv::UMatData* allocate(int dims, const int* sizes, int type, void* data0,
+            size_t* step, cv::AccessFlag, cv::UMatUsageFlags) const override {
+            size_t total = CV_ELEM_SIZE(type);
+            for (int i = dims - 1; i >= 0; i--) {
+                if (step) {
+                    if (data0 && step[i] != CV_AUTOSTEP) {
+                        CV_Assert(total <= step[i]);
+                        total = step[i];
+                    }
+                    else {
+                        step[i] = total;
+                    }
+                }
+                total *= sizes[i];
+            }
+
+            uchar* data = static_cast<uchar*>(data0);
+            if (!data) {
+                data = take(total, type);
+            }
+
+            cv::UMatData* u = new cv::UMatData(this);
+            u->data = u->origdata = data;
+            u->size = total;
+            if (data0) {
+                u->flags |= cv::UMatData::USER_ALLOCATED;
+            }
+            else {
+                // Il tipo serve a deallocate() per ritrovare la lista del buffer
+                u->userdata = reinterpret_cast<void*>(static_cast<intptr_t>(type));
+            }
+            return u;
+        }
+
+        bool allocate(cv::UMatData* u, cv::AccessFlag, cv::UMatUsageFlags) const override {
+            return u != nullptr;
+        }
+
+        void deallocate(cv::UMatData* u) const override {
+            if (!u) {
+                return;
+            }
+            CV_Assert(u->urefcount == 0);
+            CV_Assert(u->refcount == 0);
+
+            if (!(u->flags & cv::UMatData::USER_ALLOCATED)) {
+                give(u->origdata, u->size, static_cast<int>(reinterpret_cast<intptr_t>(u->userdata)));
+                u->origdata = nullptr;
+            }
+            delete u;
+        }
+
+        void setMaxCachedBytes(size_t maxCachedBytes) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_maxCachedBytes = maxCachedBytes;
+            evictLocked(Key{ 0, -1 });
+        }
+
+        void trim() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            freeCachedLocked();
+        }
+
+        MatPoolStatistics statistics() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            MatPoolStatistics stats;
+            stats.allocations = m_allocations;
+            stats.reuses = m_reuses;
+            stats.evictions = m_evictions;
+            stats.outstandingBuffers = m_outstanding;
+            stats.cachedBytes = m_cachedBytes;
+            for (const auto& entry : m_free) {
+                stats.cachedBuffers += entry.second.size();
+            }
+            return stats;
+        }
+
+        void resetCounters() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_allocations = 0;
+            m_reuses = 0;
+            m_evictions = 0;
+        }
+
+        // Chiamato dal MatPool distrutto: l'allocatore vive finché ci sono buffer in uso
+        void close() {
+            bool destroy = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                freeCachedLocked();
+                m_closed = true;
+                destroy = (m_outstanding == 0);
+            }
+            if (destroy) {
+                delete this;
+            }
+        }
+
+    private:
+        using Key = std::pair<size_t, int>;     // (bytes, tipo OpenCV)
+
+        uchar* take(size_t size, int type) const {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_outstanding;
+
+                auto it = m_free.find(Key{ size, type });
+                if (it != m_free.end() && !it->second.empty()) {
+                    uchar* data = it->second.back();
+                    it->second.pop_back();
+                    m_cachedBytes -= size;
+                    ++m_reuses;
+                    return data;
+                }
+                ++m_allocations;
+            }
+
+            try {
+                return static_cast<uchar*>(cv::fastMalloc(size));
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_outstanding;
+                throw;
+            }
+        }
+
+        void give(uchar* data, size_t size, int type) const {
+            bool destroy = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_outstanding;
+
+                if (m_closed) {
+                    cv::fastFree(data);
+                    destroy = (m_outstanding == 0);
+                }
+                else {
+                    const Key key{ size, type };
+                    m_free[key].push_back(data);
+                    m_cachedBytes += size;
+                    evictLocked(key);
+                }
+            }
+            if (destroy) {
+                delete this;
+            }
+        }
+
+        // Libera prima i buffer delle altre chiavi (es. ROI o formato precedenti),
+        // poi quelli della chiave appena restituita
+        void evictLocked(const Key& keep) const {
+            for (auto it = m_free.begin(); it != m_free.end() && m_cachedBytes > m_maxCachedBytes; ++it) {
+                if (it->first == keep) {
+                    continue;
+                }
+                while (!it->second.empty() && m_cachedBytes > m_maxCachedBytes) {
+                    cv::fastFree(it->second.back());
+                    it->second.pop_back();
+                    m_cachedBytes -= it->first.first;
+                    ++m_evictions;
+                }
+            }
+
+            auto it = m_free.find(keep);
+            while (it != m_free.end() && !it->second.empty() && m_cachedBytes > m_maxCachedBytes) {
+                cv::fastFree(it->second.back());
+                it->second.pop_back();
+                m_cachedBytes -= keep.first;
+                ++m_evictions;
+            }
+        }
+
+        void freeCachedLocked() const {
+            for (auto& entry : m_free) {
+                for (uchar* data : entry.second) {
+                    cv::fastFree(data);
+                }
+            }
+            m_free.clear();
+            m_cachedBytes = 0;
+        }
+
+        mutable std::mutex m_mutex;
+        mutable std::map<Key, std::vector<uchar*>> m_free;
+        mutable size_t m_cachedBytes = 0;
+        mutable size_t m_outstanding = 0;
+        mutable uint64_t m_allocations = 0;
+        mutable uint64_t m_reuses = 0;
+        mutable uint64_t m_evictions = 0;
+        size_t m_maxCachedBytes;
+        bool m_closed = false;
+    };
+
+    MatPool::MatPool(size_t maxCachedBytes)
+        : m_allocator(new Allocator(maxCachedBytes)) {
+    }
+
+    MatPool::~MatPool() {
+        m_allocator->close();
+    }
+
+    cv::Mat MatPool::create(int rows, int cols, int type) {
+        cv::Mat mat;
+        mat.allocator = m_allocator;
+        mat.create(rows, cols, type);
+
+        // Il rilascio torna al pool tramite UMatData::currAllocator: il puntatore nel
+        // cv::Mat verrebbe copiato in ogni Mat derivato e usato per le sue allocazioni
+        // successive, anche dopo la distruzione dell'allocatore
+        mat.allocator = nullptr;
+        return mat;
+    }
+
+    void MatPool::setMaxCachedBytes(size_t maxCachedBytes) {
+        m_allocator->setMaxCachedBytes(maxCachedBytes);
+    }
+
+    void MatPool::trim() {
+        m_allocator->trim();
+    }
+
+    MatPoolStatistics MatPool::statistics() const {
+        return m_allocator->statistics();
+    }
+
+    void MatPool::resetCounters() {
+        m_allocator->resetCounters();
+    }
+
+} // namespace GenICamWrapper
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief Stato di un MatPool
+     */
+    struct MatPoolStatistics {
+        uint64_t allocations = 0;       // Memoria nuova richiesta al sistema
+        uint64_t reuses = 0;            // Richieste servite da un buffer restituito
+        uint64_t evictions = 0;         // Buffer liberati per rispettare maxCachedBytes
+        size_t outstandingBuffers = 0;  // Buffer ancora referenziati da qualche cv::Mat
+        size_t cachedBuffers = 0;       // Buffer liberi pronti per il riuso
+        size_t cachedBytes = 0;
+    };
+
+    /**
+     * @brief Pool di buffer per i cv::Mat prodotti dalla conversione dei frame
+     *
+     * I cv::Mat creati con create() usano un MatAllocator dedicato: quando viene
+     * rilasciato l'ultimo riferimento (anche da parte del consumatore del frame)
+     * la memoria torna nel pool, raggruppata per dimensione e tipo, invece di essere
+     * liberata. A regime la conversione non alloca più memoria.
+     *
+     * Thread Safety: create() e il rilascio dei cv::Mat possono avvenire da qualsiasi
+     * thread. I cv::Mat possono sopravvivere al MatPool: l'allocatore viene distrutto
+     * alla restituzione dell'ultimo buffer.
+     */
+    class MatPool {
+    public:
+        explicit MatPool(size_t maxCachedBytes = 256 * 1024 * 1024);
+        ~MatPool();
+
+        MatPool(const MatPool&) = delete;
+        MatPool& operator=(const MatPool&) = delete;
+
+        /**
+         * @brief cv::Mat continuo rows x cols di tipo type, con memoria del pool
+         * @note Il contenuto di un buffer riutilizzato non è azzerato
+         */
+        cv::Mat create(int rows, int cols, int type);
+
+        /**
+         * @brief Limite della memoria libera trattenuta (i buffer in uso non contano)
+         */
+        void setMaxCachedBytes(size_t maxCachedBytes);
+
+        /**
+         * @brief Libera i buffer non in uso
+         */
+        void trim();
+
+        MatPoolStatistics statistics() const;
+        void resetCounters();
+
+    private:
+        class Allocator;
+        Allocator* m_allocator;
+    };
+
+} // namespace GenICamWrapper
@@ -0,0 +1,125 @@
+#include "MemoryUtils.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/resource.h>
+#endif
+
+namespace GenICamWrapper {
+
+    namespace {
+        // Scrittura dello stesso valore: forza il fault in scrittura (una lettura
+        // su memoria anonima mapperebbe solo la pagina zero condivisa)
+        void touchPages(void* ptr, size_t size, size_t pageSize) {
+            volatile uint8_t* bytes = static_cast<volatile uint8_t*>(ptr);
+            for (size_t offset = 0; offset < size; offset += pageSize) {
+                bytes[offset] = bytes[offset];
+            }
+            if (size > 0) {
+                bytes[size - 1] = bytes[size - 1];
+            }
+        }
+    }
+
+#ifdef _WIN32
+
+    size_t MemoryUtils::getPageSize() {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwPageSize;
+    }
+
+    void MemoryUtils::prefault(void* ptr, size_t size) {
+        touchPages(ptr, size, getPageSize());
+    }
+
+    bool MemoryUtils::lock(void* ptr, size_t size, std::string& error) {
+        if (VirtualLock(ptr, size)) {
+            return true;
+        }
+
+        // VirtualLock è limitato dal working set minimo del processo: lo si allarga e si riprova
+        SIZE_T minimumSize = 0;
+        SIZE_T maximumSize = 0;
+        HANDLE process = GetCurrentProcess();
+        if (GetProcessWorkingSetSize(process, &minimumSize, &maximumSize) &&
+            SetProcessWorkingSetSize(process, minimumSize + size, maximumSize + size) &&
+            VirtualLock(ptr, size)) {
+            return true;
+        }
+
+        error = "VirtualLock fallita (errore " + std::to_string(GetLastError()) + ")";
+        return false;
+    }
+
+    void MemoryUtils::unlock(void* ptr, size_t size) {
+        VirtualUnlock(ptr, size);
+    }
+
+#elif defined(__linux__)
+
+    size_t MemoryUtils::getPageSize() {
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        return pageSize > 0 ? static_cast<size_t>(pageSize) : 4096;
+    }
+
+    void MemoryUtils::prefault(void* ptr, size_t size) {
+        const size_t pageSize = getPageSize();
+
+#ifdef MADV_POPULATE_WRITE
+        // Linux 5.14+: il kernel mappa tutte le pagine con una sola chiamata
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr) & ~(pageSize - 1);
+        const uintptr_t end = reinterpret_cast<uintptr_t>(ptr) + size;
+        if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_POPULATE_WRITE) == 0) {
+            return;
+        }
+#endif
+        touchPages(ptr, size, pageSize);
+    }
+
+    bool MemoryUtils::lock(void* ptr, size_t size, std::string& error) {
+        if (mlock(ptr, size) == 0) {
+            return true;
+        }
+
+        error = std::string("mlock: ") + std::strerror(errno);
+        if (errno == ENOMEM || errno == EPERM) {
+            rlimit limit{};
+            if (getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+                error += " (RLIMIT_MEMLOCK " + std::to_string(limit.rlim_cur) + " bytes; servono ulimit -l o CAP_IPC_LOCK)";
+            }
+        }
+        return false;
+    }
+
+    void MemoryUtils::unlock(void* ptr, size_t size) {
+        munlock(ptr, size);
+    }
+
+#else
+
+    size_t MemoryUtils::getPageSize() {
+        return 4096;
+    }
+
+    void MemoryUtils::prefault(void* ptr, size_t size) {
+        touchPages(ptr, size, getPageSize());
+    }
+
+    bool MemoryUtils::lock(void*, size_t, std::string& error) {
+        error = "Blocco della memoria non supportato su questa piattaforma";
+        return false;
+    }
+
+    void MemoryUtils::unlock(void*, size_t) {
+    }
+
+#endif
+
+} // namespace GenICamWrapper
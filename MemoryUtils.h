@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief Residenza in memoria fisica dei buffer (Linux e Windows)
+     *
+     * Le pagine di un buffer appena allocato vengono mappate al primo accesso: se
+     * questo avviene durante l'acquisizione i primi frame pagano i page fault.
+     * prefault tocca le pagine in anticipo, lock le blocca in RAM (niente swap).
+     */
+    class MemoryUtils {
+    public:
+        /**
+         * @brief Dimensione della pagina standard del sistema
+         */
+        static size_t getPageSize();
+
+        /**
+         * @brief Mappa in anticipo tutte le pagine del range, senza modificarne il contenuto
+         */
+        static void prefault(void* ptr, size_t size);
+
+        /**
+         * @brief Blocca il range in memoria fisica (mlock / VirtualLock)
+         * @param error Motivo dell'eventuale fallimento (es. limite RLIMIT_MEMLOCK)
+         * @note Le pagine bloccate sono anche residenti: non serve un prefault separato
+         */
+        static bool lock(void* ptr, size_t size, std::string& error);
+
+        static void unlock(void* ptr, size_t size);
+    };
+
+} // namespace GenICamWrapper
@@ -0,0 +1,231 @@
+#include "NumaUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <dirent.h>
+    #include <unistd.h>
+    #include <sys/syscall.h>
+    #include <linux/mempolicy.h>
+#endif
+
+namespace GenICamWrapper {
+
+#ifdef _WIN32
+
+    int NumaUtils::getNodeCount() {
+        ULONG highestNode = 0;
+        if (!GetNumaHighestNodeNumber(&highestNode)) {
+            return 1;
+        }
+        return static_cast<int>(highestNode) + 1;
+    }
+
+    std::vector<int> NumaUtils::getNodeCpus(int node) {
+        std::vector<int> cpus;
+        GROUP_AFFINITY affinity = {};
+        if (node < 0 || !GetNumaNodeProcessorMaskEx(static_cast<USHORT>(node), &affinity)) {
+            return cpus;
+        }
+
+        // Solo il gruppo di processori del nodo (max 64 CPU), come SetThreadAffinityMask
+        for (int cpu = 0; cpu < static_cast<int>(sizeof(KAFFINITY) * 8); ++cpu) {
+            if (affinity.Mask & (static_cast<KAFFINITY>(1) << cpu)) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+
+    int NumaUtils::findDeviceNode(const std::string&) {
+        return -1;
+    }
+
+    bool NumaUtils::bindMemory(void*, size_t, int, std::string& error) {
+        error = "mbind non disponibile su Windows: usare VirtualAllocExNuma";
+        return false;
+    }
+
+#elif defined(__linux__)
+
+    namespace {
+        std::string readFirstLine(const std::string& path) {
+            std::ifstream file(path);
+            std::string line;
+            std::getline(file, line);
+            return line;
+        }
+
+        std::vector<std::string> listDirectory(const std::string& path) {
+            std::vector<std::string> entries;
+            DIR* dir = opendir(path.c_str());
+            if (!dir) {
+                return entries;
+            }
+            while (dirent* entry = readdir(dir)) {
+                if (entry->d_name[0] != '.') {
+                    entries.push_back(entry->d_name);
+                }
+            }
+            closedir(dir);
+            return entries;
+        }
+
+        std::string toLowerHex(const std::string& text) {
+            // MAC senza separatori, per confrontare 00:11:22... con 00-11-22... o 001122...
+            std::string result;
+            for (char c : text) {
+                if (std::isxdigit(static_cast<unsigned char>(c))) {
+                    result += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+                }
+            }
+            return result;
+        }
+
+        int readNumaNode(const std::string& path) {
+            const std::string value = readFirstLine(path);
+            if (value.empty()) {
+                return -1;
+            }
+            try {
+                return std::stoi(value);    // -1 se il firmware non riporta la località
+            }
+            catch (...) {
+                return -1;
+            }
+        }
+
+        bool containsToken(const std::string& text, const std::string& token) {
+            // Evita che "eth1" corrisponda a "eth10"
+            size_t pos = text.find(token);
+            while (pos != std::string::npos) {
+                const size_t end = pos + token.size();
+                const bool startOk = pos == 0 || !std::isalnum(static_cast<unsigned char>(text[pos - 1]));
+                const bool endOk = end == text.size() || !std::isalnum(static_cast<unsigned char>(text[end]));
+                if (startOk && endOk) {
+                    return true;
+                }
+                pos = text.find(token, pos + 1);
+            }
+            return false;
+        }
+    }
+
+    int NumaUtils::getNodeCount() {
+        int count = 0;
+        for (const auto& entry : listDirectory("/sys/devices/system/node")) {
+            if (entry.rfind("node", 0) == 0 && entry.size() > 4 && std::isdigit(static_cast<unsigned char>(entry[4]))) {
+                ++count;
+            }
+        }
+        return count > 0 ? count : 1;
+    }
+
+    std::vector<int> NumaUtils::getNodeCpus(int node) {
+        std::vector<int> cpus;
+        if (node < 0) {
+            return cpus;
+        }
+
+        // Formato cpulist: "0-15,32-47"
+        std::stringstream ranges(readFirstLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+        std::string range;
+        while (std::getline(ranges, range, ',')) {
+            try {
+                const size_t dash = range.find('-');
+                const int first = std::stoi(range.substr(0, dash));
+                const int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+            catch (...) {
+                // Voce non valida: ignorata
+            }
+        }
+        return cpus;
+    }
+
+    int NumaUtils::findDeviceNode(const std::string& identifier) {
+        if (identifier.empty()) {
+            return -1;
+        }
+
+        const std::string identifierHex = toLowerHex(identifier);
+
+        // Interfacce di rete (GigE Vision): per nome o per indirizzo MAC
+        for (const auto& name : listDirectory("/sys/class/net")) {
+            const std::string base = "/sys/class/net/" + name;
+            const std::string mac = toLowerHex(readFirstLine(base + "/address"));
+            const bool nameMatch = containsToken(identifier, name);
+            const bool macMatch = mac.size() == 12 && mac != "000000000000" && identifierHex.find(mac) != std::string::npos;
+            if (nameMatch || macMatch) {
+                const int node = readNumaNode(base + "/device/numa_node");
+                if (node >= 0) {
+                    return node;
+                }
+            }
+        }
+
+        // Dispositivi PCIe (frame grabber, controller USB3) citati per indirizzo
+        for (const auto& address : listDirectory("/sys/bus/pci/devices")) {
+            const std::string shortAddress = address.size() > 5 ? address.substr(5) : address;    // senza dominio
+            if (identifier.find(address) != std::string::npos || containsToken(identifier, shortAddress)) {
+                const int node = readNumaNode("/sys/bus/pci/devices/" + address + "/numa_node");
+                if (node >= 0) {
+                    return node;
+                }
+            }
+        }
+
+        return -1;
+    }
+
+    bool NumaUtils::bindMemory(void* ptr, size_t size, int node, std::string& error) {
+        constexpr size_t MAX_NODES = 1024;
+        constexpr size_t BITS_PER_WORD = sizeof(unsigned long) * 8;
+        if (node < 0 || static_cast<size_t>(node) >= MAX_NODES) {
+            error = "Nodo NUMA non valido";
+            return false;
+        }
+
+        unsigned long nodeMask[MAX_NODES / BITS_PER_WORD] = {};
+        nodeMask[node / BITS_PER_WORD] = 1UL << (node % BITS_PER_WORD);
+
+        // MPOL_PREFERRED: se il nodo esaurisce la memoria il kernel ripiega su un altro
+        // nodo invece di generare un SIGBUS al primo accesso alla pagina
+        if (syscall(SYS_mbind, ptr, size, MPOL_PREFERRED, nodeMask, MAX_NODES + 1, 0) != 0) {
+            error = std::string("mbind: ") + std::strerror(errno);
+            return false;
+        }
+        return true;
+    }
+
+#else
+
+    int NumaUtils::getNodeCount() {
+        return 1;
+    }
+
+    std::vector<int> NumaUtils::getNodeCpus(int) {
+        return {};
+    }
+
+    int NumaUtils::findDeviceNode(const std::string&) {
+        return -1;
+    }
+
+    bool NumaUtils::bindMemory(void*, size_t, int, std::string& error) {
+        error = "NUMA non supportato su questa piattaforma";
+        return false;
+    }
+
+#endif
+
+} // namespace GenICamWrapper
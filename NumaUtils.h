@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief Topologia NUMA e binding della memoria (Linux e Windows)
+     *
+     * Su Linux la topologia è letta da sysfs e il binding usa la system call mbind,
+     * senza dipendenze da libnuma. Su Windows la memoria viene allocata direttamente
+     * sul nodo con VirtualAllocExNuma (vedi BufferPool).
+     */
+    class NumaUtils {
+    public:
+        /**
+         * @brief Numero di nodi NUMA (1 su sistemi non NUMA)
+         */
+        static int getNodeCount();
+
+        /**
+         * @brief CPU logiche del nodo; vuoto se il nodo non esiste
+         */
+        static std::vector<int> getNodeCpus(int node);
+
+        /**
+         * @brief Nodo a cui è collegato il dispositivo identificato dalla stringa
+         * @param identifier ID o nome dell'interfaccia GenTL: viene cercato il nome di
+         *        un'interfaccia di rete, il suo indirizzo MAC o un indirizzo PCI (es. 0000:3b:00.0)
+         * @return Nodo NUMA, -1 se non determinabile
+         */
+        static int findDeviceNode(const std::string& identifier);
+
+        /**
+         * @brief Preferisce il nodo per le pagine del range (da chiamare prima di toccarle)
+         * @param ptr Indirizzo allineato alla pagina
+         * @param error Motivo dell'eventuale fallimento
+         */
+        static bool bindMemory(void* ptr, size_t size, int node, std::string& error);
+    };
+
+} // namespace GenICamWrapper
@@ -0,0 +1,356 @@
+#include "SharedFrameRing.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+namespace GenICamWrapper {
+
+    namespace {
+        constexpr uint32_t RING_MAGIC = 0x47524E47;     // "GNRG"
+        constexpr uint32_t RING_VERSION = 1;
+        constexpr size_t CACHE_LINE = 64;
+
+        static_assert(std::atomic<uint64_t>::is_always_lock_free,
+            "I contatori in memoria condivisa richiedono atomici a 64 bit lock-free");
+
+        // Layout del segmento: intestazione, poi slotCount slot di slotStride bytes
+        // (intestazione dello slot seguita dai dati)
+        struct alignas(CACHE_LINE) RingHeader {
+            std::atomic<uint32_t> magic;                // Scritto per ultimo alla creazione
+            uint32_t version;
+            uint64_t slotCount;
+            uint64_t slotCapacity;
+            uint64_t slotStride;
+            alignas(CACHE_LINE) std::atomic<uint64_t> published;
+        };
+
+        struct alignas(CACHE_LINE) SlotHeader {
+            std::atomic<uint64_t> seqlock;              // Dispari durante la scrittura
+            SharedFrameMetadata metadata;
+        };
+
+        constexpr size_t roundUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        constexpr size_t DATA_OFFSET = roundUp(sizeof(SlotHeader), CACHE_LINE);
+
+        RingHeader* ringHeader(void* base) {
+            return static_cast<RingHeader*>(base);
+        }
+
+        const RingHeader* ringHeader(const void* base) {
+            return static_cast<const RingHeader*>(base);
+        }
+
+        uint8_t* slotAt(void* base, size_t index, size_t slotStride) {
+            return static_cast<uint8_t*>(base) + sizeof(RingHeader) + index * slotStride;
+        }
+
+        const uint8_t* slotAt(const void* base, size_t index, size_t slotStride) {
+            return static_cast<const uint8_t*>(base) + sizeof(RingHeader) + index * slotStride;
+        }
+
+#ifdef _WIN32
+        std::string mappingName(const std::string& name) {
+            return "Local\\" + name;
+        }
+#else
+        std::string mappingName(const std::string& name) {
+            return "/" + name;
+        }
+#endif
+    }
+
+    // === Writer ===
+
+    SharedFrameRingWriter::~SharedFrameRingWriter() {
+        close();
+    }
+
+    bool SharedFrameRingWriter::create(const std::string& name, size_t slotCount, size_t slotCapacity, std::string& error) {
+        close();
+
+        if (name.empty() || name.find('/') != std::string::npos || slotCount == 0 || slotCapacity == 0) {
+            error = "Nome, numero di slot o capacità dell'anello non validi";
+            return false;
+        }
+
+        const size_t slotStride = roundUp(DATA_OFFSET + slotCapacity, CACHE_LINE);
+        const size_t mappedSize = sizeof(RingHeader) + slotCount * slotStride;
+        const std::string path = mappingName(name);
+
+#ifdef _WIN32
+        HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(mappedSize) >> 32), static_cast<DWORD>(mappedSize & 0xFFFFFFFF), path.c_str());
+        if (!mapping) {
+            error = "CreateFileMapping fallita (errore " + std::to_string(GetLastError()) + ")";
+            return false;
+        }
+        if (GetLastError() == ERROR_ALREADY_EXISTS) {
+            CloseHandle(mapping);
+            error = "Anello " + name + " già aperto da un altro writer";
+            return false;
+        }
+
+        void* base = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, mappedSize);
+        if (!base) {
+            error = "MapViewOfFile fallita (errore " + std::to_string(GetLastError()) + ")";
+            CloseHandle(mapping);
+            return false;
+        }
+        m_mappingHandle = mapping;
+#else
+        // Segmento rimasto da un writer terminato in modo anomalo
+        shm_unlink(path.c_str());
+
+        int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            error = std::string("shm_open: ") + std::strerror(errno);
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(mappedSize)) != 0) {
+            error = std::string("ftruncate: ") + std::strerror(errno);
+            ::close(fd);
+            shm_unlink(path.c_str());
+            return false;
+        }
+
+        void* base = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            error = std::string("mmap: ") + std::strerror(errno);
+            shm_unlink(path.c_str());
+            return false;
+        }
+#endif
+
+        // La memoria nuova è azzerata: seqlock pari e nessun frame pubblicato
+        RingHeader* header = ringHeader(base);
+        header->version = RING_VERSION;
+        header->slotCount = slotCount;
+        header->slotCapacity = slotCapacity;
+        header->slotStride = slotStride;
+        header->published.store(0, std::memory_order_relaxed);
+        header->magic.store(RING_MAGIC, std::memory_order_release);
+
+        m_name = name;
+        m_base = base;
+        m_mappedSize = mappedSize;
+        m_slotCount = slotCount;
+        m_slotCapacity = slotCapacity;
+        return true;
+    }
+
+    void SharedFrameRingWriter::close() {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+        if (!m_base) {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(m_base);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        m_mappingHandle = nullptr;
+#else
+        munmap(m_base, m_mappedSize);
+        shm_unlink(mappingName(m_name).c_str());
+#endif
+        m_base = nullptr;
+        m_mappedSize = 0;
+        m_slotCount = 0;
+        m_slotCapacity = 0;
+        m_name.clear();
+    }
+
+    bool SharedFrameRingWriter::publish(const SharedFrameMetadata& metadata, const void* data,
+        size_t rowBytes, size_t rows, size_t sourceStride) {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+
+        const size_t dataSize = rowBytes * rows;
+        if (!m_base || dataSize > m_slotCapacity) {
+            return false;
+        }
+
+        RingHeader* header = ringHeader(m_base);
+        const uint64_t sequence = header->published.load(std::memory_order_relaxed);
+        uint8_t* slot = slotAt(m_base, static_cast<size_t>(sequence % m_slotCount), static_cast<size_t>(header->slotStride));
+        SlotHeader* slotHeader = reinterpret_cast<SlotHeader*>(slot);
+
+        // Apertura del seqlock: i reader che leggono ora vedranno un valore diverso
+        const uint64_t version = slotHeader->seqlock.load(std::memory_order_relaxed);
+        slotHeader->seqlock.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        SharedFrameMetadata stored = metadata;
+        stored.sequence = sequence;
+        stored.dataSize = dataSize;
+        stored.stride = rowBytes;
+        std::memcpy(&slotHeader->metadata, &stored, sizeof(stored));
+
+        uint8_t* target = slot + DATA_OFFSET;
+        const uint8_t* source = static_cast<const uint8_t*>(data);
+        if (sourceStride == rowBytes) {
+            std::memcpy(target, source, dataSize);
+        }
+        else {
+            for (size_t row = 0; row < rows; ++row) {
+                std::memcpy(target + row * rowBytes, source + row * sourceStride, rowBytes);
+            }
+        }
+
+        slotHeader->seqlock.store(version + 2, std::memory_order_release);
+        header->published.store(sequence + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t SharedFrameRingWriter::publishedCount() const {
+        return m_base ? ringHeader(static_cast<const void*>(m_base))->published.load(std::memory_order_acquire) : 0;
+    }
+
+    // === Reader ===
+
+    SharedFrameRingReader::~SharedFrameRingReader() {
+        detach();
+    }
+
+    bool SharedFrameRingReader::attach(const std::string& name, std::string& error) {
+        detach();
+        const std::string path = mappingName(name);
+
+#ifdef _WIN32
+        HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, path.c_str());
+        if (!mapping) {
+            error = "OpenFileMapping fallita (errore " + std::to_string(GetLastError()) + ")";
+            return false;
+        }
+
+        const void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!base) {
+            error = "MapViewOfFile fallita (errore " + std::to_string(GetLastError()) + ")";
+            CloseHandle(mapping);
+            return false;
+        }
+
+        MEMORY_BASIC_INFORMATION info = {};
+        VirtualQuery(base, &info, sizeof(info));
+        const size_t mappedSize = info.RegionSize;
+        m_mappingHandle = mapping;
+#else
+        int fd = shm_open(path.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            error = std::string("shm_open: ") + std::strerror(errno);
+            return false;
+        }
+
+        struct stat status = {};
+        if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(RingHeader)) {
+            error = "Segmento dell'anello non valido";
+            ::close(fd);
+            return false;
+        }
+        const size_t mappedSize = static_cast<size_t>(status.st_size);
+
+        const void* base = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            error = std::string("mmap: ") + std::strerror(errno);
+            return false;
+        }
+#endif
+
+        m_base = base;
+        m_mappedSize = mappedSize;
+
+        const RingHeader* header = ringHeader(base);
+        if (header->magic.load(std::memory_order_acquire) != RING_MAGIC || header->version != RING_VERSION ||
+            sizeof(RingHeader) + header->slotCount * header->slotStride > mappedSize) {
+            error = "Anello non inizializzato o di versione diversa";
+            detach();
+            return false;
+        }
+
+        m_slotCount = static_cast<size_t>(header->slotCount);
+        m_slotCapacity = static_cast<size_t>(header->slotCapacity);
+        return true;
+    }
+
+    void SharedFrameRingReader::detach() {
+        if (!m_base) {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(m_base);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        m_mappingHandle = nullptr;
+#else
+        munmap(const_cast<void*>(m_base), m_mappedSize);
+#endif
+        m_base = nullptr;
+        m_mappedSize = 0;
+        m_slotCount = 0;
+        m_slotCapacity = 0;
+    }
+
+    uint64_t SharedFrameRingReader::publishedCount() const {
+        return m_base ? ringHeader(m_base)->published.load(std::memory_order_acquire) : 0;
+    }
+
+    SharedFrameReadStatus SharedFrameRingReader::read(uint64_t sequence, SharedFrameMetadata& metadata, std::vector<uint8_t>& data) const {
+        if (!m_base) {
+            return SharedFrameReadStatus::NotAvailable;
+        }
+
+        const RingHeader* header = ringHeader(m_base);
+        const uint64_t published = header->published.load(std::memory_order_acquire);
+        if (sequence >= published) {
+            return SharedFrameReadStatus::NotAvailable;
+        }
+        // Lo slot del frame è già stato riassegnato (o lo sta per essere dal writer)
+        if (sequence + m_slotCount <= published) {
+            return SharedFrameReadStatus::Overwritten;
+        }
+
+        const uint8_t* slot = slotAt(m_base, static_cast<size_t>(sequence % m_slotCount), static_cast<size_t>(header->slotStride));
+        const SlotHeader* slotHeader = reinterpret_cast<const SlotHeader*>(slot);
+
+        const uint64_t before = slotHeader->seqlock.load(std::memory_order_acquire);
+        if (before & 1) {
+            return SharedFrameReadStatus::Overwritten;
+        }
+
+        std::memcpy(&metadata, &slotHeader->metadata, sizeof(metadata));
+        if (metadata.sequence != sequence || metadata.dataSize > m_slotCapacity) {
+            return SharedFrameReadStatus::Overwritten;
+        }
+
+        data.resize(static_cast<size_t>(metadata.dataSize));
+        std::memcpy(data.data(), slot + DATA_OFFSET, data.size());
+
+        // Il seqlock invariato garantisce che metadati e dati copiati siano coerenti
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slotHeader->seqlock.load(std::memory_order_relaxed) != before) {
+            return SharedFrameReadStatus::Overwritten;
+        }
+        return SharedFrameReadStatus::Ok;
+    }
+
+    SharedFrameReadStatus SharedFrameRingReader::readLatest(SharedFrameMetadata& metadata, std::vector<uint8_t>& data) const {
+        const uint64_t published = publishedCount();
+        if (published == 0) {
+            return SharedFrameReadStatus::NotAvailable;
+        }
+        return read(published - 1, metadata, data);
+    }
+
+} // namespace GenICamWrapper
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief Metadati di un frame pubblicato nell'anello condiviso
+     *
+     * Struttura POD copiata in memoria condivisa: i tempi sono nanosecondi dell'epoca
+     * di std::chrono::steady_clock (CLOCK_MONOTONIC su Linux, QPC su Windows), comuni
+     * a tutti i processi della macchina.
+     */
+    struct SharedFrameMetadata {
+        uint64_t sequence = 0;              // Numero di pubblicazione (0, 1, 2, ...)
+        uint64_t frameID = 0;
+        int64_t timestampNs = 0;            // Istante host del prelievo del buffer
+        uint64_t deviceTimestamp = 0;
+        int64_t hostTimestampNs = 0;        // Valido solo se hostTimestampValid
+        int64_t hostTimestampErrorNs = 0;
+        uint64_t triggerToken = 0;
+        uint64_t dataSize = 0;
+        uint64_t stride = 0;                // Bytes per riga dei dati nello slot
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t pixelFormat = 0;           // GenICamWrapper::PixelFormat del sensore
+        int32_t cvType = -1;                // Tipo OpenCV dei dati convertiti, -1 = buffer raw
+        uint32_t hostTimestampValid = 0;
+        uint32_t reserved = 0;
+        double exposureTime = 0.0;
+        double gain = 0.0;
+    };
+
+    /**
+     * @brief Esito della lettura di uno slot
+     *
+     * NotAvailable: il frame richiesto non è ancora stato pubblicato.
+     * Overwritten:  il writer ha riutilizzato lo slot prima o durante la lettura;
+     *               i dati copiati non sono validi.
+     */
+    enum class SharedFrameReadStatus {
+        Ok,
+        NotAvailable,
+        Overwritten
+    };
+
+    /**
+     * @brief Writer di un anello di frame in memoria condivisa (POSIX shm / file mapping Windows)
+     *
+     * Ogni slot è protetto da un seqlock: il writer non attende mai i reader, che
+     * verificano dopo la copia che lo slot non sia stato sovrascritto. publish()
+     * serializza soltanto i writer tra loro.
+     */
+    class SharedFrameRingWriter {
+    public:
+        SharedFrameRingWriter() = default;
+        ~SharedFrameRingWriter();
+
+        SharedFrameRingWriter(const SharedFrameRingWriter&) = delete;
+        SharedFrameRingWriter& operator=(const SharedFrameRingWriter&) = delete;
+
+        /**
+         * @brief Crea il segmento (un segmento omonimo rimasto da un writer precedente viene sostituito)
+         * @param name Nome del segmento, senza '/' iniziale
+         * @param slotCapacity Bytes di dati per slot
+         * @param error Motivo dell'eventuale fallimento
+         */
+        bool create(const std::string& name, size_t slotCount, size_t slotCapacity, std::string& error);
+
+        /**
+         * @brief Rimuove il segmento; i reader collegati conservano la mappatura fino al distacco
+         */
+        void close();
+
+        /**
+         * @brief Copia un frame nello slot successivo
+         * @param data Prima riga; le righe sono lette a passi di sourceStride e scritte compatte
+         * @return false se il frame supera slotCapacity (nessuno slot modificato)
+         */
+        bool publish(const SharedFrameMetadata& metadata, const void* data,
+            size_t rowBytes, size_t rows, size_t sourceStride);
+
+        bool isOpen() const { return m_base != nullptr; }
+        uint64_t publishedCount() const;
+        size_t slotCapacity() const { return m_slotCapacity; }
+        const std::string& name() const { return m_name; }
+
+    private:
+        std::mutex m_publishMutex;
+        std::string m_name;
+        void* m_base = nullptr;
+        size_t m_mappedSize = 0;
+        size_t m_slotCount = 0;
+        size_t m_slotCapacity = 0;
+#ifdef _WIN32
+        void* m_mappingHandle = nullptr;
+#endif
+    };
+
+    /**
+     * @brief Reader in sola lettura di un anello creato da SharedFrameRingWriter
+     *
+     * Può essere usato da processi che non collegano GenICamCamera: dipende solo
+     * da questo file e da SharedFrameRing.cpp.
+     */
+    class SharedFrameRingReader {
+    public:
+        SharedFrameRingReader() = default;
+        ~SharedFrameRingReader();
+
+        SharedFrameRingReader(const SharedFrameRingReader&) = delete;
+        SharedFrameRingReader& operator=(const SharedFrameRingReader&) = delete;
+
+        bool attach(const std::string& name, std::string& error);
+        void detach();
+
+        /**
+         * @brief Numero di frame pubblicati: il più recente ha sequence = publishedCount() - 1
+         */
+        uint64_t publishedCount() const;
+
+        /**
+         * @brief Copia il frame con il numero di pubblicazione richiesto
+         * @note Un reader in ritardo di slotCount() frame o più riceve Overwritten:
+         *       può ripartire da publishedCount() - 1
+         */
+        SharedFrameReadStatus read(uint64_t sequence, SharedFrameMetadata& metadata, std::vector<uint8_t>& data) const;
+
+        /**
+         * @brief Copia il frame più recente
+         */
+        SharedFrameReadStatus readLatest(SharedFrameMetadata& metadata, std::vector<uint8_t>& data) const;
+
+        bool isAttached() const { return m_base != nullptr; }
+        size_t slotCount() const { return m_slotCount; }
+        size_t slotCapacity() const { return m_slotCapacity; }
+
+    private:
+        const void* m_base = nullptr;
+        size_t m_mappedSize = 0;
+        size_t m_slotCount = 0;
+        size_t m_slotCapacity = 0;
+#ifdef _WIN32
+        void* m_mappingHandle = nullptr;
+#endif
+    };
+
+} // namespace GenICamWrapper
@@ -0,0 +1,195 @@
+#include "ThreadUtils.h"
+#include <thread>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace GenICamWrapper {
+
+    int ThreadUtils::getCpuCount() {
+        unsigned int count = std::thread::hardware_concurrency();
+        return count > 0 ? static_cast<int>(count) : 1;
+    }
+
+    const char* ThreadUtils::policyToString(ThreadSchedulingPolicy policy) {
+        switch (policy) {
+        case ThreadSchedulingPolicy::Fifo: return "FIFO";
+        case ThreadSchedulingPolicy::RoundRobin: return "RR";
+        case ThreadSchedulingPolicy::Default:
+        default: return "Default";
+        }
+    }
+
+#ifdef _WIN32
+
+    ThreadConfigResult ThreadUtils::applyToCurrentThread(const ThreadConfig& config) {
+        ThreadConfigResult result;
+        HANDLE hThread = GetCurrentThread();
+
+        // Affinità (gruppo di processori corrente, max 64 CPU)
+        if (!config.cpuAffinity.empty()) {
+            DWORD_PTR mask = 0;
+            for (int cpu : config.cpuAffinity) {
+                if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+                    mask |= (static_cast<DWORD_PTR>(1) << cpu);
+                }
+            }
+
+            if (mask != 0 && SetThreadAffinityMask(hThread, mask) != 0) {
+                result.cpuAffinity = config.cpuAffinity;
+                result.affinityApplied = true;
+            }
+            else {
+                result.errors.push_back("SetThreadAffinityMask fallita (errore " + std::to_string(GetLastError()) + ")");
+            }
+        }
+
+        // Priorità: le politiche real-time diventano livelli di priorità del thread
+        if (config.policy != ThreadSchedulingPolicy::Default) {
+            int level = THREAD_PRIORITY_ABOVE_NORMAL;
+            if (config.priority >= 90) {
+                level = THREAD_PRIORITY_TIME_CRITICAL;
+            }
+            else if (config.priority >= 50) {
+                level = THREAD_PRIORITY_HIGHEST;
+            }
+
+            if (SetThreadPriority(hThread, level)) {
+                result.schedulingApplied = true;
+            }
+            else {
+                result.errors.push_back("SetThreadPriority fallita (errore " + std::to_string(GetLastError()) + ")");
+            }
+        }
+
+        const int obtained = GetThreadPriority(hThread);
+        result.priority = obtained;
+        result.policy = (result.schedulingApplied && obtained > THREAD_PRIORITY_NORMAL)
+            ? config.policy : ThreadSchedulingPolicy::Default;
+
+        // Nome (Windows 10 1607+)
+        if (!config.name.empty()) {
+            std::wstring wideName(config.name.begin(), config.name.end());
+            if (SUCCEEDED(SetThreadDescription(hThread, wideName.c_str()))) {
+                result.name = config.name;
+                result.nameApplied = true;
+            }
+            else {
+                result.errors.push_back("SetThreadDescription fallita");
+            }
+        }
+
+        return result;
+    }
+
+#elif defined(__linux__)
+
+    ThreadConfigResult ThreadUtils::applyToCurrentThread(const ThreadConfig& config) {
+        ThreadConfigResult result;
+        pthread_t self = pthread_self();
+
+        // Affinità
+        if (!config.cpuAffinity.empty()) {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            for (int cpu : config.cpuAffinity) {
+                if (cpu >= 0 && cpu < CPU_SETSIZE) {
+                    CPU_SET(cpu, &cpuSet);
+                }
+            }
+
+            int rc = pthread_setaffinity_np(self, sizeof(cpuSet), &cpuSet);
+            if (rc == 0) {
+                result.affinityApplied = true;
+            }
+            else {
+                result.errors.push_back(std::string("pthread_setaffinity_np: ") + std::strerror(rc));
+            }
+        }
+
+        // Scheduling real-time
+        if (config.policy != ThreadSchedulingPolicy::Default) {
+            const int policy = (config.policy == ThreadSchedulingPolicy::Fifo) ? SCHED_FIFO : SCHED_RR;
+            sched_param param{};
+            param.sched_priority = config.priority;
+
+            const int minPriority = sched_get_priority_min(policy);
+            const int maxPriority = sched_get_priority_max(policy);
+            if (param.sched_priority < minPriority) {
+                param.sched_priority = minPriority;
+            }
+            if (param.sched_priority > maxPriority) {
+                param.sched_priority = maxPriority;
+            }
+
+            int rc = pthread_setschedparam(self, policy, &param);
+            if (rc == 0) {
+                result.schedulingApplied = true;
+            }
+            else if (rc == EPERM) {
+                result.errors.push_back("Scheduling real-time negato: servono CAP_SYS_NICE o RLIMIT_RTPRIO");
+            }
+            else {
+                result.errors.push_back(std::string("pthread_setschedparam: ") + std::strerror(rc));
+            }
+        }
+
+        // Nome (max 15 caratteri + terminatore)
+        if (!config.name.empty()) {
+            const std::string shortName = config.name.substr(0, 15);
+            int rc = pthread_setname_np(self, shortName.c_str());
+            if (rc == 0) {
+                result.nameApplied = true;
+            }
+            else {
+                result.errors.push_back(std::string("pthread_setname_np: ") + std::strerror(rc));
+            }
+        }
+
+        // Rilettura delle impostazioni effettive
+        cpu_set_t obtainedSet;
+        CPU_ZERO(&obtainedSet);
+        if (pthread_getaffinity_np(self, sizeof(obtainedSet), &obtainedSet) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &obtainedSet)) {
+                    result.cpuAffinity.push_back(cpu);
+                }
+            }
+        }
+
+        int obtainedPolicy = SCHED_OTHER;
+        sched_param obtainedParam{};
+        if (pthread_getschedparam(self, &obtainedPolicy, &obtainedParam) == 0) {
+            result.priority = obtainedParam.sched_priority;
+            result.policy = obtainedPolicy == SCHED_FIFO ? ThreadSchedulingPolicy::Fifo
+                : obtainedPolicy == SCHED_RR ? ThreadSchedulingPolicy::RoundRobin
+                : ThreadSchedulingPolicy::Default;
+        }
+
+        char obtainedName[16] = {};
+        if (pthread_getname_np(self, obtainedName, sizeof(obtainedName)) == 0) {
+            result.name = obtainedName;
+        }
+
+        return result;
+    }
+
+#else
+
+    ThreadConfigResult ThreadUtils::applyToCurrentThread(const ThreadConfig& config) {
+        ThreadConfigResult result;
+        if (!config.cpuAffinity.empty() || config.policy != ThreadSchedulingPolicy::Default || !config.name.empty()) {
+            result.errors.push_back("Configurazione dei thread non supportata su questa piattaforma");
+        }
+        return result;
+    }
+
+#endif
+
+} // namespace GenICamWrapper
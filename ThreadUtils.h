@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace GenICamWrapper {
+
+    /**
+     * @brief Politica di scheduling richiesta per un thread
+     *
+     * Default:    scheduler normale del sistema operativo (SCHED_OTHER su Linux).
+     * Fifo:       real-time SCHED_FIFO (Linux), priorità 1-99.
+     * RoundRobin: real-time SCHED_RR (Linux), priorità 1-99.
+     * Su Windows le politiche real-time sono mappate sui livelli di priorità del thread.
+     */
+    enum class ThreadSchedulingPolicy {
+        Default,
+        Fifo,
+        RoundRobin
+    };
+
+    /**
+     * @brief Configurazione di scheduling, affinità e nome di un thread
+     */
+    struct ThreadConfig {
+        std::vector<int> cpuAffinity;       // CPU consentite; vuoto = nessun vincolo
+        ThreadSchedulingPolicy policy = ThreadSchedulingPolicy::Default;
+        int priority = 0;                   // Priorità real-time (ignorata con Default)
+        std::string name;                   // Su Linux troncato a 15 caratteri
+    };
+
+    /**
+     * @brief Impostazioni effettivamente ottenute dal sistema operativo
+     *
+     * I valori sono riletti dopo l'applicazione: in assenza di privilegi
+     * (CAP_SYS_NICE / RLIMIT_RTPRIO su Linux) policy e priority restano quelle
+     * di default e il motivo è riportato in errors.
+     */
+    struct ThreadConfigResult {
+        std::vector<int> cpuAffinity;
+        ThreadSchedulingPolicy policy = ThreadSchedulingPolicy::Default;
+        int priority = 0;
+        std::string name;
+        bool affinityApplied = false;
+        bool schedulingApplied = false;
+        bool nameApplied = false;
+        std::vector<std::string> errors;
+    };
+
+    /**
+     * @brief Funzioni di configurazione dei thread (Linux e Windows)
+     */
+    class ThreadUtils {
+    public:
+        /**
+         * @brief Applica la configurazione al thread chiamante
+         * @param config Impostazioni richieste; i campi vuoti/di default non vengono toccati
+         * @return Impostazioni ottenute ed eventuali errori (nessuna eccezione)
+         */
+        static ThreadConfigResult applyToCurrentThread(const ThreadConfig& config);
+
+        /**
+         * @brief Numero di CPU logiche disponibili
+         */
+        static int getCpuCount();
+
+        static const char* policyToString(ThreadSchedulingPolicy policy);
+    };
+
+} // namespace GenICamWrapper